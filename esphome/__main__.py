@@ -254,6 +254,9 @@ def upload_using_esptool(config, port):
 
 
 def upload_program(config, args, host):
+    if getattr(args, "delta_base", None) and not CORE.is_esp32:
+        raise EsphomeError("Delta patches (--delta-base) are only supported on ESP32")
+
     # if upload is to a serial port use platformio, otherwise assume ota
     if get_port_type(host) == "SERIAL":
         return upload_using_esptool(config, host)
@@ -269,7 +272,44 @@ def upload_program(config, args, host):
     ota_conf = config[CONF_OTA]
     remote_port = ota_conf[CONF_PORT]
     password = ota_conf.get(CONF_PASSWORD, "")
-    return espota2.run_ota(host, remote_port, password, CORE.firmware_bin)
+    firmware = CORE.firmware_bin
+    if getattr(args, "delta_base", None):
+        firmware = create_delta_patch(args.delta_base, firmware)
+    return espota2.run_ota(host, remote_port, password, firmware)
+
+
+def create_delta_patch(base, firmware):
+    from esphome import ota_delta
+
+    with open(base, "rb") as f:
+        old = f.read()
+    with open(firmware, "rb") as f:
+        new = f.read()
+    patch = ota_delta.create_patch(old, new)
+    path = os.path.splitext(firmware)[0] + ".delta"
+    with open(path, "wb") as f:
+        f.write(patch)
+    _LOGGER.info(
+        "Created a delta patch of %s bytes against %s (firmware is %s bytes)",
+        len(patch),
+        base,
+        len(new),
+    )
+    return path
+
+
+def get_binary_log_elf(config, args):
+    """The firmware ELF to decode binary log messages with, or None to show the text logs."""
+    if not config[CONF_LOGGER].get("binary_logs", False):
+        return None
+    elf = getattr(args, "elf", None) or CORE.firmware_elf
+    if not os.path.isfile(elf):
+        _LOGGER.warning(
+            "Firmware ELF %s not found, binary log messages can't be decoded. Showing text logs instead.",
+            elf,
+        )
+        return None
+    return elf
 
 
 def show_logs(config, args, port):
@@ -281,7 +321,7 @@ def show_logs(config, args, port):
     if get_port_type(port) == "NETWORK" and "api" in config:
         from esphome.components.api.client import run_logs
 
-        return run_logs(config, port)
+        return run_logs(config, port, get_binary_log_elf(config, args))
     if get_port_type(port) == "MQTT" and "mqtt" in config:
         from esphome import mqtt
 
@@ -566,6 +606,11 @@ def parse_args(argv):
         "--device",
         help="Manually specify the serial port/address to use, for example /dev/ttyUSB0.",
     )
+    parser_upload.add_argument(
+        "--delta-base",
+        help="Upload only the changes against this firmware binary, which must be the "
+        "one running on the device (ESP32 only).",
+    )
 
     parser_logs = subparsers.add_parser(
         "logs",
@@ -579,6 +624,11 @@ def parse_args(argv):
         "--device",
         help="Manually specify the serial port/address to use, for example /dev/ttyUSB0.",
     )
+    parser_logs.add_argument(
+        "--elf",
+        help="Firmware ELF file to decode binary log messages (logger: binary_logs) with, "
+        "defaults to the ELF of the last build.",
+    )
 
     parser_run = subparsers.add_parser(
         "run",
@@ -0,0 +1,232 @@
+"""Decoder for the binary log messages of devices with ``logger: binary_logs: true``.
+
+Instead of the formatted text, such devices send the addresses of the format string and the tag, the line and the
+raw arguments of each log call (see esphome/components/logger/binary_log.cpp). The strings are looked up in the
+firmware ELF of the same build, so the ELF has to match the firmware running on the device. ``esphome logs`` asks for
+binary messages and decodes them with the ELF of the last build, or the one given with ``--elf``.
+
+Floating point arguments are sent as 32 bit floats. A double logged with more than about 7 significant digits is
+printed with less precision than in the text log.
+"""
+import re
+import struct
+
+LOG_LEVEL_COLORS = [
+    "",  # NONE
+    "\033[1;31m",  # ERROR
+    "\033[0;33m",  # WARNING
+    "\033[0;32m",  # INFO
+    "\033[0;35m",  # CONFIG
+    "\033[0;36m",  # DEBUG
+    "\033[0;37m",  # VERBOSE
+    "\033[0;38m",  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+LOG_RESET_COLOR = "\033[0m"
+
+SHT_NOBITS = 8
+
+# Field numbers of the binary logs in the API messages, see api.proto
+SUBSCRIBE_LOGS_REQUEST_BINARY = 3
+SUBSCRIBE_LOGS_RESPONSE_BINARY_MESSAGE = 5
+
+# flags, width, precision, length modifier, conversion
+CONVERSION_RE = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t|L)?([diuoxXcfFeEgGaAsp%])"
+)
+
+
+class ElfStrings:
+    """Look up null terminated strings by their address in a 32 bit little endian ELF file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path} is not a 32 bit little endian ELF file")
+
+        (shoff,) = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        self._sections = []
+        for i in range(shnum):
+            _, sh_type, _, addr, offset, size = struct.unpack_from(
+                "<IIIIII", data, shoff + i * shentsize
+            )
+            if addr == 0 or sh_type == SHT_NOBITS:
+                continue
+            self._sections.append((addr, data[offset : offset + size]))
+        self._cache = {}
+
+    def __call__(self, address):
+        if address in self._cache:
+            return self._cache[address]
+        for start, content in self._sections:
+            if start <= address < start + len(content):
+                offset = address - start
+                end = content.find(b"\0", offset)
+                if end == -1:
+                    end = len(content)
+                value = content[offset:end].decode("utf-8", "replace")
+                self._cache[address] = value
+                return value
+        raise KeyError(f"No string at address 0x{address:08X} in the ELF file")
+
+
+class _Reader:
+    def __init__(self, data):
+        self._data = data
+        self._pos = 0
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = self._data[self._pos]
+            self._pos += 1
+            result |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return result
+
+    def zigzag(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def float(self):
+        # Doubles are sent as float32 as well, see the module docstring
+        (value,) = struct.unpack_from("<f", self._data, self._pos)
+        self._pos += 4
+        return value
+
+    def string(self):
+        length = self.varint()
+        value = self._data[self._pos : self._pos + length]
+        self._pos += length
+        return value.decode("utf-8", "replace")
+
+
+def _format(fmt, reader):
+    parts = []
+    pos = 0
+    for match in CONVERSION_RE.finditer(fmt):
+        parts.append(fmt[pos : match.start()])
+        pos = match.end()
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == "%":
+            parts.append("%")
+            continue
+
+        if width == "*":
+            value = reader.zigzag()
+            if value < 0:
+                flags += "-"
+            width = str(abs(value))
+        if precision == "*":
+            value = reader.zigzag()
+            precision = str(value) if value >= 0 else None
+        spec = "%" + flags + (width or "")
+        if precision is not None:
+            spec += "." + precision
+
+        if conversion in "di":
+            parts.append((spec + "d") % reader.zigzag())
+        elif conversion == "u":
+            parts.append((spec + "d") % reader.varint())
+        elif conversion == "o" and "#" in flags:
+            # Python would prefix 0o instead of 0
+            value = reader.varint()
+            parts.append((spec.replace("#", "") + "s") % (f"0{value:o}" if value else "0"))
+        elif conversion in "oxX":
+            parts.append((spec + conversion) % reader.varint())
+        elif conversion == "c":
+            parts.append((spec + "c") % chr(reader.zigzag()))
+        elif conversion in "aA":
+            value = float.hex(reader.float())
+            parts.append(value.upper() if conversion == "A" else value)
+        elif conversion in "fFeEgG":
+            parts.append((spec + conversion) % reader.float())
+        elif conversion == "s":
+            parts.append((spec + "s") % reader.string())
+        elif conversion == "p":
+            parts.append(f"0x{reader.varint():x}")
+    parts.append(fmt[pos:])
+    return "".join(parts)
+
+
+def decode_message(data, read_string):
+    """Decode a binary log message into its tag, line and message text.
+
+    read_string returns the string at an address of the firmware, usually an ElfStrings.
+    """
+    reader = _Reader(data)
+    format_address = reader.varint()
+    if format_address == 0:
+        # Format string not in flash, the device sent the formatted text
+        tag = reader.string()
+        line = reader.varint()
+        return tag, line, reader.string()
+
+    tag = read_string(reader.varint())
+    line = reader.varint()
+    return tag, line, _format(read_string(format_address), reader)
+
+
+def format_log_line(level, tag, line, message):
+    """Format a message the same way the device formats the text it sends to log subscribers."""
+    level = max(0, min(level, 7))
+    return (
+        f"{LOG_LEVEL_COLORS[level]}[{LOG_LEVEL_LETTERS[level]}][{tag}:{line:03}]: "
+        f"{message}{LOG_RESET_COLOR}"
+    )
+
+
+def decode_log_line(level, data, read_string):
+    """Decode a binary log message into the line the device would have sent as text."""
+    try:
+        tag, line, message = decode_message(data, read_string)
+    except (KeyError, IndexError, ValueError, struct.error) as err:
+        # Most likely the ELF file doesn't belong to the firmware on the device
+        return format_log_line(
+            level, "binary_log", 0, f"Can't decode message {data.hex()}: {err}"
+        )
+    return format_log_line(level, tag, line, message)
+
+
+def _varint(data, pos):
+    result = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return result, pos
+
+
+def encode_bool_field(number, value):
+    """Encode a bool field in the protobuf wire format, for fields the API client library doesn't know yet."""
+    return bytes([number << 3, 1 if value else 0])
+
+
+def find_bytes_field(data, number):
+    """Return the value of a bytes field of a protobuf message in the wire format, or None if it isn't set."""
+    value = None
+    pos = 0
+    while pos < len(data):
+        key, pos = _varint(data, pos)
+        wire_type = key & 7
+        if wire_type == 0:
+            _, pos = _varint(data, pos)
+        elif wire_type == 1:
+            pos += 8
+        elif wire_type == 2:
+            length, pos = _varint(data, pos)
+            if key >> 3 == number:
+                value = bytes(data[pos : pos + length])
+            pos += length
+        elif wire_type == 5:
+            pos += 4
+        else:
+            raise ValueError(f"Unsupported protobuf wire type {wire_type}")
+    return value
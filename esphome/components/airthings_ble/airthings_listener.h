@@ -10,6 +10,9 @@ namespace airthings_ble {
 
 class AirthingsListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  // Airthings manufacturer data
+  AirthingsListener() { this->set_match_uuid16(0x0334); }
+
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
@@ -20,10 +20,14 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.connection";
+// Rather stay below one TCP segment per batch than build frames the socket can't take right away
+static const size_t MAX_BATCH_SIZE = 1400;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
-  this->proto_write_buffer_.reserve(64);
+  this->proto_write_buffer_.reserve(128);
+  this->socket_fd_ = sock->get_fd();
+  App.register_wake_socket(this->socket_fd_);
 
 #if defined(USE_API_PLAINTEXT)
   helper_ = std::unique_ptr<APIFrameHelper>{new APIPlaintextFrameHelper(std::move(sock))};
@@ -33,8 +37,10 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #error "No frame helper defined"
 #endif
 }
+APIConnection::~APIConnection() { App.unregister_wake_socket(this->socket_fd_); }
 void APIConnection::start() {
   this->last_traffic_ = millis();
+  this->connected_at_ = this->last_traffic_;
 
   APIError err = helper_->init();
   if (err != APIError::OK) {
@@ -92,11 +98,14 @@ void APIConnection::loop() {
       return;
   }
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  this->advance_iterators_();
 
   const uint32_t keepalive = 60000;
   const uint32_t now = millis();
+  if (!this->pending_state_updates_.empty() &&
+      now - this->pending_state_updates_.get_pending_since() >= this->parent_->get_batch_delay())
+    this->flush_state_updates_();
+
   if (this->sent_ping_) {
     // Disconnect if not responded within 2.5*keepalive
     if (now - this->last_traffic_ > (keepalive * 5) / 2) {
@@ -144,6 +153,10 @@ void APIConnection::loop() {
       }
     }
   }
+
+  // The socket only wakes the loop for incoming data, with tickless idle queued frames would otherwise wait
+  if (this->helper_->has_pending_tx_data())
+    App.wake_when_writable(this->socket_fd_);
 }
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
@@ -167,6 +180,8 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(binary_sensor, StateUpdateType::BINARY_SENSOR, state))
+    return true;
 
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
@@ -193,6 +208,8 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(cover, StateUpdateType::COVER))
+    return true;
 
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
@@ -257,6 +274,8 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::FanState *fan) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(fan, StateUpdateType::FAN))
+    return true;
 
   auto traits = fan->get_traits();
   FanStateResponse resp{};
@@ -317,6 +336,8 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(light, StateUpdateType::LIGHT))
+    return true;
 
   auto traits = light->get_traits();
   auto values = light->remote_values;
@@ -414,6 +435,8 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(sensor, StateUpdateType::SENSOR))
+    return true;
 
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
@@ -445,6 +468,8 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(a_switch, StateUpdateType::SWITCH))
+    return true;
 
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
@@ -479,6 +504,8 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(text_sensor, StateUpdateType::TEXT_SENSOR))
+    return true;
 
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
@@ -505,6 +532,8 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(climate, StateUpdateType::CLIMATE))
+    return true;
 
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
@@ -603,6 +632,8 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 bool APIConnection::send_number_state(number::Number *number, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(number, StateUpdateType::NUMBER))
+    return true;
 
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
@@ -643,6 +674,8 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 bool APIConnection::send_select_state(select::Select *select, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->queue_state_update_(select, StateUpdateType::SELECT))
+    return true;
 
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
@@ -736,7 +769,7 @@ void APIConnection::on_get_time_response(const GetTimeResponse &value) {
 #endif
 
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
-  if (this->log_subscription_ < level)
+  if (this->log_subscription_ < level || this->log_binary_)
     return false;
 
   // Send raw so that we don't copy too much
@@ -748,6 +781,20 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
+#ifdef USE_LOGGER_BINARY
+bool APIConnection::send_binary_log_message(int level, const uint8_t *data, size_t len) {
+  if (this->log_subscription_ < level || !this->log_binary_)
+    return false;
+
+  auto buffer = this->create_buffer();
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, static_cast<uint32_t>(level));
+  // bytes binary_message = 5;
+  buffer.encode_bytes(5, data, len);
+  // SubscribeLogsResponse - 29
+  return this->send_buffer(buffer, 29);
+}
+#endif
 
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info + " (" + this->helper_->getpeername() + ")";
@@ -756,7 +803,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
 
   HelloResponse resp;
   resp.api_version_major = 1;
-  resp.api_version_minor = 6;
+  resp.api_version_minor = 7;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
@@ -819,9 +866,156 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
+bool APIConnection::queue_state_update_(EntityBase *entity, StateUpdateType type, bool binary_state) {
+  const uint32_t batch_delay = this->parent_->get_batch_delay();
+  if (batch_delay == 0 || this->batch_active_)
+    return false;
+
+#ifdef USE_TICKLESS_IDLE
+  if (this->pending_state_updates_.empty()) {
+    // Make sure the loop doesn't sleep past the batch delay. The timeout is anonymous so that the batches of several
+    // connections don't cancel each other's wakeup.
+    App.scheduler.set_timeout(this->parent_, "", batch_delay, []() {});
+  }
+#endif
+  this->pending_state_updates_.push(entity, type, binary_state);
+  return true;
+}
+bool APIConnection::send_pending_state_(const PendingStateUpdate &update) {
+  switch (update.type) {
+#ifdef USE_BINARY_SENSOR
+    case StateUpdateType::BINARY_SENSOR:
+      return this->send_binary_sensor_state(static_cast<binary_sensor::BinarySensor *>(update.entity),
+                                            update.binary_state);
+#endif
+#ifdef USE_COVER
+    case StateUpdateType::COVER:
+      return this->send_cover_state(static_cast<cover::Cover *>(update.entity));
+#endif
+#ifdef USE_FAN
+    case StateUpdateType::FAN:
+      return this->send_fan_state(static_cast<fan::FanState *>(update.entity));
+#endif
+#ifdef USE_LIGHT
+    case StateUpdateType::LIGHT:
+      return this->send_light_state(static_cast<light::LightState *>(update.entity));
+#endif
+#ifdef USE_SENSOR
+    case StateUpdateType::SENSOR: {
+      auto *sensor = static_cast<sensor::Sensor *>(update.entity);
+      return this->send_sensor_state(sensor, sensor->state);
+    }
+#endif
+#ifdef USE_SWITCH
+    case StateUpdateType::SWITCH: {
+      auto *a_switch = static_cast<switch_::Switch *>(update.entity);
+      return this->send_switch_state(a_switch, a_switch->state);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case StateUpdateType::TEXT_SENSOR: {
+      auto *text_sensor = static_cast<text_sensor::TextSensor *>(update.entity);
+      return this->send_text_sensor_state(text_sensor, text_sensor->state);
+    }
+#endif
+#ifdef USE_CLIMATE
+    case StateUpdateType::CLIMATE:
+      return this->send_climate_state(static_cast<climate::Climate *>(update.entity));
+#endif
+#ifdef USE_NUMBER
+    case StateUpdateType::NUMBER: {
+      auto *number = static_cast<number::Number *>(update.entity);
+      return this->send_number_state(number, number->state);
+    }
+#endif
+#ifdef USE_SELECT
+    case StateUpdateType::SELECT: {
+      auto *select = static_cast<select::Select *>(update.entity);
+      return this->send_select_state(select, select->state);
+    }
+#endif
+    default:
+      return false;
+  }
+}
+void APIConnection::flush_state_updates_() {
+  if (this->remove_ || !this->helper_->can_write_without_blocking())
+    return;
+
+  this->begin_batch_();
+  size_t handled = this->pending_state_updates_.build_batch(
+      [this]() { return this->proto_write_buffer_.size() < MAX_BATCH_SIZE; },
+      [this](const PendingStateUpdate &update) {
+        size_t frame_start = this->proto_write_buffer_.size();
+        if (this->send_pending_state_(update))
+          return true;
+        // Drop the partial frame, but keep the ones already built as they may already be encrypted
+        this->proto_write_buffer_.resize(frame_start);
+        return false;
+      });
+  if (this->end_batch_())
+    this->pending_state_updates_.pop(handled);
+
+  uint32_t dropped = this->pending_state_updates_.take_dropped();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "%s: Dropped %u state updates that couldn't be sent", this->client_info_.c_str(), dropped);
+}
+void APIConnection::advance_iterators_() {
+  if (this->list_entities_iterator_.completed() && this->initial_state_iterator_.completed())
+    return;
+  // Wait until the previous batch has left the frame helper, so a slow client is fed at the rate its TCP window
+  // opens up instead of failing sends; the iterators resume at the entity they stopped at.
+  if (this->remove_ || !this->helper_->can_write_without_blocking())
+    return;
+
+  this->begin_batch_();
+  while (this->proto_write_buffer_.size() < MAX_BATCH_SIZE) {
+    size_t frame_start = this->proto_write_buffer_.size();
+    bool progress;
+    if (!this->list_entities_iterator_.completed()) {
+      progress = this->list_entities_iterator_.advance();
+    } else if (!this->initial_state_iterator_.completed()) {
+      progress = this->initial_state_iterator_.advance();
+    } else {
+      break;
+    }
+    if (!progress) {
+      this->proto_write_buffer_.resize(frame_start);
+      break;
+    }
+  }
+  this->end_batch_();
+}
+void APIConnection::begin_batch_() {
+  this->proto_write_buffer_.clear();
+  this->batch_active_ = true;
+}
+bool APIConnection::end_batch_() {
+  this->batch_active_ = false;
+  if (this->proto_write_buffer_.empty())
+    return true;
+
+  APIError err = this->helper_->write_frames(ProtoWriteBuffer{&this->proto_write_buffer_});
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Batch write failed %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+    return false;
+  }
+  this->last_traffic_ = millis();
+  return true;
+}
+void APIConnection::on_initial_states_sent() {
+  uint32_t sync_time = millis() - this->connected_at_;
+  ESP_LOGD(TAG, "%s: Initial states sent %ums after connecting", this->client_info_.c_str(), sync_time);
+  this->parent_->record_sync_time(sync_time);
+}
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
+  if (this->batch_active_) {
+    // The frame is sent together with the rest of the batch in flush_state_updates_()
+    return this->helper_->finish_frame(message_type, buffer, this->batch_frame_start_) == APIError::OK;
+  }
   if (!this->helper_->can_write_without_blocking()) {
     delay(0);
     APIError err = helper_->loop();
@@ -840,7 +1034,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
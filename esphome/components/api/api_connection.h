@@ -2,10 +2,12 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/application.h"
+#include "esphome/core/entity_base.h"
 #include "api_pb2.h"
 #include "api_pb2_service.h"
 #include "api_server.h"
 #include "api_frame_helper.h"
+#include "state_update_queue.h"
 
 namespace esphome {
 namespace api {
@@ -13,10 +15,12 @@ namespace api {
 class APIConnection : public APIServerConnection {
  public:
   APIConnection(std::unique_ptr<socket::Socket> socket, APIServer *parent);
-  virtual ~APIConnection() = default;
+  virtual ~APIConnection();
 
   void start();
   void loop();
+  /// Called once the initial state of every entity has been handed to the frame helper.
+  void on_initial_states_sent();
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -79,6 +83,9 @@ class APIConnection : public APIServerConnection {
   void button_command(const ButtonCommandRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+#ifdef USE_LOGGER_BINARY
+  bool send_binary_log_message(int level, const uint8_t *data, size_t len);
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -112,6 +119,10 @@ class APIConnection : public APIServerConnection {
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+#ifdef USE_LOGGER_BINARY
+    this->log_binary_ = msg.binary;
+#endif
+    this->parent_->update_log_subscriptions();
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -132,8 +143,16 @@ class APIConnection : public APIServerConnection {
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
   ProtoWriteBuffer create_buffer() override {
+    if (this->batch_active_) {
+      // Append the next frame of the batch after the frames that were already built
+      this->batch_frame_start_ = this->proto_write_buffer_.size();
+      this->proto_write_buffer_.resize(this->batch_frame_start_ + this->helper_->frame_header_padding());
+      return {&this->proto_write_buffer_};
+    }
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    // Leave room for the frame header so the frame helper can send the encoded message without copying it
+    this->proto_write_buffer_.resize(this->helper_->frame_header_padding());
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -143,6 +162,19 @@ class APIConnection : public APIServerConnection {
 
   bool send_(const void *buf, size_t len, bool force);
 
+  /// Defer a state update when batching is enabled, returns false if the update must be sent right away.
+  bool queue_state_update_(EntityBase *entity, StateUpdateType type, bool binary_state = false);
+  /// Send the current state of an entity, used when flushing deferred state updates.
+  bool send_pending_state_(const PendingStateUpdate &update);
+  /// Build frames for as many deferred state updates as fit into one batch and send them with a single write.
+  void flush_state_updates_();
+  /// Run the entity iterators until a batch is full, but only once the previous batch has been written.
+  void advance_iterators_();
+  /// Build all following messages back to back into proto_write_buffer_ instead of sending them one by one.
+  void begin_batch_();
+  /// Send all frames built since begin_batch_() with a single write.
+  bool end_batch_();
+
   enum class ConnectionState {
     WAITING_FOR_HELLO,
     CONNECTED,
@@ -155,6 +187,12 @@ class APIConnection : public APIServerConnection {
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
   std::unique_ptr<APIFrameHelper> helper_;
+  int socket_fd_{-1};
+
+  StateUpdateQueue pending_state_updates_;
+  // While set, create_buffer()/send_buffer() append frames to proto_write_buffer_ instead of writing them
+  bool batch_active_{false};
+  size_t batch_frame_start_{0};
 
   std::string client_info_;
 #ifdef USE_ESP32_CAMERA
@@ -163,7 +201,10 @@ class APIConnection : public APIServerConnection {
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+  /// The client asked for binary log messages, devices without binary log support always send text.
+  bool log_binary_{false};
   uint32_t last_traffic_;
+  uint32_t connected_at_{0};
   bool sent_ping_{false};
   bool service_call_subscription_{false};
   bool next_close_ = false;
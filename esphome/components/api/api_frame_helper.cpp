@@ -18,6 +18,19 @@ bool is_would_block(ssize_t ret) {
   return ret == 0;
 }
 
+/** Append data to a TX backlog buffer.
+ *
+ * Bytes before offset have already been sent. Instead of erasing them after every write, they're only dropped here
+ * once they make up at least half of the buffer, so the buffer keeps its capacity and is moved around rarely.
+ */
+static void append_tx_buf(std::vector<uint8_t> &buf, size_t &offset, const uint8_t *data, size_t len) {
+  if (offset != 0 && offset >= buf.size() / 2) {
+    buf.erase(buf.begin(), buf.begin() + offset);
+    offset = 0;
+  }
+  buf.insert(buf.end(), data, data + len);
+}
+
 const char *api_error_to_str(APIError err) {
   // not using switch to ensure compiler doesn't try to build a big table out of it
   if (err == APIError::OK) {
@@ -458,7 +471,15 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+// indicator + encrypted size + type + data_len
+uint8_t APINoiseFrameHelper::frame_header_padding() { return 7; }
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
+  APIError aerr = this->finish_frame(type, buffer, 0);
+  if (aerr != APIError::OK)
+    return aerr;
+  return this->write_frames(buffer);
+}
+APIError APINoiseFrameHelper::finish_frame(uint16_t type, ProtoWriteBuffer buffer, size_t frame_start) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -470,31 +491,26 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
-
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  // The payload was encoded after frame_header_padding() reserved bytes, build the frame around it in place
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
   const uint8_t msg_offset = 3;
   const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  size_t payload_len = raw_buffer->size() - frame_start - payload_offset;
+  size_t msg_len = 4 + payload_len;
+  // Make room for the MAC, this doesn't allocate once the buffer has grown to the connection's typical message size
+  raw_buffer->resize(raw_buffer->size() + noise_cipherstate_get_mac_length(send_cipher_));
+  uint8_t *buf = raw_buffer->data() + frame_start;
+
+  buf[0] = 0x01;  // indicator
+  // buf[1], buf[2] to be set later
+  buf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
+  buf[msg_offset + 1] = (uint8_t) type;
+  buf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
+  buf[msg_offset + 3] = (uint8_t) payload_len;
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &buf[msg_offset], msg_len, raw_buffer->size() - frame_start - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -502,13 +518,20 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::CIPHERSTATE_ENCRYPT_FAILED;
   }
 
-  size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t)(mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf[1] = (uint8_t)(mbuf.size >> 8);
+  buf[2] = (uint8_t) mbuf.size;
+  raw_buffer->resize(frame_start + 3 + mbuf.size);
+  return APIError::OK;
+}
+APIError APINoiseFrameHelper::write_frames(ProtoWriteBuffer buffer) {
+  if (state_ != State::DATA) {
+    return APIError::WOULD_BLOCK;
+  }
 
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
-  iov.iov_len = total_len;
+  iov.iov_base = raw_buffer->data();
+  iov.iov_len = raw_buffer->size();
 
   // write raw to not have two packets sent if NAGLE disabled
   return write_raw_(&iov, 1);
@@ -516,7 +539,7 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    ssize_t sent = socket_->write(tx_buf_.data() + tx_buf_offset_, tx_buf_.size() - tx_buf_offset_);
     if (sent == -1) {
       if (errno == EWOULDBLOCK || errno == EAGAIN)
         break;
@@ -526,9 +549,11 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
     } else if (sent == 0) {
       break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_offset_ += sent;
+    if (tx_buf_offset_ == tx_buf_.size()) {
+      tx_buf_.clear();
+      tx_buf_offset_ = 0;
+    }
   }
 
   return APIError::OK;
@@ -562,8 +587,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -572,8 +596,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -588,8 +611,8 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
+                      iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
@@ -886,28 +909,78 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+// indicator + size varint (up to 3 bytes) + type varint (up to 2 bytes)
+uint8_t APIPlaintextFrameHelper::frame_header_padding() { return 6; }
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  // The payload was encoded after frame_header_padding() reserved bytes, put the header right in front of it
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  const uint8_t header_padding = this->frame_header_padding();
+  size_t payload_len = raw_buffer->size() - header_padding;
+  ProtoVarInt size_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  uint8_t header_len = 1 + size_varint.encoded_size() + type_varint.encoded_size();
+  if (header_len > header_padding)
+    return APIError::BAD_ARG;
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
+  uint8_t *header = raw_buffer->data() + header_padding - header_len;
+  header[0] = 0x00;  // indicator
+  uint8_t at = 1;
+  at += size_varint.encode(header + at);
+  type_varint.encode(header + at);
 
-  return write_raw_(iov, 2);
+  struct iovec iov;
+  iov.iov_base = header;
+  iov.iov_len = header_len + payload_len;
+
+  return write_raw_(&iov, 1);
+}
+APIError APIPlaintextFrameHelper::finish_frame(uint16_t type, ProtoWriteBuffer buffer, size_t frame_start) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  const uint8_t header_padding = this->frame_header_padding();
+  size_t payload_len = raw_buffer->size() - frame_start - header_padding;
+  ProtoVarInt size_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  uint8_t header_len = 1 + size_varint.encoded_size() + type_varint.encoded_size();
+  if (header_len > header_padding)
+    return APIError::BAD_ARG;
+
+  uint8_t *frame = raw_buffer->data() + frame_start;
+  if (header_len != header_padding) {
+    // The header is shorter than the space reserved for it, close the gap so frames stay back to back
+    std::memmove(frame + header_len, frame + header_padding, payload_len);
+    raw_buffer->resize(frame_start + header_len + payload_len);
+    frame = raw_buffer->data() + frame_start;
+  }
+  frame[0] = 0x00;  // indicator
+  uint8_t at = 1;
+  at += size_varint.encode(frame + at);
+  type_varint.encode(frame + at);
+  return APIError::OK;
+}
+APIError APIPlaintextFrameHelper::write_frames(ProtoWriteBuffer buffer) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  struct iovec iov;
+  iov.iov_base = raw_buffer->data();
+  iov.iov_len = raw_buffer->size();
+
+  return write_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    ssize_t sent = socket_->write(tx_buf_.data() + tx_buf_offset_, tx_buf_.size() - tx_buf_offset_);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -915,9 +988,11 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_offset_ += sent;
+    if (tx_buf_offset_ == tx_buf_.size()) {
+      tx_buf_.clear();
+      tx_buf_offset_ = 0;
+    }
   }
 
   return APIError::OK;
@@ -951,8 +1026,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -961,8 +1035,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -977,8 +1050,8 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        append_tx_buf(tx_buf_, tx_buf_offset_, reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
+                      iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
@@ -12,6 +12,7 @@
 
 #include "esphome/components/socket/socket.h"
 #include "api_noise_context.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -65,7 +66,23 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /// Whether there is data queued that the socket couldn't take yet.
+  virtual bool has_pending_tx_data() = 0;
+  /// Number of bytes to reserve in front of a payload for write_protobuf_packet() to build the frame header in.
+  virtual uint8_t frame_header_padding() = 0;
+  /** Send a packet whose payload was encoded into buffer after frame_header_padding() reserved bytes.
+   *
+   * The frame is built (and encrypted) in place, so the buffer's contents are changed.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /** Build the frame for a payload that was encoded into buffer after frame_start + frame_header_padding() bytes.
+   *
+   * Afterwards the frame occupies everything from frame_start to the end of the buffer, so several frames can be
+   * built back to back and then sent together with write_frames().
+   */
+  virtual APIError finish_frame(uint16_t type, ProtoWriteBuffer buffer, size_t frame_start) = 0;
+  /// Send all frames that were built in buffer with finish_frame().
+  virtual APIError write_frames(ProtoWriteBuffer buffer) = 0;
   virtual std::string getpeername() = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
@@ -83,7 +100,11 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_tx_data() override { return !this->tx_buf_.empty(); }
+  uint8_t frame_header_padding() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError finish_frame(uint16_t type, ProtoWriteBuffer buffer, size_t frame_start) override;
+  APIError write_frames(ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -113,6 +134,8 @@ class APINoiseFrameHelper : public APIFrameHelper {
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  /// Number of bytes at the start of tx_buf_ that have already been sent.
+  size_t tx_buf_offset_ = 0;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -143,7 +166,11 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_tx_data() override { return !this->tx_buf_.empty(); }
+  uint8_t frame_header_padding() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError finish_frame(uint16_t type, ProtoWriteBuffer buffer, size_t frame_start) override;
+  APIError write_frames(ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -171,6 +198,8 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  /// Number of bytes at the start of tx_buf_ that have already been sent.
+  size_t tx_buf_offset_ = 0;
 
   enum class State {
     INITIALIZE = 1,
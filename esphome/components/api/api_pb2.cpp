@@ -2433,6 +2433,10 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->dump_config = value.as_bool();
       return true;
     }
+    case 3: {
+      this->binary = value.as_bool();
+      return true;
+    }
     default:
       return false;
   }
@@ -2440,6 +2444,7 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
+  buffer.encode_bool(3, this->binary);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
@@ -2452,6 +2457,10 @@ void SubscribeLogsRequest::dump_to(std::string &out) const {
   out.append("  dump_config: ");
   out.append(YESNO(this->dump_config));
   out.append("\n");
+
+  out.append("  binary: ");
+  out.append(YESNO(this->binary));
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -2475,6 +2484,10 @@ bool SubscribeLogsResponse::decode_length(uint32_t field_id, ProtoLengthDelimite
       this->message = value.as_string();
       return true;
     }
+    case 5: {
+      this->binary_message = value.as_string();
+      return true;
+    }
     default:
       return false;
   }
@@ -2483,6 +2496,7 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
+  buffer.encode_string(5, this->binary_message);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
@@ -2499,6 +2513,10 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
   out.append("  send_failed: ");
   out.append(YESNO(this->send_failed));
   out.append("\n");
+
+  out.append("  binary_message: ");
+  out.append("'").append(this->binary_message).append("'");
+  out.append("\n");
   out.append("}");
 }
 #endif
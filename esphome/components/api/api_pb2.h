@@ -640,6 +640,7 @@ class SubscribeLogsRequest : public ProtoMessage {
  public:
   enums::LogLevel level{};
   bool dump_config{false};
+  bool binary{false};
   void encode(ProtoWriteBuffer buffer) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -653,6 +654,7 @@ class SubscribeLogsResponse : public ProtoMessage {
   enums::LogLevel level{};
   std::string message{};
   bool send_failed{false};
+  std::string binary_message{};
   void encode(ProtoWriteBuffer buffer) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
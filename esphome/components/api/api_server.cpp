@@ -8,6 +8,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/components/network/util.h"
 #include <cerrno>
+#include <algorithm>
 
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
@@ -62,13 +63,14 @@ void APIServer::setup() {
     this->mark_failed();
     return;
   }
+  App.register_wake_socket(socket_->get_fd());
 
-#ifdef USE_LOGGER
+#ifdef USE_LOGGER_BINARY
   if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+    logger::global_logger->add_on_binary_log_callback([this](int level, const uint8_t *data, size_t len) {
       for (auto &c : this->clients_) {
         if (!c->remove_)
-          c->send_log_message(level, tag, message);
+          c->send_binary_log_message(level, data, len);
       }
     });
   }
@@ -110,7 +112,10 @@ void APIServer::loop() {
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
   }
   // resize vector
-  this->clients_.erase(new_end, this->clients_.end());
+  if (new_end != this->clients_.end()) {
+    this->clients_.erase(new_end, this->clients_.end());
+    this->update_log_subscriptions();
+  }
 
   for (auto &client : this->clients_) {
     client->loop();
@@ -138,6 +143,8 @@ void APIServer::dump_config() {
 #else
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
+  if (this->batch_delay_ != 0)
+    ESP_LOGCONFIG(TAG, "  State batch delay: %ums", this->batch_delay_);
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -283,6 +290,52 @@ const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_sta
 }
 uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
+void APIServer::update_log_subscriptions() {
+#ifdef USE_LOGGER
+  if (logger::global_logger == nullptr)
+    return;
+
+  bool text_subscribers = false;
+  int binary_level = ESPHOME_LOG_LEVEL_NONE;
+  for (auto &c : this->clients_) {
+    if (c->remove_ || c->log_subscription_ == ESPHOME_LOG_LEVEL_NONE)
+      continue;
+    if (c->log_binary_) {
+      binary_level = std::max(binary_level, c->log_subscription_);
+    } else {
+      text_subscribers = true;
+    }
+  }
+#ifdef USE_LOGGER_BINARY
+  logger::global_logger->set_binary_log_level(binary_level);
+#endif
+  // Only hook into formatted messages once a client wants them, so that the logger doesn't have to format messages
+  // that nobody reads when all subscribers use the binary encoding
+  if (text_subscribers && !this->log_callback_registered_) {
+    this->log_callback_registered_ = true;
+    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+      for (auto &c : this->clients_) {
+        if (!c->remove_)
+          c->send_log_message(level, tag, message);
+      }
+    });
+  }
+#endif
+}
+void APIServer::record_sync_time(uint32_t sync_time) {
+  this->last_sync_time_ = sync_time;
+#ifdef USE_SENSOR
+  if (this->sync_time_sensor_ != nullptr)
+    this->sync_time_sensor_->publish_state(sync_time);
+#endif
+  if (sync_time <= this->max_sync_time_)
+    return;
+  this->max_sync_time_ = sync_time;
+#ifdef USE_SENSOR
+  if (this->max_sync_time_sensor_ != nullptr)
+    this->max_sync_time_sensor_->publish_state(sync_time);
+#endif
+}
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
   for (auto &client : this->clients_) {
@@ -30,6 +30,22 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Update the logger after a client changed its log subscription or disconnected.
+  void update_log_subscriptions();
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
+  /// Record how long a client took from connecting until all initial states were sent.
+  void record_sync_time(uint32_t sync_time);
+  /// Time from connecting until all initial states were sent, for the last client that subscribed to states.
+  uint32_t get_last_sync_time() const { return this->last_sync_time_; }
+  /// The longest time any client took from connecting until all initial states were sent.
+  uint32_t get_max_sync_time() const { return this->max_sync_time_; }
+#ifdef USE_SENSOR
+  void set_sync_time_sensor(sensor::Sensor *sync_time_sensor) { this->sync_time_sensor_ = sync_time_sensor; }
+  void set_max_sync_time_sensor(sensor::Sensor *max_sync_time_sensor) {
+    this->max_sync_time_sensor_ = max_sync_time_sensor;
+  }
+#endif
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -90,6 +106,14 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t batch_delay_{0};
+  bool log_callback_registered_{false};
+  uint32_t last_sync_time_{0};
+  uint32_t max_sync_time_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *sync_time_sensor_{nullptr};
+  sensor::Sensor *max_sync_time_sensor_{nullptr};
+#endif
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
@@ -4,8 +4,10 @@ from datetime import datetime
 from typing import Optional
 
 from aioesphomeapi import APIClient, ReconnectLogic, APIConnectionError, LogLevel
+from aioesphomeapi.api_pb2 import SubscribeLogsRequest, SubscribeLogsResponse
 import zeroconf
 
+from esphome import binary_log
 from esphome.const import CONF_KEY, CONF_PORT, CONF_PASSWORD, __version__
 from esphome.util import safe_print
 from . import CONF_ENCRYPTION
@@ -13,7 +15,25 @@ from . import CONF_ENCRYPTION
 _LOGGER = logging.getLogger(__name__)
 
 
-async def async_run_logs(config, address):
+async def async_subscribe_binary_logs(cli, on_log, dump_config):
+    # aioesphomeapi doesn't know SubscribeLogsRequest.binary yet, so the field is added as an unknown field and the
+    # request is sent the same way APIClient.subscribe_logs() sends it
+    req = SubscribeLogsRequest(
+        level=LogLevel.LOG_LEVEL_VERY_VERBOSE, dump_config=dump_config
+    )
+    req.MergeFromString(
+        binary_log.encode_bool_field(binary_log.SUBSCRIBE_LOGS_REQUEST_BINARY, True)
+    )
+
+    def on_msg(msg):
+        if isinstance(msg, SubscribeLogsResponse):
+            on_log(msg)
+
+    # pylint: disable=protected-access
+    await cli._connection.send_message_callback_response(req, on_msg)
+
+
+async def async_run_logs(config, address, elf=None):
     conf = config["api"]
     port: int = int(conf[CONF_PORT])
     password: str = conf[CONF_PASSWORD]
@@ -30,20 +50,37 @@ async def async_run_logs(config, address):
         noise_psk=noise_psk,
     )
     first_connect = True
+    read_string = None
+    if elf is not None:
+        _LOGGER.info("Decoding binary log messages with %s", elf)
+        read_string = binary_log.ElfStrings(elf)
 
     def on_log(msg):
         time_ = datetime.now().time().strftime("[%H:%M:%S]")
-        text = msg.message.decode("utf8", "backslashreplace")
+        data = None
+        if read_string is not None:
+            # Unknown fields are kept when parsing, so binary_message is still in the serialized message
+            data = binary_log.find_bytes_field(
+                msg.SerializeToString(),
+                binary_log.SUBSCRIBE_LOGS_RESPONSE_BINARY_MESSAGE,
+            )
+        if data is not None:
+            text = binary_log.decode_log_line(msg.level, data, read_string)
+        else:
+            text = msg.message.decode("utf8", "backslashreplace")
         safe_print(time_ + text)
 
     async def on_connect():
         nonlocal first_connect
         try:
-            await cli.subscribe_logs(
-                on_log,
-                log_level=LogLevel.LOG_LEVEL_VERY_VERBOSE,
-                dump_config=first_connect,
-            )
+            if read_string is not None:
+                await async_subscribe_binary_logs(cli, on_log, first_connect)
+            else:
+                await cli.subscribe_logs(
+                    on_log,
+                    log_level=LogLevel.LOG_LEVEL_VERY_VERBOSE,
+                    dump_config=first_connect,
+                )
             first_connect = False
         except APIConnectionError:
             cli.disconnect()
@@ -68,5 +105,5 @@ async def async_run_logs(config, address):
         zc.close()
 
 
-def run_logs(config, address):
-    asyncio.run(async_run_logs(config, address))
+def run_logs(config, address, elf=None):
+    asyncio.run(async_run_logs(config, address, elf))
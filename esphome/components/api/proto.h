@@ -67,6 +67,27 @@ class ProtoVarInt {
     else
       return static_cast<int64_t>(this->value_ >> 1);
   }
+  /// Size of the encoded varint in bytes.
+  uint8_t encoded_size() const {
+    uint32_t val = this->value_;
+    uint8_t size = 1;
+    while (val > 0x7F) {
+      val >>= 7;
+      size++;
+    }
+    return size;
+  }
+  /// Encode into a raw buffer that has room for at least encoded_size() bytes, returns the bytes written.
+  uint8_t encode(uint8_t *out) const {
+    uint32_t val = this->value_;
+    uint8_t i = 0;
+    while (val > 0x7F) {
+      out[i++] = (val & 0x7F) | 0x80;
+      val >>= 7;
+    }
+    out[i++] = val;
+    return i;
+  }
   void encode(std::vector<uint8_t> &out) {
     uint32_t val = this->value_;
     if (val <= 0x7F) {
@@ -156,8 +177,7 @@ class ProtoWriteBuffer {
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
     auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size());
@@ -234,9 +254,9 @@ class ProtoWriteBuffer {
 
     const uint32_t nested_length = this->buffer_->size() - begin;
     // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
+    uint8_t var[5];
+    uint8_t var_len = ProtoVarInt(nested_length).encode(var);
+    this->buffer_->insert(this->buffer_->begin() + begin, var, var + var_len);
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
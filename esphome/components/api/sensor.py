@@ -0,0 +1,49 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+)
+from . import APIServer
+
+DEPENDENCIES = ["api"]
+
+CONF_API_ID = "api_id"
+CONF_SYNC_TIME = "sync_time"
+CONF_MAX_SYNC_TIME = "max_sync_time"
+
+UNIT_MILLISECOND = "ms"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_API_ID): cv.use_id(APIServer),
+        cv.Optional(CONF_SYNC_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_MAX_SYNC_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    server = await cg.get_variable(config[CONF_API_ID])
+
+    if CONF_SYNC_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_SYNC_TIME])
+        cg.add(server.set_sync_time_sensor(sens))
+
+    if CONF_MAX_SYNC_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_MAX_SYNC_TIME])
+        cg.add(server.set_max_sync_time_sensor(sens))
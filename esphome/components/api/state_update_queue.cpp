@@ -0,0 +1,40 @@
+#include "state_update_queue.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace api {
+
+void StateUpdateQueue::push(EntityBase *entity, StateUpdateType type, bool binary_state) {
+#ifdef USE_BINARY_SENSOR
+  if (type == StateUpdateType::BINARY_SENSOR) {
+    // Only a repeat of the last queued state is dropped
+    for (auto it = this->updates_.rbegin(); it != this->updates_.rend(); ++it) {
+      if (it->entity == entity) {
+        if (it->binary_state == binary_state)
+          return;
+        break;
+      }
+    }
+  } else
+#endif
+  {
+    for (auto &update : this->updates_) {
+      if (update.entity == entity)
+        return;
+    }
+  }
+  if (this->updates_.empty())
+    this->pending_since_ = millis();
+  this->updates_.push_back(PendingStateUpdate{entity, type, binary_state});
+}
+void StateUpdateQueue::pop(size_t count) {
+  this->updates_.erase(this->updates_.begin(), this->updates_.begin() + count);
+}
+uint32_t StateUpdateQueue::take_dropped() {
+  uint32_t dropped = this->dropped_;
+  this->dropped_ = 0;
+  return dropped;
+}
+
+}  // namespace api
+}  // namespace esphome
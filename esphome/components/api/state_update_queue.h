@@ -0,0 +1,97 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+enum class StateUpdateType : uint8_t {
+#ifdef USE_BINARY_SENSOR
+  BINARY_SENSOR,
+#endif
+#ifdef USE_COVER
+  COVER,
+#endif
+#ifdef USE_FAN
+  FAN,
+#endif
+#ifdef USE_LIGHT
+  LIGHT,
+#endif
+#ifdef USE_SENSOR
+  SENSOR,
+#endif
+#ifdef USE_SWITCH
+  SWITCH,
+#endif
+#ifdef USE_TEXT_SENSOR
+  TEXT_SENSOR,
+#endif
+#ifdef USE_CLIMATE
+  CLIMATE,
+#endif
+#ifdef USE_NUMBER
+  NUMBER,
+#endif
+#ifdef USE_SELECT
+  SELECT,
+#endif
+};
+
+struct PendingStateUpdate {
+  EntityBase *entity;
+  StateUpdateType type;
+  /// The state to send for binary sensors, whose updates aren't coalesced.
+  bool binary_state;
+};
+
+/** The state updates of a native API connection that wait for the next batch (api: batch_delay).
+ *
+ * Every entity has at most one queued update and its state is read from the entity when the batch is built, so the
+ * latest state wins. Binary sensors are the exception: every change is queued with its state, so that a pulse (e.g.
+ * motion or a button press) within the batch delay isn't lost.
+ */
+class StateUpdateQueue {
+ public:
+  /// Queue the state update of an entity, `binary_state` is only used for binary sensors.
+  void push(EntityBase *entity, StateUpdateType type, bool binary_state = false);
+
+  /** Call `build` for the queued updates in order, as long as `has_room` returns true.
+   *
+   * An update that `build` returns false for, e.g. because its message couldn't be encoded, is counted as dropped
+   * and skipped, so that it can't hold up the updates behind it for the rest of the connection. Returns the number of
+   * updates that were handled, remove them with pop() once the batch was written.
+   */
+  template<typename R, typename B> size_t build_batch(R &&has_room, B &&build) {
+    size_t handled = 0;
+    for (auto &update : this->updates_) {
+      if (!has_room())
+        break;
+      if (!build(update))
+        this->dropped_++;
+      handled++;
+    }
+    return handled;
+  }
+  /// Remove the first `count` updates.
+  void pop(size_t count);
+
+  bool empty() const { return this->updates_.empty(); }
+  size_t size() const { return this->updates_.size(); }
+  /// When the oldest of the queued updates was queued.
+  uint32_t get_pending_since() const { return this->pending_since_; }
+  /// Updates that were dropped since the last call.
+  uint32_t take_dropped();
+
+ protected:
+  std::vector<PendingStateUpdate> updates_;
+  uint32_t pending_since_{0};
+  uint32_t dropped_{0};
+};
+
+}  // namespace api
+}  // namespace esphome
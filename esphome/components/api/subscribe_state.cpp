@@ -47,6 +47,10 @@ bool InitialStateIterator::on_select(select::Select *select) {
   return this->client_->send_select_state(select, select->state);
 }
 #endif
+bool InitialStateIterator::on_end() {
+  this->client_->on_initial_states_sent();
+  return true;
+}
 InitialStateIterator::InitialStateIterator(APIServer *server, APIConnection *client)
     : ComponentIterator(server), client_(client) {}
 
@@ -46,6 +46,8 @@ class InitialStateIterator : public ComponentIterator {
 #ifdef USE_SELECT
   bool on_select(select::Select *select) override;
 #endif
+  bool on_end() override;
+
  protected:
   APIConnection *client_;
 };
@@ -12,18 +12,18 @@ void ComponentIterator::begin() {
   this->state_ = IteratorState::BEGIN;
   this->at_ = 0;
 }
-void ComponentIterator::advance() {
+bool ComponentIterator::advance() {
   bool advance_platform = false;
   bool success = true;
   switch (this->state_) {
     case IteratorState::NONE:
       // not started
-      return;
+      return false;
     case IteratorState::BEGIN:
       if (this->on_begin()) {
         advance_platform = true;
       } else {
-        return;
+        return false;
       }
       break;
 #ifdef USE_BINARY_SENSOR
@@ -216,8 +216,9 @@ void ComponentIterator::advance() {
     case IteratorState::MAX:
       if (this->on_end()) {
         this->state_ = IteratorState::NONE;
+        return true;
       }
-      return;
+      return false;
   }
 
   if (advance_platform) {
@@ -226,6 +227,7 @@ void ComponentIterator::advance() {
   } else if (success) {
     this->at_++;
   }
+  return advance_platform || success;
 }
 bool ComponentIterator::on_end() { return true; }
 bool ComponentIterator::on_begin() { return true; }
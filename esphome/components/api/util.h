@@ -18,7 +18,9 @@ class ComponentIterator {
   ComponentIterator(APIServer *server);
 
   void begin();
-  void advance();
+  /// Handle the next entity, returns false if there was nothing to do or the message couldn't be sent.
+  bool advance();
+  bool completed() const { return this->state_ == IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
@@ -89,7 +89,10 @@ class BLEClient : public espbt::ESPBTClient, public Component {
   void on_scan_end() override {}
   void connect() override;
 
-  void set_address(uint64_t address) { this->address = address; }
+  void set_address(uint64_t address) {
+    this->address = address;
+    this->set_match_address(address);
+  }
 
   void set_enabled(bool enabled);
 
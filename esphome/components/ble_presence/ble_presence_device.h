@@ -20,6 +20,7 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
   void set_service_uuid16(uint16_t uuid) {
     this->match_by_ = MATCH_BY_SERVICE_UUID;
     this->uuid_ = esp32_ble_tracker::ESPBTUUID::from_uint16(uuid);
+    this->set_match_uuid16(uuid);
   }
   void set_service_uuid32(uint32_t uuid) {
     this->match_by_ = MATCH_BY_SERVICE_UUID;
@@ -32,6 +33,8 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
   void set_ibeacon_uuid(uint8_t *uuid) {
     this->match_by_ = MATCH_BY_IBEACON_UUID;
     this->ibeacon_uuid_ = esp32_ble_tracker::ESPBTUUID::from_raw(uuid);
+    // iBeacons are manufacturer data of Apple
+    this->set_match_uuid16(0x004C);
   }
   void set_ibeacon_major(uint16_t major) {
     this->check_ibeacon_major_ = true;
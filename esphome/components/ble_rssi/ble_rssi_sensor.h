@@ -18,6 +18,7 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
   void set_service_uuid16(uint16_t uuid) {
     this->by_address_ = false;
     this->uuid_ = esp32_ble_tracker::ESPBTUUID::from_uint16(uuid);
+    this->set_match_uuid16(uuid);
   }
   void set_service_uuid32(uint32_t uuid) {
     this->by_address_ = false;
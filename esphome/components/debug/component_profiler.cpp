@@ -0,0 +1,133 @@
+#include "component_profiler.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef USE_DEBUG_PROFILER
+
+namespace esphome {
+namespace debug {
+
+static const char *const TAG = "debug";
+
+ComponentProfiler *global_component_profiler = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static const char *profile_name(const ComponentProfile *profile) {
+  if (profile->component == nullptr)
+    return "<unknown>";
+  return profile->component->get_component_source();
+}
+
+uint32_t ComponentProfile::quantile_us(float quantile) const {
+  uint32_t total = 0;
+  for (uint32_t samples : this->histogram)
+    total += samples;
+  uint32_t target = static_cast<uint32_t>(ceilf(total * quantile));
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+    seen += this->histogram[i];
+    if (seen >= target && seen != 0) {
+      // Bucket i holds durations in [2^(i-1), 2^i - 1]
+      uint32_t upper = i == 0 ? 0 : (1UL << i) - 1;
+      return std::min(upper, this->max_us);
+    }
+  }
+  return this->max_us;
+}
+
+ComponentProfiler::ComponentProfiler(size_t max_components) : profiles_(max_components) {}
+
+ComponentProfile *HOT ComponentProfiler::find_(Component *component) {
+  const size_t size = this->profiles_.size();
+  if (size == 0)
+    return nullptr;
+  // Open addressing on the component pointer, the table never shrinks so entries stay where they are
+  size_t index = (reinterpret_cast<uintptr_t>(component) >> 2) % size;
+  for (size_t i = 0; i < size; i++) {
+    ComponentProfile &profile = this->profiles_[index];
+    if (!profile.used) {
+      profile.used = true;
+      profile.component = component;
+      return &profile;
+    }
+    if (profile.component == component)
+      return &profile;
+    index = (index + 1) % size;
+  }
+  return nullptr;
+}
+void HOT ComponentProfiler::record_loop(Component *component, uint32_t duration_us) {
+  ComponentProfile *profile = this->find_(component);
+  if (profile == nullptr) {
+    this->dropped_++;
+    return;
+  }
+  profile->count++;
+  profile->total_us += duration_us;
+  profile->max_us = std::max(profile->max_us, duration_us);
+  uint8_t bucket = 0;
+  while (duration_us != 0 && bucket < PROFILER_HISTOGRAM_BUCKETS - 1) {
+    duration_us >>= 1;
+    bucket++;
+  }
+  profile->histogram[bucket]++;
+}
+void ComponentProfiler::record_setup(Component *component, uint32_t duration_us) {
+  ComponentProfile *profile = this->find_(component);
+  if (profile == nullptr) {
+    this->dropped_++;
+    return;
+  }
+  profile->setup_us += duration_us;
+}
+std::vector<const ComponentProfile *> ComponentProfiler::sorted_by_total_() {
+  std::vector<const ComponentProfile *> sorted;
+  for (const auto &profile : this->profiles_) {
+    if (profile.used)
+      sorted.push_back(&profile);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const ComponentProfile *a, const ComponentProfile *b) { return a->total_us > b->total_us; });
+  return sorted;
+}
+void ComponentProfiler::dump(uint32_t window_ms) {
+  const float window_us = window_ms * 1000.0f;
+  ESP_LOGD(TAG, "Component profile over the last %.1fs:", window_ms / 1000.0f);
+  for (const auto *profile : this->sorted_by_total_()) {
+    ESP_LOGD(TAG, "  %-24s count=%-7u p50<=%-6u p99<=%-6u max=%-7u cpu=%5.2f%% setup=%uus", profile_name(profile),
+             profile->count, profile->quantile_us(0.5f), profile->quantile_us(0.99f), profile->max_us,
+             window_us > 0 ? profile->total_us * 100.0f / window_us : 0.0f, profile->setup_us);
+  }
+  if (this->dropped_ != 0)
+    ESP_LOGW(TAG, "  %u measurements dropped, increase max_components", this->dropped_);
+}
+std::string ComponentProfiler::summarize(uint32_t window_ms, size_t max_entries) {
+  const float window_us = window_ms * 1000.0f;
+  std::string summary;
+  for (const auto *profile : this->sorted_by_total_()) {
+    if (max_entries-- == 0)
+      break;
+    if (!summary.empty())
+      summary += ", ";
+    char buf[16];
+    snprintf(buf, sizeof(buf), " %.1f%%", window_us > 0 ? profile->total_us * 100.0f / window_us : 0.0f);
+    summary += profile_name(profile);
+    summary += buf;
+  }
+  return summary;
+}
+void ComponentProfiler::reset_window() {
+  for (auto &profile : this->profiles_) {
+    profile.count = 0;
+    profile.max_us = 0;
+    profile.total_us = 0;
+    std::fill(std::begin(profile.histogram), std::end(profile.histogram), 0);
+  }
+  this->dropped_ = 0;
+}
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif  // USE_DEBUG_PROFILER
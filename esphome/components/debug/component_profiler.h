@@ -0,0 +1,60 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace debug {
+
+#ifdef USE_DEBUG_PROFILER
+/// Number of log2-spaced duration buckets, the last one collects everything >= 2^(N-2) µs (~0.26 s).
+static const uint8_t PROFILER_HISTOGRAM_BUCKETS = 20;
+
+/// Timing statistics of a single component, collected over one reporting window.
+struct ComponentProfile {
+  Component *component{nullptr};
+  bool used{false};
+  uint32_t setup_us{0};
+  uint32_t count{0};
+  uint32_t max_us{0};
+  uint64_t total_us{0};
+  uint32_t histogram[PROFILER_HISTOGRAM_BUCKETS]{};
+
+  /// Estimate the given quantile (0-1) from the histogram, as an upper bound in µs.
+  uint32_t quantile_us(float quantile) const;
+};
+
+/** Fixed-size table of per-component timing statistics.
+ *
+ * Fed by WarnIfComponentBlockingGuard (loop() calls and scheduler callbacks) and Component::call() (setup()).
+ * The table is allocated once; components that don't fit in it anymore are only counted as dropped.
+ */
+class ComponentProfiler {
+ public:
+  explicit ComponentProfiler(size_t max_components);
+
+  void record_loop(Component *component, uint32_t duration_us);
+  void record_setup(Component *component, uint32_t duration_us);
+
+  /// Log the statistics collected over the last window_ms milliseconds.
+  void dump(uint32_t window_ms);
+  /// Short summary of the components with the highest CPU share, suitable for a text sensor.
+  std::string summarize(uint32_t window_ms, size_t max_entries);
+  /// Start a new reporting window. Setup times are kept.
+  void reset_window();
+
+ protected:
+  ComponentProfile *find_(Component *component);
+  std::vector<const ComponentProfile *> sorted_by_total_();
+
+  std::vector<ComponentProfile> profiles_;
+  uint32_t dropped_{0};
+};
+
+extern ComponentProfiler *global_component_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
+}  // namespace debug
+}  // namespace esphome
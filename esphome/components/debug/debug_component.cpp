@@ -1,5 +1,6 @@
 #include "debug_component.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/version.h"
@@ -26,6 +27,33 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+#ifdef USE_DEBUG_PROFILER
+void DebugComponent::enable_profiler(size_t max_components, uint32_t update_interval) {
+  global_component_profiler = new ComponentProfiler(max_components);  // NOLINT(cppcoreguidelines-owning-memory)
+  this->profiler_update_interval_ = update_interval;
+}
+void DebugComponent::report_profile_() {
+  const uint32_t now = millis();
+  const uint32_t window = now - this->profiler_window_start_;
+  global_component_profiler->dump(window);
+#ifdef USE_TEXT_SENSOR
+  if (this->profile_text_sensor_ != nullptr)
+    this->profile_text_sensor_->publish_state(global_component_profiler->summarize(window, 5));
+#endif
+  global_component_profiler->reset_window();
+  this->profiler_window_start_ = now;
+}
+#endif
+
+void DebugComponent::setup() {
+#ifdef USE_DEBUG_PROFILER
+  if (global_component_profiler != nullptr) {
+    this->profiler_window_start_ = millis();
+    this->set_interval("profiler", this->profiler_update_interval_, [this]() { this->report_profile_(); });
+  }
+#endif
+}
+
 void DebugComponent::dump_config() {
 #ifndef ESPHOME_LOG_HAS_DEBUG
   ESP_LOGE(TAG, "Debug Component requires debug log level!");
@@ -34,6 +62,10 @@ void DebugComponent::dump_config() {
 #endif
 
   ESP_LOGD(TAG, "ESPHome version %s", ESPHOME_VERSION);
+#ifdef USE_DEBUG_PROFILER
+  if (global_component_profiler != nullptr)
+    ESP_LOGD(TAG, "Component profiler: reporting every %.1fs", this->profiler_update_interval_ / 1000.0f);
+#endif
 #ifdef USE_ARDUINO
   this->free_heap_ = ESP.getFreeHeap();  // NOLINT(readability-static-accessed-through-instance)
 #elif defined(USE_ESP_IDF)
@@ -1,18 +1,45 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <vector>
+#include "component_profiler.h"
+
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
 
 namespace esphome {
 namespace debug {
 
 class DebugComponent : public Component {
  public:
+  void setup() override;
   void loop() override;
   float get_setup_priority() const override;
   void dump_config() override;
 
+#ifdef USE_DEBUG_PROFILER
+  void enable_profiler(size_t max_components, uint32_t update_interval);
+#ifdef USE_TEXT_SENSOR
+  void set_profile_text_sensor(text_sensor::TextSensor *profile_text_sensor) {
+    this->profile_text_sensor_ = profile_text_sensor;
+  }
+#endif
+#endif
+
  protected:
   uint32_t free_heap_{};
+
+#ifdef USE_DEBUG_PROFILER
+  void report_profile_();
+
+  uint32_t profiler_update_interval_{60000};
+  uint32_t profiler_window_start_{0};
+#ifdef USE_TEXT_SENSOR
+  text_sensor::TextSensor *profile_text_sensor_{nullptr};
+#endif
+#endif
 };
 
 }  // namespace debug
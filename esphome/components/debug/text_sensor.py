@@ -0,0 +1,53 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.components import text_sensor
+from esphome.const import (
+    CONF_ENTITY_CATEGORY,
+    CONF_ICON,
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+)
+from . import CONF_DEBUG_ID, CONF_PROFILER, DebugComponent
+
+DEPENDENCIES = ["debug"]
+
+CONF_PROFILE = "profile"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
+        cv.Optional(CONF_PROFILE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
+            {
+                cv.GenerateID(): cv.declare_id(text_sensor.TextSensor),
+                cv.Optional(CONF_ICON, default=ICON_TIMER): text_sensor.icon,
+                cv.Optional(
+                    CONF_ENTITY_CATEGORY, default=ENTITY_CATEGORY_DIAGNOSTIC
+                ): cv.entity_category,
+            }
+        ),
+    }
+)
+
+
+def _validate_profiler_enabled(config):
+    if CONF_PROFILE in config:
+        debug_config = fv.full_config.get()["debug"]
+        if CONF_PROFILER not in debug_config:
+            raise cv.Invalid(
+                "The profile text sensor requires the 'profiler' option of the debug component",
+                path=[CONF_PROFILE],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _validate_profiler_enabled
+
+
+async def to_code(config):
+    debug_component = await cg.get_variable(config[CONF_DEBUG_ID])
+    if CONF_PROFILE in config:
+        sens = cg.new_Pvariable(config[CONF_PROFILE][CONF_ID])
+        await text_sensor.register_text_sensor(sens, config[CONF_PROFILE])
+        cg.add(debug_component.set_profile_text_sensor(sens))
@@ -1,5 +1,6 @@
 #include "display_buffer.h"
 
+#include <algorithm>
 #include <utility>
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
@@ -22,6 +23,50 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   }
   this->clear();
 }
+void DisplayBuffer::mark_dirty_all_() {
+  this->dirty_x1_ = 0;
+  this->dirty_y1_ = 0;
+  this->dirty_x2_ = this->get_width_internal() - 1;
+  this->dirty_y2_ = this->get_height_internal() - 1;
+}
+void DisplayBuffer::reset_dirty_() {
+  this->dirty_x1_ = INT_MAX;
+  this->dirty_y1_ = INT_MAX;
+  this->dirty_x2_ = -1;
+  this->dirty_y2_ = -1;
+}
+void DisplayBuffer::flush_dirty_() {
+  const uint32_t start = micros();
+  // The size can change after the region was marked, e.g. when the driver learns its model during setup
+  const int x1 = std::max(this->dirty_x1_, 0);
+  const int y1 = std::max(this->dirty_y1_, 0);
+  const int x2 = std::min(this->dirty_x2_, this->get_width_internal() - 1);
+  const int y2 = std::min(this->dirty_y2_, this->get_height_internal() - 1);
+  size_t bytes = 0;
+  if (x1 <= x2 && y1 <= y2)
+    bytes = this->flush_rect_(x1, y1, x2, y2);
+  this->reset_dirty_();
+  this->flush_bytes_ = bytes;
+  this->flush_time_us_ = micros() - start;
+  ESP_LOGV(TAG, "Flushed %u bytes in %u us", this->flush_bytes_, this->flush_time_us_);
+}
+bool DisplayBuffer::row_changed_(int row, const uint8_t *data, size_t length) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  // 0 means unknown
+  if (hash == 0)
+    hash = 1;
+  if (row >= int(this->row_hashes_.size()))
+    this->row_hashes_.resize(row + 1, 0);
+  if (this->row_hashes_[row] == hash)
+    return false;
+  this->row_hashes_[row] = hash;
+  return true;
+}
 void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
 int DisplayBuffer::get_width() {
@@ -88,14 +133,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->filled_rectangle(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->filled_rectangle(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -103,11 +144,113 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1, y1, height, color);
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
-void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+void HOT DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  this->fill_rect_(x1, y1, width, height, color);
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::fill_rect_(int x1, int y1, int width, int height, Color color) {
+  if (width <= 0 || height <= 0)
+    return;
+
+  // Rotate the whole rectangle once instead of every pixel
+  int x, y, w, h;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+    default:
+      x = x1, y = y1, w = width, h = height;
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      x = this->get_width_internal() - y1 - height, y = x1, w = height, h = width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x1 - width, y = this->get_height_internal() - y1 - height, w = width, h = height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      x = y1, y = this->get_height_internal() - x1 - width, w = height, h = width;
+      break;
+  }
+  this->fill_absolute_rect_internal(x, y, w, h, color);
+}
+bool DisplayBuffer::clip_absolute_rect_(int *x, int *y, int *width, int *height) {
+  if (*x < 0) {
+    *width += *x;
+    *x = 0;
+  }
+  if (*y < 0) {
+    *height += *y;
+    *y = 0;
   }
+  *width = std::min(*width, this->get_width_internal() - *x);
+  *height = std::min(*height, this->get_height_internal() - *y);
+  return *width > 0 && *height > 0;
+}
+void HOT DisplayBuffer::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int j = y; j < y + height; j++) {
+    for (int i = x; i < x + width; i++)
+      this->draw_absolute_pixel_internal(i, j, color);
+  }
+}
+void HOT DisplayBuffer::draw_absolute_row_internal(int x, int y, const Color *colors, int length) {
+  for (int i = 0; i < length; i++)
+    this->draw_absolute_pixel_internal(x + i, y, colors[i]);
+}
+void HOT DisplayBuffer::draw_pixels_at_(int x, int y, Color *colors, int length) {
+  if (length <= 0)
+    return;
+
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+    default:
+      this->draw_absolute_row_internal(x, y, colors, length);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      // The row runs from right to left on the display
+      std::reverse(colors, colors + length);
+      this->draw_absolute_row_internal(this->get_width_internal() - x - length, this->get_height_internal() - y - 1,
+                                       colors, length);
+      break;
+    case DISPLAY_ROTATION_90_DEGREES: {
+      // The row is a column on the display
+      const int abs_x = this->get_width_internal() - y - 1;
+      for (int i = 0; i < length; i++)
+        this->draw_absolute_pixel_internal(abs_x, x + i, colors[i]);
+      break;
+    }
+    case DISPLAY_ROTATION_270_DEGREES: {
+      const int abs_y = this->get_height_internal() - x - 1;
+      for (int i = 0; i < length; i++)
+        this->draw_absolute_pixel_internal(y, abs_y - i, colors[i]);
+      break;
+    }
+  }
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::draw_glyph_(int x, int y, const Glyph &glyph, Color color) {
+  const GlyphData *data = glyph.glyph_data_;
+  const int bytes_per_row = (data->width + 7) / 8;
+  x += data->offset_x;
+  y += data->offset_y;
+  for (int glyph_y = 0; glyph_y < data->height; glyph_y++) {
+    const uint8_t *row = data->data + glyph_y * bytes_per_row;
+    uint8_t byte = 0;
+    int run_start = -1;
+    // One past the end to close the last run
+    for (int glyph_x = 0; glyph_x <= data->width; glyph_x++) {
+      bool on = false;
+      if (glyph_x < data->width) {
+        if (glyph_x % 8 == 0)
+          byte = progmem_read_byte(row + glyph_x / 8);
+        on = byte & (0x80 >> (glyph_x % 8));
+      }
+      if (on && run_start < 0) {
+        run_start = glyph_x;
+      } else if (!on && run_start >= 0) {
+        this->fill_rect_(x + run_start, y + glyph_y, glyph_x - run_start, 1, color);
+        run_start = -1;
+      }
+    }
+  }
+  App.feed_wdt();
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
@@ -174,9 +317,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->filled_rectangle(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -185,16 +326,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     }
 
     const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    this->draw_glyph_(x_at, y_start, glyph, color);
 
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
@@ -211,26 +343,38 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color_on : color_off);
+      // Draw runs of equal pixels as spans
+      for (int img_y = 0; img_y < image->get_height(); img_y++) {
+        int run_start = 0;
+        bool run_on = image->get_pixel(0, img_y);
+        for (int img_x = 1; img_x <= image->get_width(); img_x++) {
+          bool on = img_x < image->get_width() && image->get_pixel(img_x, img_y);
+          if (img_x < image->get_width() && on == run_on)
+            continue;
+          this->fill_rect_(x + run_start, y + img_y, img_x - run_start, 1, run_on ? color_on : color_off);
+          run_start = img_x;
+          run_on = on;
         }
+        App.feed_wdt();
       }
       break;
     case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
+    case IMAGE_TYPE_RGB24: {
+      // Copy the rows in chunks
+      Color colors[32];
+      const bool grayscale = image->get_type() == IMAGE_TYPE_GRAYSCALE;
+      for (int img_y = 0; img_y < image->get_height(); img_y++) {
+        for (int img_x = 0; img_x < image->get_width(); img_x += 32) {
+          const int length = std::min(32, image->get_width() - img_x);
+          for (int i = 0; i < length; i++) {
+            colors[i] = grayscale ? image->get_grayscale_pixel(img_x + i, img_y)
+                                  : image->get_color_pixel(img_x + i, img_y);
+          }
+          this->draw_pixels_at_(x + img_x, y + img_y, colors, length);
         }
       }
       break;
+    }
   }
 }
 
@@ -5,6 +5,8 @@
 #include "esphome/core/automation.h"
 #include "display_color_utils.h"
 #include <cstdarg>
+#include <climits>
+#include <vector>
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
@@ -84,6 +86,7 @@ enum DisplayRotation {
 
 class Font;
 class Image;
+class Glyph;
 class DisplayBuffer;
 class DisplayPage;
 class DisplayOnPageChangeTrigger;
@@ -336,11 +339,85 @@ class DisplayBuffer {
   // Internal method to set display auto clearing.
   void set_auto_clear(bool auto_clear_enabled) { this->auto_clear_enabled_ = auto_clear_enabled; }
 
+  /// Get the number of bytes the last update sent to the display.
+  uint32_t get_flush_bytes() const { return this->flush_bytes_; }
+  /// Get the time in microseconds the last update spent sending the changed region to the display.
+  uint32_t get_flush_time_us() const { return this->flush_time_us_; }
+
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
 
+  /// Grow the dirty region by the absolute pixel (x, y), drivers call this when a pixel in the buffer changes.
+  void mark_dirty_(int x, int y) {
+    if (x < this->dirty_x1_)
+      this->dirty_x1_ = x;
+    if (x > this->dirty_x2_)
+      this->dirty_x2_ = x;
+    if (y < this->dirty_y1_)
+      this->dirty_y1_ = y;
+    if (y > this->dirty_y2_)
+      this->dirty_y2_ = y;
+  }
+  /// Mark the whole display as dirty, e.g. after filling the buffer.
+  void mark_dirty_all_();
+  /// Mark the whole display as clean, e.g. after the driver wrote the buffer content to the display by itself.
+  void reset_dirty_();
+
+  /** Send the dirty region to the display with flush_rect_() and reset it.
+   *
+   * Records the number of bytes sent and the time that took, see get_flush_bytes() and get_flush_time_us().
+   */
+  void flush_dirty_();
+
+  /** Send the part of the buffer from (x1, y1) to (x2, y2), inclusive and in absolute coordinates, to the display.
+   *
+   * Drivers that call mark_dirty_() override this to transmit only the window that changed.
+   *
+   * @return The number of bytes sent.
+   */
+  virtual size_t flush_rect_(int x1, int y1, int x2, int y2) { return 0; }
+
+  /** Check whether a row of the buffer changed since the last time this was called for it.
+   *
+   * With auto clear everything that's drawn marks the dirty region, even if it's drawn exactly like in the last
+   * frame. Drivers use this in flush_rect_() to skip the rows whose content is still what they sent before.
+   *
+   * Rows are compared by a 32 bit hash rather than a copy of what was sent, which would take as much memory as the
+   * buffer itself. A changed row whose hash happens to equal the old one (about one change in 4 billion) is skipped
+   * and stays outdated on the display until its content changes again or invalidate_rows_() is called.
+   */
+  bool row_changed_(int row, const uint8_t *data, size_t length);
+  /// Forget what was sent for every row, so that row_changed_() reports all of them as changed.
+  void invalidate_rows_() { this->row_hashes_.clear(); }
+
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill a rectangle in absolute coordinates.
+   *
+   * The default draws every pixel with draw_absolute_pixel_internal(), drivers override this to write whole spans
+   * of their buffer at once. The rectangle isn't clipped, see clip_absolute_rect_().
+   */
+  virtual void fill_absolute_rect_internal(int x, int y, int width, int height, Color color);
+
+  /** Draw `length` pixels of a row in absolute coordinates from left to right.
+   *
+   * The default draws every pixel with draw_absolute_pixel_internal(), drivers override this to copy the run into
+   * their buffer at once. The row isn't clipped, see clip_absolute_rect_().
+   */
+  virtual void draw_absolute_row_internal(int x, int y, const Color *colors, int length);
+
+  /// Fill a rectangle with rotation applied, like filled_rectangle() without feeding the watchdog.
+  void fill_rect_(int x1, int y1, int width, int height, Color color);
+
+  /// Clip a rectangle in absolute coordinates to the display, returns false if nothing of it is left.
+  bool clip_absolute_rect_(int *x, int *y, int *width, int *height);
+
+  /// Draw a row of pixels starting at [x,y] to the right with rotation applied. Reorders colors.
+  void draw_pixels_at_(int x, int y, Color *colors, int length);
+
+  /// Draw the set pixels of a glyph with its origin at [x,y] as horizontal spans.
+  void draw_glyph_(int x, int y, const Glyph &glyph, Color color);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
@@ -356,6 +433,15 @@ class DisplayBuffer {
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
+
+  int dirty_x1_{INT_MAX};
+  int dirty_y1_{INT_MAX};
+  int dirty_x2_{-1};
+  int dirty_y2_{-1};
+  /// Hash of the content of every row when it was last sent, 0 if unknown.
+  std::vector<uint32_t> row_hashes_;
+  uint32_t flush_bytes_{0};
+  uint32_t flush_time_us_{0};
 };
 
 class DisplayPage {
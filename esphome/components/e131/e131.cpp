@@ -4,6 +4,8 @@
 #include "e131_addressable_light_effect.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 #ifdef USE_ESP32
 #include <WiFi.h>
 #endif
@@ -40,19 +42,30 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
 
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    int len = udp_->read(this->buffer_, sizeof(this->buffer_));
+    if (len <= 0) {
+      continue;
+    }
+
+    if (packet_size > sizeof(this->buffer_)) {
+      // Too large for an E1.31 packet, drop the rest of it
+      while (udp_->read(this->buffer_, sizeof(this->buffer_)) > 0) {
+      }
+      ESP_LOGV(TAG, "Invalid packet received of size %d.", packet_size);
+      continue;
+    }
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (sync_packet_(this->buffer_, len, universe)) {
+      process_sync_(universe);
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
+    if (!packet_(this->buffer_, len, universe, packet)) {
+      ESP_LOGV(TAG, "Invalid packet received of size %d.", len);
       continue;
     }
 
@@ -63,45 +76,83 @@ void E131Component::loop() {
 }
 
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
-  if (light_effects_.count(light_effect)) {
-    return;
+  for (auto &consumer : consumers_) {
+    if (consumer.effect == light_effect)
+      return;
   }
 
   ESP_LOGD(TAG, "Registering '%s' for universes %d-%d.", light_effect->get_name().c_str(),
            light_effect->get_first_universe(), light_effect->get_last_universe());
 
-  light_effects_.insert(light_effect);
-
+  int32_t offset = 0;
   for (auto universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe(); ++universe) {
+    Consumer consumer{universe, offset, light_effect, -1};
+    offset += light_effect->get_lights_per_universe();
+    auto it = std::upper_bound(consumers_.begin(), consumers_.end(), universe,
+                               [](int universe, const Consumer &consumer) { return universe < consumer.universe; });
+    consumers_.insert(it, consumer);
     join_(universe);
   }
 }
 
 void E131Component::remove_effect(E131AddressableLightEffect *light_effect) {
-  if (!light_effects_.count(light_effect)) {
+  auto it = std::remove_if(consumers_.begin(), consumers_.end(),
+                           [light_effect](const Consumer &consumer) { return consumer.effect == light_effect; });
+  if (it == consumers_.end()) {
     return;
   }
+  consumers_.erase(it, consumers_.end());
 
   ESP_LOGD(TAG, "Unregistering '%s' for universes %d-%d.", light_effect->get_name().c_str(),
            light_effect->get_first_universe(), light_effect->get_last_universe());
 
-  light_effects_.erase(light_effect);
-
   for (auto universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe(); ++universe) {
     leave_(universe);
   }
+  join_sync_(light_effect, 0);
 }
 
 bool E131Component::process_(int universe, const E131Packet &packet) {
-  bool handled = false;
-
   ESP_LOGV(TAG, "Received E1.31 packet for %d universe, with %d bytes", universe, packet.count);
 
-  for (auto light_effect : light_effects_) {
-    handled = light_effect->process_(universe, packet) || handled;
+  auto it = std::lower_bound(consumers_.begin(), consumers_.end(), universe,
+                             [](const Consumer &consumer, int universe) { return consumer.universe < universe; });
+  if (it == consumers_.end() || it->universe != universe)
+    return false;
+
+  // Packets up to 20 sequence numbers behind the last one arrived out of order, the newer data wins
+  if (it->last_sequence >= 0) {
+    auto diff = static_cast<int8_t>(packet.sequence - it->last_sequence);
+    if (diff <= 0 && diff > -20)
+      return false;
+  }
+
+  for (; it != consumers_.end() && it->universe == universe; ++it) {
+    it->last_sequence = packet.sequence;
+    it->effect->process_(it->offset, packet);
+    join_sync_(it->effect, packet.sync_universe);
   }
 
-  return handled;
+  return true;
+}
+
+void E131Component::join_sync_(E131AddressableLightEffect *effect, uint16_t sync_universe) {
+  // Synchronization packets are sent to the multicast group of their own universe
+  if (effect->joined_sync_universe_ == sync_universe)
+    return;
+  if (effect->joined_sync_universe_ != 0)
+    leave_(effect->joined_sync_universe_);
+  effect->joined_sync_universe_ = sync_universe;
+  if (sync_universe != 0)
+    join_(sync_universe);
+}
+
+void E131Component::process_sync_(int universe) {
+  ESP_LOGV(TAG, "Received E1.31 synchronization packet for %d universe", universe);
+
+  for (auto &consumer : consumers_) {
+    consumer.effect->sync_(universe);
+  }
 }
 
 }  // namespace e131
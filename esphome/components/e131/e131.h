@@ -5,8 +5,8 @@
 #include "esphome/core/component.h"
 
 #include <memory>
-#include <set>
 #include <map>
+#include <vector>
 
 class UDP;
 
@@ -18,10 +18,16 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+// Size of a data packet with all property values
+const size_t E131_MAX_PACKET_SIZE = 638;
 
+/// A received data packet, the values point into the receive buffer of E131Component.
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  const uint8_t *values;
+  uint8_t sequence;
+  /// The universe of the synchronization packet that shows this data, 0 to show it right away.
+  uint16_t sync_universe;
 };
 
 class E131Component : public esphome::Component {
@@ -41,18 +47,35 @@ class E131Component : public esphome::Component {
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  /// The consumers of a universe, registered by the running effects.
+  struct Consumer {
+    int universe;
+    /// The first LED of the universe in the light of the effect.
+    int32_t offset;
+    E131AddressableLightEffect *effect;
+    /// Sequence number of the last packet, used to drop packets that arrive out of order.
+    int16_t last_sequence;
+  };
+
+  bool packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet);
+  bool sync_packet_(const uint8_t *data, size_t len, int &universe);
   bool process_(int universe, const E131Packet &packet);
+  void process_sync_(int universe);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
+  /// Listen to the synchronization universe named by the data for an effect, leaving the one it used before.
+  void join_sync_(E131AddressableLightEffect *effect, uint16_t sync_universe);
 
  protected:
   E131ListenMethod listen_method_{E131_MULTICAST};
   std::unique_ptr<UDP> udp_;
-  std::set<E131AddressableLightEffect *> light_effects_;
+  /// Packets are parsed in place in this buffer.
+  uint8_t buffer_[E131_MAX_PACKET_SIZE];
+  /// Sorted by universe, so that a packet finds its consumers with a binary search.
+  std::vector<Consumer> consumers_;
+  /// Number of consumers of each multicast group, data universes and the synchronization universes of effects.
   std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
 };
 
 }  // namespace e131
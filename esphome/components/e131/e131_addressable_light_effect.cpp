@@ -8,7 +8,9 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = E131_MAX_PROPERTY_VALUES_COUNT - 1;
+// Without synchronization packets for this long, data is shown right away again
+static const uint32_t SYNC_TIMEOUT = 2500;
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -29,6 +31,10 @@ int E131AddressableLightEffect::get_universe_count() const {
 void E131AddressableLightEffect::start() {
   AddressableLightEffect::start();
 
+  sync_universe_ = 0;
+  last_sync_ = 0;
+  sync_pending_ = false;
+
   if (this->e131_) {
     this->e131_->add_effect(this);
   }
@@ -43,49 +49,54 @@ void E131AddressableLightEffect::stop() {
 }
 
 void E131AddressableLightEffect::apply(light::AddressableLight &it, const Color &current_color) {
-  // ignore, it is run by `E131Component::update()`
+  // Data is applied by `E131Component::loop()`, only data that waits for a synchronization packet which doesn't come
+  // anymore is shown from here
+  if (sync_pending_ && millis() - last_sync_ >= SYNC_TIMEOUT) {
+    ESP_LOGV(TAG, "No synchronization packet for '%s', showing the data.", get_name().c_str());
+    sync_pending_ = false;
+    it.schedule_show();
+  }
 }
 
-bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet) {
-  auto it = get_addressable_();
+void E131AddressableLightEffect::sync_(int universe) {
+  if (sync_universe_ == 0 || universe != sync_universe_)
+    return;
 
-  // check if this is our universe and data are valid
-  if (universe < first_universe_ || universe > get_last_universe())
-    return false;
+  last_sync_ = millis();
+  if (sync_pending_) {
+    sync_pending_ = false;
+    get_addressable_()->schedule_show();
+  }
+}
+
+bool E131AddressableLightEffect::process_(int32_t offset, const E131Packet &packet) {
+  auto it = get_addressable_();
 
-  int output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end =
-      std::min(it->size(), std::min(output_offset + get_lights_per_universe(), output_offset + packet.count - 1));
-  auto input_data = packet.values + 1;
+  int count = std::min(get_lights_per_universe(), (packet.count - 1) / channels_);
 
-  ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
-           output_end);
+  ESP_LOGV(TAG, "Applying data for '%s', for %d-%d.", get_name().c_str(), offset, offset + count);
 
   switch (channels_) {
     case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
+      it->set_range_raw(offset, packet.values + 1, count, light::RawPixelFormat::MONO);
       break;
-
     case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
+      it->set_range_raw(offset, packet.values + 1, count, light::RawPixelFormat::RGB_WHITE_AVG);
       break;
-
     case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
+      it->set_range_raw(offset, packet.values + 1, count, light::RawPixelFormat::RGBW);
       break;
   }
 
+  // Data for a synchronization universe is shown together with the other universes of the frame once the
+  // synchronization packet arrives, unless the sender stopped sending those
+  sync_universe_ = packet.sync_universe;
+  if (sync_universe_ != 0 && last_sync_ != 0 && millis() - last_sync_ < SYNC_TIMEOUT) {
+    sync_pending_ = true;
+    return true;
+  }
+
   it->schedule_show();
   return true;
 }
@@ -35,13 +35,22 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
   void set_e131(E131Component *e131) { this->e131_ = e131; }
 
  protected:
-  bool process_(int universe, const E131Packet &packet);
+  bool process_(int32_t offset, const E131Packet &packet);
+  void sync_(int universe);
 
  protected:
   int first_universe_{0};
   int last_universe_{0};
   E131LightChannels channels_{E131_RGB};
   E131Component *e131_{nullptr};
+  /// The synchronization universe of the last received data, 0 if none.
+  uint16_t sync_universe_{0};
+  /// The synchronization universe whose multicast group E131Component joined for this effect, 0 if none.
+  uint16_t joined_sync_universe_{0};
+  /// When the last synchronization packet for sync_universe_ arrived, 0 if none did.
+  uint32_t last_sync_{0};
+  /// Whether received data waits for a synchronization packet to be shown.
+  bool sync_pending_{false};
 
   friend class E131Component;
 };
@@ -18,7 +18,9 @@ static const char *const TAG = "e131";
 
 static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 static const uint32_t VECTOR_ROOT = 4;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
 static const uint32_t VECTOR_FRAME = 2;
+static const uint32_t VECTOR_FRAME_SYNCHRONIZATION = 1;
 static const uint8_t VECTOR_DMP = 2;
 
 // E1.31 Packet Structure
@@ -37,7 +39,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -52,13 +54,35 @@ union E131RawPacket {
     uint8_t property_values[E131_MAX_PROPERTY_VALUES_COUNT];
   } __attribute__((packed));
 
-  uint8_t raw[638];
+  uint8_t raw[E131_MAX_PACKET_SIZE];
 };
 
+// E1.31 Synchronization Packet Structure
+struct E131RawSyncPacket {
+  // Root Layer
+  uint16_t preamble_size;
+  uint16_t postamble_size;
+  uint8_t acn_id[12];
+  uint16_t root_flength;
+  uint32_t root_vector;
+  uint8_t cid[16];
+
+  // Frame Layer
+  uint16_t frame_flength;
+  uint32_t frame_vector;
+  uint8_t sequence_number;
+  uint16_t sync_address;
+  uint16_t reserved;
+} __attribute__((packed));
+
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const size_t E131_MIN_PACKET_SIZE = reinterpret_cast<size_t>(&((E131RawPacket *) nullptr)->property_values[1]);
 
+static ip4_addr_t multicast_address(int universe) {
+  return {static_cast<uint32_t>(network::IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
+}
+
 bool E131Component::join_igmp_groups_() {
   if (listen_method_ != E131_MULTICAST)
     return false;
@@ -69,8 +93,7 @@ bool E131Component::join_igmp_groups_() {
     if (!universe.second)
       continue;
 
-    ip4_addr_t multicast_addr = {static_cast<uint32_t>(
-        network::IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff)))};
+    ip4_addr_t multicast_addr = multicast_address(universe.first);
 
     auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
@@ -90,9 +113,17 @@ void E131Component::join_(int universe) {
     return;  // we already joined before
   }
 
-  if (join_igmp_groups_()) {
-    ESP_LOGD(TAG, "Joined %d universe for E1.31.", universe);
+  // Before setup() the groups are joined all at once there. lwIP counts the joins of a group, so the groups that
+  // were joined before must not be joined again.
+  if (listen_method_ != E131_MULTICAST || !udp_)
+    return;
+
+  ip4_addr_t multicast_addr = multicast_address(universe);
+  if (igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr)) {
+    ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe);
+    return;
   }
+  ESP_LOGD(TAG, "Joined %d universe for E1.31.", universe);
 }
 
 void E131Component::leave_(int universe) {
@@ -102,9 +133,8 @@ void E131Component::leave_(int universe) {
     return;  // we have other consumers of the given universe
   }
 
-  if (listen_method_ == E131_MULTICAST) {
-    ip4_addr_t multicast_addr = {
-        static_cast<uint32_t>(network::IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
+  if (listen_method_ == E131_MULTICAST && udp_) {
+    ip4_addr_t multicast_addr = multicast_address(universe);
 
     igmp_leavegroup(IP4_ADDR_ANY4, &multicast_addr);
   }
@@ -112,11 +142,11 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet) {
+  if (len < E131_MIN_PACKET_SIZE)
     return false;
 
-  auto sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
@@ -131,10 +161,32 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
 
   universe = htons(sbuff->universe);
   packet.count = htons(sbuff->property_value_count);
-  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
+  if (packet.count < 1 || packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
+    return false;
+  // The values are used in place, so they have to be in the packet
+  if (len < E131_MIN_PACKET_SIZE - 1 + packet.count)
+    return false;
+
+  packet.values = sbuff->property_values;
+  packet.sequence = sbuff->sequence_number;
+  packet.sync_universe = htons(sbuff->sync_address);
+  return true;
+}
+
+bool E131Component::sync_packet_(const uint8_t *data, size_t len, int &universe) {
+  if (len < sizeof(E131RawSyncPacket))
+    return false;
+
+  auto sbuff = reinterpret_cast<const E131RawSyncPacket *>(data);
+
+  if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
+    return false;
+  if (htonl(sbuff->root_vector) != VECTOR_ROOT_EXTENDED)
+    return false;
+  if (htonl(sbuff->frame_vector) != VECTOR_FRAME_SYNCHRONIZATION)
     return false;
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
+  universe = htons(sbuff->sync_address);
   return true;
 }
 
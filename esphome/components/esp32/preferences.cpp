@@ -115,9 +115,17 @@ class ESP32Preferences : public ESPPreferences {
     // goal try write all pending saves even if one fails
     bool any_failed = false;
 
+    // Unlike the ESP8266 preferences, this needs no journal of its own: NVS already appends every write as a new
+    // entry to its log-structured pages and only erases a page once all of it is stale. Writing a blob does cost a
+    // new entry even if the value didn't change though, so unchanged values are skipped.
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
       const auto &save = s_pending_save[i];
+      if (!is_changed_(nvs_handle, save)) {
+        ESP_LOGVV(TAG, "NVS data not changed, skipping '%s'", save.key.c_str());
+        s_pending_save.erase(s_pending_save.begin() + i);
+        continue;
+      }
       esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
       if (err != 0) {
         ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
@@ -137,6 +145,19 @@ class ESP32Preferences : public ESPPreferences {
 
     return !any_failed;
   }
+
+ protected:
+  static bool is_changed_(uint32_t nvs_handle, const NVSData &to_save) {
+    size_t actual_len;
+    esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
+    if (err != 0 || actual_len != to_save.data.size())
+      return true;
+    std::vector<uint8_t> stored_data(actual_len);
+    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data(), &actual_len);
+    if (err != 0)
+      return true;
+    return stored_data != to_save.data;
+  }
 };
 
 void setup_preferences() {
@@ -23,6 +23,9 @@ CONF_ESP32_BLE_ID = "esp32_ble_id"
 CONF_SCAN_PARAMETERS = "scan_parameters"
 CONF_WINDOW = "window"
 CONF_ACTIVE = "active"
+CONF_SCAN_RESULT_QUEUE_SIZE = "scan_result_queue_size"
+CONF_MAX_TRACKED_DEVICES = "max_tracked_devices"
+CONF_MIN_ADVERTISEMENT_INTERVAL = "min_advertisement_interval"
 esp32_ble_tracker_ns = cg.esphome_ns.namespace("esp32_ble_tracker")
 ESP32BLETracker = esp32_ble_tracker_ns.class_("ESP32BLETracker", cg.Component)
 ESPBTClient = esp32_ble_tracker_ns.class_("ESPBTClient")
@@ -142,6 +145,15 @@ CONFIG_SCHEMA = cv.Schema(
             ),
             validate_scan_parameters,
         ),
+        cv.Optional(CONF_SCAN_RESULT_QUEUE_SIZE, default=32): cv.int_range(
+            min=4, max=1024
+        ),
+        cv.Optional(CONF_MAX_TRACKED_DEVICES, default=128): cv.int_range(
+            min=16, max=2048
+        ),
+        cv.Optional(
+            CONF_MIN_ADVERTISEMENT_INTERVAL, default="0ms"
+        ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ESPBTAdvertiseTrigger),
@@ -186,6 +198,11 @@ async def to_code(config):
     cg.add(var.set_scan_interval(int(params[CONF_INTERVAL].total_milliseconds / 0.625)))
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
+    cg.add(var.set_scan_result_queue_size(config[CONF_SCAN_RESULT_QUEUE_SIZE]))
+    cg.add(var.set_max_tracked_devices(config[CONF_MAX_TRACKED_DEVICES]))
+    cg.add(
+        var.set_min_advertisement_interval(config[CONF_MIN_ADVERTISEMENT_INTERVAL])
+    )
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
@@ -223,6 +240,9 @@ async def to_code(config):
 async def register_ble_device(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
     cg.add(paren.register_listener(var))
+    if CONF_MAC_ADDRESS in config:
+        # Lets the tracker skip this listener for advertisements of other devices
+        cg.add(var.set_match_address(config[CONF_MAC_ADDRESS].as_hex))
     return var
 
 
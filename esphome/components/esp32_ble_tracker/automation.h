@@ -10,7 +10,10 @@ namespace esp32_ble_tracker {
 class ESPBTAdvertiseTrigger : public Trigger<const ESPBTDevice &>, public ESPBTDeviceListener {
  public:
   explicit ESPBTAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
-  void set_address(uint64_t address) { this->address_ = address; }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->set_match_address(address);
+  }
 
   bool parse_device(const ESPBTDevice &device) override {
     if (this->address_ && device.address_uint64() != this->address_) {
@@ -27,8 +30,14 @@ class ESPBTAdvertiseTrigger : public Trigger<const ESPBTDevice &>, public ESPBTD
 class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, public ESPBTDeviceListener {
  public:
   explicit BLEServiceDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
-  void set_address(uint64_t address) { this->address_ = address; }
-  void set_service_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->set_match_address(address);
+  }
+  void set_service_uuid16(uint16_t uuid) {
+    this->uuid_ = ESPBTUUID::from_uint16(uuid);
+    this->set_match_uuid16(uuid);
+  }
   void set_service_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_service_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
@@ -53,8 +62,14 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
 class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>, public ESPBTDeviceListener {
  public:
   explicit BLEManufacturerDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
-  void set_address(uint64_t address) { this->address_ = address; }
-  void set_manufacturer_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->set_match_address(address);
+  }
+  void set_manufacturer_uuid16(uint16_t uuid) {
+    this->uuid_ = ESPBTUUID::from_uint16(uuid);
+    this->set_match_uuid16(uuid);
+  }
   void set_manufacturer_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_manufacturer_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
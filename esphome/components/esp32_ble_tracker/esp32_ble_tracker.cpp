@@ -44,8 +44,10 @@ float ESP32BLETracker::get_setup_priority() const { return setup_priority::BLUET
 
 void ESP32BLETracker::setup() {
   global_esp32_ble_tracker = this;
-  this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
+  this->scan_results_.init(this->scan_result_queue_size_);
+  // Active scans rate limit the scan responses of each device separately
+  this->devices_.init(this->max_tracked_devices_ * (this->scan_active_ ? 2 : 1));
 
   if (!ESP32BLETracker::ble_setup()) {
     this->mark_failed();
@@ -56,6 +58,11 @@ void ESP32BLETracker::setup() {
 }
 
 void ESP32BLETracker::loop() {
+  if (this->listener_index_dirty_) {
+    this->listener_index_.build(this->listeners_);
+    this->listener_index_dirty_ = false;
+  }
+
   BLEEvent *ble_event = this->ble_events_.pop();
   while (ble_event != nullptr) {
     if (ble_event->type_)
@@ -77,43 +84,7 @@ void ESP32BLETracker::loop() {
     global_esp32_ble_tracker->start_scan_(false);
   }
 
-  if (xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-    uint32_t index = this->scan_result_index_;
-    xSemaphoreGive(this->scan_result_lock_);
-
-    if (index >= 16) {
-      ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-    }
-    for (size_t i = 0; i < index; i++) {
-      ESPBTDevice device;
-      device.parse_scan_rst(this->scan_result_buffer_[i]);
-
-      bool found = false;
-      for (auto *listener : this->listeners_)
-        if (listener->parse_device(device))
-          found = true;
-
-      for (auto *client : this->clients_)
-        if (client->parse_device(device)) {
-          found = true;
-          if (client->state() == ClientState::DISCOVERED) {
-            esp_ble_gap_stop_scanning();
-            if (xSemaphoreTake(this->scan_end_lock_, 10L / portTICK_PERIOD_MS)) {
-              xSemaphoreGive(this->scan_end_lock_);
-            }
-          }
-        }
-
-      if (!found) {
-        this->print_bt_device_info(device);
-      }
-    }
-
-    if (xSemaphoreTake(this->scan_result_lock_, 10L / portTICK_PERIOD_MS)) {
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
-    }
-  }
+  this->process_scan_results_();
 
   if (this->scan_set_param_failed_) {
     ESP_LOGE(TAG, "Scan set param failed: %d", this->scan_set_param_failed_);
@@ -211,12 +182,18 @@ void ESP32BLETracker::start_scan_(bool first) {
     return;
   }
 
+  if (this->scan_results_dropped_ != 0) {
+    ESP_LOGW(TAG, "%u advertisements were dropped because the scan result queue was full, consider increasing "
+                  "scan_result_queue_size",
+             this->scan_results_dropped_);
+    this->scan_results_dropped_ = 0;
+  }
   ESP_LOGD(TAG, "Starting scan...");
   if (!first) {
     for (auto *listener : this->listeners_)
       listener->on_scan_end();
   }
-  this->already_discovered_.clear();
+  this->devices_.clear();
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
   this->scan_params_.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
@@ -237,7 +214,68 @@ void ESP32BLETracker::register_client(ESPBTClient *client) {
   this->clients_.push_back(client);
 }
 
+void ESP32BLETracker::process_scan_results_() {
+  // Bounded by the queue size, so that a busy Bluetooth task can't keep the loop here forever
+  for (size_t i = 0; i < this->scan_results_.get_capacity(); i++) {
+    auto *result = this->scan_results_.front();
+    if (result == nullptr)
+      break;
+    this->process_scan_result_(*result);
+    this->scan_results_.pop();
+  }
+  this->scan_results_dropped_ += this->scan_results_.take_dropped();
+}
+
+void ESP32BLETracker::process_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+  const uint64_t address = ble_addr_to_uint64(param.bda);
+  if (this->min_advertisement_interval_ != 0 &&
+      !this->devices_.should_forward(address, param.ble_evt_type == ESP_BLE_EVT_SCAN_RSP, param.ble_adv,
+                                     param.adv_data_len + param.scan_rsp_len, millis(),
+                                     this->min_advertisement_interval_))
+    return;
+
+  const auto &matched = this->listener_index_.match(address, param.ble_adv, param.adv_data_len + param.scan_rsp_len);
+
+  // Only parse the advertisement once somebody is interested in it
+  bool parsed = false;
+  auto device = [this, &param, &parsed]() -> const ESPBTDevice & {
+    if (!parsed) {
+      this->device_.parse_scan_rst(param);
+      parsed = true;
+    }
+    return this->device_;
+  };
+
+  bool found = false;
+  for (auto *listener : matched)
+    if (listener->parse_device(device()))
+      found = true;
+
+  for (auto *client : this->clients_) {
+    if (client->get_match_address() != 0 && client->get_match_address() != address)
+      continue;
+    if (client->parse_device(device())) {
+      found = true;
+      if (client->state() == ClientState::DISCOVERED) {
+        esp_ble_gap_stop_scanning();
+        if (xSemaphoreTake(this->scan_end_lock_, 10L / portTICK_PERIOD_MS)) {
+          xSemaphoreGive(this->scan_end_lock_);
+        }
+      }
+    }
+  }
+
+  if (!found && !this->devices_.is_discovered(address)) {
+    this->print_bt_device_info(device());
+  }
+}
+
 void ESP32BLETracker::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (event == ESP_GAP_BLE_SCAN_RESULT_EVT && param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
+    // Advertisements are the bulk of the events, copy them into the queue without allocating or locking
+    global_esp32_ble_tracker->scan_results_.push(param->scan_rst);
+    return;
+  }
   BLEEvent *gap_event = new BLEEvent(event, param);  // NOLINT(cppcoreguidelines-owning-memory)
   global_esp32_ble_tracker->ble_events_.push(gap_event);
 }  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -274,14 +312,11 @@ void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_
 }
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < 16) {
-        this->scan_result_buffer_[this->scan_result_index_++] = param;
-      }
-      xSemaphoreGive(this->scan_result_lock_);
-    }
-  } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+  // Advertisements (ESP_GAP_SEARCH_INQ_RES_EVT) go through scan_results_ instead
+  if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+    // The Bluetooth task queued all advertisements of the scan before this event, they still belong to it and have to
+    // be processed before the next scan clears the devices and ends the listeners' scan
+    this->process_scan_results_();
     xSemaphoreGive(this->scan_end_lock_);
   }
 }
@@ -483,6 +518,14 @@ optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData
 }
 
 void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+  // The tracker reuses the device for every advertisement
+  this->name_.clear();
+  this->tx_powers_.clear();
+  this->appearance_.reset();
+  this->ad_flag_.reset();
+  this->service_uuids_.clear();
+  this->manufacturer_datas_.clear();
+  this->service_datas_.clear();
   this->scan_result_ = param;
   for (uint8_t i = 0; i < ESP_BD_ADDR_LEN; i++)
     this->address_[i] = param.bda[i];
@@ -708,14 +751,15 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Interval: %.1f ms", this->scan_interval_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
+  ESP_LOGCONFIG(TAG, "  Scan Result Queue Size: %zu", this->scan_results_.get_capacity());
+  ESP_LOGCONFIG(TAG, "  Max Tracked Devices: %zu", this->max_tracked_devices_);
+  if (this->min_advertisement_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Min Advertisement Interval: %u ms", this->min_advertisement_interval_);
+  }
 }
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
-  }
-  this->already_discovered_.push_back(address);
+  if (!this->devices_.mark_discovered(device.address_uint64()))
+    return;
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
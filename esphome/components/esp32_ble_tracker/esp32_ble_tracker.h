@@ -2,12 +2,16 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "listener_index.h"
 #include "queue.h"
+#include "scan_device_table.h"
 
 #ifdef USE_ESP32
 
 #include <string>
 #include <array>
+#include <utility>
+#include <vector>
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
 #include <esp_bt_defs.h>
@@ -134,8 +138,21 @@ class ESPBTDeviceListener {
   virtual bool parse_device(const ESPBTDevice &device) = 0;
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
+  /** Only offer advertisements from this address to parse_device().
+   *
+   * The match filters let the tracker skip listeners (and parsing the advertisement altogether) without calling
+   * parse_device(), which still has to check the device itself. Without a filter every advertisement is offered.
+   */
+  void set_match_address(uint64_t address) { this->match_address_ = address; }
+  uint64_t get_match_address() const { return this->match_address_; }
+  /// Only offer advertisements that contain this UUID as service UUID, service data UUID or manufacturer ID.
+  void set_match_uuid16(uint16_t uuid) { this->match_uuid16_ = uuid; }
+  const optional<uint16_t> &get_match_uuid16() const { return this->match_uuid16_; }
+
  protected:
   ESP32BLETracker *parent_{nullptr};
+  uint64_t match_address_{0};
+  optional<uint16_t> match_uuid16_{};
 };
 
 enum class ClientState {
@@ -170,6 +187,14 @@ class ESP32BLETracker : public Component {
   void set_scan_interval(uint32_t scan_interval) { scan_interval_ = scan_interval; }
   void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
+  void set_scan_result_queue_size(size_t scan_result_queue_size) {
+    scan_result_queue_size_ = scan_result_queue_size;
+  }
+  void set_max_tracked_devices(size_t max_tracked_devices) { max_tracked_devices_ = max_tracked_devices; }
+  /// Forward at most one advertisement per device and interval, unless its payload changed. 0 disables the limit.
+  void set_min_advertisement_interval(uint32_t min_advertisement_interval) {
+    min_advertisement_interval_ = min_advertisement_interval;
+  }
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -181,12 +206,16 @@ class ESP32BLETracker : public Component {
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
+    this->listener_index_dirty_ = true;
   }
 
   void register_client(ESPBTClient *client);
 
   void print_bt_device_info(const ESPBTDevice &device);
 
+  /// Number of advertisements dropped because the scan result queue was full.
+  uint32_t get_scan_results_dropped() const { return this->scan_results_dropped_; }
+
  protected:
   /// The FreeRTOS task managing the bluetooth interface.
   static bool ble_setup();
@@ -197,6 +226,10 @@ class ESP32BLETracker : public Component {
   void real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
   /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
   void gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// Process the advertisements in scan_results_.
+  void process_scan_results_();
+  /// Offer a queued advertisement to the listeners and clients that match it.
+  void process_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT` event is received.
   void gap_scan_set_param_complete_(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_START_COMPLETE_EVT` event is received.
@@ -209,9 +242,16 @@ class ESP32BLETracker : public Component {
   static void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
   void real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// The devices seen in the current scan, for print_bt_device_info and the advertisement rate limit
+  ScanDeviceTable devices_;
+  size_t max_tracked_devices_{128};
+  uint32_t min_advertisement_interval_{0};
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// The listeners sorted by their match filters, rebuilt in loop() after listeners were registered.
+  ListenerIndex<ESPBTDeviceListener> listener_index_;
+  bool listener_index_dirty_{false};
+  /// The advertisement being processed, reused so that its vectors keep their capacity.
+  ESPBTDevice device_;
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -221,10 +261,11 @@ class ESP32BLETracker : public Component {
   uint32_t scan_interval_;
   uint32_t scan_window_;
   bool scan_active_;
-  SemaphoreHandle_t scan_result_lock_;
   SemaphoreHandle_t scan_end_lock_;
-  size_t scan_result_index_{0};
-  esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_buffer_[16];
+  /// Advertisements copied in by the Bluetooth task, processed in loop().
+  LockFreeQueue<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> scan_results_;
+  size_t scan_result_queue_size_{32};
+  uint32_t scan_results_dropped_{0};
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 
@@ -0,0 +1,82 @@
+#include "listener_index.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/optional.h"
+
+#include <cstring>
+
+#include <esp_gap_ble_api.h>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+// Bluetooth Base UUID, the 16 bit UUID goes into bytes 12 and 13 (all little endian like on air)
+static const uint8_t BASE_UUID128[12] = {0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00};
+
+static optional<uint16_t> uuid128_as_uuid16(const uint8_t *uuid) {
+  if (memcmp(uuid, BASE_UUID128, sizeof(BASE_UUID128)) != 0 || uuid[14] != 0 || uuid[15] != 0)
+    return {};
+  return encode_uint16(uuid[13], uuid[12]);
+}
+
+size_t collect_uuid16s(const uint8_t *payload, size_t len, uint16_t *uuids, size_t max_uuids) {
+  size_t count = 0;
+  auto add = [&](uint16_t uuid) {
+    if (count < max_uuids)
+      uuids[count++] = uuid;
+  };
+
+  size_t offset = 0;
+  while (offset + 2 < len) {
+    const uint8_t field_length = payload[offset];
+    if (field_length == 0 || offset + 1 + field_length > len)
+      break;
+    const uint8_t record_type = payload[offset + 1];
+    const uint8_t *record = &payload[offset + 2];
+    const uint8_t record_length = field_length - 1;
+    offset += 1 + field_length;
+
+    switch (record_type) {
+      case ESP_BLE_AD_TYPE_16SRV_CMPL:
+      case ESP_BLE_AD_TYPE_16SRV_PART:
+        for (uint8_t i = 0; i + 2 <= record_length; i += 2)
+          add(encode_uint16(record[i + 1], record[i]));
+        break;
+      case ESP_BLE_AD_TYPE_32SRV_CMPL:
+      case ESP_BLE_AD_TYPE_32SRV_PART:
+        for (uint8_t i = 0; i + 4 <= record_length; i += 4) {
+          if (record[i + 2] == 0 && record[i + 3] == 0)
+            add(encode_uint16(record[i + 1], record[i]));
+        }
+        break;
+      case ESP_BLE_AD_TYPE_128SRV_CMPL:
+      case ESP_BLE_AD_TYPE_128SRV_PART:
+      case ESP_BLE_AD_TYPE_128SERVICE_DATA:
+        if (record_length >= 16) {
+          auto uuid = uuid128_as_uuid16(record);
+          if (uuid.has_value())
+            add(*uuid);
+        }
+        break;
+      case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE:
+        if (record_length >= 2)
+          add(encode_uint16(record[1], record[0]));
+        break;
+      case ESP_BLE_AD_TYPE_32SERVICE_DATA:
+        if (record_length >= 4 && record[2] == 0 && record[3] == 0)
+          add(encode_uint16(record[1], record[0]));
+        break;
+      default:
+        break;
+    }
+  }
+  return count;
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif  // USE_ESP32
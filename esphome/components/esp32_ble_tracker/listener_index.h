@@ -0,0 +1,94 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP32
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/// Collect the 16 bit service UUIDs, service data UUIDs and manufacturer IDs of an advertisement without parsing it.
+size_t collect_uuid16s(const uint8_t *payload, size_t len, uint16_t *uuids, size_t max_uuids);
+
+/** The device listeners sorted by their match filters, to find the ones an advertisement is for without offering it
+ * to all of them.
+ *
+ * Listener is ESPBTDeviceListener, anything with get_match_address() and get_match_uuid16() works.
+ */
+template<class Listener> class ListenerIndex {
+ public:
+  void build(const std::vector<Listener *> &listeners) {
+    this->by_address_.clear();
+    this->by_uuid16_.clear();
+    this->unfiltered_.clear();
+    for (auto *listener : listeners) {
+      if (listener->get_match_address() != 0) {
+        this->by_address_.emplace_back(listener->get_match_address(), listener);
+      } else if (listener->get_match_uuid16().has_value()) {
+        this->by_uuid16_.emplace_back(*listener->get_match_uuid16(), listener);
+      } else {
+        this->unfiltered_.push_back(listener);
+      }
+    }
+    // Stable, so that listeners with the same filter are still called in the order they were registered
+    std::stable_sort(this->by_address_.begin(), this->by_address_.end(),
+                     [](const std::pair<uint64_t, Listener *> &a, const std::pair<uint64_t, Listener *> &b) {
+                       return a.first < b.first;
+                     });
+    std::stable_sort(this->by_uuid16_.begin(), this->by_uuid16_.end(),
+                     [](const std::pair<uint16_t, Listener *> &a, const std::pair<uint16_t, Listener *> &b) {
+                       return a.first < b.first;
+                     });
+    this->matched_.reserve(listeners.size());
+  }
+
+  /** The listeners for an advertisement: those for its address, then those for one of its UUIDs and then the ones
+   * without a filter. Valid until the next call.
+   */
+  const std::vector<Listener *> &match(uint64_t address, const uint8_t *payload, size_t len) {
+    auto &matched = this->matched_;
+    matched.clear();
+    auto by_address = std::lower_bound(
+        this->by_address_.begin(), this->by_address_.end(), address,
+        [](const std::pair<uint64_t, Listener *> &entry, uint64_t value) { return entry.first < value; });
+    for (; by_address != this->by_address_.end() && by_address->first == address; by_address++)
+      matched.push_back(by_address->second);
+    if (!this->by_uuid16_.empty()) {
+      uint16_t uuids[16];
+      size_t uuid_count = collect_uuid16s(payload, len, uuids, 16);
+      for (size_t i = 0; i < uuid_count; i++) {
+        auto by_uuid = std::lower_bound(
+            this->by_uuid16_.begin(), this->by_uuid16_.end(), uuids[i],
+            [](const std::pair<uint16_t, Listener *> &entry, uint16_t value) { return entry.first < value; });
+        for (; by_uuid != this->by_uuid16_.end() && by_uuid->first == uuids[i]; by_uuid++) {
+          // The same UUID can be in the service UUIDs and the service data
+          if (std::find(matched.begin(), matched.end(), by_uuid->second) == matched.end())
+            matched.push_back(by_uuid->second);
+        }
+      }
+    }
+    matched.insert(matched.end(), this->unfiltered_.begin(), this->unfiltered_.end());
+    return matched;
+  }
+
+ protected:
+  /// Listeners with an address filter, sorted by address.
+  std::vector<std::pair<uint64_t, Listener *>> by_address_;
+  /// Listeners with only a UUID filter, sorted by UUID.
+  std::vector<std::pair<uint16_t, Listener *>> by_uuid16_;
+  /// Listeners without a filter.
+  std::vector<Listener *> unfiltered_;
+  /// The result of match(), reused to not allocate per advertisement.
+  std::vector<Listener *> matched_;
+};
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif  // USE_ESP32
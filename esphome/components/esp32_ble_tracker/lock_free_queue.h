@@ -0,0 +1,70 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP32
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/** Lock-free queue of elements copied in by one producer task and taken out by one consumer.
+ *
+ * The storage is allocated once in init(), so pushing neither blocks nor allocates. When the queue is full the
+ * element is dropped and counted instead.
+ */
+template<class T> class LockFreeQueue {
+ public:
+  void init(size_t capacity) {
+    // One slot always stays empty to tell a full queue from an empty one
+    this->capacity_ = capacity + 1;
+    this->data_ = new T[this->capacity_];  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+  size_t get_capacity() const { return this->capacity_ - 1; }
+
+  /// Copy an element into the queue, only called by the producer.
+  bool push(const T &element) {
+    size_t head = this->head_.load(std::memory_order_relaxed);
+    size_t next = this->next_(head);
+    if (next == this->tail_.load(std::memory_order_acquire)) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    this->data_[head] = element;
+    this->head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /// The oldest element or nullptr if the queue is empty, only called by the consumer.
+  T *front() {
+    size_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return nullptr;
+    return &this->data_[tail];
+  }
+  /// Remove the element returned by front(), only called by the consumer.
+  void pop() {
+    size_t tail = this->tail_.load(std::memory_order_relaxed);
+    this->tail_.store(this->next_(tail), std::memory_order_release);
+  }
+
+  /// Number of elements dropped since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+
+ protected:
+  size_t next_(size_t index) const { return index + 1 == this->capacity_ ? 0 : index + 1; }
+
+  T *data_{nullptr};
+  size_t capacity_{0};
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif  // USE_ESP32
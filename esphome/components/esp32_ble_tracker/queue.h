@@ -3,6 +3,7 @@
 #ifdef USE_ESP32
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "lock_free_queue.h"
 
 #include <queue>
 #include <mutex>
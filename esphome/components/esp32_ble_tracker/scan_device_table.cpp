@@ -0,0 +1,96 @@
+#include "scan_device_table.h"
+
+#ifdef USE_ESP32
+
+#include <cstring>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+// Scan responses have other content than the advertisements of the same device, rate limit them separately
+static const uint64_t SCAN_RESPONSE_KEY = 1ULL << 48;
+
+static uint32_t payload_hash(const uint8_t *data, size_t len) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+// Marks used slots, so that the table can store address 0
+static const uint64_t KEY_USED = 1ULL << 63;
+// Set on the address entry of devices that were printed
+static const uint64_t KEY_DISCOVERED = 1ULL << 62;
+
+void ScanDeviceTable::init(size_t max_devices) {
+  // Keep the load factor below 3/4, so that probe sequences stay short
+  size_t capacity = 1;
+  while (capacity * 3 < max_devices * 4)
+    capacity *= 2;
+  this->entries_ = new Entry[capacity];  // NOLINT(cppcoreguidelines-owning-memory)
+  this->mask_ = capacity - 1;
+  this->max_size_ = max_devices;
+  this->clear();
+}
+void ScanDeviceTable::clear() {
+  memset(this->entries_, 0, (this->mask_ + 1) * sizeof(Entry));
+  this->size_ = 0;
+}
+ScanDeviceTable::Entry *ScanDeviceTable::find_(uint64_t key, bool insert, bool *inserted) {
+  // Fibonacci hashing spreads the vendor prefixes that many devices share
+  size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & this->mask_;
+  key |= KEY_USED;
+  while (true) {
+    Entry &entry = this->entries_[index];
+    if (entry.key == 0) {
+      if (!insert || this->size_ >= this->max_size_)
+        return nullptr;
+      entry.key = key;
+      this->size_++;
+      *inserted = true;
+      return &entry;
+    }
+    if ((entry.key & ~KEY_DISCOVERED) == key) {
+      *inserted = false;
+      return &entry;
+    }
+    index = (index + 1) & this->mask_;
+  }
+}
+bool ScanDeviceTable::is_discovered(uint64_t address) {
+  bool inserted;
+  Entry *entry = this->find_(address, false, &inserted);
+  if (entry == nullptr)
+    return this->size_ >= this->max_size_;
+  return (entry->key & KEY_DISCOVERED) != 0;
+}
+bool ScanDeviceTable::mark_discovered(uint64_t address) {
+  bool inserted;
+  Entry *entry = this->find_(address, true, &inserted);
+  if (entry == nullptr || (entry->key & KEY_DISCOVERED) != 0)
+    return false;
+  entry->key |= KEY_DISCOVERED;
+  return true;
+}
+bool ScanDeviceTable::should_forward(uint64_t address, bool scan_response, const uint8_t *payload, size_t len,
+                                     uint32_t now, uint32_t interval) {
+  const uint64_t key = scan_response ? address | SCAN_RESPONSE_KEY : address;
+  const uint32_t hash = payload_hash(payload, len);
+  bool inserted;
+  Entry *entry = this->find_(key, true, &inserted);
+  if (entry == nullptr)
+    return true;
+  if (!inserted && entry->payload_hash == hash && now - entry->last_forward < interval)
+    return false;
+  entry->last_forward = now;
+  entry->payload_hash = hash;
+  return true;
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP32
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/** Fixed capacity open addressing hash table of the devices seen during the current scan.
+ *
+ * Used to print every unknown device only once per scan and to rate limit advertisements, without searching all
+ * devices for every advertisement. Devices beyond the capacity aren't tracked: they are never printed and never rate
+ * limited.
+ */
+class ScanDeviceTable {
+ public:
+  void init(size_t max_devices);
+  /// Forget all devices, for the start of a new scan.
+  void clear();
+  /// Number of tracked entries, an active scan has one for the advertisements and one for the scan responses.
+  size_t size() const { return this->size_; }
+
+  /// Whether the device was already printed in this scan, also true for untracked devices.
+  bool is_discovered(uint64_t address);
+  /// Remember that the device was printed, returns false if it already was or can't be tracked.
+  bool mark_discovered(uint64_t address);
+  /** Whether an advertisement should be forwarded.
+   *
+   * Returns false if the last forwarded advertisement or scan response of the device is less than interval ms old and
+   * had the same payload.
+   */
+  bool should_forward(uint64_t address, bool scan_response, const uint8_t *payload, size_t len, uint32_t now,
+                      uint32_t interval);
+
+ protected:
+  struct Entry {
+    /// KEY_USED | the key, 0 for free slots.
+    uint64_t key;
+    uint32_t last_forward;
+    uint32_t payload_hash;
+  };
+  /// The entry for the key, inserting it if needed. nullptr if it's not in the table and the table is full.
+  Entry *find_(uint64_t key, bool insert, bool *inserted);
+
+  Entry *entries_{nullptr};
+  size_t mask_{0};
+  size_t size_{0};
+  size_t max_size_{0};
+};
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -32,6 +32,25 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+// The preferences sector starts with a snapshot of all ESP8266_FLASH_STORAGE_SIZE words (the same layout that older
+// versions wrote) and uses the rest of the sector as a journal of single word updates. A sync only appends the words
+// that changed to the journal, the sector is only erased and rewritten with a fresh snapshot once the journal is full.
+//
+// Each journal record is two words: the header (index | ~index << 16) and the new value. The value is programmed
+// before the header, so a record interrupted by a power loss is skipped when the journal is replayed.
+static const uint32_t ESP8266_JOURNAL_START = ESP8266_FLASH_STORAGE_SIZE * 4;
+static const uint32_t ESP8266_JOURNAL_SLOTS = (SPI_FLASH_SEC_SIZE - ESP8266_JOURNAL_START) / 8;
+static const uint32_t ESP8266_JOURNAL_READ_SLOTS = 8;
+static const uint32_t ESP8266_FLASH_ERASED = 0xFFFFFFFF;
+
+static uint32_t s_journal_pos = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Bitmap of the words in s_flash_storage that changed since the last sync
+static uint32_t s_flash_dirty_words[(ESP8266_FLASH_STORAGE_SIZE + 31) / 32] = {};  // NOLINT
+// Statistics since boot, used to report the write amplification of the journal
+static uint32_t s_flash_bytes_changed = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_flash_bytes_written = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_flash_erases = 0;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -64,6 +83,10 @@ static uint32_t get_esp8266_flash_sector() {
   return (data.uint - 0x40200000) / SPI_FLASH_SEC_SIZE;
 }
 static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
+static uint32_t get_esp8266_journal_address(uint32_t slot) {
+  return get_esp8266_flash_address() + ESP8266_JOURNAL_START + slot * 8;
+}
+static inline uint32_t journal_record_header(uint32_t index) { return (index & 0xFFFF) | (~index << 16); }
 
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
@@ -80,8 +103,10 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
       s_flash_dirty = true;
+      s_flash_dirty_words[j / 32] |= 1UL << (j % 32);
+    }
     *ptr = v;
   }
   return true;
@@ -171,6 +196,7 @@ class ESP8266Preferences : public ESPPreferences {
       InterruptLock lock;
       spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
     }
+    this->replay_journal_();
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -231,7 +257,87 @@ class ESP8266Preferences : public ESPPreferences {
     if (s_prevent_write)
       return false;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
+    uint32_t changed = 0;
+    for (uint32_t bits : s_flash_dirty_words) {
+      for (; bits != 0; bits &= bits - 1)
+        changed++;
+    }
+
+    bool ok;
+    if (s_journal_pos + changed <= ESP8266_JOURNAL_SLOTS) {
+      ESP_LOGD(TAG, "Saving preferences to flash (%u words to journal)...", changed);
+      ok = this->append_journal_();
+    } else {
+      ESP_LOGD(TAG, "Saving preferences to flash (compacting journal)...");
+      ok = this->write_snapshot_();
+    }
+    if (!ok)
+      return false;
+
+    s_flash_bytes_changed += changed * 4;
+    ESP_LOGV(TAG, "Flash writes since boot: %u bytes for %u changed bytes, %u sector erases", s_flash_bytes_written,
+             s_flash_bytes_changed, s_flash_erases);
+    memset(s_flash_dirty_words, 0, sizeof(s_flash_dirty_words));
+    s_flash_dirty = false;
+    return true;
+  }
+
+ protected:
+  void replay_journal_() {
+    uint32_t records[ESP8266_JOURNAL_READ_SLOTS * 2];
+    uint32_t applied = 0;
+    s_journal_pos = ESP8266_JOURNAL_SLOTS;
+    for (uint32_t slot = 0; slot < ESP8266_JOURNAL_SLOTS; slot += ESP8266_JOURNAL_READ_SLOTS) {
+      {
+        InterruptLock lock;
+        spi_flash_read(get_esp8266_journal_address(slot), records, sizeof(records));
+      }
+      for (uint32_t i = 0; i < ESP8266_JOURNAL_READ_SLOTS && slot + i < ESP8266_JOURNAL_SLOTS; i++) {
+        uint32_t header = records[i * 2];
+        uint32_t value = records[i * 2 + 1];
+        if (header == ESP8266_FLASH_ERASED && value == ESP8266_FLASH_ERASED) {
+          s_journal_pos = slot + i;
+          ESP_LOGVV(TAG, "Applied %u journal records", applied);
+          return;
+        }
+        uint32_t index = header & 0xFFFF;
+        // Skip interrupted records and data left in the sector by other firmware
+        if (header != journal_record_header(index) || index >= ESP8266_FLASH_STORAGE_SIZE)
+          continue;
+        s_flash_storage[index] = value;
+        applied++;
+      }
+    }
+  }
+
+  bool append_journal_() {
+    SpiFlashOpResult res = SPI_FLASH_RESULT_OK;
+    {
+      InterruptLock lock;
+      for (uint32_t index = 0; index < ESP8266_FLASH_STORAGE_SIZE; index++) {
+        if ((s_flash_dirty_words[index / 32] & (1UL << (index % 32))) == 0)
+          continue;
+        uint32_t address = get_esp8266_journal_address(s_journal_pos);
+        uint32_t value = s_flash_storage[index];
+        uint32_t header = journal_record_header(index);
+        // Even a failed write may have programmed part of the slot, so never reuse it
+        s_journal_pos++;
+        res = spi_flash_write(address + 4, &value, 4);
+        if (res == SPI_FLASH_RESULT_OK)
+          res = spi_flash_write(address, &header, 4);
+        if (res != SPI_FLASH_RESULT_OK)
+          break;
+        s_flash_bytes_written += 8;
+      }
+    }
+    if (res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGV(TAG, "Write ESP8266 flash failed!");
+      return false;
+    }
+    return true;
+  }
+
+  bool write_snapshot_() {
     SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
     {
       InterruptLock lock;
@@ -244,12 +350,15 @@ class ESP8266Preferences : public ESPPreferences {
       ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
       return false;
     }
+    s_flash_erases++;
     if (write_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGV(TAG, "Write ESP8266 flash failed!");
+      // The snapshot is gone, make sure the next sync writes a complete one again
+      s_journal_pos = ESP8266_JOURNAL_SLOTS;
       return false;
     }
-
-    s_flash_dirty = false;
+    s_journal_pos = 0;
+    s_flash_bytes_written += ESP8266_FLASH_STORAGE_SIZE * 4;
     return true;
   }
 };
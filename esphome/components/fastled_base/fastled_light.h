@@ -228,6 +228,12 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  light::AddressableLightBuffer get_buffer_internal() const override {
+    light::AddressableLightBuffer buffer;
+    // CRGB is packed as r, g, b
+    buffer.data = reinterpret_cast<uint8_t *>(this->leds_);
+    return buffer;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -0,0 +1,32 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import light
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["light"]
+
+CONF_FRAME_CLOCK_ID = "frame_clock_id"
+CONF_FPS = "fps"
+CONF_LIGHTS = "lights"
+
+frame_clock_ns = cg.esphome_ns.namespace("frame_clock")
+FrameClock = frame_clock_ns.class_("FrameClock", cg.PollingComponent)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(FrameClock),
+        cv.Optional(CONF_FPS, default=60): cv.float_range(min=1, max=1000),
+        cv.Required(CONF_LIGHTS): cv.All(
+            cv.ensure_list(cv.use_id(light.AddressableLightState)), cv.Length(min=1)
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_fps(config[CONF_FPS]))
+    for conf in config[CONF_LIGHTS]:
+        light_ = await cg.get_variable(conf)
+        cg.add(var.add_light(light_))
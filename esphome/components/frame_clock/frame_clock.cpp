@@ -0,0 +1,126 @@
+#include "frame_clock.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace frame_clock {
+
+static const char *const TAG = "frame_clock";
+
+void FrameClock::add_light(light::AddressableLightState *light) {
+  light->set_frame_clocked(true);
+  this->lights_.push_back(light);
+}
+
+void FrameClock::dump_config() {
+  ESP_LOGCONFIG(TAG, "Frame Clock:");
+  ESP_LOGCONFIG(TAG, "  FPS: %.1f", 1e6f / this->interval_us_);
+  ESP_LOGCONFIG(TAG, "  Lights: %zu", this->lights_.size());
+  LOG_UPDATE_INTERVAL(this);
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Render Time", this->render_time_sensor_);
+  LOG_SENSOR("  ", "Transfer Time", this->transfer_time_sensor_);
+  LOG_SENSOR("  ", "Missed Frames", this->missed_frames_sensor_);
+#endif
+}
+
+bool FrameClock::is_show_done_() {
+  for (auto *light : this->lights_) {
+    if (!static_cast<light::AddressableLight *>(light->get_output())->is_show_done())
+      return false;
+  }
+  return true;
+}
+
+void FrameClock::loop() {
+  const uint32_t now = micros();
+
+  if (this->transfer_active_ && this->is_show_done_()) {
+    this->transfer_active_ = false;
+    this->transfer_time_us_ = now - this->show_start_us_;
+    this->max_transfer_time_us_ = std::max(this->max_transfer_time_us_, this->transfer_time_us_);
+  }
+
+  bool active = false;
+  for (auto *light : this->lights_)
+    active |= light->needs_render();
+  if (!active) {
+    // Nothing to do until a light changes, don't count the frames in between as missed
+    this->high_freq_.stop();
+    this->idle_ = true;
+    return;
+  }
+  this->high_freq_.start();
+  if (this->idle_) {
+    this->idle_ = false;
+    this->next_frame_us_ = now;
+  }
+
+  if (static_cast<int32_t>(now - this->next_frame_us_) < 0)
+    return;
+
+  // Frames that should have been rendered in the meantime are skipped, keeping the clock in phase
+  const uint32_t late = now - this->next_frame_us_;
+  if (late >= this->interval_us_) {
+    const uint32_t skipped = late / this->interval_us_;
+    this->missed_frames_ += skipped;
+    this->next_frame_us_ += skipped * this->interval_us_;
+  }
+  this->next_frame_us_ += this->interval_us_;
+
+  this->render_frame_(now);
+}
+
+void FrameClock::render_frame_(uint32_t now) {
+  if (this->transfer_active_) {
+    // The outputs are still busy with the last frame, showing this one has to wait for them
+    this->missed_frames_++;
+  }
+
+  for (auto *light : this->lights_)
+    light->render();
+  const uint32_t rendered = micros();
+
+  bool shown = false;
+  for (auto *light : this->lights_) {
+    if (light->show())
+      shown = true;
+  }
+  const uint32_t done = micros();
+
+  this->render_time_us_ = rendered - now;
+  this->max_render_time_us_ = std::max(this->max_render_time_us_, this->render_time_us_);
+  if (done - now > this->interval_us_)
+    this->missed_frames_++;
+
+  if (shown) {
+    this->show_start_us_ = rendered;
+    this->transfer_active_ = true;
+    // Outputs that send while showing are done already
+    if (this->is_show_done_()) {
+      this->transfer_active_ = false;
+      this->transfer_time_us_ = done - rendered;
+      this->max_transfer_time_us_ = std::max(this->max_transfer_time_us_, this->transfer_time_us_);
+    }
+  }
+
+  ESP_LOGVV(TAG, "Frame rendered in %uus, shown in %uus", this->render_time_us_, done - rendered);
+}
+
+void FrameClock::update() {
+#ifdef USE_SENSOR
+  if (this->render_time_sensor_ != nullptr)
+    this->render_time_sensor_->publish_state(this->max_render_time_us_ / 1000.0f);
+  if (this->transfer_time_sensor_ != nullptr)
+    this->transfer_time_sensor_->publish_state(this->max_transfer_time_us_ / 1000.0f);
+  if (this->missed_frames_sensor_ != nullptr)
+    this->missed_frames_sensor_->publish_state(this->missed_frames_);
+#endif
+  this->max_render_time_us_ = 0;
+  this->max_transfer_time_us_ = 0;
+}
+
+}  // namespace frame_clock
+}  // namespace esphome
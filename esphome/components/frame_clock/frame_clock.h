@@ -0,0 +1,77 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/light/addressable_light.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include <vector>
+
+namespace esphome {
+namespace frame_clock {
+
+/** Updates a group of addressable lights together at a fixed frame rate.
+ *
+ * Every frame, the effects and transitions of all lights are rendered first, then all lights that changed are
+ * shown back to back. Outputs that send in the background (like the RMT, I2S and DMA methods of NeoPixelBus) transfer
+ * their frames in parallel, so the strips update at the same time instead of whenever their own light state loops.
+ *
+ * Frames that are rendered late, that take longer than the frame interval, or that start while the outputs are
+ * still sending the previous one count as missed.
+ */
+class FrameClock : public PollingComponent {
+ public:
+  void add_light(light::AddressableLightState *light);
+  void set_fps(float fps) { this->interval_us_ = static_cast<uint32_t>(1e6f / fps); }
+#ifdef USE_SENSOR
+  void set_render_time_sensor(sensor::Sensor *render_time_sensor) { this->render_time_sensor_ = render_time_sensor; }
+  void set_transfer_time_sensor(sensor::Sensor *transfer_time_sensor) {
+    this->transfer_time_sensor_ = transfer_time_sensor;
+  }
+  void set_missed_frames_sensor(sensor::Sensor *missed_frames_sensor) {
+    this->missed_frames_sensor_ = missed_frames_sensor;
+  }
+#endif
+
+  void dump_config() override;
+  void loop() override;
+  void update() override;
+  float get_setup_priority() const override { return setup_priority::HARDWARE - 2.0f; }
+
+  /// Time it took to render the last frame, in microseconds.
+  uint32_t get_render_time_us() const { return this->render_time_us_; }
+  /// Time from showing the last frame until all outputs finished sending it, in microseconds.
+  uint32_t get_transfer_time_us() const { return this->transfer_time_us_; }
+  uint32_t get_missed_frames() const { return this->missed_frames_; }
+
+ protected:
+  void render_frame_(uint32_t now);
+  bool is_show_done_();
+
+  std::vector<light::AddressableLightState *> lights_;
+  uint32_t interval_us_{16666};
+  uint32_t next_frame_us_{0};
+  uint32_t show_start_us_{0};
+  /// Whether the outputs are still sending the last frame.
+  bool transfer_active_{false};
+  bool idle_{true};
+  uint32_t render_time_us_{0};
+  uint32_t transfer_time_us_{0};
+  /// The slowest frames since the last update(), reported by the sensors.
+  uint32_t max_render_time_us_{0};
+  uint32_t max_transfer_time_us_{0};
+  uint32_t missed_frames_{0};
+  HighFrequencyLoopRequester high_freq_;
+#ifdef USE_SENSOR
+  sensor::Sensor *render_time_sensor_{nullptr};
+  sensor::Sensor *transfer_time_sensor_{nullptr};
+  sensor::Sensor *missed_frames_sensor_{nullptr};
+#endif
+};
+
+}  // namespace frame_clock
+}  // namespace esphome
@@ -0,0 +1,60 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+from . import CONF_FRAME_CLOCK_ID, FrameClock
+
+DEPENDENCIES = ["frame_clock"]
+
+CONF_RENDER_TIME = "render_time"
+CONF_TRANSFER_TIME = "transfer_time"
+CONF_MISSED_FRAMES = "missed_frames"
+
+UNIT_MILLISECOND = "ms"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_FRAME_CLOCK_ID): cv.use_id(FrameClock),
+        cv.Optional(CONF_RENDER_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_TRANSFER_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_MISSED_FRAMES): sensor.sensor_schema(
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    frame_clock = await cg.get_variable(config[CONF_FRAME_CLOCK_ID])
+
+    if CONF_RENDER_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_RENDER_TIME])
+        cg.add(frame_clock.set_render_time_sensor(sens))
+
+    if CONF_TRANSFER_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_TRANSFER_TIME])
+        cg.add(frame_clock.set_transfer_time_sensor(sens))
+
+    if CONF_MISSED_FRAMES in config:
+        sens = await sensor.new_sensor(config[CONF_MISSED_FRAMES])
+        cg.add(frame_clock.set_missed_frames_sensor(sens))
@@ -1,4 +1,5 @@
 #include "gpio_binary_sensor.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -9,8 +10,21 @@ static const char *const TAG = "gpio.binary_sensor";
 void GPIOBinarySensor::setup() {
   this->pin_->setup();
   this->publish_initial_state(this->pin_->digital_read());
+#ifdef USE_TICKLESS_IDLE
+  // The pin is only read in loop(), so every edge has to wake the loop from its tickless sleep
+  if (this->pin_->is_internal()) {
+    static_cast<InternalGPIOPin *>(this->pin_)->attach_interrupt(&GPIOBinarySensor::gpio_intr, this,
+                                                                 gpio::INTERRUPT_ANY_EDGE);
+  } else {
+    ESP_LOGW(TAG, "'%s' - Pin can't wake the loop, it is only read every max_sleep_time", this->get_name().c_str());
+  }
+#endif
 }
 
+#ifdef USE_TICKLESS_IDLE
+void IRAM_ATTR GPIOBinarySensor::gpio_intr(GPIOBinarySensor *arg) { App.wake_loop_isr(); }
+#endif
+
 void GPIOBinarySensor::dump_config() {
   LOG_BINARY_SENSOR("", "GPIO Binary Sensor", this);
   LOG_PIN("  Pin: ", this->pin_);
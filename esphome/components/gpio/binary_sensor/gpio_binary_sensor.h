@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/hal.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 
@@ -21,6 +22,10 @@ class GPIOBinarySensor : public binary_sensor::BinarySensor, public Component {
   void loop() override;
 
  protected:
+#ifdef USE_TICKLESS_IDLE
+  static void gpio_intr(GPIOBinarySensor *arg);
+#endif
+
   GPIOPin *pin_;
 };
 
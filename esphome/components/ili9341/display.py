@@ -14,6 +14,7 @@ from esphome.const import (
 DEPENDENCIES = ["spi"]
 
 CONF_LED_PIN = "led_pin"
+CONF_DOUBLE_BUFFER = "double_buffer"
 
 ili9341_ns = cg.esphome_ns.namespace("ili9341")
 ili9341 = ili9341_ns.class_(
@@ -39,6 +40,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_LED_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_DOUBLE_BUFFER, default=False): cv.boolean,
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -59,6 +61,7 @@ async def to_code(config):
     await display.register_display(var, config)
     await spi.register_spi_device(var, config)
     cg.add(var.set_model(config[CONF_MODEL]))
+    cg.add(var.set_double_buffer(config[CONF_DOUBLE_BUFFER]))
     dc = await cg.gpio_pin_expression(config[CONF_DC_PIN])
     cg.add(var.set_dc_pin(dc))
 
@@ -11,6 +11,14 @@ static const char *const TAG = "ili9341";
 
 void ILI9341Display::setup_pins_() {
   this->init_internal_(this->get_buffer_length_());
+  if (this->double_buffer_ && this->buffer_ != nullptr) {
+    this->front_buffer_ = new (std::nothrow) uint8_t[this->get_buffer_length_()];  // NOLINT
+    if (this->front_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Could not allocate the second buffer, drawing and sending frames one after the other");
+    } else {
+      memcpy(this->front_buffer_, this->buffer_, this->get_buffer_length_());
+    }
+  }
   this->dc_pin_->setup();  // OUTPUT
   this->dc_pin_->digital_write(false);
   if (this->reset_pin_ != nullptr) {
@@ -33,6 +41,7 @@ void ILI9341Display::dump_config() {
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Busy Pin: ", this->busy_pin_);
   LOG_PIN("  Backlight Pin: ", this->led_pin_);
+  ESP_LOGCONFIG(TAG, "  Double Buffer: %s", YESNO(this->front_buffer_ != nullptr));
   LOG_UPDATE_INTERVAL(this);
 }
 
@@ -81,35 +90,105 @@ uint8_t ILI9341Display::read_command(uint8_t command_byte, uint8_t index) {
 
 void ILI9341Display::update() {
   this->do_update_();
-  this->display_();
+  if (this->transfer_active_) {
+    // The last frame is still being sent from the front buffer, swap when it's done
+    this->frame_pending_ = true;
+    return;
+  }
+  this->flush_dirty_();
 }
 
-void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;
-  uint16_t h = this->y_high_ - this->y_low_ + 1;
+size_t ILI9341Display::flush_rect_(int x1, int y1, int x2, int y2) {
+  const uint16_t w = x2 - x1 + 1;
+  if (this->front_buffer_ != nullptr) {
+    // Send the frame that was just drawn and keep drawing on a copy of it. The frames only differ in the dirty window.
+    std::swap(this->buffer_, this->front_buffer_);
+    for (int y = y1; y <= y2; y++) {
+      uint32_t pos = y * this->width_ + x1;
+      memcpy(this->buffer_ + pos, this->front_buffer_ + pos, w);
+    }
+  }
+  const uint8_t *src = this->front_buffer_ != nullptr ? this->front_buffer_ : this->buffer_;
+
+  // we will only update the changed rows of the dirty window, in bands of consecutive rows
+  size_t bytes = 0;
+  int band_start = -1;
+  this->bands_.clear();
+  for (int y = y1; y <= y2 + 1; y++) {
+    bool changed = y <= y2 && this->row_changed_(y, src + y * this->width_, this->width_);
+    if (changed && band_start < 0)
+      band_start = y;
+    if (changed || band_start < 0)
+      continue;
+
+    const uint16_t h = y - band_start;
+    bytes += 2 * uint32_t(w) * h;
+    if (this->front_buffer_ != nullptr) {
+      this->bands_.emplace_back(band_start, y - 1);
+      band_start = -1;
+      continue;
+    }
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
-  this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-  for (uint16_t row = 0; row < h; row++) {
-    uint32_t pos = start_pos + (row * width_);
-    uint32_t rem = w;
-
-    while (rem > 0) {
-      uint32_t sz = buffer_to_transfer_(pos, rem);
-      this->write_array(transfer_buffer_, 2 * sz);
-      pos += sz;
-      rem -= sz;
+    this->set_addr_window_(x1, band_start, w, h);
+    this->start_data_();
+    for (int row = band_start; row < y; row++) {
+      uint32_t pos = row * this->width_ + x1;
+      uint32_t rem = w;
+      while (rem > 0) {
+        uint32_t sz = buffer_to_transfer_(src, pos, rem);
+        this->write_array(transfer_buffer_, 2 * sz);
+        pos += sz;
+        rem -= sz;
+      }
     }
+    this->end_data_();
+    band_start = -1;
   }
-  this->end_data_();
 
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  if (this->front_buffer_ != nullptr) {
+    this->band_x1_ = x1;
+    this->band_x2_ = x2;
+    this->band_index_ = 0;
+    this->write_next_band_();
+  }
+  return bytes;
+}
+
+void ILI9341Display::write_next_band_() {
+  if (this->band_index_ >= this->bands_.size()) {
+    this->transfer_active_ = false;
+    if (this->frame_pending_) {
+      this->frame_pending_ = false;
+      this->flush_dirty_();
+    }
+    return;
+  }
+
+  const auto &band = this->bands_[this->band_index_++];
+  this->set_addr_window_(this->band_x1_, band.first, this->band_x2_ - this->band_x1_ + 1, band.second - band.first + 1);
+  this->dc_pin_->digital_write(true);
+  this->transfer_active_ = true;
+  this->band_row_ = band.first;
+  this->band_column_ = this->band_x1_;
+  // The SPI bus sends the band from its loop, the next band is started when it's done
+  this->write_async([this](const uint8_t **data) { return this->next_band_chunk_(data); },
+                    [this]() { this->write_next_band_(); });
+}
+
+size_t ILI9341Display::next_band_chunk_(const uint8_t **data) {
+  const auto &band = this->bands_[this->band_index_ - 1];
+  if (this->band_row_ > band.second)
+    return 0;
+
+  uint32_t sz = this->buffer_to_transfer_(this->front_buffer_, this->band_row_ * this->width_ + this->band_column_,
+                                          this->band_x2_ - this->band_column_ + 1);
+  this->band_column_ += sz;
+  if (this->band_column_ > this->band_x2_) {
+    this->band_column_ = this->band_x1_;
+    this->band_row_++;
+  }
+  *data = this->transfer_buffer_;
+  return 2 * sz;
 }
 
 uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
@@ -135,10 +214,7 @@ uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
 void ILI9341Display::fill(Color color) {
   auto color565 = display::ColorUtil::color_to_565(color);
   memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->mark_dirty_all_();
 }
 
 void ILI9341Display::fill_internal_(Color color) {
@@ -168,21 +244,69 @@ void ILI9341Display::fill_internal_(Color color) {
   this->end_data_();
 
   memset(buffer_, 0, (this->get_width_internal()) * (this->get_height_internal()));
+  if (this->front_buffer_ != nullptr)
+    memset(this->front_buffer_, 0, (this->get_width_internal()) * (this->get_height_internal()));
+  // the display was written directly, don't assume anything about what it showed before
+  this->reset_dirty_();
+  this->invalidate_rows_();
 }
 
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
   uint32_t pos = (y * width_) + x;
   auto color565 = display::ColorUtil::color_to_565(color);
-  buffer_[pos] = convert_to_8bit_color_(color565);
+  uint8_t color332 = convert_to_8bit_color_(color565);
+  // only changed pixels grow the window that's sent to the display
+  if (buffer_[pos] == color332)
+    return;
+  buffer_[pos] = color332;
+  this->mark_dirty_(x, y);
+}
+
+void HOT ILI9341Display::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+  const uint8_t color332 = convert_to_8bit_color_(display::ColorUtil::color_to_565(color));
+  for (int row = y; row < y + height; row++) {
+    uint8_t *dst = this->buffer_ + row * this->width_ + x;
+    // only the changed part of the span grows the dirty window
+    int first = 0;
+    while (first < width && dst[first] == color332)
+      first++;
+    if (first == width)
+      continue;
+    int last = width - 1;
+    while (dst[last] == color332)
+      last--;
+    memset(dst + first, color332, last - first + 1);
+    this->mark_dirty_(x + first, row);
+    this->mark_dirty_(x + last, row);
+  }
+}
+
+void HOT ILI9341Display::draw_absolute_row_internal(int x, int y, const Color *colors, int length) {
+  const int start = x;
+  int height = 1;
+  if (!this->clip_absolute_rect_(&x, &y, &length, &height))
+    return;
+  colors += x - start;
+  uint8_t *dst = this->buffer_ + y * this->width_ + x;
+  int first = -1, last = -1;
+  for (int i = 0; i < length; i++) {
+    const uint8_t color332 = convert_to_8bit_color_(display::ColorUtil::color_to_565(colors[i]));
+    if (dst[i] == color332)
+      continue;
+    dst[i] = color332;
+    if (first < 0)
+      first = i;
+    last = i;
+  }
+  if (first < 0)
+    return;
+  this->mark_dirty_(x + first, y);
+  this->mark_dirty_(x + last, y);
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
@@ -238,8 +362,8 @@ void ILI9341Display::invert_display_(bool invert) { this->command(invert ? ILI93
 int ILI9341Display::get_width_internal() { return this->width_; }
 int ILI9341Display::get_height_internal() { return this->height_; }
 
-uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
-  uint8_t *src = buffer_ + pos;
+uint32_t ILI9341Display::buffer_to_transfer_(const uint8_t *buffer, uint32_t pos, uint32_t sz) {
+  const uint8_t *src = buffer + pos;
   uint8_t *dst = transfer_buffer_;
 
   if (sz > sizeof(transfer_buffer_) / 2) {
@@ -24,6 +24,8 @@ class ILI9341Display : public PollingComponent,
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_led_pin(GPIOPin *led) { this->led_pin_ = led; }
   void set_model(ILI9341Model model) { this->model_ = model; }
+  /// Draw the next frame into a second buffer while the last one is sent in the background.
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
 
   void command(uint8_t value);
   void data(uint8_t value);
@@ -43,6 +45,8 @@ class ILI9341Display : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_row_internal(int x, int y, const Color *colors, int length) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -50,17 +54,17 @@ class ILI9341Display : public PollingComponent,
   void invert_display_(bool invert);
   void reset_();
   void fill_internal_(Color color);
-  void display_();
+  size_t flush_rect_(int x1, int y1, int x2, int y2) override;
+  /// Start sending the next band of the frame in the front buffer asynchronously.
+  void write_next_band_();
+  /// Source of the asynchronous write of the current band.
+  size_t next_band_chunk_(const uint8_t **data);
   uint16_t convert_to_16bit_color_(uint8_t color_8bit);
   uint8_t convert_to_8bit_color_(uint16_t color_16bit);
 
   ILI9341Model model_;
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
 
   uint32_t get_buffer_length_();
   int get_width_internal() override;
@@ -73,7 +77,21 @@ class ILI9341Display : public PollingComponent,
 
   uint8_t transfer_buffer_[64];
 
-  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
+  uint32_t buffer_to_transfer_(const uint8_t *buffer, uint32_t pos, uint32_t sz);
+
+  bool double_buffer_{false};
+  /// The buffer that's sent to the display in double buffer mode, while the writer draws into buffer_.
+  uint8_t *front_buffer_{nullptr};
+  bool transfer_active_{false};
+  /// A frame was drawn while the last one was still being sent.
+  bool frame_pending_{false};
+  /// The first and last row of every band of changed rows in the frame that's being sent.
+  std::vector<std::pair<uint16_t, uint16_t>> bands_;
+  size_t band_index_{0};
+  uint16_t band_x1_{0};
+  uint16_t band_x2_{0};
+  uint16_t band_row_{0};
+  uint16_t band_column_{0};
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *led_pin_{nullptr};
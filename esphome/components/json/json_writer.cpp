@@ -0,0 +1,199 @@
+#include "json_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+// Most state documents fit, so the output string doesn't have to grow while it's written
+static const size_t JSON_STRING_RESERVE = 128;
+
+JsonWriter::JsonWriter(char *buffer, size_t size) : buffer_(buffer), size_(size) {
+  if (size != 0)
+    buffer[0] = '\0';
+}
+
+void JsonWriter::begin_object() { this->begin_object(nullptr); }
+void JsonWriter::begin_object(const char *key) {
+  this->begin_value_(key);
+  this->write_('{');
+  this->depth_++;
+  this->empty_ |= 1UL << this->depth_;
+}
+void JsonWriter::end_object() {
+  this->empty_ &= ~(1UL << this->depth_);
+  this->depth_--;
+  this->write_('}');
+}
+void JsonWriter::begin_array(const char *key) {
+  this->begin_value_(key);
+  this->write_('[');
+  this->depth_++;
+  this->empty_ |= 1UL << this->depth_;
+}
+void JsonWriter::end_array() {
+  this->empty_ &= ~(1UL << this->depth_);
+  this->depth_--;
+  this->write_(']');
+}
+
+void JsonWriter::add(const char *key, const char *value) { this->add(key, value, strlen(value)); }
+void JsonWriter::add(const char *key, const char *value, size_t len) {
+  this->begin_value_(key);
+  this->write_string_(value, len);
+}
+void JsonWriter::add(const char *key, bool value) {
+  this->begin_value_(key);
+  if (value) {
+    this->write_("true", 4);
+  } else {
+    this->write_("false", 5);
+  }
+}
+void JsonWriter::add(const char *key, float value) {
+  this->begin_value_(key);
+  // Same as ArduinoJson, which wrote these states before
+  if (std::isnan(value)) {
+    this->write_("NaN", 3);
+    return;
+  }
+  if (std::isinf(value)) {
+    if (value < 0) {
+      this->write_("-Infinity", 9);
+    } else {
+      this->write_("Infinity", 8);
+    }
+    return;
+  }
+  char buf[20];
+  int len = snprintf(buf, sizeof(buf), "%.7g", value);
+  this->write_(buf, len);
+}
+void JsonWriter::add_signed_(const char *key, int64_t value) {
+  this->begin_value_(key);
+  char buf[24];
+  char *pos = buf + sizeof(buf);
+  uint64_t magnitude = value < 0 ? -static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  do {
+    *--pos = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0)
+    *--pos = '-';
+  this->write_(pos, buf + sizeof(buf) - pos);
+}
+void JsonWriter::add_unsigned_(const char *key, uint64_t value) {
+  this->begin_value_(key);
+  char buf[24];
+  char *pos = buf + sizeof(buf);
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->write_(pos, buf + sizeof(buf) - pos);
+}
+
+void JsonWriter::begin_value_(const char *key) {
+  uint32_t bit = 1UL << this->depth_;
+  if (this->depth_ != 0) {
+    if (this->empty_ & bit) {
+      this->empty_ &= ~bit;
+    } else {
+      this->write_(',');
+    }
+  }
+  if (key != nullptr) {
+    this->write_string_(key, strlen(key));
+    this->write_(':');
+  }
+}
+void JsonWriter::write_(const char *data, size_t len) {
+  if (this->string_ != nullptr) {
+    this->string_->append(data, len);
+  } else if (this->length_ + 1 < this->size_) {
+    size_t n = std::min(len, this->size_ - 1 - this->length_);
+    memcpy(this->buffer_ + this->length_, data, n);
+    this->buffer_[this->length_ + n] = '\0';
+  }
+  this->length_ += len;
+}
+void JsonWriter::write_(char c) { this->write_(&c, 1); }
+void JsonWriter::write_string_(const char *str, size_t len) {
+  this->write_('"');
+  size_t start = 0;
+  for (size_t i = 0; i < len; i++) {
+    auto c = static_cast<uint8_t>(str[i]);
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    // Copy the run of characters that don't need escaping at once
+    this->write_(str + start, i - start);
+    start = i + 1;
+    char escape[7] = {'\\', 0};
+    size_t escape_len = 2;
+    switch (c) {
+      case '"':
+      case '\\':
+        escape[1] = static_cast<char>(c);
+        break;
+      case '\b':
+        escape[1] = 'b';
+        break;
+      case '\f':
+        escape[1] = 'f';
+        break;
+      case '\n':
+        escape[1] = 'n';
+        break;
+      case '\r':
+        escape[1] = 'r';
+        break;
+      case '\t':
+        escape[1] = 't';
+        break;
+      default:
+        snprintf(escape + 1, sizeof(escape) - 1, "u%04x", c);
+        escape_len = 6;
+        break;
+    }
+    this->write_(escape, escape_len);
+  }
+  this->write_(str + start, len - start);
+  this->write_('"');
+}
+
+std::string write_json(const json_write_t &f) {
+  std::string output;
+  output.reserve(JSON_STRING_RESERVE);
+  JsonWriter writer(output);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  return output;
+}
+
+static std::string global_json_write_buffer;  // NOLINT
+
+const char *write_json(const json_write_t &f, size_t *length) {
+  // Keeps its capacity, so after the first few messages no allocations are needed at all
+  global_json_write_buffer.clear();
+  JsonWriter writer(global_json_write_buffer);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  *length = global_json_write_buffer.size();
+  return global_json_write_buffer.c_str();
+}
+
+size_t write_json(char *buffer, size_t size, const json_write_t &f) {
+  JsonWriter writer(buffer, size);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  return writer.length();
+}
+
+}  // namespace json
+}  // namespace esphome
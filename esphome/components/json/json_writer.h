@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome {
+namespace json {
+
+/** Streaming JSON writer that emits the document straight into its output, without building a DOM first.
+ *
+ * Values are written in the order they're added, so nested objects and arrays have to be completed before the next
+ * key of their parent is added. The output is either appended to a std::string, or written to a fixed buffer like
+ * snprintf() does: the text is truncated to the buffer and always null terminated, and length() still returns the
+ * length of the complete document.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string &output) : string_(&output) {}
+  JsonWriter(char *buffer, size_t size);
+
+  void begin_object();
+  void begin_object(const char *key);
+  void end_object();
+  void begin_array(const char *key);
+  void end_array();
+
+  void add(const char *key, const char *value);
+  void add(const char *key, const std::string &value) { this->add(key, value.data(), value.size()); }
+  void add(const char *key, const char *value, size_t len);
+  void add(const char *key, bool value);
+  void add(const char *key, int value) { this->add_signed_(key, value); }
+  void add(const char *key, long value) { this->add_signed_(key, value); }              // NOLINT(google-runtime-int)
+  void add(const char *key, unsigned int value) { this->add_unsigned_(key, value); }
+  void add(const char *key, unsigned long value) { this->add_unsigned_(key, value); }  // NOLINT(google-runtime-int)
+  void add(const char *key, float value);
+  void add(const char *key, double value) { this->add(key, static_cast<float>(value)); }
+
+  /// Add values to the array that was opened last.
+  void add_value(const char *value) { this->add(nullptr, value); }
+  void add_value(const std::string &value) { this->add(nullptr, value); }
+
+  /// Length of the complete document, including anything that didn't fit into a fixed buffer.
+  size_t length() const { return this->length_; }
+
+ protected:
+  void add_signed_(const char *key, int64_t value);
+  void add_unsigned_(const char *key, uint64_t value);
+  /// Write the separator and the key for the next value of the current object or array.
+  void begin_value_(const char *key);
+  void write_(const char *data, size_t len);
+  void write_(char c);
+  void write_string_(const char *str, size_t len);
+
+  std::string *string_{nullptr};
+  char *buffer_{nullptr};
+  size_t size_{0};
+  size_t length_{0};
+  /// One bit per nesting level, set while the object or array at that level doesn't have a value yet.
+  uint32_t empty_{0};
+  uint8_t depth_{0};
+};
+
+/// Callback function typedef for writing the members of a JSON object.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Write a JSON object with the provided json write function into a new string.
+std::string write_json(const json_write_t &f);
+
+/** Write a JSON object with the provided json write function into a buffer that's reused between calls.
+ *
+ * The returned string is valid until the next call.
+ */
+const char *write_json(const json_write_t &f, size_t *length);
+
+/// Write a JSON object into a caller supplied buffer, returns the length like snprintf().
+size_t write_json(char *buffer, size_t size, const json_write_t &f);
+
+}  // namespace json
+}  // namespace esphome
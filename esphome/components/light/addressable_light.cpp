@@ -1,6 +1,9 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
@@ -27,6 +30,144 @@ std::unique_ptr<LightTransformer> AddressableLight::create_default_transition()
   return make_unique<AddressableLightTransformer>(*this);
 }
 
+bool AddressableLight::clamp_range_(int32_t *from, int32_t *to) const {
+  const int32_t size = this->size();
+  *from = std::max<int32_t>(interpret_index(*from, size), 0);
+  *to = std::min<int32_t>(interpret_index(*to, size), size);
+  return *from < *to;
+}
+
+void AddressableLight::fill_range(int32_t from, int32_t to, const Color &color) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  AddressableLightBuffer buffer = this->get_buffer_internal();
+  if (buffer.data == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set(color);
+    return;
+  }
+
+  const Color corrected = this->correction_.color_correct(color);
+  const size_t stride = buffer.stride();
+  uint8_t *start = buffer.data + from * stride;
+  start[buffer.offsets[0]] = corrected.red;
+  start[buffer.offsets[1]] = corrected.green;
+  start[buffer.offsets[2]] = corrected.blue;
+  if (buffer.white)
+    start[buffer.offsets[3]] = corrected.white;
+  // Every byte of a pixel is a channel, so the rest of the span is copies of the first pixel
+  const size_t len = (to - from) * stride;
+  for (size_t done = stride; done < len;) {
+    size_t chunk = std::min(done, len - done);
+    memcpy(start + done, start, chunk);
+    done += chunk;
+  }
+}
+
+void AddressableLight::blend_range(int32_t from, int32_t to, const Color &color, uint8_t amnt) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  const Color add = color * amnt;
+  const uint8_t inv_amnt = 255 - amnt;
+  AddressableLightBuffer buffer = this->get_buffer_internal();
+  if (buffer.data == nullptr) {
+    for (int32_t i = from; i < to; i++) {
+      ESPColorView view = this->get_view_internal(i);
+      view.set(add + view.get() * inv_amnt);
+    }
+    return;
+  }
+
+  // The new value of a channel only depends on its old value, so uncorrecting, blending and correcting it again is
+  // fused into one table per channel.
+  const size_t stride = buffer.stride();
+  const uint8_t channels = buffer.white ? 4 : 3;
+  uint8_t table[256];
+  for (uint8_t c = 0; c < channels; c++) {
+    const uint8_t *correct = this->correction_.get_correct_table(c);
+    const uint8_t *uncorrect = this->correction_.get_uncorrect_table(c);
+    const uint8_t add_c = add.raw[c];
+    for (uint16_t i = 0; i < 256; i++) {
+      uint8_t blended = esp_scale8(uncorrect[i], inv_amnt);
+      table[i] = correct[blended > 255 - add_c ? 255 : blended + add_c];
+    }
+    uint8_t *p = buffer.data + from * stride + buffer.offsets[c];
+    uint8_t *end = buffer.data + to * stride + buffer.offsets[c];
+    for (; p != end; p += stride)
+      *p = table[*p];
+  }
+}
+
+void AddressableLight::set_range(int32_t from, const Color *colors, int32_t count) {
+  const int32_t size = this->size();
+  from = interpret_index(from, size);
+  int32_t to = std::min<int32_t>(from + count, size);
+  if (from < 0) {
+    colors -= from;
+    from = 0;
+  }
+  if (from >= to)
+    return;
+  AddressableLightBuffer buffer = this->get_buffer_internal();
+  if (buffer.data == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set(*colors++);
+    return;
+  }
+
+  const size_t stride = buffer.stride();
+  const uint8_t *correct_red = this->correction_.get_correct_table(0);
+  const uint8_t *correct_green = this->correction_.get_correct_table(1);
+  const uint8_t *correct_blue = this->correction_.get_correct_table(2);
+  const uint8_t *correct_white = this->correction_.get_correct_table(3);
+  uint8_t *end = buffer.data + to * stride;
+  for (uint8_t *p = buffer.data + from * stride; p != end; p += stride, colors++) {
+    p[buffer.offsets[0]] = correct_red[colors->red];
+    p[buffer.offsets[1]] = correct_green[colors->green];
+    p[buffer.offsets[2]] = correct_blue[colors->blue];
+    if (buffer.white)
+      p[buffer.offsets[3]] = correct_white[colors->white];
+  }
+}
+
+void AddressableLight::set_range_raw(int32_t from, const uint8_t *data, int32_t count, RawPixelFormat format) {
+  if (from < 0)
+    return;
+  count = std::min<int32_t>(count, this->size() - from);
+
+  Color chunk[32];
+  while (count > 0) {
+    const int32_t len = std::min<int32_t>(count, 32);
+    for (int32_t i = 0; i < len; i++) {
+      switch (format) {
+        case RawPixelFormat::MONO:
+          chunk[i] = Color(data[0], data[0], data[0], data[0]);
+          data += 1;
+          break;
+        case RawPixelFormat::RGB:
+          chunk[i] = Color(data[0], data[1], data[2]);
+          data += 3;
+          break;
+        case RawPixelFormat::RGB_WHITE_AVG:
+          chunk[i] = Color(data[0], data[1], data[2], (data[0] + data[1] + data[2]) / 3);
+          data += 3;
+          break;
+        case RawPixelFormat::RGB_WHITE_MIN:
+          chunk[i] = Color(data[0], data[1], data[2], std::min(std::min(data[0], data[1]), data[2]));
+          data += 3;
+          break;
+        case RawPixelFormat::RGBW:
+          chunk[i] = Color(data[0], data[1], data[2], data[3]);
+          data += 4;
+          break;
+      }
+    }
+    this->set_range(from, chunk, len);
+    from += len;
+    count -= len;
+  }
+}
+
 Color color_from_light_color_values(LightColorValues val) {
   auto r = to_uint8_scale(val.get_color_brightness() * val.get_red());
   auto g = to_uint8_scale(val.get_color_brightness() * val.get_green());
@@ -95,13 +236,8 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   alpha255 = clamp(alpha255, 0.0f, 255.0f);
   auto alpha8 = static_cast<uint8_t>(alpha255);
 
-  if (alpha8 != 0) {
-    uint8_t inv_alpha8 = 255 - alpha8;
-    Color add = this->target_color_ * alpha8;
-
-    for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
-  }
+  if (alpha8 != 0)
+    this->light_.blend_range(0, this->light_.size(), this->target_color_, alpha8);
 
   this->last_transition_progress_ = smoothed_progress;
   this->light_.schedule_show();
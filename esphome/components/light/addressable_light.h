@@ -28,6 +28,27 @@ class AddressableLightState : public LightState {
   using LightState::LightState;
 };
 
+/// Channel layout of raw pixel data, as received by realtime protocols like E1.31, WLED and Adalight.
+enum class RawPixelFormat : uint8_t {
+  MONO,           ///< One byte per pixel, used for all channels.
+  RGB,            ///< Red, green and blue, white is off.
+  RGB_WHITE_AVG,  ///< Red, green and blue, white is their average.
+  RGB_WHITE_MIN,  ///< Red, green and blue, white is their minimum.
+  RGBW,           ///< Red, green, blue and white.
+};
+
+/// The pixel buffer of an addressable light, with the channels of each pixel stored next to each other.
+struct AddressableLightBuffer {
+  /// The first pixel, nullptr if the light has no such buffer.
+  uint8_t *data{nullptr};
+  /// Byte offset of the red, green, blue and white channel within a pixel.
+  uint8_t offsets[4]{0, 1, 2, 3};
+  /// Whether pixels have a white channel, pixels are 4 bytes long if so and 3 bytes otherwise.
+  bool white{false};
+
+  uint8_t stride() const { return this->white ? 4 : 3; }
+};
+
 class AddressableLight : public LightOutput, public Component {
  public:
   virtual int32_t size() const = 0;
@@ -42,6 +63,20 @@ class AddressableLight : public LightOutput, public Component {
   ESPRangeView all() { return ESPRangeView(this, 0, this->size()); }
   ESPRangeIterator begin() { return this->all().begin(); }
   ESPRangeIterator end() { return this->all().end(); }
+
+  /** Set the pixels from (inclusive) to (exclusive) to a color.
+   *
+   * The bulk operations accept negative indices like range(), and apply the color correction once for the whole
+   * span when the light exposes its pixel buffer.
+   */
+  void fill_range(int32_t from, int32_t to, const Color &color);
+  /// Blend the pixels from (inclusive) to (exclusive) towards a color, amnt=255 replaces them with the color.
+  void blend_range(int32_t from, int32_t to, const Color &color, uint8_t amnt);
+  /// Set count pixels starting at from to the colors in colors.
+  void set_range(int32_t from, const Color *colors, int32_t count);
+  /// Set count pixels starting at from to raw pixel data, converted in small chunks instead of a full color array.
+  void set_range_raw(int32_t from, const uint8_t *data, int32_t count, RawPixelFormat format);
+
   void shift_left(int32_t amnt) {
     if (amnt < 0) {
       this->shift_right(-amnt);
@@ -74,6 +109,8 @@ class AddressableLight : public LightOutput, public Component {
   }
   void update_state(LightState *state) override;
   void schedule_show() { this->state_parent_->next_write_ = true; }
+  /// Whether the output finished sending the last frame, outputs that send in the background override this.
+  virtual bool is_show_done() { return true; }
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -86,6 +123,18 @@ class AddressableLight : public LightOutput, public Component {
 
   void mark_shown_() {
 #ifdef USE_POWER_SUPPLY
+    AddressableLightBuffer buffer = this->get_buffer_internal();
+    if (buffer.data != nullptr) {
+      const uint8_t *end = buffer.data + this->size() * buffer.stride();
+      for (const uint8_t *p = buffer.data; p != end; p++) {
+        if (*p != 0) {
+          this->power_.request();
+          return;
+        }
+      }
+      this->power_.unrequest();
+      return;
+    }
     for (const auto &c : *this) {
       if (c.get_red_raw() > 0 || c.get_green_raw() > 0 || c.get_blue_raw() > 0 || c.get_white_raw() > 0) {
         this->power_.request();
@@ -96,6 +145,10 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// The pixel buffer used by the bulk operations, lights without one fall back to get_view_internal().
+  virtual AddressableLightBuffer get_buffer_internal() const { return {}; }
+  /// Interpret negative indices and clamp them to the light, false if the range is empty.
+  bool clamp_range_(int32_t *from, int32_t *to) const;
 
   bool effect_active_{false};
   ESPColorCorrection correction_{};
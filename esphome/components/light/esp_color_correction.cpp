@@ -2,6 +2,8 @@
 #include "light_color_values.h"
 #include "esphome/core/log.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
@@ -14,6 +16,7 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   if (gamma == 0.0f) {
     for (uint16_t i = 0; i < 256; i++)
       this->gamma_reverse_table_[i] = i;
+    this->calculate_tables_();
     return;
   }
   for (uint16_t i = 0; i < 256; i++) {
@@ -21,6 +24,38 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
     auto uncorrected = to_uint8_scale(powf(i / 255.0f, 1.0f / gamma));
     this->gamma_reverse_table_[i] = uncorrected;
   }
+  this->calculate_tables_();
+}
+
+ESPColorCorrection::Tables *ESPColorCorrection::get_tables_() {
+  if (this->tables_ == nullptr) {
+    this->tables_ = make_unique<Tables>();
+    this->calculate_tables_();
+  }
+  return this->tables_.get();
+}
+
+void ESPColorCorrection::calculate_tables_() {
+  if (this->tables_ == nullptr)
+    return;
+  const uint8_t max_brightness[4] = {this->max_brightness_.red, this->max_brightness_.green,
+                                     this->max_brightness_.blue, this->max_brightness_.white};
+  for (uint8_t c = 0; c < 4; c++) {
+    for (uint16_t i = 0; i < 256; i++) {
+      uint8_t res = esp_scale8(esp_scale8(i, max_brightness[c]), this->local_brightness_);
+      this->tables_->correct[c][i] = this->gamma_table_[res];
+    }
+
+    if (max_brightness[c] == 0 || this->local_brightness_ == 0) {
+      memset(this->tables_->uncorrect[c], 0, 256);
+      continue;
+    }
+    for (uint16_t i = 0; i < 256; i++) {
+      uint16_t uncorrected = this->gamma_reverse_table_[i] * 255UL;
+      uint8_t res = ((uncorrected / max_brightness[c]) * 255UL) / this->local_brightness_;
+      this->tables_->uncorrect[c][i] = res;
+    }
+  }
 }
 
 }  // namespace light
@@ -2,14 +2,33 @@
 
 #include "esphome/core/color.h"
 
+#include <memory>
+
 namespace esphome {
 namespace light {
 
+/** Color correction of an addressable light, applied to the colors written to the pixel buffer.
+ *
+ * corrected = (uncorrected * max_brightness * local_brightness) ^ gamma. Single pixels are corrected with this math.
+ * The bulk range operations of AddressableLight instead need the result for every input value, so the first time
+ * they ask for it (through get_correct_table() or get_uncorrect_table()), the correction is fused into one lookup
+ * table per channel plus one for the inverse. These tables take 2 KB of heap per light and are rebuilt whenever one
+ * of the inputs changes; once they exist, single pixels are corrected with a table lookup as well. Lights that never
+ * use the bulk operations don't allocate them.
+ */
 class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  void set_max_brightness(const Color &max_brightness) {
+    this->max_brightness_ = max_brightness;
+    this->calculate_tables_();
+  }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (this->local_brightness_ == local_brightness)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->calculate_tables_();
+  }
   void calculate_gamma_table(float gamma);
   inline Color color_correct(Color color) const ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
@@ -17,20 +36,16 @@ class ESPColorCorrection {
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
   inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(red, this->max_brightness_.red), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->correct_(0, red, this->max_brightness_.red);
   }
   inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(green, this->max_brightness_.green), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->correct_(1, green, this->max_brightness_.green);
   }
   inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(blue, this->max_brightness_.blue), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->correct_(2, blue, this->max_brightness_.blue);
   }
   inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(white, this->max_brightness_.white), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->correct_(3, white, this->max_brightness_.white);
   }
   inline Color color_uncorrect(Color color) const ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
@@ -38,37 +53,50 @@ class ESPColorCorrection {
                  this->color_uncorrect_blue(color.blue), this->color_uncorrect_white(color.white));
   }
   inline uint8_t color_uncorrect_red(uint8_t red) const ALWAYS_INLINE {
-    if (this->max_brightness_.red == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[red] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.red) * 255UL) / this->local_brightness_;
-    return res;
+    return this->uncorrect_(0, red, this->max_brightness_.red);
   }
   inline uint8_t color_uncorrect_green(uint8_t green) const ALWAYS_INLINE {
-    if (this->max_brightness_.green == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[green] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.green) * 255UL) / this->local_brightness_;
-    return res;
+    return this->uncorrect_(1, green, this->max_brightness_.green);
   }
   inline uint8_t color_uncorrect_blue(uint8_t blue) const ALWAYS_INLINE {
-    if (this->max_brightness_.blue == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[blue] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.blue) * 255UL) / this->local_brightness_;
-    return res;
+    return this->uncorrect_(2, blue, this->max_brightness_.blue);
   }
   inline uint8_t color_uncorrect_white(uint8_t white) const ALWAYS_INLINE {
-    if (this->max_brightness_.white == 0 || this->local_brightness_ == 0)
+    return this->uncorrect_(3, white, this->max_brightness_.white);
+  }
+  /// The fused correction table of a channel (0 = red, 1 = green, 2 = blue, 3 = white), built on first use.
+  const uint8_t *get_correct_table(uint8_t channel) { return this->get_tables_()->correct[channel]; }
+  /// The fused inverse correction table of a channel (0 = red, 1 = green, 2 = blue, 3 = white), built on first use.
+  const uint8_t *get_uncorrect_table(uint8_t channel) { return this->get_tables_()->uncorrect[channel]; }
+
+ protected:
+  struct Tables {
+    uint8_t correct[4][256];
+    uint8_t uncorrect[4][256];
+  };
+
+  inline uint8_t correct_(uint8_t channel, uint8_t value, uint8_t max_brightness) const ALWAYS_INLINE {
+    if (this->tables_ != nullptr)
+      return this->tables_->correct[channel][value];
+    uint8_t res = esp_scale8(esp_scale8(value, max_brightness), this->local_brightness_);
+    return this->gamma_table_[res];
+  }
+  inline uint8_t uncorrect_(uint8_t channel, uint8_t value, uint8_t max_brightness) const ALWAYS_INLINE {
+    if (this->tables_ != nullptr)
+      return this->tables_->uncorrect[channel][value];
+    if (max_brightness == 0 || this->local_brightness_ == 0)
       return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[white] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.white) * 255UL) / this->local_brightness_;
+    uint16_t uncorrected = this->gamma_reverse_table_[value] * 255UL;
+    uint8_t res = ((uncorrected / max_brightness) * 255UL) / this->local_brightness_;
     return res;
   }
+  Tables *get_tables_();
+  /// Rebuild the fused tables from the gamma tables and brightness settings, if they are in use.
+  void calculate_tables_();
 
- protected:
-  uint8_t gamma_table_[256];
-  uint8_t gamma_reverse_table_[256];
+  uint8_t gamma_table_[256]{};
+  uint8_t gamma_reverse_table_[256]{};
+  std::unique_ptr<Tables> tables_;
   Color max_brightness_;
   uint8_t local_brightness_{255};
 };
@@ -106,6 +106,13 @@ void LightState::dump_config() {
   }
 }
 void LightState::loop() {
+  if (this->frame_clocked_)
+    return;
+
+  this->render();
+  this->show();
+}
+void LightState::render() {
   // Apply effect (if any)
   auto *effect = this->get_active_effect_();
   if (effect != nullptr) {
@@ -130,12 +137,14 @@ void LightState::loop() {
       this->target_state_reached_callback_.call();
     }
   }
+}
+bool LightState::show() {
+  if (!this->next_write_)
+    return false;
 
-  // Write state to the light
-  if (this->next_write_) {
-    this->next_write_ = false;
-    this->output_->write_state(this);
-  }
+  this->next_write_ = false;
+  this->output_->write_state(this);
+  return true;
 }
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
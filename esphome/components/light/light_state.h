@@ -48,6 +48,16 @@ class LightState : public EntityBase, public Component {
   void setup() override;
   void dump_config() override;
   void loop() override;
+  /// Apply the active effect and transition, done every loop unless a frame clock does it.
+  void render();
+  /// Write the state to the output if it changed since the last write, returns whether it did.
+  bool show();
+  /// Whether an effect or transition is running or a write is pending, so that render() and show() have work to do.
+  bool needs_render() const {
+    return this->active_effect_index_ != 0 || this->transformer_ != nullptr || this->next_write_;
+  }
+  /// Leave render() and show() to a frame clock that updates several lights together instead of doing them in loop().
+  void set_frame_clocked(bool frame_clocked) { this->frame_clocked_ = frame_clocked; }
   /// Shortly after HARDWARE.
   float get_setup_priority() const override;
 
@@ -176,6 +186,8 @@ class LightState : public EntityBase, public Component {
   std::unique_ptr<LightTransformer> transformer_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// Whether render() and show() are called by a frame clock.
+  bool frame_clocked_{false};
 
   /// Object used to store the persisted values of the light.
   ESPPreferenceObject rtc_;
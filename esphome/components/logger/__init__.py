@@ -106,12 +106,22 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
+CONF_BINARY_LOGS = "binary_logs"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(Logger),
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE): cv.All(
+                cv.only_on_esp32,
+                cv.validate_bytes,
+                cv.int_range(min=256, max=65536),
+            ),
+            cv.SplitDefault(CONF_BINARY_LOGS, esp32=False): cv.All(
+                cv.only_on_esp32, cv.boolean
+            ),
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
             cv.Optional(CONF_HARDWARE_UART, default="UART0"): uart_selection,
             cv.Optional(CONF_LEVEL, default="DEBUG"): is_log_level,
@@ -144,6 +154,11 @@ async def to_code(config):
         HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]],
     )
     log = cg.Pvariable(config[CONF_ID], rhs)
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_buffer_size(config[CONF_ASYNC_BUFFER_SIZE]))
+    if config.get(CONF_BINARY_LOGS):
+        cg.add_define("USE_LOGGER_BINARY")
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -0,0 +1,264 @@
+#include "binary_log.h"
+
+#ifdef USE_LOGGER_BINARY
+
+#include <soc/soc_memory_layout.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+static size_t varint_size(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+class BinaryLogWriter {
+ public:
+  BinaryLogWriter(uint8_t *buffer, size_t size) : at_(buffer), end_(buffer == nullptr ? nullptr : buffer + size) {}
+
+  void write_varint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      if (value != 0)
+        byte |= 0x80;
+      this->write_byte_(byte);
+    } while (value != 0);
+  }
+  void write_zigzag(int64_t value) {
+    this->write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+  void write_float(float value) {
+    uint8_t bytes[4];
+    memcpy(bytes, &value, sizeof(bytes));
+    for (uint8_t byte : bytes)
+      this->write_byte_(byte);
+  }
+  void write_string(const char *value, size_t len) {
+    this->write_varint(len);
+    for (size_t i = 0; i < len; i++)
+      this->write_byte_(value[i]);
+  }
+  /// Append the formatted text, truncated to what is left of the buffer.
+  void write_text(const char *format, va_list args) {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int ret = vsnprintf(nullptr, 0, format, args_copy);
+    va_end(args_copy);
+    size_t len = ret < 0 ? 0 : ret;
+    if (this->at_ != nullptr) {
+      size_t remaining = this->end_ - this->at_;
+      // vsnprintf() also writes a null terminator
+      size_t overhead = varint_size(len) + 1;
+      len = remaining > overhead ? std::min(len, remaining - overhead) : 0;
+    }
+    this->write_varint(len);
+    if (this->at_ != nullptr && len != 0) {
+      vsnprintf(reinterpret_cast<char *>(this->at_), len + 1, format, args);
+      this->at_ += len;
+    }
+    this->length_ += len;
+  }
+
+  size_t get_length() const { return this->length_; }
+
+ protected:
+  void write_byte_(uint8_t byte) {
+    if (this->at_ != this->end_)
+      *this->at_++ = byte;
+    this->length_++;
+  }
+
+  uint8_t *at_;
+  uint8_t *end_;
+  size_t length_{0};
+};
+
+static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+enum class LengthModifier { NONE, HH, H, L, LL, Z, J, T, BIG_L };
+
+/// Write the raw value of every argument the format string consumes, returns false on unsupported conversions.
+static bool write_arguments(BinaryLogWriter &writer, const char *format, va_list args) {
+  const char *p = format;
+  while (*p != '\0') {
+    if (*p++ != '%')
+      continue;
+    if (*p == '%') {
+      p++;
+      continue;
+    }
+
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    if (*p == '*') {
+      writer.write_zigzag(va_arg(args, int));
+      p++;
+    } else {
+      while (is_digit(*p))
+        p++;
+    }
+    // A negative precision counts as if it was omitted
+    int precision = -1;
+    if (*p == '.') {
+      p++;
+      if (*p == '*') {
+        precision = va_arg(args, int);
+        writer.write_zigzag(precision);
+        p++;
+      } else {
+        precision = 0;
+        while (is_digit(*p))
+          precision = precision * 10 + (*p++ - '0');
+      }
+    }
+
+    LengthModifier length = LengthModifier::NONE;
+    switch (*p) {
+      case 'h':
+        length = p[1] == 'h' ? LengthModifier::HH : LengthModifier::H;
+        break;
+      case 'l':
+        length = p[1] == 'l' ? LengthModifier::LL : LengthModifier::L;
+        break;
+      case 'z':
+        length = LengthModifier::Z;
+        break;
+      case 'j':
+        length = LengthModifier::J;
+        break;
+      case 't':
+        length = LengthModifier::T;
+        break;
+      case 'L':
+        length = LengthModifier::BIG_L;
+        break;
+      default:
+        break;
+    }
+    if (length == LengthModifier::HH || length == LengthModifier::LL) {
+      p += 2;
+    } else if (length != LengthModifier::NONE) {
+      p++;
+    }
+
+    switch (*p++) {
+      case 'd':
+      case 'i':
+        switch (length) {
+          case LengthModifier::L:
+            writer.write_zigzag(va_arg(args, long));
+            break;
+          case LengthModifier::LL:
+            writer.write_zigzag(va_arg(args, long long));
+            break;
+          case LengthModifier::Z:
+          case LengthModifier::T:
+            writer.write_zigzag(va_arg(args, ptrdiff_t));
+            break;
+          case LengthModifier::J:
+            writer.write_zigzag(va_arg(args, intmax_t));
+            break;
+          default:
+            writer.write_zigzag(va_arg(args, int));
+            break;
+        }
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        switch (length) {
+          case LengthModifier::L:
+            writer.write_varint(va_arg(args, unsigned long));
+            break;
+          case LengthModifier::LL:
+            writer.write_varint(va_arg(args, unsigned long long));
+            break;
+          case LengthModifier::Z:
+          case LengthModifier::T:
+            writer.write_varint(va_arg(args, size_t));
+            break;
+          case LengthModifier::J:
+            writer.write_varint(va_arg(args, uintmax_t));
+            break;
+          default:
+            writer.write_varint(va_arg(args, unsigned int));
+            break;
+        }
+        break;
+      case 'c':
+        writer.write_zigzag(va_arg(args, int));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        // Sent as float32 to save space. Nearly all log arguments are floats promoted to double, which this
+        // doesn't change; real doubles lose precision beyond about 7 significant digits.
+        if (length == LengthModifier::BIG_L) {
+          writer.write_float(static_cast<float>(va_arg(args, long double)));
+        } else {
+          writer.write_float(static_cast<float>(va_arg(args, double)));
+        }
+        break;
+      case 's': {
+        const char *value = va_arg(args, const char *);
+        if (value == nullptr)
+          value = "(null)";
+        // With a precision the string doesn't have to be null terminated
+        size_t len = precision >= 0 ? strnlen(value, precision) : strlen(value);
+        writer.write_string(value, len);
+        break;
+      }
+      case 'p':
+        writer.write_varint(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      default:
+        // %n, wide characters or a malformed format string
+        return false;
+    }
+  }
+  return true;
+}
+
+static size_t encode_text(uint8_t *buffer, size_t size, const char *tag, int line, const char *format, va_list args) {
+  BinaryLogWriter writer(buffer, size);
+  writer.write_varint(0);
+  writer.write_string(tag, strlen(tag));
+  writer.write_varint(line);
+  writer.write_text(format, args);
+  return writer.get_length();
+}
+
+size_t encode_binary_log(uint8_t *buffer, size_t size, const char *tag, int line, const char *format, va_list args) {
+  if (esp_ptr_in_drom(format) && esp_ptr_in_drom(tag)) {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    BinaryLogWriter writer(buffer, size);
+    writer.write_varint(reinterpret_cast<uintptr_t>(format));
+    writer.write_varint(reinterpret_cast<uintptr_t>(tag));
+    writer.write_varint(line);
+    bool ok = write_arguments(writer, format, args_copy);
+    va_end(args_copy);
+    if (ok && (buffer == nullptr || writer.get_length() <= size))
+      return writer.get_length();
+  }
+  return encode_text(buffer, size, tag, line, format, args);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_BINARY
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_BINARY
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/** Encode a log message in the compact binary format that esphome/binary_log.py decodes.
+ *
+ * If the format string and the tag are stored in flash, the message is encoded as their addresses, the line and the
+ * raw arguments. It then doesn't have to be formatted on the device, and the decoder looks the strings up in the
+ * firmware ELF. Messages with a format string built at runtime or a conversion the encoder doesn't know are encoded as
+ * the tag, the line and the formatted text instead.
+ *
+ * Returns the size of the encoding. With buffer == nullptr nothing is written and the size of the complete encoding
+ * is returned. Otherwise at most size bytes are written, including the null terminator vsnprintf() adds to the text
+ * fallback, so one byte more than the complete encoding is always enough. If the arguments don't fit, the message is
+ * encoded as truncated text instead.
+ */
+size_t encode_binary_log(uint8_t *buffer, size_t size, const char *tag, int line, const char *format, va_list args);
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_BINARY
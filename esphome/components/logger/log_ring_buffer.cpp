@@ -0,0 +1,93 @@
+#include "log_ring_buffer.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+// Released and never published space is zeroed, so the state of a record that is still being written reads as 0
+static const uint8_t RECORD_READY = 1;
+// Fills the end of the ring when the next record doesn't fit before the wrap around
+static const uint8_t RECORD_PADDING = 2;
+
+static inline uint32_t align_record_size(size_t size) {
+  const size_t align = alignof(LogRingBuffer::Record);
+  return (size + align - 1) & ~(align - 1);
+}
+
+bool LogRingBuffer::init(size_t size) {
+  uint32_t pow2 = 1;
+  while (pow2 * 2 <= size)
+    pow2 *= 2;
+  if (pow2 < 2 * sizeof(Record))
+    return false;
+  this->data_ = new uint8_t[pow2]();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->size_ = pow2;
+  this->mask_ = pow2 - 1;
+  return true;
+}
+
+LogRingBuffer::Record *LogRingBuffer::reserve(size_t text_len) {
+  const uint32_t needed = align_record_size(sizeof(Record) + text_len + 1);
+  if (needed > this->size_ / 2)
+    return nullptr;
+
+  uint32_t head = this->head_.load(std::memory_order_relaxed);
+  uint32_t pad;
+  do {
+    uint32_t contiguous = this->size_ - (head & this->mask_);
+    pad = contiguous < needed ? contiguous : 0;
+    if (head + pad + needed - this->tail_.load(std::memory_order_acquire) > this->size_)
+      return nullptr;
+  } while (!this->head_.compare_exchange_weak(head, head + pad + needed, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+
+  if (pad >= sizeof(Record)) {
+    // Gaps too small for a header are skipped by the consumer without one
+    auto *filler = reinterpret_cast<Record *>(this->data_ + (head & this->mask_));
+    filler->size = pad;
+    __atomic_store_n(&filler->state, RECORD_PADDING, __ATOMIC_RELEASE);
+  }
+  auto *record = reinterpret_cast<Record *>(this->data_ + ((head + pad) & this->mask_));
+  record->size = needed;
+  record->text_len = text_len;
+  return record;
+}
+
+void LogRingBuffer::publish(Record *record) { __atomic_store_n(&record->state, RECORD_READY, __ATOMIC_RELEASE); }
+
+LogRingBuffer::Record *LogRingBuffer::peek() {
+  uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  while (tail != this->head_.load(std::memory_order_acquire)) {
+    uint32_t contiguous = this->size_ - (tail & this->mask_);
+    if (contiguous < sizeof(Record)) {
+      tail += contiguous;
+      this->tail_.store(tail, std::memory_order_release);
+      continue;
+    }
+    auto *record = reinterpret_cast<Record *>(this->data_ + (tail & this->mask_));
+    uint8_t state = __atomic_load_n(&record->state, __ATOMIC_ACQUIRE);
+    if (state == RECORD_READY)
+      return record;
+    if (state != RECORD_PADDING)
+      // Reserved, but the producer is still writing it
+      return nullptr;
+    tail += record->size;
+    memset(record, 0, record->size);
+    this->tail_.store(tail, std::memory_order_release);
+  }
+  return nullptr;
+}
+
+void LogRingBuffer::release(Record *record) {
+  uint32_t size = record->size;
+  memset(record, 0, size);
+  this->tail_.store(this->tail_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
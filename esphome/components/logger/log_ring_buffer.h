@@ -0,0 +1,72 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/** Multi-producer, single-consumer ring buffer of variable length log records.
+ *
+ * Producers claim space by moving the head with a compare-and-swap, fill in their record and then publish it, so
+ * log calls from other tasks never block and never share a format buffer. The single consumer hands out records in
+ * the order they were reserved and stops at a record that is reserved but not published yet.
+ */
+class LogRingBuffer {
+ public:
+  struct Record {
+    /// Bytes the record occupies in the ring, including this header.
+    uint32_t size;
+    /// One of the RECORD_* states, only accessed atomically.
+    uint8_t state;
+    uint8_t level;
+    uint16_t line;
+    uint16_t text_len;
+    /// The text holds the binary encoding of the message instead of the formatted message.
+    bool binary;
+    const char *tag;
+
+    /// The null terminated message, stored right after the header.
+    char *text() { return reinterpret_cast<char *>(this + 1); }
+  };
+
+  /// Allocate the ring, the size is rounded down to a power of two.
+  bool init(size_t size);
+  bool is_initialized() const { return this->data_ != nullptr; }
+  uint32_t get_size() const { return this->size_; }
+
+  /** Reserve a record with room for text_len characters and a null terminator.
+   *
+   * Returns nullptr if the ring doesn't have enough free space. Safe to call from any task.
+   */
+  Record *reserve(size_t text_len);
+  /// Make a reserved record visible to the consumer.
+  void publish(Record *record);
+  /// The oldest published record, or nullptr if there is none. Only called by the consumer.
+  Record *peek();
+  /// Free the record returned by peek(). Only called by the consumer.
+  void release(Record *record);
+
+  void add_dropped() { this->dropped_.fetch_add(1, std::memory_order_relaxed); }
+  /// Number of records dropped since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+
+ protected:
+  uint8_t *data_{nullptr};
+  uint32_t size_{0};
+  uint32_t mask_{0};
+  // Free running positions, the offset into data_ is position & mask_
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
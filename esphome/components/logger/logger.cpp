@@ -10,6 +10,10 @@
 #endif
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#ifdef USE_LOGGER_ASYNC
+#include "esphome/core/application.h"
+#include <algorithm>
+#endif
 
 namespace esphome {
 namespace logger {
@@ -49,10 +53,24 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_buffer_.is_initialized()) {
+    this->log_async_(level, tag, line, format, args);
+    return;
+  }
+#endif
   if (level > this->level_for(tag) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
+#ifdef USE_LOGGER_BINARY
+  if (level <= this->binary_log_level_)
+    this->log_binary_(level, tag, line, format, args);
+  if (!this->needs_text_()) {
+    recursion_guard_ = false;
+    return;
+  }
+#endif
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -60,6 +78,21 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   this->log_message_(level, tag);
   recursion_guard_ = false;
 }
+#ifdef USE_LOGGER_BINARY
+void HOT Logger::log_binary_(int level, const char *tag, int line, const char *format, va_list args) {
+  // Same as for formatted messages, don't risk running out of memory in the network stack
+  if (xPortGetFreeHeapSize() < 2048)
+    return;
+
+  va_list args_copy;
+  va_copy(args_copy, args);
+  auto *data = reinterpret_cast<uint8_t *>(this->tx_buffer_);
+  size_t len = encode_binary_log(data, this->tx_buffer_size_, tag, line, format, args_copy);
+  va_end(args_copy);
+  if (len <= static_cast<size_t>(this->tx_buffer_size_))
+    this->binary_log_callback_.call(level, data, len);
+}
+#endif
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
@@ -91,6 +124,131 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+#ifdef USE_LOGGER_ASYNC
+void HOT Logger::log_async_(int level, const char *tag, int line, const char *format, va_list args) {
+  if (level > this->level_for(tag))
+    return;
+  const bool main_task = this->is_main_task_();
+  // Messages logged by the log callbacks themselves are dropped, like in the synchronous path
+  if (main_task && this->recursion_guard_)
+    return;
+
+  bool queued = false;
+#ifdef USE_LOGGER_BINARY
+  if (level <= this->binary_log_level_)
+    queued |= this->queue_binary_(level, tag, line, format, args, main_task);
+  if (this->needs_text_())
+    queued |= this->queue_text_(level, tag, line, format, args, main_task);
+#else
+  queued = this->queue_text_(level, tag, line, format, args, main_task);
+#endif
+  if (queued && main_task && this->shutting_down_)
+    this->drain_async_buffer_();
+
+#ifdef USE_TICKLESS_IDLE
+  if (queued && !main_task) {
+    if (xPortInIsrContext()) {
+      App.wake_loop_isr();
+    } else {
+      App.wake_loop();
+    }
+  }
+#endif
+}
+bool Logger::queue_text_(int level, const char *tag, int line, const char *format, va_list args, bool main_task) {
+  // Format twice instead of into a shared buffer, so that any task can log without taking a lock
+  va_list args_copy;
+  va_copy(args_copy, args);
+  int len = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (len < 0)
+    return false;
+  len = std::min(len, this->tx_buffer_size_);
+
+  auto *record = this->reserve_record_(len, main_task);
+  if (record == nullptr)
+    return false;
+  record->level = level;
+  record->line = line;
+  record->tag = tag;
+  record->binary = false;
+  va_copy(args_copy, args);
+  vsnprintf(record->text(), len + 1, format, args_copy);
+  va_end(args_copy);
+  this->async_buffer_.publish(record);
+  return true;
+}
+#ifdef USE_LOGGER_BINARY
+bool Logger::queue_binary_(int level, const char *tag, int line, const char *format, va_list args, bool main_task) {
+  va_list args_copy;
+  va_copy(args_copy, args);
+  size_t len = encode_binary_log(nullptr, 0, tag, line, format, args_copy);
+  va_end(args_copy);
+
+  auto *record = this->reserve_record_(len, main_task);
+  if (record == nullptr)
+    return false;
+  record->level = level;
+  record->line = line;
+  record->tag = tag;
+  record->binary = true;
+  va_copy(args_copy, args);
+  auto *data = reinterpret_cast<uint8_t *>(record->text());
+  record->text_len = encode_binary_log(data, len + 1, tag, line, format, args_copy);
+  va_end(args_copy);
+  this->async_buffer_.publish(record);
+  return true;
+}
+#endif
+LogRingBuffer::Record *Logger::reserve_record_(size_t len, bool main_task) {
+  auto *record = this->async_buffer_.reserve(len);
+  if (record == nullptr && main_task) {
+    // The main task is the consumer, so it can make room instead of dropping messages (e.g. during setup)
+    this->drain_async_buffer_();
+    record = this->async_buffer_.reserve(len);
+  }
+  if (record == nullptr)
+    this->async_buffer_.add_dropped();
+  return record;
+}
+void Logger::drain_async_buffer_() {
+  this->recursion_guard_ = true;
+  // Don't keep writing forever if other tasks log faster than the UART can keep up
+  size_t drained = 0;
+  LogRingBuffer::Record *record;
+  while (drained < this->async_buffer_.get_size() && (record = this->async_buffer_.peek()) != nullptr) {
+    drained += record->size;
+    int level = record->level;
+    const char *tag = record->tag;
+#ifdef USE_LOGGER_BINARY
+    if (record->binary) {
+      this->binary_log_callback_.call(level, reinterpret_cast<const uint8_t *>(record->text()), record->text_len);
+      this->async_buffer_.release(record);
+      continue;
+    }
+#endif
+    this->reset_buffer_();
+    this->write_header_(level, tag, record->line);
+    this->write_to_buffer_(record->text(), record->text_len);
+    this->write_footer_();
+    this->async_buffer_.release(record);
+    this->log_message_(level, tag);
+  }
+  this->recursion_guard_ = false;
+
+  uint32_t dropped = this->async_buffer_.take_dropped();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Log buffer full, %u messages were dropped", dropped);
+}
+void Logger::flush_async_buffer_() {
+  if (!this->async_buffer_.is_initialized())
+    return;
+  this->shutting_down_ = true;
+  this->drain_async_buffer_();
+}
+void Logger::loop() { this->drain_async_buffer_(); }
+#endif
+
 int HOT Logger::level_for(const char *tag) {
   // Uses std::vector<> for low memory footprint, though the vector
   // could be sorted to minimize lookup times. This feature isn't used that
@@ -204,6 +362,11 @@ void Logger::pre_setup() {
 #endif
 
   global_logger = this;
+#ifdef USE_LOGGER_ASYNC
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+  if (this->async_buffer_size_ > 0)
+    this->async_buffer_.init(this->async_buffer_size_);
+#endif
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
   if (ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE) {
@@ -220,7 +383,15 @@ void Logger::set_log_level(const std::string &tag, int log_level) {
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
+#ifdef USE_LOGGER_BINARY
+  this->has_log_callbacks_ = true;
+#endif
+}
+#ifdef USE_LOGGER_BINARY
+void Logger::add_on_binary_log_callback(std::function<void(int, const uint8_t *, size_t)> &&callback) {
+  this->binary_log_callback_.add(std::move(callback));
 }
+#endif
 float Logger::get_setup_priority() const { return setup_priority::BUS + 500.0f; }
 const char *const LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DEBUG", "VERBOSE", "VERY_VERBOSE"};
 #ifdef USE_ESP32
@@ -234,6 +405,9 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
+#ifdef USE_LOGGER_ASYNC
+  ESP_LOGCONFIG(TAG, "  Async Buffer Size: %u", this->async_buffer_.get_size());
+#endif
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
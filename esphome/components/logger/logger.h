@@ -4,6 +4,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/log.h"
 #include <cstdarg>
 
 #ifdef USE_ARDUINO
@@ -12,6 +13,14 @@
 #ifdef USE_ESP_IDF
 #include <driver/uart.h>
 #endif
+#ifdef USE_LOGGER_ASYNC
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "log_ring_buffer.h"
+#endif
+#ifdef USE_LOGGER_BINARY
+#include "binary_log.h"
+#endif
 
 namespace esphome {
 
@@ -52,6 +61,15 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_ASYNC
+  /// Queue log messages in a buffer of this size and write them out from loop(), must be called before pre_setup().
+  void set_async_buffer_size(size_t async_buffer_size) { this->async_buffer_size_ = async_buffer_size; }
+  void loop() override;
+  /// Write out the queued messages before rebooting, and the ones logged by the rest of the shutdown right away.
+  void on_safe_shutdown() override { this->flush_async_buffer_(); }
+  void on_shutdown() override { this->flush_async_buffer_(); }
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -62,6 +80,12 @@ class Logger : public Component {
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+#ifdef USE_LOGGER_BINARY
+  /// Register a callback that receives log messages in the binary encoding of encode_binary_log().
+  void add_on_binary_log_callback(std::function<void(int, const uint8_t *, size_t)> &&callback);
+  /// Encode messages up to this level for the binary log callbacks, ESPHOME_LOG_LEVEL_NONE turns encoding off.
+  void set_binary_log_level(int level) { this->binary_log_level_ = level; }
+#endif
 
   float get_setup_priority() const override;
 
@@ -74,6 +98,22 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+#ifdef USE_LOGGER_BINARY
+  void log_binary_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Whether anything consumes formatted messages, otherwise only binary messages are produced.
+  bool needs_text_() const { return this->baud_rate_ > 0 || this->has_log_callbacks_; }
+#endif
+#ifdef USE_LOGGER_ASYNC
+  void log_async_(int level, const char *tag, int line, const char *format, va_list args);
+  LogRingBuffer::Record *reserve_record_(size_t len, bool main_task);
+  bool queue_text_(int level, const char *tag, int line, const char *format, va_list args, bool main_task);
+#ifdef USE_LOGGER_BINARY
+  bool queue_binary_(int level, const char *tag, int line, const char *format, va_list args, bool main_task);
+#endif
+  void drain_async_buffer_();
+  void flush_async_buffer_();
+  bool is_main_task_() const { return !xPortInIsrContext() && xTaskGetCurrentTaskHandle() == this->main_task_; }
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -130,8 +170,21 @@ class Logger : public Component {
   };
   std::vector<LogLevelOverride> log_levels_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+#ifdef USE_LOGGER_BINARY
+  CallbackManager<void(int, const uint8_t *, size_t)> binary_log_callback_{};
+  int binary_log_level_{ESPHOME_LOG_LEVEL_NONE};
+  bool has_log_callbacks_{false};
+#endif
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_ASYNC
+  size_t async_buffer_size_{0};
+  LogRingBuffer async_buffer_;
+  /// The task that runs loop(), the only one allowed to write out queued messages.
+  TaskHandle_t main_task_{nullptr};
+  /// The device is shutting down and loop() won't run again, messages of the main task are written out right away.
+  bool shutting_down_{false};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -44,6 +44,8 @@ from esphome.core import coroutine_with_priority, CORE
 DEPENDENCIES = ["network"]
 AUTO_LOAD = ["json", "async_tcp"]
 
+CONF_PUBLISH_QUEUE_SIZE = "publish_queue_size"
+
 
 def validate_message_just_topic(value):
     value = cv.publish_topic(value)
@@ -182,6 +184,7 @@ CONFIG_SCHEMA = cv.All(
                 cv.only_on_esp8266, cv.ensure_list(validate_fingerprint)
             ),
             cv.Optional(CONF_KEEPALIVE, default="15s"): cv.positive_time_period_seconds,
+            cv.Optional(CONF_PUBLISH_QUEUE_SIZE, default="2kB"): cv.validate_bytes,
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
@@ -298,6 +301,7 @@ async def to_code(config):
         cg.add_build_flag("-DASYNC_TCP_SSL_ENABLED=1")
 
     cg.add(var.set_keep_alive(config[CONF_KEEPALIVE]))
+    cg.add(var.set_publish_queue_size(config[CONF_PUBLISH_QUEUE_SIZE]))
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
 
@@ -55,6 +55,8 @@ void MQTTClientComponent::setup() {
     });
   }
 #endif
+  if (this->publish_queue_.get_capacity() != 0)
+    this->set_interval("publish_queue", 60000, [this]() { this->log_publish_queue_stats_(); });
 
   this->last_connected_ = millis();
   this->start_dnslookup_();
@@ -76,6 +78,9 @@ void MQTTClientComponent::dump_config() {
   if (!this->availability_.topic.empty()) {
     ESP_LOGCONFIG(TAG, "  Availability: '%s'", this->availability_.topic.c_str());
   }
+  if (this->publish_queue_.get_capacity() != 0) {
+    ESP_LOGCONFIG(TAG, "  Publish Queue Size: %zu bytes", this->publish_queue_.get_capacity());
+  }
 }
 bool MQTTClientComponent::can_proceed() { return this->is_connected(); }
 
@@ -258,6 +263,7 @@ void MQTTClientComponent::loop() {
     }
     ESP_LOGW(TAG, "MQTT Disconnected: %s.", LOG_STR_ARG(reason_s));
     this->disconnect_reason_.reset();
+    this->drop_publish_queue_();
   }
 
   const uint32_t now = millis();
@@ -278,8 +284,11 @@ void MQTTClientComponent::loop() {
       if (!this->mqtt_client_.connected()) {
         this->state_ = MQTT_CLIENT_DISCONNECTED;
         ESP_LOGW(TAG, "Lost MQTT Client connection!");
+        this->drop_publish_queue_();
         this->start_dnslookup_();
       } else {
+        this->flush_publish_queue_();
+
         if (!this->birth_message_.topic.empty() && !this->sent_birth_message_) {
           this->sent_birth_message_ = this->publish(this->birth_message_);
         }
@@ -341,6 +350,7 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.add(topic, this->subscriptions_.size());
   this->subscriptions_.push_back(subscription);
 }
 
@@ -356,6 +366,7 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_js
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.add(topic, this->subscriptions_.size());
   this->subscriptions_.push_back(subscription);
 }
 
@@ -377,6 +388,11 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
     else
       ++it;
   }
+
+  // The positions of the remaining subscriptions changed
+  this->subscription_trie_.clear();
+  for (size_t i = 0; i < this->subscriptions_.size(); i++)
+    this->subscription_trie_.add(this->subscriptions_[i].topic, i);
 }
 
 // Publish
@@ -391,13 +407,20 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
     return false;
   }
   bool logging_topic = topic == this->log_message_.topic;
-  uint16_t ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
-  delay(0);
-  if (ret == 0 && !logging_topic && this->is_connected()) {
-    delay(0);
+  uint16_t ret = 0;
+  // Publishing past queued messages would reorder them
+  if (this->publish_queue_.empty()) {
     ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
     delay(0);
+    if (ret == 0 && this->publish_queue_.get_capacity() == 0 && !logging_topic && this->is_connected()) {
+      delay(0);
+      ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
+      delay(0);
+    }
   }
+  // Log messages aren't states, each of them has to be sent
+  if (ret == 0 && this->publish_queue_.push(topic, payload, payload_length, qos, retain, !logging_topic))
+    return true;
 
   if (!logging_topic) {
     if (ret != 0) {
@@ -411,6 +434,35 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
   return ret != 0;
 }
 
+void MQTTClientComponent::flush_publish_queue_() {
+  this->publish_queue_.flush(millis(), [this](const MQTTQueuedPublish &queued) {
+    if (this->mqtt_client_.publish(queued.topic.c_str(), queued.qos, queued.retain, queued.payload.data(),
+                                   queued.payload.size()) == 0) {
+      // The TCP window is still full, try again in the next loop
+      return false;
+    }
+    delay(0);
+    return true;
+  });
+}
+void MQTTClientComponent::drop_publish_queue_() {
+  // Components send their full state again after reconnecting, publishes with QoS > 0 are kept
+  const uint32_t dropped = this->publish_queue_.drop_qos0();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u queued QoS 0 publishes, %zu are kept for the reconnect", dropped,
+             this->publish_queue_.size());
+}
+void MQTTClientComponent::log_publish_queue_stats_() {
+  const auto stats = this->publish_queue_.take_stats();
+  if (stats.dropped != 0) {
+    ESP_LOGW(TAG, "Publish queue: %u dropped, %u coalesced, max latency %u ms, %zu bytes in use", stats.dropped,
+             stats.coalesced, stats.max_latency, this->publish_queue_.get_memory());
+  } else if (stats.coalesced != 0 || stats.max_latency != 0 || !this->publish_queue_.empty()) {
+    ESP_LOGD(TAG, "Publish queue: %u coalesced, max latency %u ms, %zu bytes in use", stats.coalesced,
+             stats.max_latency, this->publish_queue_.get_memory());
+  }
+}
+
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
   return this->publish(message.topic, message.payload, message.qos, message.retain);
 }
@@ -420,62 +472,11 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json::jso
   const char *message = json::build_json(f, &len);
   return this->publish(topic, message, len, qos, retain);
 }
-
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
-}
-
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos,
+                                       bool retain) {
+  size_t len;
+  const char *message = json::write_json(f, &len);
+  return this->publish(topic, message, len, qos, retain);
 }
 
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
@@ -484,9 +485,11 @@ void MQTTClientComponent::on_message(const std::string &topic, const std::string
   // in an ISR.
   this->defer([this, topic, payload]() {
 #endif
-    for (auto &subscription : this->subscriptions_)
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
+    auto &matched = this->matched_subscriptions_;
+    matched.clear();
+    this->subscription_trie_.match(topic, matched);
+    for (uint16_t index : matched)
+      this->subscriptions_[index].callback(topic, payload);
 #ifdef USE_ESP8266
   });
 #endif
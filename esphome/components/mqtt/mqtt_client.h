@@ -8,7 +8,10 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/ip_address.h"
+#include "mqtt_publish_queue.h"
+#include "mqtt_topic_trie.h"
 #include <AsyncMqttClient.h>
 #include "lwip/ip_addr.h"
 
@@ -206,6 +209,21 @@ class MQTTClientComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
 
+  /** Send a JSON MQTT message that's streamed into the publish buffer, without building a JSON document first.
+   *
+   * @param topic The topic.
+   * @param f The function writing the members of the message.
+   * @param retain Whether to retain the message.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false);
+
+  /** Set the memory for publishes that don't fit into the TCP window right away, 0 disables the queue.
+   *
+   * Queued publishes are sent in order from loop() as soon as there's room again. A newer QoS 0 publish to a topic
+   * that's still queued replaces the queued payload. What happened to them is logged once a minute.
+   */
+  void set_publish_queue_size(size_t publish_queue_size) { this->publish_queue_.set_capacity(publish_queue_size); }
+
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
   void dump_config() override;
@@ -251,6 +269,12 @@ class MQTTClientComponent : public Component {
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
+  /// Send queued publishes until the TCP window is full.
+  void flush_publish_queue_();
+  /// Drop the queued QoS 0 publishes after the connection was lost.
+  void drop_publish_queue_();
+  /// Log the statistics of the publish queue if anything was queued since the last report.
+  void log_publish_queue_stats_();
 
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
@@ -276,6 +300,11 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  /// The topic filters of subscriptions_, indexed by their position in it.
+  MQTTTopicTrie subscription_trie_;
+  /// Reused for the matches of each incoming message.
+  std::vector<uint16_t> matched_subscriptions_;
+  MQTTPublishQueue publish_queue_;
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
   network::IPAddress ip_;
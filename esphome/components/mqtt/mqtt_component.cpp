@@ -27,16 +27,20 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
          "/" + suffix;
 }
 
-const std::string MQTTComponent::get_state_topic_() const {
-  if (this->custom_state_topic_.empty())
-    return this->get_default_topic_for_("state");
-  return this->custom_state_topic_;
+const std::string &MQTTComponent::get_state_topic_() const {
+  if (!this->custom_state_topic_.empty())
+    return this->custom_state_topic_;
+  if (this->default_state_topic_.empty())
+    this->default_state_topic_ = this->get_default_topic_for_("state");
+  return this->default_state_topic_;
 }
 
-const std::string MQTTComponent::get_command_topic_() const {
-  if (this->custom_command_topic_.empty())
-    return this->get_default_topic_for_("command");
-  return this->custom_command_topic_;
+const std::string &MQTTComponent::get_command_topic_() const {
+  if (!this->custom_command_topic_.empty())
+    return this->custom_command_topic_;
+  if (this->default_command_topic_.empty())
+    this->default_command_topic_ = this->get_default_topic_for_("command");
+  return this->default_command_topic_;
 }
 
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
@@ -51,6 +55,12 @@ bool MQTTComponent::publish_json(const std::string &topic, const json::json_buil
   return global_mqtt_client->publish_json(topic, f, 0, this->retain_);
 }
 
+bool MQTTComponent::publish_json(const std::string &topic, const json::json_write_t &f) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish_json(topic, f, 0, this->retain_);
+}
+
 bool MQTTComponent::send_discovery_() {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
 
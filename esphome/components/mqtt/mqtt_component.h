@@ -119,6 +119,13 @@ class MQTTComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f);
 
+  /** Send a JSON MQTT message that's streamed into the publish buffer.
+   *
+   * @param topic The topic.
+   * @param f The function writing the members of the message.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f);
+
   /** Subscribe to a MQTT topic.
    *
    * @param topic The topic. Wildcards are currently not supported.
@@ -170,11 +177,11 @@ class MQTTComponent : public Component {
   /// Get whether the underlying Entity is disabled by default
   virtual bool is_disabled_by_default() const;
 
-  /// Get the MQTT topic that new states will be shared to.
-  const std::string get_state_topic_() const;
+  /// Get the MQTT topic that new states will be shared to, built once and reused for every publish.
+  const std::string &get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
-  const std::string get_command_topic_() const;
+  const std::string &get_command_topic_() const;
 
   bool is_connected_() const;
 
@@ -189,6 +196,9 @@ class MQTTComponent : public Component {
  protected:
   std::string custom_state_topic_{};
   std::string custom_command_topic_{};
+  /// The default topics, built on first use.
+  mutable std::string default_state_topic_{};
+  mutable std::string default_command_topic_{};
   bool retain_{true};
   bool discovery_enabled_{true};
   std::unique_ptr<Availability> availability_;
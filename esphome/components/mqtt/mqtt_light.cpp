@@ -32,7 +32,7 @@ MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : MQTTComponen
 
 bool MQTTJSONLightComponent::publish_state_() {
   return this->publish_json(this->get_state_topic_(),
-                            [this](JsonObject &root) { LightJSONSchema::dump_json(*this->state_, root); });
+                            [this](json::JsonWriter &root) { LightJSONSchema::dump_json(*this->state_, root); });
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 
@@ -0,0 +1,74 @@
+#include "mqtt_publish_queue.h"
+
+#ifdef USE_MQTT
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace mqtt {
+
+bool MQTTPublishQueue::push(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
+                            bool retain, bool coalesce) {
+  if (this->capacity_ == 0)
+    return false;
+
+  if (qos == 0 && coalesce) {
+    for (auto &queued : this->queue_) {
+      if (queued.qos != 0 || queued.retain != retain || queued.topic != topic)
+        continue;
+      if (this->memory_ - queued.payload.size() + payload_length > this->capacity_)
+        break;
+      this->memory_ = this->memory_ - queued.payload.size() + payload_length;
+      queued.payload.assign(payload, payload_length);
+      this->coalesced_++;
+      return true;
+    }
+  }
+
+  const size_t size = sizeof(MQTTQueuedPublish) + topic.size() + payload_length;
+  if (this->memory_ + size > this->capacity_) {
+    this->dropped_++;
+    return false;
+  }
+  this->queue_.push_back(MQTTQueuedPublish{
+      .topic = topic,
+      .payload = std::string(payload, payload_length),
+      .qos = qos,
+      .retain = retain,
+      .queued_at = millis(),
+  });
+  this->memory_ += size;
+  return true;
+}
+
+uint32_t MQTTPublishQueue::drop_qos0() {
+  uint32_t dropped = 0;
+  for (auto it = this->queue_.begin(); it != this->queue_.end();) {
+    if (it->qos != 0) {
+      ++it;
+      continue;
+    }
+    this->memory_ -= memory_of_(*it);
+    it = this->queue_.erase(it);
+    dropped++;
+  }
+  this->dropped_ += dropped;
+  return dropped;
+}
+
+MQTTPublishQueueStats MQTTPublishQueue::take_stats() {
+  MQTTPublishQueueStats stats{
+      .dropped = this->dropped_,
+      .coalesced = this->coalesced_,
+      .max_latency = this->max_latency_,
+  };
+  this->dropped_ = 0;
+  this->coalesced_ = 0;
+  this->max_latency_ = 0;
+  return stats;
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
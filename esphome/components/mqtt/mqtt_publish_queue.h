@@ -0,0 +1,95 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace esphome {
+namespace mqtt {
+
+/// internal struct for publishes waiting for room in the TCP window.
+struct MQTTQueuedPublish {
+  std::string topic;
+  std::string payload;
+  uint8_t qos;
+  bool retain;
+  uint32_t queued_at;
+};
+
+/// What happened to the queued publishes since the statistics were last taken.
+struct MQTTPublishQueueStats {
+  /// Publishes dropped because the queue was full or the connection was lost.
+  uint32_t dropped;
+  /// Queued publishes that were replaced by a newer one to the same topic.
+  uint32_t coalesced;
+  /// The longest time a publish waited in the queue, in ms.
+  uint32_t max_latency;
+};
+
+/** Publishes that the MQTT client couldn't send because the TCP window was full, in the order they were made.
+ *
+ * The memory of the queued publishes is capped, publishes that don't fit are dropped. A QoS 0 publish to a topic that
+ * is still queued replaces the queued payload, since only the latest state of a topic matters.
+ */
+class MQTTPublishQueue {
+ public:
+  /// Set the memory for queued publishes in bytes, 0 disables the queue.
+  void set_capacity(size_t capacity) { this->capacity_ = capacity; }
+  size_t get_capacity() const { return this->capacity_; }
+
+  /** Queue a publish, returns false if it doesn't fit.
+   *
+   * @param coalesce Whether a QoS 0 publish may replace a queued one, false for messages that all have to be sent
+   * such as log messages.
+   */
+  bool push(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+            bool coalesce);
+
+  /// Send the queued publishes in order until `publish` returns false, e.g. because the TCP window is full again.
+  template<typename F> void flush(uint32_t now, F &&publish) {
+    while (!this->queue_.empty()) {
+      auto &queued = this->queue_.front();
+      if (!publish(queued))
+        break;
+      this->max_latency_ = std::max(this->max_latency_, now - queued.queued_at);
+      this->memory_ -= memory_of_(queued);
+      this->queue_.pop_front();
+    }
+  }
+
+  /** Drop the QoS 0 publishes after the connection was lost, returns how many were dropped.
+   *
+   * Components send their state again after reconnecting. QoS > 0 publishes stay queued and are sent once the client
+   * is connected again.
+   */
+  uint32_t drop_qos0();
+
+  bool empty() const { return this->queue_.empty(); }
+  size_t size() const { return this->queue_.size(); }
+  /// Bytes used by the queued publishes.
+  size_t get_memory() const { return this->memory_; }
+  /// Return the statistics and start counting again.
+  MQTTPublishQueueStats take_stats();
+
+ protected:
+  static size_t memory_of_(const MQTTQueuedPublish &queued) {
+    return sizeof(MQTTQueuedPublish) + queued.topic.size() + queued.payload.size();
+  }
+
+  std::deque<MQTTQueuedPublish> queue_;
+  size_t capacity_{0};
+  size_t memory_{0};
+  uint32_t dropped_{0};
+  uint32_t coalesced_{0};
+  uint32_t max_latency_{0};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,143 @@
+#include "mqtt_topic_trie.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+static int compare_level(const std::string &a, const char *b, size_t b_len) {
+  int cmp = memcmp(a.data(), b, std::min(a.size(), b_len));
+  if (cmp != 0)
+    return cmp;
+  if (a.size() == b_len)
+    return 0;
+  return a.size() < b_len ? -1 : 1;
+}
+
+MQTTTopicTrie::MQTTTopicTrie() { this->clear(); }
+
+void MQTTTopicTrie::clear() {
+  this->nodes_.clear();
+  // The root
+  this->nodes_.emplace_back();
+}
+
+void MQTTTopicTrie::add(const std::string &filter, uint16_t id) {
+  uint16_t node = 0;
+  size_t start = 0;
+  while (true) {
+    size_t end = filter.find('/', start);
+    if (end == std::string::npos)
+      end = filter.size();
+    const char *level = filter.data() + start;
+    size_t len = end - start;
+
+    if (len == 1 && *level == '#') {
+      // Only valid as the last level
+      this->nodes_[node].hash_ids.push_back(id);
+      return;
+    }
+
+    uint16_t child;
+    if (len == 1 && *level == '+') {
+      child = this->nodes_[node].plus_child;
+      if (child == NONE) {
+        child = this->nodes_.size();
+        this->nodes_.emplace_back();
+        this->nodes_.back().level = "+";
+        this->nodes_[node].plus_child = child;
+      }
+    } else {
+      child = this->find_child_(this->nodes_[node], level, len);
+      if (child == NONE) {
+        child = this->nodes_.size();
+        this->nodes_.emplace_back();
+        this->nodes_.back().level.assign(level, len);
+        auto &children = this->nodes_[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), child, [this](uint16_t a, uint16_t b) {
+          return this->nodes_[a].level < this->nodes_[b].level;
+        });
+        children.insert(it, child);
+      }
+    }
+    node = child;
+
+    if (end == filter.size())
+      break;
+    start = end + 1;
+  }
+  this->nodes_[node].ids.push_back(id);
+}
+
+uint16_t MQTTTopicTrie::find_child_(const Node &node, const char *level, size_t len) const {
+  size_t lo = 0;
+  size_t hi = node.children.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    uint16_t child = node.children[mid];
+    int cmp = compare_level(this->nodes_[child].level, level, len);
+    if (cmp == 0)
+      return child;
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return NONE;
+}
+
+void MQTTTopicTrie::match(const std::string &topic, std::vector<uint16_t> &matches) {
+  const size_t first_match = matches.size();
+  // Wildcards don't match the first level of topics like $SYS/...
+  const bool system_topic = !topic.empty() && topic[0] == '$';
+
+  this->active_.clear();
+  this->active_.push_back(0);
+  size_t start = 0;
+  while (!this->active_.empty()) {
+    size_t end = topic.find('/', start);
+    if (end == std::string::npos)
+      end = topic.size();
+    const char *level = topic.data() + start;
+    size_t len = end - start;
+    bool wildcards = start != 0 || !system_topic;
+
+    this->next_.clear();
+    for (uint16_t index : this->active_) {
+      const Node &node = this->nodes_[index];
+      if (wildcards) {
+        // '#' matches this and all remaining levels
+        matches.insert(matches.end(), node.hash_ids.begin(), node.hash_ids.end());
+        if (node.plus_child != NONE)
+          this->next_.push_back(node.plus_child);
+      }
+      uint16_t child = this->find_child_(node, level, len);
+      if (child != NONE)
+        this->next_.push_back(child);
+    }
+    std::swap(this->active_, this->next_);
+
+    if (end == topic.size())
+      break;
+    start = end + 1;
+  }
+
+  for (uint16_t index : this->active_) {
+    const Node &node = this->nodes_[index];
+    matches.insert(matches.end(), node.ids.begin(), node.ids.end());
+    // "a/#" also matches "a"
+    matches.insert(matches.end(), node.hash_ids.begin(), node.hash_ids.end());
+  }
+
+  // Call the subscriptions in the order they were made, like before
+  std::sort(matches.begin() + first_match, matches.end());
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
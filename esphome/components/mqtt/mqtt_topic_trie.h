@@ -0,0 +1,59 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Trie of MQTT subscription topic filters, split into levels at '/'.
+ *
+ * Finding the filters that match a topic walks the trie once per topic level instead of comparing the topic against
+ * every filter. Children are kept sorted by their level, so each step is a binary search. '+' and '#' follow the MQTT
+ * spec: '+' matches exactly one level, a trailing '#' matches any number of levels including none (so "a/#" also
+ * matches "a"), and neither matches a first level that starts with '$'.
+ */
+class MQTTTopicTrie {
+ public:
+  MQTTTopicTrie();
+
+  /// Add a topic filter, id is reported for every topic the filter matches.
+  void add(const std::string &filter, uint16_t id);
+  /// Remove all filters.
+  void clear();
+
+  /// Append the ids of all filters matching topic to matches, in ascending order.
+  void match(const std::string &topic, std::vector<uint16_t> &matches);
+
+ protected:
+  static const uint16_t NONE = 0xFFFF;
+
+  struct Node {
+    std::string level;
+    /// Indices into nodes_ of the child nodes except '+', sorted by their level.
+    std::vector<uint16_t> children;
+    uint16_t plus_child{NONE};
+    /// Ids of the filters that end at this node.
+    std::vector<uint16_t> ids;
+    /// Ids of the filters that end with a '#' level after this node.
+    std::vector<uint16_t> hash_ids;
+  };
+
+  /// The child of a node with this level, NONE if there's none.
+  uint16_t find_child_(const Node &node, const char *level, size_t len) const;
+
+  std::vector<Node> nodes_;
+  // Reused between matches, so that dispatching doesn't allocate
+  std::vector<uint16_t> active_;
+  std::vector<uint16_t> next_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -92,6 +92,9 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
     this->controller_->Show();
   }
 
+  // RMT, I2S and DMA methods send the frame in the background after Show()
+  bool is_show_done() override { return this->controller_->CanShow(); }
+
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   int32_t size() const override { return this->controller_->PixelCount(); }
@@ -125,6 +128,12 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  light::AddressableLightBuffer get_buffer_internal() const override {
+    light::AddressableLightBuffer buffer;
+    buffer.data = this->controller_->Pixels();
+    memcpy(buffer.offsets, this->rgb_offsets_, 4);
+    return buffer;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -142,6 +151,13 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  light::AddressableLightBuffer get_buffer_internal() const override {
+    light::AddressableLightBuffer buffer;
+    buffer.data = this->controller_->Pixels();
+    memcpy(buffer.offsets, this->rgb_offsets_, 4);
+    buffer.white = true;
+    return buffer;
+  }
 };
 
 }  // namespace neopixelbus
@@ -4,6 +4,9 @@
 namespace esphome {
 namespace ota {
 
+/// Passed to OTABackend::begin() when the size of the image is only known once it's complete.
+static const size_t OTA_IMAGE_SIZE_UNKNOWN = 0xFFFFFFFF;
+
 class OTABackend {
  public:
   virtual ~OTABackend() = default;
@@ -13,6 +16,11 @@ class OTABackend {
   virtual OTAResponseTypes end() = 0;
   virtual void abort() = 0;
   virtual bool supports_compression() = 0;
+  /// Read from the image of the running firmware, false if that's not possible.
+  virtual bool read_running_image(size_t offset, uint8_t *data, size_t len) { return false; }
+  /// Bytes of the image written so far, may be called from another task while write() runs. Backends where a single
+  /// write() can take long report it, so that the OTA writer doesn't time out while they make progress.
+  virtual size_t get_bytes_written() { return 0; }
 };
 
 }  // namespace ota
@@ -6,12 +6,14 @@
 #include "ota_backend.h"
 
 #include <Update.h>
+#include <esp_ota_ops.h>
 
 namespace esphome {
 namespace ota {
 
 OTAResponseTypes ArduinoESP32OTABackend::begin(size_t image_size) {
-  bool ret = Update.begin(image_size, U_FLASH);
+  this->size_unknown_ = image_size == OTA_IMAGE_SIZE_UNKNOWN;
+  bool ret = Update.begin(this->size_unknown_ ? UPDATE_SIZE_UNKNOWN : image_size, U_FLASH);
   if (ret) {
     return OTA_RESPONSE_OK;
   }
@@ -33,13 +35,19 @@ OTAResponseTypes ArduinoESP32OTABackend::write(uint8_t *data, size_t len) {
 }
 
 OTAResponseTypes ArduinoESP32OTABackend::end() {
-  if (!Update.end())
+  // Without a size, Update can't tell whether the image is complete
+  if (!Update.end(this->size_unknown_))
     return OTA_RESPONSE_ERROR_UPDATE_END;
   return OTA_RESPONSE_OK;
 }
 
 void ArduinoESP32OTABackend::abort() { Update.abort(); }
 
+bool ArduinoESP32OTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  return running != nullptr && esp_partition_read(running, offset, data, len) == ESP_OK;
+}
+
 }  // namespace ota
 }  // namespace esphome
 
@@ -16,6 +16,10 @@ class ArduinoESP32OTABackend : public OTABackend {
   OTAResponseTypes end() override;
   void abort() override;
   bool supports_compression() override { return false; }
+  bool read_running_image(size_t offset, uint8_t *data, size_t len) override;
+
+ protected:
+  bool size_unknown_{false};
 };
 
 }  // namespace ota
@@ -14,6 +14,11 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
   if (this->partition_ == nullptr) {
     return OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION;
   }
+#ifdef OTA_WITH_SEQUENTIAL_WRITES
+  // Erase the flash as the image is written instead of erasing the whole partition up front
+  if (image_size == OTA_IMAGE_SIZE_UNKNOWN)
+    image_size = OTA_WITH_SEQUENTIAL_WRITES;
+#endif
   esp_err_t err = esp_ota_begin(this->partition_, image_size, &this->update_handle_);
   if (err != ESP_OK) {
     esp_ota_abort(this->update_handle_);
@@ -26,14 +31,19 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
     return OTA_RESPONSE_ERROR_UNKNOWN;
   }
   this->md5_.init();
+  this->check_md5_ = false;
   return OTA_RESPONSE_OK;
 }
 
-void IDFOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
+void IDFOTABackend::set_update_md5(const char *expected_md5) {
+  memcpy(this->expected_bin_md5_, expected_md5, 32);
+  this->check_md5_ = true;
+}
 
 OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
   esp_err_t err = esp_ota_write(this->update_handle_, data, len);
-  this->md5_.add(data, len);
+  if (this->check_md5_)
+    this->md5_.add(data, len);
   if (err != ESP_OK) {
     if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
       return OTA_RESPONSE_ERROR_MAGIC;
@@ -46,10 +56,12 @@ OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
 }
 
 OTAResponseTypes IDFOTABackend::end() {
-  this->md5_.calculate();
-  if (!this->md5_.equals_hex(this->expected_bin_md5_)) {
-    this->abort();
-    return OTA_RESPONSE_ERROR_UPDATE_END;
+  if (this->check_md5_) {
+    this->md5_.calculate();
+    if (!this->md5_.equals_hex(this->expected_bin_md5_)) {
+      this->abort();
+      return OTA_RESPONSE_ERROR_UPDATE_END;
+    }
   }
   esp_err_t err = esp_ota_end(this->update_handle_);
   this->update_handle_ = 0;
@@ -73,6 +85,11 @@ void IDFOTABackend::abort() {
   this->update_handle_ = 0;
 }
 
+bool IDFOTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  return running != nullptr && esp_partition_read(running, offset, data, len) == ESP_OK;
+}
+
 }  // namespace ota
 }  // namespace esphome
 #endif
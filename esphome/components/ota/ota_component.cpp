@@ -3,6 +3,8 @@
 #include "ota_backend_arduino_esp32.h"
 #include "ota_backend_arduino_esp8266.h"
 #include "ota_backend_esp_idf.h"
+#include "ota_decoder.h"
+#include "ota_writer.h"
 
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
@@ -20,6 +22,10 @@ namespace ota {
 static const char *const TAG = "ota";
 
 static const uint8_t OTA_VERSION_1_0 = 1;
+/// How long to wait for more data of the image, in ms.
+static const uint32_t OTA_RECEIVE_TIMEOUT = 10000;
+/// How long the flash writes may make no progress before the update fails, in ms.
+static const uint32_t OTA_WRITE_TIMEOUT = 10000;
 
 std::unique_ptr<OTABackend> make_ota_backend() {
 #ifdef USE_ARDUINO
@@ -27,11 +33,11 @@ std::unique_ptr<OTABackend> make_ota_backend() {
   return make_unique<ArduinoESP8266OTABackend>();
 #endif  // USE_ESP8266
 #ifdef USE_ESP32
-  return make_unique<ArduinoESP32OTABackend>();
+  return make_unique<DecodingOTABackend>(make_unique<ArduinoESP32OTABackend>());
 #endif  // USE_ESP32
 #endif  // USE_ARDUINO
 #ifdef USE_ESP_IDF
-  return make_unique<IDFOTABackend>();
+  return make_unique<DecodingOTABackend>(make_unique<IDFOTABackend>());
 #endif  // USE_ESP_IDF
 }
 
@@ -74,6 +80,7 @@ void OTAComponent::setup() {
     this->mark_failed();
     return;
   }
+  App.register_wake_socket(server_->get_fd());
 
   this->dump_config();
 }
@@ -81,6 +88,7 @@ void OTAComponent::setup() {
 void OTAComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Over-The-Air Updates:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %zu", this->buffer_size_);
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
     ESP_LOGCONFIG(TAG, "  Using Password.");
@@ -109,9 +117,7 @@ static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
-  size_t total = 0;
-  uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
   size_t ota_size;
   uint8_t ota_features;
@@ -271,46 +277,9 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
-  while (total < ota_size) {
-    // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
-    if (read == -1) {
-      if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        App.feed_wdt();
-        delay(1);
-        continue;
-      }
-      ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    } else if (read == 0) {
-      // $ man recv
-      // "When  a  stream socket peer has performed an orderly shutdown, the return value will
-      // be 0 (the traditional "end-of-file" return)."
-      ESP_LOGW(TAG, "Remote end closed connection");
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
-
-    error_code = backend->write(buf, read);
-    if (error_code != OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!");
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
-    total += read;
-
-    uint32_t now = millis();
-    if (now - last_progress > 1000) {
-      last_progress = now;
-      float percentage = (total * 100.0f) / ota_size;
-      ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
-#ifdef USE_OTA_STATE_CALLBACK
-      this->state_callback_.call(OTA_IN_PROGRESS, percentage, 0);
-#endif
-      // feed watchdog and give other tasks a chance to run
-      App.feed_wdt();
-      yield();
-    }
-  }
+  error_code = this->receive_image_(backend.get(), ota_size);
+  if (error_code != OTA_RESPONSE_OK)
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
 
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
@@ -359,13 +328,96 @@ error:
 #endif
 }
 
+OTAResponseTypes OTAComponent::receive_image_(OTABackend *backend, size_t ota_size) {
+  OTAWriter writer;
+  if (!writer.begin(backend, std::min(this->buffer_size_, ota_size)))
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+
+  const uint32_t start = millis();
+  uint32_t last_data = start;
+  uint32_t last_progress = start;
+  uint32_t receive_wait = 0;
+  size_t total = 0;
+  while (total < ota_size) {
+    // With a pipelined writer, the previous chunk is written to flash while this one is being received
+    uint8_t *chunk = writer.get_buffer(OTA_WRITE_TIMEOUT);
+    if (chunk == nullptr) {
+      ESP_LOGW(TAG, "Timed out writing binary data to flash!");
+      return OTA_RESPONSE_ERROR_WRITING_FLASH;
+    }
+    const size_t requested = std::min(writer.get_chunk_size(), ota_size - total);
+    size_t filled = 0;
+    while (filled < requested) {
+      ssize_t read = this->client_->read(chunk + filled, requested - filled);
+      if (read == -1) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
+          return OTA_RESPONSE_ERROR_UNKNOWN;
+        }
+        const uint32_t now = millis();
+        if (now - last_data > OTA_RECEIVE_TIMEOUT) {
+          ESP_LOGW(TAG, "Timed out receiving data for update");
+          return OTA_RESPONSE_ERROR_UNKNOWN;
+        }
+        App.feed_wdt();
+        delay(1);
+        receive_wait += millis() - now;
+        continue;
+      } else if (read == 0) {
+        // $ man recv
+        // "When  a  stream socket peer has performed an orderly shutdown, the return value will
+        // be 0 (the traditional "end-of-file" return)."
+        ESP_LOGW(TAG, "Remote end closed connection");
+        return OTA_RESPONSE_ERROR_UNKNOWN;
+      }
+      filled += read;
+      last_data = millis();
+    }
+
+    OTAResponseTypes error_code = writer.write(filled);
+    if (error_code != OTA_RESPONSE_OK) {
+      ESP_LOGW(TAG, "Error writing binary data to flash!");
+      return error_code;
+    }
+    total += filled;
+
+    uint32_t now = millis();
+    if (now - last_progress > 1000) {
+      last_progress = now;
+      float percentage = (total * 100.0f) / ota_size;
+      // Bytes per millisecond are close enough to kB/s
+      ESP_LOGD(TAG, "OTA in progress: %0.1f%%, %zu kB/s", percentage, total / (now - start));
+#ifdef USE_OTA_STATE_CALLBACK
+      this->state_callback_.call(OTA_IN_PROGRESS, percentage, 0);
+#endif
+      // feed watchdog and give other tasks a chance to run
+      App.feed_wdt();
+      yield();
+    }
+  }
+
+  OTAResponseTypes error_code = writer.finish(OTA_WRITE_TIMEOUT);
+  if (error_code != OTA_RESPONSE_OK) {
+    ESP_LOGW(TAG, "Error writing binary data to flash!");
+    return error_code;
+  }
+
+  const uint32_t duration = std::max<uint32_t>(millis() - start, 1);
+  ESP_LOGI(TAG, "Received %zu bytes in %ums (%zu kB/s)", ota_size, duration, ota_size / duration);
+  ESP_LOGD(TAG, "  Waited %ums for data and %ums for flash writes (%s)", receive_wait, writer.get_wait_time() / 1000,
+           writer.is_pipelined() ? "pipelined" : "synchronous");
+  ESP_LOGD(TAG, "  Writes took %ums in total, %ums at most", writer.get_write_time() / 1000,
+           writer.get_max_write_time() / 1000);
+  return OTA_RESPONSE_OK;
+}
+
 bool OTAComponent::readall_(uint8_t *buf, size_t len) {
   uint32_t start = millis();
   uint32_t at = 0;
   while (len - at > 0) {
     uint32_t now = millis();
     if (now - start > 1000) {
-      ESP_LOGW(TAG, "Timed out reading %d bytes of data", len);
+      ESP_LOGW(TAG, "Timed out reading %zu bytes of data", len);
       return false;
     }
 
@@ -376,7 +428,7 @@ bool OTAComponent::readall_(uint8_t *buf, size_t len) {
         delay(1);
         continue;
       }
-      ESP_LOGW(TAG, "Failed to read %d bytes of data, errno: %d", len, errno);
+      ESP_LOGW(TAG, "Failed to read %zu bytes of data, errno: %d", len, errno);
       return false;
     } else if (read == 0) {
       ESP_LOGW(TAG, "Remote closed connection");
@@ -396,7 +448,7 @@ bool OTAComponent::writeall_(const uint8_t *buf, size_t len) {
   while (len - at > 0) {
     uint32_t now = millis();
     if (now - start > 1000) {
-      ESP_LOGW(TAG, "Timed out writing %d bytes of data", len);
+      ESP_LOGW(TAG, "Timed out writing %zu bytes of data", len);
       return false;
     }
 
@@ -407,7 +459,7 @@ bool OTAComponent::writeall_(const uint8_t *buf, size_t len) {
         delay(1);
         continue;
       }
-      ESP_LOGW(TAG, "Failed to write %d bytes of data, errno: %d", len, errno);
+      ESP_LOGW(TAG, "Failed to write %zu bytes of data, errno: %d", len, errno);
       return false;
     } else {
       at += written;
@@ -421,6 +473,7 @@ bool OTAComponent::writeall_(const uint8_t *buf, size_t len) {
 float OTAComponent::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
 uint16_t OTAComponent::get_port() const { return this->port_; }
 void OTAComponent::set_port(uint16_t port) { this->port_ = port; }
+void OTAComponent::set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
 
 void OTAComponent::set_safe_mode_pending(const bool &pending) {
   if (!this->has_safe_mode_)
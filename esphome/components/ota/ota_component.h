@@ -32,11 +32,15 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
   OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION = 138,
+  OTA_RESPONSE_ERROR_WRONG_DELTA_BASE = 139,
+  OTA_RESPONSE_ERROR_INVALID_IMAGE = 140,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
 enum OTAState { OTA_COMPLETED = 0, OTA_STARTED, OTA_IN_PROGRESS, OTA_ERROR };
 
+class OTABackend;
+
 /// OTAComponent provides a simple way to integrate Over-the-Air updates into your app using ArduinoOTA.
 class OTAComponent : public Component {
  public:
@@ -46,6 +50,8 @@ class OTAComponent : public Component {
 
   /// Manually set the port OTA should listen on.
   void set_port(uint16_t port);
+  /// Set the size of the chunks the image is received and written to flash in.
+  void set_buffer_size(size_t buffer_size);
 
   bool should_enter_safe_mode(uint8_t num_attempts, uint32_t enable_time);
 
@@ -75,6 +81,8 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
+  /// Receive the image and write it to the backend.
+  OTAResponseTypes receive_image_(OTABackend *backend, size_t ota_size);
   bool readall_(uint8_t *buf, size_t len);
   bool writeall_(const uint8_t *buf, size_t len);
 
@@ -83,6 +91,7 @@ class OTAComponent : public Component {
 #endif  // USE_OTA_PASSWORD
 
   uint16_t port_;
+  size_t buffer_size_{1024};
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
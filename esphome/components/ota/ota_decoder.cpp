@@ -0,0 +1,443 @@
+#include "ota_decoder.h"
+#ifdef USE_ESP32
+
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef USE_ESP_IDF
+#include "esp32/rom/crc.h"
+#endif
+
+#ifdef USE_ARDUINO
+#include "rom/crc.h"
+#endif
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.decoder";
+
+static const uint8_t GZIP_FLAG_HEADER_CRC = 0x02;
+static const uint8_t GZIP_FLAG_EXTRA = 0x04;
+static const uint8_t GZIP_FLAG_NAME = 0x08;
+static const uint8_t GZIP_FLAG_COMMENT = 0x10;
+static const uint8_t DELTA_MAGIC[4] = {'E', 'S', 'P', 'D'};
+static const uint8_t DELTA_VERSION = 1;
+
+static uint32_t read_le32(const uint8_t *data) {
+  return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+OTAResponseTypes DecodingOTABackend::begin(size_t image_size) {
+  this->error_ = OTA_RESPONSE_OK;
+  this->check_md5_ = false;
+  this->md5_.init();
+  this->gzip_state_ = GzipState::DETECT;
+  this->content_state_ = ContentState::DETECT;
+  this->header_len_ = 0;
+  this->written_ = 0;
+  // The size of the decoded image isn't known yet
+  return this->backend_->begin(OTA_IMAGE_SIZE_UNKNOWN);
+}
+
+bool DecodingOTABackend::supports_compression() {
+  if (!this->allocate_inflator_()) {
+    ESP_LOGW(TAG, "Not enough memory to decompress, asking for an uncompressed image");
+    return false;
+  }
+  return true;
+}
+
+void DecodingOTABackend::set_update_md5(const char *md5) {
+  memcpy(this->expected_md5_, md5, 32);
+  this->check_md5_ = true;
+}
+
+OTAResponseTypes DecodingOTABackend::write(uint8_t *data, size_t len) {
+  this->md5_.add(data, len);
+  while (len > 0 && this->error_ == OTA_RESPONSE_OK) {
+    size_t used = 1;
+    switch (this->gzip_state_) {
+      case GzipState::DETECT:
+        if (data[0] == 0x1F) {
+          if (!this->allocate_inflator_()) {
+            ESP_LOGW(TAG, "Not enough memory to decompress the image");
+            this->error_ = OTA_RESPONSE_ERROR_UNKNOWN;
+            break;
+          }
+          tinfl_init(this->inflator_.get());
+          this->dict_pos_ = 0;
+          this->gzip_crc_ = 0;
+          this->gzip_size_ = 0;
+          this->gzip_pos_ = 0;
+          this->gzip_state_ = GzipState::HEADER;
+        } else {
+          // Not needed after all
+          this->free_inflator_();
+          this->gzip_state_ = GzipState::NONE;
+        }
+        // The byte is handled in the new state
+        continue;
+      case GzipState::NONE:
+        used = len;
+        this->write_decoded_(data, len);
+        break;
+      case GzipState::INFLATE:
+        used = this->inflate_(data, len);
+        break;
+      case GzipState::TRAILER:
+        if (this->gzip_pos_ == sizeof(this->gzip_trailer_)) {
+          ESP_LOGW(TAG, "Unexpected data after the compressed image");
+          this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+          break;
+        }
+        this->gzip_trailer_[this->gzip_pos_++] = data[0];
+        break;
+      default:
+        this->parse_gzip_header_(data[0]);
+        break;
+    }
+    data += used;
+    len -= used;
+  }
+  return this->error_;
+}
+
+void DecodingOTABackend::parse_gzip_header_(uint8_t c) {
+  switch (this->gzip_state_) {
+    case GzipState::HEADER:
+      // ID1 ID2 CM FLG MTIME(4) XFL OS
+      if ((this->gzip_pos_ == 1 && c != 0x8B) || (this->gzip_pos_ == 2 && c != 8)) {
+        ESP_LOGW(TAG, "Invalid gzip header");
+        this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+        return;
+      }
+      if (this->gzip_pos_ == 3)
+        this->gzip_flags_ = c;
+      if (++this->gzip_pos_ == 10)
+        this->next_gzip_field_();
+      break;
+    case GzipState::EXTRA_LENGTH:
+      this->gzip_skip_ |= uint16_t(c) << (8 * this->gzip_pos_);
+      if (++this->gzip_pos_ == 2) {
+        this->gzip_state_ = GzipState::EXTRA;
+        if (this->gzip_skip_ == 0)
+          this->next_gzip_field_();
+      }
+      break;
+    case GzipState::EXTRA:
+      if (--this->gzip_skip_ == 0)
+        this->next_gzip_field_();
+      break;
+    case GzipState::NAME:
+    case GzipState::COMMENT:
+      if (c == 0)
+        this->next_gzip_field_();
+      break;
+    case GzipState::HEADER_CRC:
+      if (++this->gzip_pos_ == 2)
+        this->next_gzip_field_();
+      break;
+    default:
+      break;
+  }
+}
+
+void DecodingOTABackend::next_gzip_field_() {
+  this->gzip_pos_ = 0;
+  this->gzip_skip_ = 0;
+  if (this->gzip_flags_ & GZIP_FLAG_EXTRA) {
+    this->gzip_flags_ &= ~GZIP_FLAG_EXTRA;
+    this->gzip_state_ = GzipState::EXTRA_LENGTH;
+  } else if (this->gzip_flags_ & GZIP_FLAG_NAME) {
+    this->gzip_flags_ &= ~GZIP_FLAG_NAME;
+    this->gzip_state_ = GzipState::NAME;
+  } else if (this->gzip_flags_ & GZIP_FLAG_COMMENT) {
+    this->gzip_flags_ &= ~GZIP_FLAG_COMMENT;
+    this->gzip_state_ = GzipState::COMMENT;
+  } else if (this->gzip_flags_ & GZIP_FLAG_HEADER_CRC) {
+    this->gzip_flags_ &= ~GZIP_FLAG_HEADER_CRC;
+    this->gzip_state_ = GzipState::HEADER_CRC;
+  } else {
+    this->gzip_state_ = GzipState::INFLATE;
+  }
+}
+
+bool DecodingOTABackend::allocate_inflator_() {
+  if (this->inflator_ == nullptr)
+    this->inflator_.reset(new (std::nothrow) tinfl_decompressor);  // NOLINT
+  if (this->dict_ == nullptr)
+    this->dict_.reset(new (std::nothrow) uint8_t[TINFL_LZ_DICT_SIZE]);  // NOLINT
+  if (this->inflator_ == nullptr || this->dict_ == nullptr) {
+    this->free_inflator_();
+    return false;
+  }
+  return true;
+}
+
+size_t DecodingOTABackend::inflate_(const uint8_t *data, size_t len) {
+  size_t in_size = len;
+  // The dictionary is a ring buffer, tinfl writes up to its end and then continues at the start
+  size_t out_size = TINFL_LZ_DICT_SIZE - this->dict_pos_;
+  uint8_t *out = this->dict_.get() + this->dict_pos_;
+  tinfl_status status = tinfl_decompress(this->inflator_.get(), data, &in_size, this->dict_.get(), out, &out_size,
+                                         TINFL_FLAG_HAS_MORE_INPUT);
+  if (out_size > 0) {
+    this->gzip_crc_ = crc32_le(this->gzip_crc_, out, out_size);
+    this->gzip_size_ += out_size;
+    this->dict_pos_ = (this->dict_pos_ + out_size) & (TINFL_LZ_DICT_SIZE - 1);
+    this->write_decoded_(out, out_size);
+  }
+  if (status == TINFL_STATUS_DONE) {
+    // tinfl reads ahead and counts the bytes after the deflate stream as used: the first bytes of the trailer are in
+    // its bit buffer, after the unused bits of the last byte of the stream
+    const tinfl_decompressor *inflator = this->inflator_.get();
+    tinfl_bit_buf_t bit_buf = inflator->m_bit_buf >> (inflator->m_num_bits & 7);
+    this->gzip_pos_ = 0;
+    for (uint32_t bytes = inflator->m_num_bits / 8; bytes > 0; bytes--) {
+      if (this->gzip_pos_ == sizeof(this->gzip_trailer_)) {
+        ESP_LOGW(TAG, "Unexpected data after the compressed image");
+        this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+        break;
+      }
+      this->gzip_trailer_[this->gzip_pos_++] = bit_buf & 0xFF;
+      bit_buf >>= 8;
+    }
+    this->free_inflator_();
+    this->gzip_state_ = GzipState::TRAILER;
+  } else if (status < TINFL_STATUS_DONE) {
+    ESP_LOGW(TAG, "Invalid compressed data (%d)", status);
+    this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+  }
+  return in_size;
+}
+
+void DecodingOTABackend::write_decoded_(const uint8_t *data, size_t len) {
+  while (len > 0 && this->error_ == OTA_RESPONSE_OK) {
+    size_t used = 1;
+    switch (this->content_state_) {
+      case ContentState::DETECT:
+        this->header_[this->header_len_++] = data[0];
+        if (this->header_len_ == sizeof(DELTA_MAGIC)) {
+          if (memcmp(this->header_, DELTA_MAGIC, sizeof(DELTA_MAGIC)) == 0) {
+            this->content_state_ = ContentState::DELTA_HEADER;
+          } else {
+            this->content_state_ = ContentState::IMAGE;
+            this->write_image_(this->header_, this->header_len_);
+          }
+        }
+        break;
+      case ContentState::IMAGE:
+        used = len;
+        this->write_image_(data, len);
+        break;
+      case ContentState::DELTA_HEADER:
+        this->header_[this->header_len_++] = data[0];
+        if (this->header_len_ == DELTA_HEADER_SIZE)
+          this->parse_delta_header_();
+        break;
+      case ContentState::DELTA_OPCODE:
+        this->op_ = data[0];
+        if (this->op_ > DELTA_OP_ADD) {
+          ESP_LOGW(TAG, "Invalid delta operation %u", this->op_);
+          this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+          break;
+        }
+        this->op_field_ = 0;
+        this->op_args_[0] = this->op_args_[1] = 0;
+        this->varint_shift_ = 0;
+        this->content_state_ = ContentState::DELTA_VARINT;
+        break;
+      case ContentState::DELTA_VARINT:
+        // The 5th byte only has the top 4 bits of a 32 bit value left, anything else would be cut off silently
+        if (this->varint_shift_ == 28 && data[0] > 0x0F) {
+          ESP_LOGW(TAG, "Invalid delta operation");
+          this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+          break;
+        }
+        this->op_args_[this->op_field_] |= uint32_t(data[0] & 0x7F) << this->varint_shift_;
+        this->varint_shift_ += 7;
+        if ((data[0] & 0x80) == 0) {
+          this->varint_shift_ = 0;
+          // DATA only has a length, COPY and ADD an offset and a length
+          if (++this->op_field_ == (this->op_ == DELTA_OP_DATA ? 1 : 2))
+            this->start_delta_op_();
+        }
+        break;
+      case ContentState::DELTA_DATA:
+        used = std::min(len, this->op_remaining_);
+        this->write_image_(data, used);
+        this->op_remaining_ -= used;
+        if (this->op_remaining_ == 0)
+          this->content_state_ = ContentState::DELTA_OPCODE;
+        break;
+      case ContentState::DELTA_ADD:
+        used = std::min(std::min(len, this->op_remaining_), sizeof(this->scratch_));
+        this->copy_running_(used, data);
+        this->op_remaining_ -= used;
+        if (this->op_remaining_ == 0)
+          this->content_state_ = ContentState::DELTA_OPCODE;
+        break;
+      case ContentState::DELTA_DONE:
+        ESP_LOGW(TAG, "Unexpected data after the delta patch");
+        this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+        break;
+    }
+    data += used;
+    len -= used;
+    if (this->content_state_ == ContentState::DELTA_OPCODE && this->written_ == this->image_size_)
+      this->content_state_ = ContentState::DELTA_DONE;
+  }
+}
+
+void DecodingOTABackend::parse_delta_header_() {
+  const uint8_t *header = this->header_ + sizeof(DELTA_MAGIC);
+  if (header[0] != DELTA_VERSION) {
+    ESP_LOGW(TAG, "Unsupported delta patch version %u", header[0]);
+    this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+    return;
+  }
+  this->base_size_ = read_le32(header + 1);
+  const uint8_t *base_md5 = header + 5;
+  this->image_size_ = read_le32(header + 21);
+  memcpy(this->image_md5_expected_, header + 25, 16);
+  ESP_LOGD(TAG, "Applying a delta patch against %u bytes of the running image, creating %u bytes",
+           this->base_size_, this->image_size_);
+
+  // The patch only makes sense against the image it was created from
+  md5::MD5Digest base{};
+  base.init();
+  for (size_t offset = 0; offset < this->base_size_; offset += sizeof(this->scratch_)) {
+    size_t len = std::min(this->base_size_ - offset, sizeof(this->scratch_));
+    if (!this->backend_->read_running_image(offset, this->scratch_, len)) {
+      ESP_LOGW(TAG, "Could not read the running image");
+      this->error_ = OTA_RESPONSE_ERROR_WRONG_DELTA_BASE;
+      return;
+    }
+    base.add(this->scratch_, len);
+  }
+  base.calculate();
+  if (!base.equals_bytes(base_md5)) {
+    ESP_LOGW(TAG, "The delta patch was not created from the running firmware");
+    this->error_ = OTA_RESPONSE_ERROR_WRONG_DELTA_BASE;
+    return;
+  }
+
+  this->image_md5_.init();
+  this->content_state_ = this->image_size_ == 0 ? ContentState::DELTA_DONE : ContentState::DELTA_OPCODE;
+}
+
+void DecodingOTABackend::start_delta_op_() {
+  if (this->op_ == DELTA_OP_DATA) {
+    this->op_remaining_ = this->op_args_[0];
+    this->content_state_ = this->op_remaining_ == 0 ? ContentState::DELTA_OPCODE : ContentState::DELTA_DATA;
+    return;
+  }
+  this->op_offset_ = this->op_args_[0];
+  this->op_remaining_ = this->op_args_[1];
+  if (this->op_offset_ > this->base_size_ || this->op_remaining_ > this->base_size_ - this->op_offset_) {
+    ESP_LOGW(TAG, "Delta operation reads past the end of the running image");
+    this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+    return;
+  }
+  if (this->op_ == DELTA_OP_ADD) {
+    this->content_state_ = this->op_remaining_ == 0 ? ContentState::DELTA_OPCODE : ContentState::DELTA_ADD;
+    return;
+  }
+  while (this->op_remaining_ > 0 && this->error_ == OTA_RESPONSE_OK) {
+    size_t len = std::min(this->op_remaining_, sizeof(this->scratch_));
+    this->copy_running_(len, nullptr);
+    this->op_remaining_ -= len;
+  }
+  this->content_state_ = ContentState::DELTA_OPCODE;
+}
+
+void DecodingOTABackend::copy_running_(size_t len, const uint8_t *add) {
+  if (!this->backend_->read_running_image(this->op_offset_, this->scratch_, len)) {
+    ESP_LOGW(TAG, "Could not read the running image");
+    this->error_ = OTA_RESPONSE_ERROR_UNKNOWN;
+    return;
+  }
+  if (add != nullptr) {
+    for (size_t i = 0; i < len; i++)
+      this->scratch_[i] += add[i];
+  }
+  this->op_offset_ += len;
+  this->write_image_(this->scratch_, len);
+}
+
+void DecodingOTABackend::write_image_(const uint8_t *data, size_t len) {
+  if (this->content_state_ != ContentState::IMAGE) {
+    if (len > this->image_size_ - this->written_) {
+      ESP_LOGW(TAG, "Delta patch creates more than %u bytes", this->image_size_);
+      this->error_ = OTA_RESPONSE_ERROR_INVALID_IMAGE;
+      return;
+    }
+    this->image_md5_.add(data, len);
+  }
+  this->written_ += len;
+  this->error_ = this->backend_->write(const_cast<uint8_t *>(data), len);
+}
+
+OTAResponseTypes DecodingOTABackend::end() {
+  if (this->error_ != OTA_RESPONSE_OK)
+    return this->error_;
+
+  if ((this->gzip_state_ != GzipState::NONE && this->gzip_state_ != GzipState::TRAILER &&
+       this->gzip_state_ != GzipState::DETECT) ||
+      (this->gzip_state_ == GzipState::TRAILER && this->gzip_pos_ != sizeof(this->gzip_trailer_))) {
+    ESP_LOGW(TAG, "Compressed image is incomplete");
+    return OTA_RESPONSE_ERROR_INVALID_IMAGE;
+  }
+  if (this->gzip_state_ == GzipState::TRAILER &&
+      (read_le32(this->gzip_trailer_) != this->gzip_crc_ || read_le32(this->gzip_trailer_ + 4) != this->gzip_size_)) {
+    ESP_LOGW(TAG, "CRC or size of the decompressed image don't match");
+    return OTA_RESPONSE_ERROR_INVALID_IMAGE;
+  }
+
+  if (this->content_state_ == ContentState::DETECT) {
+    // Images shorter than the magic of a patch won't boot, but that's for the backend to decide
+    this->content_state_ = ContentState::IMAGE;
+    this->write_image_(this->header_, this->header_len_);
+    if (this->error_ != OTA_RESPONSE_OK)
+      return this->error_;
+  } else if (this->content_state_ != ContentState::IMAGE && this->content_state_ != ContentState::DELTA_DONE) {
+    ESP_LOGW(TAG, "Delta patch is incomplete");
+    return OTA_RESPONSE_ERROR_INVALID_IMAGE;
+  }
+
+  if (this->check_md5_) {
+    this->md5_.calculate();
+    if (!this->md5_.equals_hex(this->expected_md5_)) {
+      ESP_LOGW(TAG, "MD5 of the received data doesn't match");
+      return OTA_RESPONSE_ERROR_UPDATE_END;
+    }
+  }
+  if (this->content_state_ == ContentState::DELTA_DONE) {
+    this->image_md5_.calculate();
+    if (!this->image_md5_.equals_bytes(this->image_md5_expected_)) {
+      ESP_LOGW(TAG, "MD5 of the patched image doesn't match");
+      return OTA_RESPONSE_ERROR_INVALID_IMAGE;
+    }
+  }
+  ESP_LOGD(TAG, "Decoded %zu bytes", this->written_);
+  return this->backend_->end();
+}
+
+void DecodingOTABackend::abort() {
+  this->free_inflator_();
+  this->backend_->abort();
+}
+
+void DecodingOTABackend::free_inflator_() {
+  this->inflator_.reset();
+  this->dict_.reset();
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,139 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_ESP32
+
+#include "ota_component.h"
+#include "ota_backend.h"
+#include "esphome/components/md5/md5.h"
+
+#include <memory>
+
+#ifdef USE_ESP_IDF
+#include "esp32/rom/miniz.h"
+#endif
+
+#ifdef USE_ARDUINO
+#include "rom/miniz.h"
+#endif
+
+namespace esphome {
+namespace ota {
+
+/** Wraps a backend to accept gzip compressed images and delta patches.
+ *
+ * What was uploaded is told apart by its first bytes:
+ *  - gzip (1F 8B) is inflated while it's received; the inflated data is one of the other two.
+ *  - A delta patch ("ESPD") is applied against the image of the running firmware. Its header has the size and MD5
+ *    of the image it was made from, which must match the running image, and of the image it produces, which is
+ *    checked before the update is finished.
+ *  - Anything else is an image and written as is.
+ *
+ * The MD5 sent by the client is checked against the bytes as they were received.
+ *
+ * A patch is a sequence of operations, each an opcode followed by LEB128 varints:
+ *  - DATA len, followed by len bytes to write.
+ *  - COPY offset len, write len bytes of the running image from offset.
+ *  - ADD offset len, followed by len bytes that are added (mod 256) to the bytes of the running image from offset.
+ * esphome/ota_delta.py creates them.
+ */
+class DecodingOTABackend : public OTABackend {
+ public:
+  explicit DecodingOTABackend(std::unique_ptr<OTABackend> backend) : backend_(std::move(backend)) {}
+
+  OTAResponseTypes begin(size_t image_size) override;
+  void set_update_md5(const char *md5) override;
+  OTAResponseTypes write(uint8_t *data, size_t len) override;
+  OTAResponseTypes end() override;
+  void abort() override;
+  /// Allocates the memory to decompress, so that compression is only offered when there's enough.
+  bool supports_compression() override;
+  size_t get_bytes_written() override { return this->written_; }
+
+ protected:
+  enum class GzipState : uint8_t {
+    DETECT,
+    NONE,
+    HEADER,
+    EXTRA_LENGTH,
+    EXTRA,
+    NAME,
+    COMMENT,
+    HEADER_CRC,
+    INFLATE,
+    TRAILER,
+  };
+  enum class ContentState : uint8_t {
+    DETECT,
+    IMAGE,
+    DELTA_HEADER,
+    DELTA_OPCODE,
+    DELTA_VARINT,
+    DELTA_DATA,
+    DELTA_ADD,
+    DELTA_DONE,
+  };
+  enum DeltaOpcode : uint8_t {
+    DELTA_OP_DATA = 0,
+    DELTA_OP_COPY = 1,
+    DELTA_OP_ADD = 2,
+  };
+
+  /// Size of the delta patch header: magic, version, base size and MD5, new size and MD5.
+  static const size_t DELTA_HEADER_SIZE = 4 + 1 + 4 + 16 + 4 + 16;
+
+  void parse_gzip_header_(uint8_t c);
+  void next_gzip_field_();
+  /// Allocate the inflator and its dictionary unless that's done already, false if there isn't enough memory.
+  bool allocate_inflator_();
+  size_t inflate_(const uint8_t *data, size_t len);
+  /// Handle the uploaded data after decompression.
+  void write_decoded_(const uint8_t *data, size_t len);
+  void parse_delta_header_();
+  /// Called when all varints of a delta operation are complete.
+  void start_delta_op_();
+  void copy_running_(size_t len, const uint8_t *add);
+  /// Write to the backend.
+  void write_image_(const uint8_t *data, size_t len);
+  void free_inflator_();
+
+  std::unique_ptr<OTABackend> backend_;
+  OTAResponseTypes error_{OTA_RESPONSE_OK};
+
+  md5::MD5Digest md5_{};
+  char expected_md5_[32];
+  bool check_md5_{false};
+
+  GzipState gzip_state_{GzipState::DETECT};
+  uint8_t gzip_flags_{0};
+  uint16_t gzip_pos_{0};
+  uint16_t gzip_skip_{0};
+  uint8_t gzip_trailer_[8];
+  uint32_t gzip_crc_{0};
+  uint32_t gzip_size_{0};
+  std::unique_ptr<tinfl_decompressor> inflator_;
+  std::unique_ptr<uint8_t[]> dict_;
+  size_t dict_pos_{0};
+
+  ContentState content_state_{ContentState::DETECT};
+  uint8_t header_[DELTA_HEADER_SIZE];
+  size_t header_len_{0};
+  uint32_t base_size_{0};
+  uint32_t image_size_{0};
+  uint8_t image_md5_expected_[16];
+  md5::MD5Digest image_md5_{};
+  /// Bytes written to the backend, a COPY of the whole running image takes many flash writes.
+  volatile size_t written_{0};
+  uint8_t op_{0};
+  uint8_t op_field_{0};
+  uint32_t op_args_[2];
+  uint8_t varint_shift_{0};
+  /// Offset in the running image and bytes left of the current COPY or ADD.
+  size_t op_offset_{0};
+  size_t op_remaining_{0};
+  uint8_t scratch_[256];
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
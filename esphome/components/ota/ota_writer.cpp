@@ -0,0 +1,178 @@
+#include "ota_writer.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <new>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.writer";
+
+bool OTAWriter::begin(OTABackend *backend, size_t chunk_size) {
+  this->backend_ = backend;
+  this->chunk_size_ = chunk_size;
+  this->error_ = OTA_RESPONSE_OK;
+  this->write_time_ = 0;
+  this->max_write_time_ = 0;
+  this->wait_time_ = 0;
+
+  this->buffers_[0].reset(new (std::nothrow) uint8_t[chunk_size]);  // NOLINT
+  if (this->buffers_[0] == nullptr) {
+    ESP_LOGW(TAG, "Could not allocate %zu bytes for the update buffer", chunk_size);
+    return false;
+  }
+
+#ifdef USE_ESP32
+  this->buffers_[1].reset(new (std::nothrow) uint8_t[chunk_size]);  // NOLINT
+  if (this->buffers_[1] == nullptr) {
+    ESP_LOGW(TAG, "Not enough memory for a second buffer, writing synchronously");
+    return true;
+  }
+  this->free_queue_ = xQueueCreate(2, sizeof(uint8_t *));
+  this->write_queue_ = xQueueCreate(2, sizeof(Chunk));
+  if (this->free_queue_ == nullptr || this->write_queue_ == nullptr ||
+      xTaskCreate(OTAWriter::writer_task, "ota_writer", 4096, this, 1, &this->task_) != pdPASS) {
+    ESP_LOGW(TAG, "Could not start the writer task, writing synchronously");
+    this->task_ = nullptr;
+    this->end();
+    this->buffers_[0].reset(new (std::nothrow) uint8_t[chunk_size]);  // NOLINT
+    return this->buffers_[0] != nullptr;
+  }
+  for (auto &buffer : this->buffers_) {
+    uint8_t *data = buffer.get();
+    xQueueSend(this->free_queue_, &data, 0);
+  }
+#endif
+  return true;
+}
+
+void OTAWriter::write_chunk_(uint8_t *data, size_t len) {
+  // Once a write failed, the image is broken anyway
+  if (this->error_ != OTA_RESPONSE_OK)
+    return;
+  const uint32_t start = micros();
+  OTAResponseTypes error = this->backend_->write(data, len);
+  const uint32_t duration = micros() - start;
+  this->write_time_ += duration;
+  if (duration > this->max_write_time_)
+    this->max_write_time_ = duration;
+  if (error != OTA_RESPONSE_OK)
+    this->error_ = error;
+}
+
+#ifdef USE_ESP32
+void OTAWriter::writer_task(void *params) {
+  auto *writer = reinterpret_cast<OTAWriter *>(params);
+  Chunk chunk;
+  while (true) {
+    if (xQueueReceive(writer->write_queue_, &chunk, portMAX_DELAY) != pdTRUE)
+      continue;
+    writer->write_chunk_(chunk.data, chunk.len);
+    xQueueSend(writer->free_queue_, &chunk.data, portMAX_DELAY);
+  }
+}
+
+bool OTAWriter::stalled_(uint32_t &start, size_t &written, uint32_t timeout) {
+  const uint32_t now = millis();
+  const size_t current = this->backend_->get_bytes_written();
+  if (current != written) {
+    written = current;
+    start = now;
+    return false;
+  }
+  return now - start > timeout;
+}
+
+bool OTAWriter::wait_idle_(uint32_t timeout) {
+  const UBaseType_t count = this->current_ == nullptr ? 2 : 1;
+  uint32_t start = millis();
+  size_t written = this->backend_->get_bytes_written();
+  while (uxQueueMessagesWaiting(this->free_queue_) < count) {
+    if (this->stalled_(start, written, timeout))
+      return false;
+    App.feed_wdt();
+    delay(1);
+  }
+  return true;
+}
+#endif
+
+uint8_t *OTAWriter::get_buffer(uint32_t timeout) {
+#ifdef USE_ESP32
+  if (this->task_ != nullptr && this->current_ == nullptr) {
+    const uint32_t start = micros();
+    uint32_t start_ms = millis();
+    size_t written = this->backend_->get_bytes_written();
+    while (xQueueReceive(this->free_queue_, &this->current_, pdMS_TO_TICKS(10)) != pdTRUE) {
+      if (this->stalled_(start_ms, written, timeout)) {
+        this->current_ = nullptr;
+        break;
+      }
+      App.feed_wdt();
+    }
+    this->wait_time_ += micros() - start;
+    return this->current_;
+  }
+#endif
+  if (this->current_ == nullptr)
+    this->current_ = this->buffers_[0].get();
+  return this->current_;
+}
+
+OTAResponseTypes OTAWriter::write(size_t len) {
+#ifdef USE_ESP32
+  if (this->task_ != nullptr) {
+    Chunk chunk{this->current_, len};
+    // There are only two buffers, so there's always room in the queue
+    xQueueSend(this->write_queue_, &chunk, portMAX_DELAY);
+    this->current_ = nullptr;
+    return this->error_;
+  }
+#endif
+  this->write_chunk_(this->current_, len);
+  this->current_ = nullptr;
+  return this->error_;
+}
+
+OTAResponseTypes OTAWriter::finish(uint32_t timeout) {
+#ifdef USE_ESP32
+  if (this->task_ != nullptr) {
+    const uint32_t start = micros();
+    bool idle = this->wait_idle_(timeout);
+    this->wait_time_ += micros() - start;
+    if (!idle) {
+      ESP_LOGW(TAG, "Timed out waiting for the flash writes to finish");
+      return OTA_RESPONSE_ERROR_WRITING_FLASH;
+    }
+  }
+#endif
+  return this->error_;
+}
+
+void OTAWriter::end() {
+#ifdef USE_ESP32
+  if (this->task_ != nullptr) {
+    // The task can't be stopped in the middle of a flash write
+    this->wait_idle_(UINT32_MAX);
+    vTaskDelete(this->task_);
+    this->task_ = nullptr;
+  }
+  if (this->free_queue_ != nullptr) {
+    vQueueDelete(this->free_queue_);
+    this->free_queue_ = nullptr;
+  }
+  if (this->write_queue_ != nullptr) {
+    vQueueDelete(this->write_queue_);
+    this->write_queue_ = nullptr;
+  }
+#endif
+  this->current_ = nullptr;
+  this->buffers_[0].reset();
+  this->buffers_[1].reset();
+}
+
+}  // namespace ota
+}  // namespace esphome
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ota_component.h"
+#include "ota_backend.h"
+
+#include <memory>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+/** Writes a received image to an OTABackend in chunks.
+ *
+ * On ESP32 the backend is called from a separate task with two buffers: while one chunk is being written to flash
+ * (and hashed by the backend), the next one is received into the other buffer, so neither the network nor the flash
+ * has to wait for the other. If there's no memory for the second buffer, and on other platforms, every chunk is
+ * written as soon as it's complete.
+ */
+class OTAWriter {
+ public:
+  ~OTAWriter() { this->end(); }
+
+  /// Allocate the buffers and start the writer, false if there isn't enough memory for a single buffer.
+  bool begin(OTABackend *backend, size_t chunk_size);
+  /// The buffer to receive the next chunk into, nullptr if the writes made no progress for timeout ms.
+  uint8_t *get_buffer(uint32_t timeout);
+  /// Queue the first len bytes of the buffer from get_buffer() for writing, returns the first error of the writes.
+  OTAResponseTypes write(size_t len);
+  /// Wait for all queued chunks to be written, returns the first error of the writes. Fails if the writes made no
+  /// progress for timeout ms.
+  OTAResponseTypes finish(uint32_t timeout);
+  /// Stop the writer and free the buffers. Chunks that are still being written are waited for.
+  void end();
+
+  size_t get_chunk_size() const { return this->chunk_size_; }
+  bool is_pipelined() const { return this->buffers_[1] != nullptr; }
+  /// Total time spent in the backend's write(), in microseconds.
+  uint32_t get_write_time() const { return this->write_time_; }
+  /// Longest single call to the backend's write(), in microseconds.
+  uint32_t get_max_write_time() const { return this->max_write_time_; }
+  /// Time spent waiting for the writes to free a buffer, in microseconds.
+  uint32_t get_wait_time() const { return this->wait_time_; }
+
+ protected:
+  void write_chunk_(uint8_t *data, size_t len);
+
+  OTABackend *backend_{nullptr};
+  size_t chunk_size_{0};
+  std::unique_ptr<uint8_t[]> buffers_[2];
+  /// The buffer handed out by get_buffer(), nullptr if none.
+  uint8_t *current_{nullptr};
+  volatile OTAResponseTypes error_{OTA_RESPONSE_OK};
+  volatile uint32_t write_time_{0};
+  volatile uint32_t max_write_time_{0};
+  uint32_t wait_time_{0};
+
+#ifdef USE_ESP32
+  struct Chunk {
+    uint8_t *data;
+    size_t len;
+  };
+
+  static void writer_task(void *params);
+  /// Whether the backend wrote nothing for timeout ms since start, which is moved forward whenever it did.
+  bool stalled_(uint32_t &start, size_t &written, uint32_t timeout);
+  /// Wait until all buffers except current_ are back in free_queue_.
+  bool wait_idle_(uint32_t timeout);
+
+  /// Buffers that are free to receive into.
+  QueueHandle_t free_queue_{nullptr};
+  /// Chunks waiting to be written by the task.
+  QueueHandle_t write_queue_{nullptr};
+  TaskHandle_t task_{nullptr};
+#endif
+};
+
+}  // namespace ota
+}  // namespace esphome
@@ -1,6 +1,7 @@
 #include "rotary_encoder.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 namespace esphome {
 namespace rotary_encoder {
@@ -118,6 +119,8 @@ void IRAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensorStore
     } else {
       *std::prev(first_zero) += rotation_dir;  // store the rotation into the previous slot
     }
+    // Publish the new state right away, even if the loop is in a tickless sleep
+    App.wake_loop_isr();
   }
 
   arg->state = new_state;
@@ -28,6 +28,9 @@ optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &dev
 
 class RuuviListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  // Ruuvi Innovations manufacturer data
+  RuuviListener() { this->set_match_uuid16(0x0499); }
+
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
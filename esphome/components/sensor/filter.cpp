@@ -2,6 +2,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "sensor.h"
+#include <algorithm>
 #include <cmath>
 
 namespace esphome {
@@ -31,17 +32,143 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// SlidingWindowExtreme
+void SlidingWindowExtreme::set_window_size(size_t window_size) {
+  this->window_size_ = std::max<size_t>(window_size, 1);
+  // Keep the values that are still in the smaller window
+  while (!this->queue_.empty() && this->count_ - this->queue_.front().first > this->window_size_)
+    this->queue_.pop_front();
+  this->queue_.set_capacity(this->window_size_);
+}
+void SlidingWindowExtreme::push(float value) {
+  uint32_t index = this->count_++;
+  // The queue holds at most window_size values, so the oldest one leaves the window before it overflows
+  if (!this->queue_.empty() && index - this->queue_.front().first >= this->window_size_)
+    this->queue_.pop_front();
+  while (!this->queue_.empty()) {
+    float back = this->queue_.back().second;
+    if (this->maximum_ ? back > value : back < value)
+      break;
+    this->queue_.pop_back();
+  }
+  this->queue_.push_back(std::make_pair(index, value));
+}
+
+// SlidingWindowOrderStatistic
+void SlidingWindowOrderStatistic::set_window_size(size_t window_size) {
+  window_size = std::max<size_t>(window_size, 1);
+  // Keep the newest values that still fit, like the window of the other sliding window filters
+  std::vector<float> kept;
+  const size_t keep = std::min(this->size_, window_size);
+  kept.reserve(keep);
+  for (size_t i = this->size_ - keep; i < this->size_; i++)
+    kept.push_back(this->values_[(this->head_ + i) % this->values_.size()]);
+
+  this->values_.assign(window_size, 0.0f);
+  this->position_.assign(window_size, 0);
+  this->in_lower_.assign(window_size, 0);
+  this->lower_.clear();
+  this->lower_.reserve(window_size);
+  this->upper_.clear();
+  this->upper_.reserve(window_size);
+  this->head_ = 0;
+  this->size_ = 0;
+  for (float value : kept)
+    this->push(value);
+}
+void SlidingWindowOrderStatistic::push(float value) {
+  const size_t capacity = this->values_.size();
+  if (this->size_ == capacity) {
+    uint32_t oldest = this->head_;
+    this->heap_remove_(this->in_lower_[oldest], this->position_[oldest]);
+    this->head_ = (this->head_ + 1) % capacity;
+    this->size_--;
+  }
+
+  uint32_t slot = (this->head_ + this->size_) % capacity;
+  this->size_++;
+  this->values_[slot] = value;
+  // Every lower value must stay less than or equal to every upper value, the heaps are balanced in select()
+  bool lower;
+  if (!this->lower_.empty()) {
+    lower = value <= this->values_[this->lower_[0]];
+  } else {
+    lower = this->upper_.empty() || value <= this->values_[this->upper_[0]];
+  }
+  this->heap_push_(lower, slot);
+}
+float SlidingWindowOrderStatistic::select(size_t rank) {
+  while (this->lower_.size() > rank + 1)
+    this->move_top_(true);
+  while (this->lower_.size() < rank + 1)
+    this->move_top_(false);
+  return this->values_[this->lower_[0]];
+}
+void SlidingWindowOrderStatistic::place_(bool lower, size_t pos, uint32_t slot) {
+  this->heap_(lower)[pos] = slot;
+  this->position_[slot] = pos;
+}
+void SlidingWindowOrderStatistic::sift_up_(bool lower, size_t pos) {
+  auto &heap = this->heap_(lower);
+  uint32_t slot = heap[pos];
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!this->before_(lower, slot, heap[parent]))
+      break;
+    this->place_(lower, pos, heap[parent]);
+    pos = parent;
+  }
+  this->place_(lower, pos, slot);
+}
+void SlidingWindowOrderStatistic::sift_down_(bool lower, size_t pos) {
+  auto &heap = this->heap_(lower);
+  const size_t size = heap.size();
+  uint32_t slot = heap[pos];
+  while (true) {
+    size_t child = 2 * pos + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->before_(lower, heap[child + 1], heap[child]))
+      child++;
+    if (!this->before_(lower, heap[child], slot))
+      break;
+    this->place_(lower, pos, heap[child]);
+    pos = child;
+  }
+  this->place_(lower, pos, slot);
+}
+void SlidingWindowOrderStatistic::heap_push_(bool lower, uint32_t slot) {
+  auto &heap = this->heap_(lower);
+  this->in_lower_[slot] = lower;
+  heap.push_back(slot);
+  this->sift_up_(lower, heap.size() - 1);
+}
+void SlidingWindowOrderStatistic::heap_remove_(bool lower, size_t pos) {
+  auto &heap = this->heap_(lower);
+  uint32_t last = heap.back();
+  heap.pop_back();
+  if (pos == heap.size())
+    return;
+  this->place_(lower, pos, last);
+  this->sift_up_(lower, pos);
+  this->sift_down_(lower, this->position_[last]);
+}
+void SlidingWindowOrderStatistic::move_top_(bool from_lower) {
+  uint32_t slot = this->heap_(from_lower)[0];
+  this->heap_remove_(from_lower, 0);
+  this->heap_push_(!from_lower, slot);
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at) {
+  this->window_.set_window_size(window_size);
+}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MedianFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -49,15 +176,12 @@ optional<float> MedianFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
+    if (!this->window_.empty()) {
+      size_t window_size = this->window_.size();
+      if (window_size % 2) {
+        median = this->window_.select(window_size / 2);
       } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
+        median = (this->window_.select((window_size / 2) - 1) + this->window_.select_next()) / 2.0f;
       }
     }
 
@@ -69,16 +193,15 @@ optional<float> MedianFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), quantile_(quantile) {
+  this->window_.set_window_size(window_size);
+}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
   }
 
@@ -86,14 +209,12 @@ optional<float> QuantileFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float result = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> quantile_queue = this->queue_;
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      size_t position = ceilf(queue_size * this->quantile_) - 1;
-      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position, queue_size);
-      result = quantile_queue[position];
+    if (!this->window_.empty()) {
+      size_t window_size = this->window_.size();
+      size_t position = ceilf(window_size * this->quantile_);
+      position = std::min(std::max<size_t>(position, 1), window_size) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %zu/%zu", this, position, window_size);
+      result = this->window_.select(position);
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING", this, result);
@@ -104,15 +225,14 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at) {
+  this->window_.set_window_size(window_size);
+}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MinFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -120,10 +240,8 @@ optional<float> MinFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float min = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::min_element(queue_.begin(), queue_.end());
-      min = *it;
-    }
+    if (!this->window_.empty())
+      min = this->window_.get();
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING", this, min);
     return min;
@@ -133,15 +251,14 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at) {
+  this->window_.set_window_size(window_size);
+}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MaxFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -149,10 +266,8 @@ optional<float> MaxFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float max = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::max_element(queue_.begin(), queue_.end());
-      max = *it;
-    }
+    if (!this->window_.empty())
+      max = this->window_.get();
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING", this, max);
     return max;
@@ -163,13 +278,20 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at) {
+  this->set_window_size(window_size);
+}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->queue_.set_capacity(std::max<size_t>(window_size, 1));
+  this->sum_ = 0.0f;
+  for (size_t i = 0; i < this->queue_.size(); i++)
+    this->sum_ += this->queue_[i];
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_[0];
+    if (this->queue_.full()) {
+      this->sum_ -= this->queue_.front();
       this->queue_.pop_front();
     }
     this->queue_.push_back(value);
@@ -186,8 +308,8 @@ optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
     if (this->send_at_ >= 10000) {
       // Recalculate to prevent floating point error accumulating
       this->sum_ = 0;
-      for (auto v : this->queue_)
-        this->sum_ += v;
+      for (size_t i = 0; i < this->queue_.size(); i++)
+        this->sum_ += this->queue_[i];
       average = this->sum_ / this->queue_.size();
       this->send_at_ = 0;
     }
@@ -2,8 +2,9 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 namespace esphome {
 namespace sensor {
@@ -42,6 +43,115 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/// Fixed capacity FIFO of the last values of a sliding window, allocated once when the capacity is set.
+template<typename T> class SlidingWindowBuffer {
+ public:
+  /// Change the capacity, keeping the newest values that still fit.
+  void set_capacity(size_t capacity) {
+    std::vector<T> data(capacity, T{});
+    const size_t keep = std::min(this->size_, capacity);
+    for (size_t i = 0; i < keep; i++)
+      data[i] = (*this)[this->size_ - keep + i];
+    this->data_ = std::move(data);
+    this->head_ = 0;
+    this->size_ = keep;
+  }
+  size_t capacity() const { return this->data_.size(); }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->data_.size(); }
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  /// The i-th oldest value.
+  T &operator[](size_t i) { return this->data_[(this->head_ + i) % this->data_.size()]; }
+  T &front() { return this->data_[this->head_]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+
+  /// Append a value, the buffer must not be full.
+  void push_back(const T &value) {
+    this->size_++;
+    this->back() = value;
+  }
+  void pop_front() {
+    this->head_ = (this->head_ + 1) % this->data_.size();
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+
+ protected:
+  std::vector<T> data_;
+  size_t head_{0};
+  size_t size_{0};
+};
+
+/** Minimum or maximum of a sliding window in amortized O(1) per value.
+ *
+ * Keeps a monotonic queue of the values that can still become the extreme, every value that is followed by a
+ * smaller (for the minimum) one will leave the window before it and is dropped right away.
+ */
+class SlidingWindowExtreme {
+ public:
+  explicit SlidingWindowExtreme(bool maximum) : maximum_(maximum) {}
+
+  void set_window_size(size_t window_size);
+  void push(float value);
+  bool empty() const { return this->queue_.empty(); }
+  /// The extreme of the last window_size values, the window must not be empty.
+  float get() { return this->queue_.front().second; }
+
+ protected:
+  bool maximum_;
+  size_t window_size_{0};
+  uint32_t count_{0};
+  /// Pairs of the index of a value and the value.
+  SlidingWindowBuffer<std::pair<uint32_t, float>> queue_;
+};
+
+/** Order statistics of a sliding window in O(log n) per value.
+ *
+ * The values are split into a max-heap of the lower values and a min-heap of the upper ones. The heaps hold the
+ * slots of the values in a ring buffer and every slot knows its position in its heap, so the oldest value can be
+ * removed from the middle of a heap when it leaves the window.
+ */
+class SlidingWindowOrderStatistic {
+ public:
+  void set_window_size(size_t window_size);
+  void push(float value);
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+
+  /// The value with the given rank (0 is the smallest), which must be less than size().
+  float select(size_t rank);
+  /// The value with the rank one higher than the last select(), which must not have selected the largest value.
+  float select_next() const { return this->values_[this->upper_[0]]; }
+
+ protected:
+  std::vector<uint32_t> &heap_(bool lower) { return lower ? this->lower_ : this->upper_; }
+  /// Whether the value in slot a belongs closer to the top of the heap than the value in slot b.
+  bool before_(bool lower, uint32_t a, uint32_t b) const {
+    return lower ? this->values_[a] > this->values_[b] : this->values_[a] < this->values_[b];
+  }
+  void place_(bool lower, size_t pos, uint32_t slot);
+  void sift_up_(bool lower, size_t pos);
+  void sift_down_(bool lower, size_t pos);
+  void heap_push_(bool lower, uint32_t slot);
+  void heap_remove_(bool lower, size_t pos);
+  /// Move the top of one heap to the other one.
+  void move_top_(bool from_lower);
+
+  std::vector<float> values_;
+  /// Position of every slot in its heap.
+  std::vector<uint32_t> position_;
+  std::vector<uint8_t> in_lower_;
+  std::vector<uint32_t> lower_;
+  std::vector<uint32_t> upper_;
+  size_t head_{0};
+  size_t size_{0};
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -66,10 +176,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowOrderStatistic window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
   float quantile_;
 };
 
@@ -95,10 +204,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowOrderStatistic window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple min filter.
@@ -123,10 +231,9 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtreme window_{false};
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -151,10 +258,9 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtreme window_{true};
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -181,10 +287,9 @@ class SlidingWindowMovingAverageFilter : public Filter {
 
  protected:
   float sum_{0.0};
-  std::deque<float> queue_;
+  SlidingWindowBuffer<float> queue_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
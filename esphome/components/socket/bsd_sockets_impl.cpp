@@ -132,6 +132,7 @@ class BSDSocketImpl : public Socket {
     return ::writev(fd_, iov, iovcnt);
 #endif
   }
+  int get_fd() override { return fd_; }
   int setblocking(bool blocking) override {
     int fl = ::fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -36,6 +36,8 @@ class Socket {
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+  /// Get the underlying file descriptor, or -1 if this socket implementation doesn't have one.
+  virtual int get_fd() { return -1; }
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol);
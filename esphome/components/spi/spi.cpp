@@ -8,6 +8,9 @@ namespace spi {
 
 static const char *const TAG = "spi";
 
+/// How much of an asynchronous write is sent per loop() call, 4 kB take about 1ms at 40MHz.
+static const size_t ASYNC_WRITE_BYTES_PER_LOOP = 4096;
+
 void IRAM_ATTR HOT SPIComponent::disable() {
 #ifdef USE_SPI_ARDUINO_BACKEND
   if (this->hw_spi_ != nullptr) {
@@ -19,6 +22,40 @@ void IRAM_ATTR HOT SPIComponent::disable() {
     this->active_cs_ = nullptr;
   }
 }
+void SPIComponent::loop() {
+  if (!this->async_source_)
+    return;
+  // Give other components a chance to run between chunks
+  size_t written = 0;
+  while (written < ASYNC_WRITE_BYTES_PER_LOOP) {
+    size_t length = this->write_async_chunk_();
+    if (length == 0)
+      break;
+    written += length;
+  }
+}
+void SPIComponent::finish_async_write() {
+  while (this->async_source_)
+    this->write_async_chunk_();
+}
+size_t HOT SPIComponent::write_async_chunk_() {
+  const uint8_t *data = nullptr;
+  size_t length = this->async_source_(&data);
+  if (length != 0) {
+    (this->*async_write_)(data, length);
+    return length;
+  }
+
+  this->disable();
+  this->async_source_ = nullptr;
+  this->high_freq_.stop();
+  // on_done may start the next write
+  auto on_done = std::move(this->async_done_);
+  this->async_done_ = nullptr;
+  if (on_done)
+    on_done();
+  return 0;
+}
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
   this->clk_->setup();
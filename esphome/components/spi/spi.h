@@ -2,6 +2,8 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include <functional>
 #include <vector>
 
 #ifdef USE_ARDUINO
@@ -69,6 +71,13 @@ enum SPIDataRate : uint32_t {
   DATA_RATE_40MHZ = 40000000,
 };
 
+/** Provides the data of an asynchronous write in chunks.
+ *
+ * Called until it returns 0, it sets data to the next chunk and returns its length. The chunk has to stay valid until
+ * the next call.
+ */
+using spi_write_source_t = std::function<size_t(const uint8_t **data)>;
+
 class SPIComponent : public Component {
  public:
   void set_clk(GPIOPin *clk) { clk_ = clk; }
@@ -193,6 +202,10 @@ class SPIComponent : public Component {
 
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, uint32_t DATA_RATE>
   void enable(GPIOPin *cs) {
+    // The bus is still claimed by an asynchronous write
+    if (this->async_source_)
+      this->finish_async_write();
+
 #ifdef USE_SPI_ARDUINO_BACKEND
     if (this->hw_spi_ != nullptr) {
       uint8_t data_mode = SPI_MODE0;
@@ -222,9 +235,31 @@ class SPIComponent : public Component {
 
   void disable();
 
+  /** Write the data from source to the device with chip select cs in the background and call on_done after.
+   *
+   * Returns immediately. The chunks are written from loop() while the bus stays claimed by the device, enabling any
+   * device in the meantime first finishes the write.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, uint32_t DATA_RATE>
+  void write_async(GPIOPin *cs, spi_write_source_t &&source, std::function<void()> &&on_done) {
+    this->enable<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>(cs);
+    this->async_write_ = &SPIComponent::write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>;
+    this->async_source_ = std::move(source);
+    this->async_done_ = std::move(on_done);
+    this->high_freq_.start();
+  }
+  /// Whether an asynchronous write is in progress.
+  bool is_async_write_active() const { return bool(this->async_source_); }
+  /// Block until the asynchronous write, and any write started when it's done, is finished.
+  void finish_async_write();
+
+  void loop() override;
+
   float get_setup_priority() const override;
 
  protected:
+  /// Write the next chunk of the asynchronous write, returns its length and 0 when the write is done.
+  size_t write_async_chunk_();
   inline void cycle_clock_(bool value);
 
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
@@ -238,6 +273,11 @@ class SPIComponent : public Component {
   SPIClass *hw_spi_{nullptr};
 #endif  // USE_SPI_ARDUINO_BACKEND
   uint32_t wait_cycle_;
+
+  spi_write_source_t async_source_{nullptr};
+  std::function<void()> async_done_{nullptr};
+  void (SPIComponent::*async_write_)(const uint8_t *data, size_t length){nullptr};
+  HighFrequencyLoopRequester high_freq_;
 };
 
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
@@ -302,6 +342,12 @@ class SPIDevice {
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
 
+  /// Write the data from source in the background and call on_done after, see SPIComponent::write_async().
+  void write_async(spi_write_source_t source, std::function<void()> on_done) {
+    this->parent_->template write_async<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>(this->cs_, std::move(source),
+                                                                                           std::move(on_done));
+  }
+
  protected:
   SPIComponent *parent_{nullptr};
   GPIOPin *cs_{nullptr};
@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ssd1306_base {
 
@@ -169,7 +171,59 @@ bool SSD1306::is_ssd1305_() const {
 }
 void SSD1306::update() {
   this->do_update_();
-  this->display();
+  this->flush_dirty_();
+}
+size_t SSD1306::flush_rect_(int x1, int y1, int x2, int y2) {
+  const int width = this->get_width_internal();
+  size_t bytes = 0;
+  int band_start = -1;
+  // every buffer byte is a column of 8 pixels in a page, send the changed pages in bands of consecutive pages
+  for (int page = y1 / 8; page <= y2 / 8 + 1; page++) {
+    bool changed = page <= y2 / 8 && this->row_changed_(page, this->buffer_ + page * width, width);
+    if (changed && band_start < 0)
+      band_start = page;
+    if (changed || band_start < 0)
+      continue;
+    bytes += this->write_display_window_(x1, band_start, x2, page - 1);
+    band_start = -1;
+  }
+  return bytes;
+}
+size_t SSD1306::write_display_window_(int x1, int page1, int x2, int page2) {
+  const int width = this->get_width_internal();
+  const size_t length = x2 - x1 + 1;
+  if (this->is_sh1106_()) {
+    // The SH1106 has no column and page window, set the start of every page. Its visible columns start at 2.
+    const uint8_t column = x1 + 2;
+    for (int page = page1; page <= page2; page++) {
+      this->command(0xB0 + page);
+      this->command(column & 0x0F);
+      this->command(0x10 | (column >> 4));
+      this->write_display_data(this->buffer_ + page * width + x1, length);
+    }
+    return length * (page2 - page1 + 1);
+  }
+
+  this->command(SSD1306_COMMAND_COLUMN_ADDRESS);
+  switch (this->model_) {
+    case SSD1306_MODEL_64_48:
+    case SSD1306_MODEL_64_32:
+      this->command(0x20 + this->offset_x_ + x1);
+      this->command(0x20 + this->offset_x_ + x2);
+      break;
+    default:
+      this->command(this->offset_x_ + x1);
+      this->command(this->offset_x_ + x2);
+      break;
+  }
+  this->command(SSD1306_COMMAND_PAGE_ADDRESS);
+  this->command(page1);
+  this->command(page2);
+
+  // Horizontal addressing wraps to the start of the window on the next page
+  for (int page = page1; page <= page2; page++)
+    this->write_display_data(this->buffer_ + page * width + x1, length);
+  return length * (page2 - page1 + 1);
 }
 void SSD1306::set_contrast(float contrast) {
   // validation
@@ -246,16 +300,45 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
 
   uint16_t pos = x + (y / 8) * this->get_width_internal();
   uint8_t subpos = y & 0x07;
+  uint8_t value = this->buffer_[pos];
   if (color.is_on()) {
-    this->buffer_[pos] |= (1 << subpos);
+    value |= (1 << subpos);
   } else {
-    this->buffer_[pos] &= ~(1 << subpos);
+    value &= ~(1 << subpos);
+  }
+  // only changed pixels grow the window that's sent to the display
+  if (value == this->buffer_[pos])
+    return;
+  this->buffer_[pos] = value;
+  this->mark_dirty_(x, y);
+}
+void HOT SSD1306::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+  const int buffer_width = this->get_width_internal();
+  const bool on = color.is_on();
+  // Every buffer byte holds 8 rows of a column, update all rows of the rectangle in a page at once
+  for (int page = y / 8; page <= (y + height - 1) / 8; page++) {
+    const int row1 = std::max(y, page * 8);
+    const int row2 = std::min(y + height - 1, page * 8 + 7);
+    const uint8_t mask = (0xFF << (row1 & 0x07)) & (0xFF >> (7 - (row2 & 0x07)));
+    uint8_t *dst = this->buffer_ + page * buffer_width + x;
+    for (int i = 0; i < width; i++) {
+      const uint8_t value = on ? (dst[i] | mask) : (dst[i] & ~mask);
+      if (value == dst[i])
+        continue;
+      dst[i] = value;
+      // only changed pixels grow the window that's sent to the display
+      this->mark_dirty_(x + i, row1);
+      this->mark_dirty_(x + i, row2);
+    }
   }
 }
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     this->buffer_[i] = fill;
+  this->mark_dirty_all_();
 }
 void SSD1306::init_reset_() {
   if (this->reset_pin_ != nullptr) {
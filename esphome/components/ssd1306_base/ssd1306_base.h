@@ -50,12 +50,18 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
  protected:
   virtual void command(uint8_t value) = 0;
   virtual void write_display_data() = 0;
+  /// Write display data for consecutive columns at the current position.
+  virtual void write_display_data(const uint8_t *data, size_t length) = 0;
+  size_t flush_rect_(int x1, int y1, int x2, int y2) override;
+  /// Send the columns x1 to x2 of the pages page1 to page2, returns the number of bytes sent.
+  size_t write_display_window_(int x1, int page1, int x2, int page2);
   void init_reset_();
 
   bool is_sh1106_() const;
   bool is_ssd1305_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
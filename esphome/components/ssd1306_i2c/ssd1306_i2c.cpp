@@ -1,6 +1,8 @@
 #include "ssd1306_i2c.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ssd1306_i2c {
 
@@ -62,5 +64,14 @@ void HOT I2CSSD1306::write_display_data() {
   }
 }
 
+void HOT I2CSSD1306::write_display_data(const uint8_t *data, size_t length) {
+  while (length > 0) {
+    uint8_t size = std::min<size_t>(length, 16);
+    this->write_bytes(0x40, data, size);
+    data += size;
+    length -= size;
+  }
+}
+
 }  // namespace ssd1306_i2c
 }  // namespace esphome
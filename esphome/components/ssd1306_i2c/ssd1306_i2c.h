@@ -15,6 +15,7 @@ class I2CSSD1306 : public ssd1306_base::SSD1306, public i2c::I2CDevice {
  protected:
   void command(uint8_t value) override;
   void write_display_data() override;
+  void write_display_data(const uint8_t *data, size_t length) override;
 
   enum ErrorCode { NONE = 0, COMMUNICATION_FAILED } error_code_{NONE};
 };
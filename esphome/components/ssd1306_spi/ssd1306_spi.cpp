@@ -57,5 +57,12 @@ void HOT SPISSD1306::write_display_data() {
   }
 }
 
+void HOT SPISSD1306::write_display_data(const uint8_t *data, size_t length) {
+  this->dc_pin_->digital_write(true);
+  this->enable();
+  this->write_array(data, length);
+  this->disable();
+}
+
 }  // namespace ssd1306_spi
 }  // namespace esphome
@@ -289,11 +289,13 @@ void ST7735::setup() {
 
   this->init_internal_(this->get_buffer_length());
   memset(this->buffer_, 0x00, this->get_buffer_length());
+  // the panel RAM holds garbage after power-on, send everything on the first update
+  this->mark_dirty_all_();
 }
 
 void ST7735::update() {
   this->do_update_();
-  this->write_display_data_();
+  this->flush_dirty_();
 }
 
 int ST7735::get_height_internal() { return height_; }
@@ -312,15 +314,99 @@ void HOT ST7735::draw_absolute_pixel_internal(int x, int y, Color color) {
     return;
 
   if (this->eightbitcolor_) {
-    const uint32_t color332 = display::ColorUtil::color_to_332(color);
-    uint16_t pos = (x + y * this->get_width_internal());
+    const uint8_t color332 = display::ColorUtil::color_to_332(color);
+    uint32_t pos = (x + y * this->get_width_internal());
+    if (this->buffer_[pos] == color332)
+      return;
     this->buffer_[pos] = color332;
   } else {
     const uint32_t color565 = display::ColorUtil::color_to_565(color);
-    uint16_t pos = (x + y * this->get_width_internal()) * 2;
-    this->buffer_[pos++] = (color565 >> 8) & 0xff;
-    this->buffer_[pos] = color565 & 0xff;
+    const uint8_t high = (color565 >> 8) & 0xff;
+    const uint8_t low = color565 & 0xff;
+    uint32_t pos = (x + y * this->get_width_internal()) * 2;
+    if (this->buffer_[pos] == high && this->buffer_[pos + 1] == low)
+      return;
+    this->buffer_[pos++] = high;
+    this->buffer_[pos] = low;
   }
+  // only changed pixels grow the window that's sent to the display
+  this->mark_dirty_(x, y);
+}
+
+void HOT ST7735::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+  const uint16_t color565 = display::ColorUtil::color_to_565(color);
+  const uint8_t color332 = display::ColorUtil::color_to_332(color);
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
+  for (int row = y; row < y + height; row++) {
+    // only the changed part of the span grows the dirty window
+    int first = -1, last = -1;
+    if (this->eightbitcolor_) {
+      uint8_t *dst = this->buffer_ + row * this->get_width_internal() + x;
+      for (int i = 0; i < width; i++) {
+        if (dst[i] == color332)
+          continue;
+        dst[i] = color332;
+        if (first < 0)
+          first = i;
+        last = i;
+      }
+    } else {
+      uint8_t *dst = this->buffer_ + (row * this->get_width_internal() + x) * 2;
+      for (int i = 0; i < width; i++, dst += 2) {
+        if (dst[0] == high && dst[1] == low)
+          continue;
+        dst[0] = high;
+        dst[1] = low;
+        if (first < 0)
+          first = i;
+        last = i;
+      }
+    }
+    if (first < 0)
+      continue;
+    this->mark_dirty_(x + first, row);
+    this->mark_dirty_(x + last, row);
+  }
+}
+
+void HOT ST7735::draw_absolute_row_internal(int x, int y, const Color *colors, int length) {
+  const int start = x;
+  int height = 1;
+  if (!this->clip_absolute_rect_(&x, &y, &length, &height))
+    return;
+  colors += x - start;
+  int first = -1, last = -1;
+  uint8_t *dst = this->buffer_ + (y * this->get_width_internal() + x) * (this->eightbitcolor_ ? 1 : 2);
+  for (int i = 0; i < length; i++) {
+    if (this->eightbitcolor_) {
+      const uint8_t color332 = display::ColorUtil::color_to_332(colors[i]);
+      if (*dst == color332) {
+        dst++;
+        continue;
+      }
+      *dst++ = color332;
+    } else {
+      const uint16_t color565 = display::ColorUtil::color_to_565(colors[i]);
+      const uint8_t high = (color565 >> 8) & 0xff;
+      const uint8_t low = color565 & 0xff;
+      if (dst[0] == high && dst[1] == low) {
+        dst += 2;
+        continue;
+      }
+      *dst++ = high;
+      *dst++ = low;
+    }
+    if (first < 0)
+      first = i;
+    last = i;
+  }
+  if (first < 0)
+    return;
+  this->mark_dirty_(x + first, y);
+  this->mark_dirty_(x + last, y);
 }
 
 void ST7735::init_reset_() {
@@ -417,37 +503,49 @@ void HOT ST7735::senddata_(const uint8_t *data_bytes, uint8_t num_data_bytes) {
   this->disable();
 }
 
-void HOT ST7735::write_display_data_() {
-  uint16_t offsetx = colstart_;
-  uint16_t offsety = rowstart_;
-
-  uint16_t x1 = offsetx;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = offsety;
-  uint16_t y2 = y1 + get_height_internal() - 1;
+size_t HOT ST7735::flush_rect_(int x1, int y1, int x2, int y2) {
+  const size_t bytes_per_pixel = this->eightbitcolor_ ? 1 : 2;
+  const size_t row_length = this->get_width_internal() * bytes_per_pixel;
+  size_t bytes = 0;
+  int band_start = -1;
+  // send the changed rows of the dirty window, in bands of consecutive rows
+  for (int y = y1; y <= y2 + 1; y++) {
+    bool changed = y <= y2 && this->row_changed_(y, this->buffer_ + y * row_length, row_length);
+    if (changed && band_start < 0)
+      band_start = y;
+    if (changed || band_start < 0)
+      continue;
+    bytes += this->write_display_data_(x1, band_start, x2, y - 1);
+    band_start = -1;
+  }
+  return bytes;
+}
 
+size_t HOT ST7735::write_display_data_(int x1, int y1, int x2, int y2) {
   this->enable();
 
   // set column(x) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_CASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(x1, x2);
+  this->spi_master_write_addr_(x1 + colstart_, x2 + colstart_);
 
   // set Page(y) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(y1, y2);
+  this->spi_master_write_addr_(y1 + rowstart_, y2 + rowstart_);
 
   //  Memory Write
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  if (this->eightbitcolor_) {
-    for (size_t line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
+  const size_t width = x2 - x1 + 1;
+  for (int y = y1; y <= y2; y++) {
+    if (this->eightbitcolor_) {
+      const size_t line = y * this->get_width_internal();
+      for (size_t index = x1; index <= size_t(x2); ++index) {
         auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
                                                      display::ColorBitness::COLOR_BITNESS_332, true);
 
@@ -456,11 +554,12 @@ void HOT ST7735::write_display_data_() {
         this->write_byte((color >> 8) & 0xff);
         this->write_byte(color & 0xff);
       }
+    } else {
+      this->write_array(this->buffer_ + (x1 + y * this->get_width_internal()) * 2, width * 2);
     }
-  } else {
-    this->write_array(this->buffer_, this->get_buffer_length());
   }
   this->disable();
+  return width * (y2 - y1 + 1) * 2;
 }
 
 void ST7735::spi_master_write_addr_(uint16_t addr1, uint16_t addr2) {
@@ -60,12 +60,16 @@ class ST7735 : public PollingComponent,
   void writecommand_(uint8_t value);
   void writedata_(uint8_t value);
 
-  void write_display_data_();
+  size_t flush_rect_(int x1, int y1, int x2, int y2) override;
+  /// Send the window from (x1, y1) to (x2, y2) of the buffer, returns the number of bytes sent.
+  size_t write_display_data_(int x1, int y1, int x2, int y2);
 
   void init_reset_();
   void display_init_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_row_internal(int x, int y, const Color *colors, int length) override;
   void spi_master_write_addr_(uint16_t addr1, uint16_t addr2);
   void spi_master_write_color_(uint16_t color, uint16_t size);
 
@@ -27,6 +27,7 @@ from esphome.const import (
     CONF_DUMMY_RECEIVER,
     CONF_DUMMY_RECEIVER_ID,
     CONF_LAMBDA,
+    CONF_ESPHOME,
 )
 from esphome.core import CORE
 
@@ -100,6 +101,7 @@ UART_PARITY_OPTIONS = {
 }
 
 CONF_STOP_BITS = "stop_bits"
+CONF_TICKLESS_IDLE = "tickless_idle"
 CONF_DATA_BITS = "data_bits"
 CONF_PARITY = "parity"
 
@@ -180,6 +182,24 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _final_validate(config):
+    # Only the ESP-IDF implementation wakes the loop from its tickless sleep when data arrives
+    if (
+        CORE.is_esp32
+        and CORE.using_arduino
+        and CONF_RX_PIN in config
+        and CONF_TICKLESS_IDLE in fv.full_config.get()[CONF_ESPHOME]
+    ):
+        raise cv.Invalid(
+            "tickless_idle requires the esp-idf framework when a uart bus has an rx_pin, "
+            "with the arduino framework received data would only be read every max_sleep_time"
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def debug_to_code(config, parent):
     trigger = cg.new_Pvariable(config[CONF_TRIGGER_ID], parent)
     await cg.register_component(trigger, config)
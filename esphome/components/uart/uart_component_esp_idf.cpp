@@ -14,6 +14,20 @@ namespace esphome {
 namespace uart {
 static const char *const TAG = "uart.idf";
 
+#ifdef USE_TICKLESS_IDLE
+// Events beyond this are dropped by the driver, which is fine as any single one wakes the loop.
+static const int RX_EVENT_QUEUE_SIZE = 8;
+
+static void rx_wake_task(void *arg) {
+  auto queue = static_cast<QueueHandle_t>(arg);
+  uart_event_t event;
+  while (true) {
+    if (xQueueReceive(queue, &event, portMAX_DELAY) == pdTRUE)
+      App.wake_loop();
+  }
+}
+#endif
+
 uart_config_t IDFUARTComponent::get_config_() {
   uart_parity_t parity = UART_PARITY_DISABLE;
   if (this->parity_ == UART_CONFIG_PARITY_EVEN)
@@ -78,12 +92,25 @@ void IDFUARTComponent::setup() {
     return;
   }
 
-  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, 0, nullptr, 0);
+  QueueHandle_t *event_queue = nullptr;
+#ifdef USE_TICKLESS_IDLE
+  // Devices only read the UART in loop(), so received data has to wake the loop from its tickless sleep
+  if (this->rx_pin_ != nullptr)
+    event_queue = &this->rx_event_queue_;
+#endif
+  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, event_queue != nullptr ? RX_EVENT_QUEUE_SIZE : 0,
+                            event_queue, 0);
   if (err != ESP_OK) {
     ESP_LOGW(TAG, "uart_driver_install failed: %s", esp_err_to_name(err));
     this->mark_failed();
     return;
   }
+#ifdef USE_TICKLESS_IDLE
+  if (event_queue != nullptr &&
+      xTaskCreate(rx_wake_task, "uart_wake", 2048, this->rx_event_queue_, 5, nullptr) != pdPASS) {
+    ESP_LOGW(TAG, "Could not start the UART wake task, received data is only read every max_sleep_time");
+  }
+#endif
 
   int8_t tx = this->tx_pin_ != nullptr ? this->tx_pin_->get_pin() : -1;
   int8_t rx = this->rx_pin_ != nullptr ? this->rx_pin_->get_pin() : -1;
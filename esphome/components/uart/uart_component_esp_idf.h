@@ -4,6 +4,7 @@
 
 #include <driver/uart.h>
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "uart_component.h"
 
 namespace esphome {
@@ -31,6 +32,9 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool has_peek_{false};
   uint8_t peek_byte_;
+#ifdef USE_TICKLESS_IDLE
+  QueueHandle_t rx_event_queue_{nullptr};
+#endif
 };
 
 }  // namespace uart
@@ -1,3 +1,7 @@
+import gzip
+import hashlib
+import io
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
@@ -15,10 +19,14 @@ from esphome.const import (
     CONF_INCLUDE_INTERNAL,
     CONF_OTA,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, HexInt, coroutine_with_priority
 
 AUTO_LOAD = ["json", "web_server_base"]
 
+CONF_EVENTS_FLUSH_INTERVAL = "events_flush_interval"
+CONF_CSS_INCLUDE_DATA_ID = "css_include_data_id"
+CONF_JS_INCLUDE_DATA_ID = "js_include_data_id"
+
 web_server_ns = cg.esphome_ns.namespace("web_server")
 WebServer = web_server_ns.class_("WebServer", cg.Component, cg.Controller)
 
@@ -31,10 +39,12 @@ CONFIG_SCHEMA = cv.All(
                 CONF_CSS_URL, default="https://esphome.io/_static/webserver-v1.min.css"
             ): cv.string,
             cv.Optional(CONF_CSS_INCLUDE): cv.file_,
+            cv.GenerateID(CONF_CSS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
             cv.Optional(
                 CONF_JS_URL, default="https://esphome.io/_static/webserver-v1.min.js"
             ): cv.string,
             cv.Optional(CONF_JS_INCLUDE): cv.file_,
+            cv.GenerateID(CONF_JS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
             cv.Optional(CONF_AUTH): cv.Schema(
                 {
                     cv.Required(CONF_USERNAME): cv.All(
@@ -50,12 +60,28 @@ CONFIG_SCHEMA = cv.All(
             ),
             cv.Optional(CONF_INCLUDE_INTERNAL, default=False): cv.boolean,
             cv.Optional(CONF_OTA, default=True): cv.boolean,
+            cv.Optional(
+                CONF_EVENTS_FLUSH_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
         },
     ).extend(cv.COMPONENT_SCHEMA),
     cv.only_with_arduino,
 )
 
 
+def compress_include(file):
+    """Gzip an included file for serving it straight from flash, returns the bytes and a strong ETag."""
+    path = CORE.relative_config_path(file)
+    with open(file=path, mode="rb") as myfile:
+        content = myfile.read()
+    buffer = io.BytesIO()
+    # Without a timestamp the output only depends on the content, so it's the same for every build
+    with gzip.GzipFile(fileobj=buffer, mode="wb", compresslevel=9, mtime=0) as f:
+        f.write(content)
+    etag = f'"{hashlib.sha256(content).hexdigest()[:16]}"'
+    return [HexInt(x) for x in buffer.getvalue()], etag
+
+
 @coroutine_with_priority(40.0)
 async def to_code(config):
     paren = await cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
@@ -71,17 +97,18 @@ async def to_code(config):
     cg.add(var.set_css_url(config[CONF_CSS_URL]))
     cg.add(var.set_js_url(config[CONF_JS_URL]))
     cg.add(var.set_allow_ota(config[CONF_OTA]))
+    cg.add(var.set_events_flush_interval(config[CONF_EVENTS_FLUSH_INTERVAL]))
     if CONF_AUTH in config:
         cg.add(paren.set_auth_username(config[CONF_AUTH][CONF_USERNAME]))
         cg.add(paren.set_auth_password(config[CONF_AUTH][CONF_PASSWORD]))
     if CONF_CSS_INCLUDE in config:
         cg.add_define("WEBSERVER_CSS_INCLUDE")
-        path = CORE.relative_config_path(config[CONF_CSS_INCLUDE])
-        with open(file=path, mode="r", encoding="utf-8") as myfile:
-            cg.add(var.set_css_include(myfile.read()))
+        data, etag = compress_include(config[CONF_CSS_INCLUDE])
+        arr = cg.progmem_array(config[CONF_CSS_INCLUDE_DATA_ID], data)
+        cg.add(var.set_css_include(arr, len(data), etag))
     if CONF_JS_INCLUDE in config:
         cg.add_define("WEBSERVER_JS_INCLUDE")
-        path = CORE.relative_config_path(config[CONF_JS_INCLUDE])
-        with open(file=path, mode="r", encoding="utf-8") as myfile:
-            cg.add(var.set_js_include(myfile.read()))
+        data, etag = compress_include(config[CONF_JS_INCLUDE])
+        arr = cg.progmem_array(config[CONF_JS_INCLUDE_DATA_ID], data)
+        cg.add(var.set_js_include(arr, len(data), etag))
     cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
@@ -0,0 +1,41 @@
+#include "etag.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace web_server {
+
+bool etag_matches(const char *if_none_match, const char *etag) {
+  const size_t etag_len = strlen(etag);
+  const char *p = if_none_match;
+  while (*p != '\0') {
+    while (*p == ' ' || *p == '\t' || *p == ',')
+      p++;
+    if (*p == '\0')
+      break;
+    if (*p == '*')
+      return true;
+    if (p[0] == 'W' && p[1] == '/')
+      p += 2;
+    const char *end = p;
+    if (*end == '"') {
+      // The quotes are part of the ETag, it ends after the closing one
+      end = strchr(end + 1, '"');
+      end = end == nullptr ? p + strlen(p) : end + 1;
+    } else {
+      while (*end != '\0' && *end != ',' && *end != ' ' && *end != '\t')
+        end++;
+    }
+    const bool complete = *end == '\0' || *end == ',' || *end == ' ' || *end == '\t';
+    if (complete && static_cast<size_t>(end - p) == etag_len && strncmp(p, etag, etag_len) == 0)
+      return true;
+    // Skip the rest of a malformed entry
+    while (*end != '\0' && *end != ',')
+      end++;
+    p = end;
+  }
+  return false;
+}
+
+}  // namespace web_server
+}  // namespace esphome
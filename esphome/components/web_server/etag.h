@@ -0,0 +1,16 @@
+#pragma once
+
+namespace esphome {
+namespace web_server {
+
+/** Whether an If-None-Match request header matches the ETag of a resource, so that 304 Not Modified can be sent.
+ *
+ * The header may list several ETags separated by commas or be "*". ETags are compared with the weak comparison of
+ * RFC 7232, a "W/" prefix is ignored, since browsers mark the ETags of responses they decompressed as weak.
+ *
+ * @param etag The strong ETag of the resource, including the quotes.
+ */
+bool etag_matches(const char *if_none_match, const char *etag);
+
+}  // namespace web_server
+}  // namespace esphome
@@ -0,0 +1,46 @@
+#include "state_event_queue.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace web_server {
+
+void StateEventQueue::push(EntityBase *obj, StateEventType type, bool binary_state) {
+  if (type == StateEventType::BINARY_SENSOR) {
+    // Only a repeat of the last queued state is dropped
+    for (auto it = this->events_.rbegin(); it != this->events_.rend(); ++it) {
+      if (it->obj == obj) {
+        if (it->binary_state != binary_state)
+          break;
+        this->coalesced_++;
+        return;
+      }
+    }
+  } else {
+    for (auto &event : this->events_) {
+      if (event.obj == obj) {
+        this->coalesced_++;
+        return;
+      }
+    }
+  }
+  if (this->events_.empty())
+    this->pending_since_ = millis();
+  this->events_.push_back(PendingStateEvent{obj, type, binary_state});
+}
+bool StateEventQueue::is_due(uint32_t now, bool clients_backed_up) const {
+  if (this->events_.empty() || now - this->last_flush_ < this->flush_interval_)
+    return false;
+  return !clients_backed_up || now - this->pending_since_ >= this->max_hold_back_;
+}
+void StateEventQueue::sent(uint32_t now) {
+  this->events_.clear();
+  this->last_flush_ = now;
+}
+uint32_t StateEventQueue::take_coalesced() {
+  const uint32_t coalesced = this->coalesced_;
+  this->coalesced_ = 0;
+  return coalesced;
+}
+
+}  // namespace web_server
+}  // namespace esphome
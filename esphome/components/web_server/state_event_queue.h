@@ -0,0 +1,73 @@
+#pragma once
+
+#include "esphome/core/entity_base.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace web_server {
+
+enum class StateEventType : uint8_t {
+  BINARY_SENSOR,
+  COVER,
+  FAN,
+  LIGHT,
+  NUMBER,
+  SELECT,
+  SENSOR,
+  SWITCH,
+  TEXT_SENSOR,
+};
+
+struct PendingStateEvent {
+  EntityBase *obj;
+  StateEventType type;
+  /// The state to send for binary sensors, whose changes aren't coalesced.
+  bool binary_state;
+};
+
+/** The state events that wait to be sent to the event source clients.
+ *
+ * Every entity has at most one queued event and its state is read from the entity when the event is sent, so a newer
+ * state replaces one that wasn't sent yet. Binary sensors are the exception: every change is queued with its state, so
+ * that a pulse (e.g. motion or a button press) isn't lost.
+ */
+class StateEventQueue {
+ public:
+  /// Queue the state event of an entity, `binary_state` is only used for binary sensors.
+  void push(EntityBase *obj, StateEventType type, bool binary_state = false);
+
+  /** Whether the queued events should be sent now.
+   *
+   * They wait until the flush interval passed since the last events were sent. While the clients are backed up they
+   * are held back, but at most max_hold_back milliseconds after the oldest of them was queued, so that a single stalled
+   * client can't hold back the events of all the others.
+   */
+  bool is_due(uint32_t now, bool clients_backed_up) const;
+
+  const std::vector<PendingStateEvent> &events() const { return this->events_; }
+  bool empty() const { return this->events_.empty(); }
+  /// Drop the queued events without sending them.
+  void clear() { this->events_.clear(); }
+  /// Forget the queued events after they were sent.
+  void sent(uint32_t now);
+  /// Events that were replaced by a newer state since the last call.
+  uint32_t take_coalesced();
+
+  void set_flush_interval(uint32_t flush_interval) { this->flush_interval_ = flush_interval; }
+  uint32_t get_flush_interval() const { return this->flush_interval_; }
+  void set_max_hold_back(uint32_t max_hold_back) { this->max_hold_back_ = max_hold_back; }
+
+ protected:
+  std::vector<PendingStateEvent> events_;
+  uint32_t flush_interval_{0};
+  uint32_t max_hold_back_{1000};
+  uint32_t last_flush_{0};
+  /// When the oldest of the queued events was queued.
+  uint32_t pending_since_{0};
+  uint32_t coalesced_{0};
+};
+
+}  // namespace web_server
+}  // namespace esphome
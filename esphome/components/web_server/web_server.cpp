@@ -1,11 +1,13 @@
 #ifdef USE_ARDUINO
 
 #include "web_server.h"
+#include "etag.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
 #include "esphome/core/util.h"
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 
 #include "StreamString.h"
@@ -29,6 +31,10 @@ namespace web_server {
 
 static const char *const TAG = "web_server";
 
+// Hold back state events while the event source clients have this many messages waiting on average, so that the
+// coalescing keeps slow clients from overflowing their queues. StateEventQueue limits how long they are held back.
+static const size_t EVENTS_MAX_PACKETS_WAITING = 8;
+
 void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &klass, const std::string &action,
                const std::function<void(AsyncResponseStream &stream, EntityBase *obj)> &action_func = nullptr) {
   stream->print("<tr class=\"");
@@ -77,15 +83,27 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
 }
 
 void WebServer::set_css_url(const char *css_url) { this->css_url_ = css_url; }
-void WebServer::set_css_include(const char *css_include) { this->css_include_ = css_include; }
+void WebServer::set_css_include(const uint8_t *css_include, size_t css_include_size, const char *css_include_etag) {
+  this->css_include_ = css_include;
+  this->css_include_size_ = css_include_size;
+  this->css_include_etag_ = css_include_etag;
+}
 void WebServer::set_js_url(const char *js_url) { this->js_url_ = js_url; }
-void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_include; }
+void WebServer::set_js_include(const uint8_t *js_include, size_t js_include_size, const char *js_include_etag) {
+  this->js_include_ = js_include;
+  this->js_include_size_ = js_include_size;
+  this->js_include_etag_ = js_include_etag;
+}
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
   this->setup_controller(this->include_internal_);
   this->base_->init();
 
+  char etag[11];
+  snprintf(etag, sizeof(etag), "\"%08x\"", fnv1_hash(App.get_name() + App.get_compilation_time()));
+  this->index_etag_ = etag;
+
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout
     client->send("", "ping", millis(), 30000);
@@ -158,14 +176,114 @@ void WebServer::setup() {
 
   this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
 }
+void WebServer::loop() {
+  if (this->state_events_.empty())
+    return;
+  if (this->events_.count() == 0) {
+    // Clients get the current state of all entities when they connect
+    this->state_events_.clear();
+    return;
+  }
+  const uint32_t now = millis();
+  if (!this->state_events_.is_due(now, this->events_.avgPacketsWaiting() >= EVENTS_MAX_PACKETS_WAITING))
+    return;
+
+  for (auto &event : this->state_events_.events())
+    this->events_.send(this->state_event_json_(event).c_str(), "state");
+  this->state_events_.sent(now);
+
+  const uint32_t coalesced = this->state_events_.take_coalesced();
+  if (coalesced != 0)
+    ESP_LOGV(TAG, "Coalesced %u state events", coalesced);
+}
+std::string WebServer::state_event_json_(const PendingStateEvent &event) {
+  switch (event.type) {
+#ifdef USE_BINARY_SENSOR
+    case StateEventType::BINARY_SENSOR:
+      return this->binary_sensor_json(static_cast<binary_sensor::BinarySensor *>(event.obj), event.binary_state);
+#endif
+#ifdef USE_COVER
+    case StateEventType::COVER:
+      return this->cover_json(static_cast<cover::Cover *>(event.obj));
+#endif
+#ifdef USE_FAN
+    case StateEventType::FAN:
+      return this->fan_json(static_cast<fan::FanState *>(event.obj));
+#endif
+#ifdef USE_LIGHT
+    case StateEventType::LIGHT:
+      return this->light_json(static_cast<light::LightState *>(event.obj));
+#endif
+#ifdef USE_NUMBER
+    case StateEventType::NUMBER: {
+      auto *number = static_cast<number::Number *>(event.obj);
+      return this->number_json(number, number->state);
+    }
+#endif
+#ifdef USE_SELECT
+    case StateEventType::SELECT: {
+      auto *select = static_cast<select::Select *>(event.obj);
+      return this->select_json(select, select->state);
+    }
+#endif
+#ifdef USE_SENSOR
+    case StateEventType::SENSOR: {
+      auto *sensor = static_cast<sensor::Sensor *>(event.obj);
+      return this->sensor_json(sensor, sensor->state);
+    }
+#endif
+#ifdef USE_SWITCH
+    case StateEventType::SWITCH: {
+      auto *a_switch = static_cast<switch_::Switch *>(event.obj);
+      return this->switch_json(a_switch, a_switch->state);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case StateEventType::TEXT_SENSOR: {
+      auto *text_sensor = static_cast<text_sensor::TextSensor *>(event.obj);
+      return this->text_sensor_json(text_sensor, text_sensor->state);
+    }
+#endif
+    default:
+      return "";
+  }
+}
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->base_->get_port());
+  if (this->state_events_.get_flush_interval() != 0)
+    ESP_LOGCONFIG(TAG, "  Events Flush Interval: %u ms", this->state_events_.get_flush_interval());
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
+bool WebServer::send_not_modified_(AsyncWebServerRequest *request, const char *etag) {
+  if (!request->hasHeader("If-None-Match") || !etag_matches(request->header("If-None-Match").c_str(), etag))
+    return false;
+  AsyncWebServerResponse *response = request->beginResponse(304);
+  response->addHeader("ETag", etag);
+  request->send(response);
+  return true;
+}
+
+void WebServer::send_include_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data,
+                              size_t size, const char *etag) {
+  if (this->send_not_modified_(request, etag))
+    return;
+  // Sent in chunks straight from flash, the file is never copied to RAM as a whole
+  AsyncWebServerResponse *response = request->beginResponse_P(200, content_type, data, size);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", etag);
+  // Let browsers revalidate, so that a new firmware's files are picked up right away
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
+  if (this->send_not_modified_(request, this->index_etag_.c_str()))
+    return;
   AsyncResponseStream *stream = request->beginResponseStream("text/html");
+  stream->addHeader("ETag", this->index_etag_.c_str());
+  stream->addHeader("Cache-Control", "no-cache");
   std::string title = App.get_name() + " Web Server";
   stream->print(F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=UTF-8>"
                   "<meta name=\"viewport\" content=\"width=device-width, "
@@ -281,29 +399,19 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 
 #ifdef WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/css");
-  if (this->css_include_ != nullptr) {
-    stream->print(this->css_include_);
-  }
-
-  request->send(stream);
+  this->send_include_(request, "text/css", this->css_include_, this->css_include_size_, this->css_include_etag_);
 }
 #endif
 
 #ifdef WEBSERVER_JS_INCLUDE
 void WebServer::handle_js_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/javascript");
-  if (this->js_include_ != nullptr) {
-    stream->print(this->js_include_);
-  }
-
-  request->send(stream);
+  this->send_include_(request, "text/javascript", this->js_include_, this->js_include_size_, this->js_include_etag_);
 }
 #endif
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::SENSOR);
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -316,20 +424,20 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "sensor-" + obj->get_object_id();
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "sensor-" + obj->get_object_id());
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
     if (!obj->get_unit_of_measurement().empty())
       state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
+    root.add("state", state);
+    root.add("value", value);
   });
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::TEXT_SENSOR);
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -342,23 +450,23 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
   request->send(404);
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "text_sensor-" + obj->get_object_id());
+    root.add("state", value);
+    root.add("value", value);
   });
 }
 #endif
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::SWITCH);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "switch-" + obj->get_object_id());
+    root.add("state", value ? "ON" : "OFF");
+    root.add("value", value);
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -407,13 +515,13 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::BINARY_SENSOR, state);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "binary_sensor-" + obj->get_object_id());
+    root.add("state", value ? "ON" : "OFF");
+    root.add("value", value);
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -429,33 +537,33 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::FanState *obj) { this->events_.send(this->fan_json(obj).c_str(), "state"); }
+void WebServer::on_fan_update(fan::FanState *obj) { this->state_events_.push(obj, StateEventType::FAN); }
 std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.add("id", "fan-" + obj->get_object_id());
+    root.add("state", obj->state ? "ON" : "OFF");
+    root.add("value", obj->state);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
+      root.add("speed_level", obj->speed);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
       // NOLINTNEXTLINE(clang-diagnostic-deprecated-declarations)
       switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
         case fan::FAN_SPEED_LOW:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "low";
+          root.add("speed", "low");
           break;
         case fan::FAN_SPEED_MEDIUM:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "medium";
+          root.add("speed", "medium");
           break;
         case fan::FAN_SPEED_HIGH:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "high";
+          root.add("speed", "high");
           break;
       }
 #pragma GCC diagnostic pop
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.add("oscillation", obj->oscillating);
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -520,7 +628,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 #endif
 
 #ifdef USE_LIGHT
-void WebServer::on_light_update(light::LightState *obj) { this->events_.send(this->light_json(obj).c_str(), "state"); }
+void WebServer::on_light_update(light::LightState *obj) { this->state_events_.push(obj, StateEventType::LIGHT); }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
     if (obj->get_object_id() != match.id)
@@ -580,16 +688,16 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "light-" + obj->get_object_id();
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.add("id", "light-" + obj->get_object_id());
+    // The state is written by dump_json()
     light::LightJSONSchema::dump_json(*obj, root);
   });
 }
 #endif
 
 #ifdef USE_COVER
-void WebServer::on_cover_update(cover::Cover *obj) { this->events_.send(this->cover_json(obj).c_str(), "state"); }
+void WebServer::on_cover_update(cover::Cover *obj) { this->state_events_.push(obj, StateEventType::COVER); }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
     if (obj->get_object_id() != match.id)
@@ -632,21 +740,21 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.add("id", "cover-" + obj->get_object_id());
+    root.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+    root.add("value", obj->position);
+    root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.add("tilt", obj->tilt);
   });
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::NUMBER);
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
@@ -659,19 +767,19 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::number_json(number::Number *obj, float value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "number-" + obj->get_object_id();
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "number-" + obj->get_object_id());
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "%f", value);
-    root["state"] = buffer;
-    root["value"] = value;
+    root.add("state", buffer);
+    root.add("value", value);
   });
 }
 #endif
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state) {
-  this->events_.send(this->select_json(obj, state).c_str(), "state");
+  this->state_events_.push(obj, StateEventType::SELECT);
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
@@ -703,27 +811,27 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "select-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "select-" + obj->get_object_id());
+    root.add("state", value);
+    root.add("value", value);
   });
 }
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
-  if (request->url() == "/")
-    return true;
-
+  bool cached = request->url() == "/";
 #ifdef WEBSERVER_CSS_INCLUDE
-  if (request->url() == "/0.css")
-    return true;
+  cached |= request->url() == "/0.css";
 #endif
-
 #ifdef WEBSERVER_JS_INCLUDE
-  if (request->url() == "/0.js")
-    return true;
+  cached |= request->url() == "/0.js";
 #endif
+  if (cached) {
+    // AsyncWebServer drops the request headers that no handler asked for while it parses them
+    request->addInterestingHeader("If-None-Match");
+    return true;
+  }
 
   UrlMatch match = match_url(request->url().c_str(), true);
   if (!match.valid)
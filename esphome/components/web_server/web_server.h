@@ -5,6 +5,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "state_event_queue.h"
 
 #include <vector>
 
@@ -39,11 +40,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_css_url(const char *css_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the stylesheet that's served under '/0.css', gzipped at build time and stored in flash.
    *
-   * @param css_include Local path to web server script.
+   * @param css_include The gzipped stylesheet.
+   * @param css_include_size The size of the gzipped stylesheet.
+   * @param css_include_etag The strong ETag of the stylesheet, including the quotes.
    */
-  void set_css_include(const char *css_include);
+  void set_css_include(const uint8_t *css_include, size_t css_include_size, const char *css_include_etag);
 
   /** Set the URL to the script that's embedded in the index page. Defaults to
    * https://esphome.io/_static/webserver-v1.min.js
@@ -52,11 +55,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_js_url(const char *js_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the script that's served under '/0.js', gzipped at build time and stored in flash.
    *
-   * @param js_include Local path to web server script.
+   * @param js_include The gzipped script.
+   * @param js_include_size The size of the gzipped script.
+   * @param js_include_etag The strong ETag of the script, including the quotes.
    */
-  void set_js_include(const char *js_include);
+  void set_js_include(const uint8_t *js_include, size_t js_include_size, const char *js_include_etag);
 
   /** Determine whether internal components should be displayed on the web server.
    * Defaults to false.
@@ -69,11 +74,22 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    * @param allow_ota.
    */
   void set_allow_ota(bool allow_ota) { this->allow_ota_ = allow_ota; }
+  /** Set the minimum time between two batches of state events. Defaults to 0, sending them every loop iteration.
+   *
+   * Only the latest state of an entity is sent, so changes in between are coalesced.
+   *
+   * @param events_flush_interval The interval in milliseconds.
+   */
+  void set_events_flush_interval(uint32_t events_flush_interval) {
+    this->state_events_.set_flush_interval(events_flush_interval);
+  }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
   void setup() override;
+  /// Send the queued state events to the event source clients.
+  void loop() override;
 
   void dump_config() override;
 
@@ -193,14 +209,30 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// Serialize the current state of a queued state event.
+  std::string state_event_json_(const PendingStateEvent &event);
+
+  /// Answer with 304 Not Modified if the client already has the version with this ETag.
+  bool send_not_modified_(AsyncWebServerRequest *request, const char *etag);
+  /// Serve a gzipped file straight from flash.
+  void send_include_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data, size_t size,
+                     const char *etag);
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   const char *css_url_{nullptr};
-  const char *css_include_{nullptr};
+  const uint8_t *css_include_{nullptr};
+  size_t css_include_size_{0};
+  const char *css_include_etag_{nullptr};
   const char *js_url_{nullptr};
-  const char *js_include_{nullptr};
+  const uint8_t *js_include_{nullptr};
+  size_t js_include_size_{0};
+  const char *js_include_etag_{nullptr};
+  /// The index page only changes with the firmware, this identifies the firmware.
+  std::string index_etag_;
   bool include_internal_{false};
   bool allow_ota_{true};
+  StateEventQueue state_events_;
 };
 
 }  // namespace web_server
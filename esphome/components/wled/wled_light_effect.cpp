@@ -21,6 +21,8 @@ namespace wled {
 enum Protocol { WLED_NOTIFIER = 0, WARLS = 1, DRGB = 2, DRGBW = 3, DNRGB = 4 };
 
 const int DEFAULT_BLANK_TIME = 1000;
+// The UDP payload of a 1500 byte MTU, which is also the largest frame WLED sends (490 LEDs)
+const size_t MAX_PACKET_SIZE = 1472;
 
 static const char *const TAG = "wled_light_effect";
 
@@ -39,12 +41,12 @@ void WLEDLightEffect::stop() {
     udp_->stop();
     udp_.reset();
   }
+  payload_.clear();
+  payload_.shrink_to_fit();
 }
 
 void WLEDLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(Color::BLACK);
-  }
+  it.all() = Color::BLACK;
   it.schedule_show();
 }
 
@@ -52,6 +54,7 @@ void WLEDLightEffect::apply(light::AddressableLight &it, const Color &current_co
   // Init UDP lazily
   if (!udp_) {
     udp_ = make_unique<WiFiUDP>();
+    payload_.resize(MAX_PACKET_SIZE);
 
     if (!udp_->begin(port_)) {
       ESP_LOGW(TAG, "Cannot bind WLEDLightEffect to %d.", port_);
@@ -59,16 +62,22 @@ void WLEDLightEffect::apply(light::AddressableLight &it, const Color &current_co
     }
   }
 
-  std::vector<uint8_t> payload;
+  // Frames are written straight into the LED buffer, so when several are waiting the last one wins
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    int len = udp_->read(&payload_[0], payload_.size());
+    if (len <= 0) {
+      continue;
+    }
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (packet_size > payload_.size()) {
+      while (udp_->read(&payload_[0], payload_.size()) > 0) {
+      }
+      ESP_LOGD(TAG, "Frame: Too large (size=%d).", packet_size);
       continue;
     }
 
-    if (!this->parse_frame_(it, &payload[0], payload.size())) {
-      ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", payload.size(), payload[0]);
+    if (!this->parse_frame_(it, &payload_[0], len)) {
+      ESP_LOGD(TAG, "Frame: Invalid (size=%d, first=0x%02X).", len, payload_[0]);
       continue;
     }
   }
@@ -176,19 +185,7 @@ bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 3) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
-  }
-
+  it.set_range_raw(0, payload, size / 3, light::RawPixelFormat::RGB);
   return true;
 }
 
@@ -198,20 +195,7 @@ bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 4;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 4) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-    uint8_t w = payload[3];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b, w));
-    }
-  }
-
+  it.set_range_raw(0, payload, size / 4, light::RawPixelFormat::RGBW);
   return true;
 }
 
@@ -230,19 +214,7 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (; count > 0; count--, payload += 3, led++) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
-  }
-
+  it.set_range_raw(led, payload, size / 3, light::RawPixelFormat::RGB);
   return true;
 }
 
@@ -35,6 +35,8 @@ class WLEDLightEffect : public light::AddressableLightEffect {
  protected:
   uint16_t port_{0};
   std::unique_ptr<UDP> udp_;
+  /// Receive buffer, allocated once together with udp_.
+  std::vector<uint8_t> payload_;
   uint32_t blank_at_{0};
   uint32_t dropped_{0};
 };
@@ -68,6 +68,9 @@ bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std:
 
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  // Xiaomi MiBeacon service data
+  XiaomiListener() { this->set_match_uuid16(0xFE95); }
+
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
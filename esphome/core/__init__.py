@@ -581,6 +581,10 @@ class EsphomeCore:
     def firmware_bin(self):
         return self.relative_pioenvs_path(self.name, "firmware.bin")
 
+    @property
+    def firmware_elf(self):
+        return self.relative_pioenvs_path(self.name, "firmware.elf")
+
     @property
     def target_platform(self):
         return self.data[KEY_CORE][KEY_TARGET_PLATFORM]
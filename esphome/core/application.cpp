@@ -7,10 +7,32 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#if defined(USE_TICKLESS_IDLE) && defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/timers.h>
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+#include <lwip/sockets.h>
+#include <atomic>
+#endif
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#if defined(USE_TICKLESS_IDLE) && defined(USE_ESP32)
+// The task the loop runs in, notified by wake_loop() when there are no wake sockets to select() on.
+static TaskHandle_t loop_task_handle = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+// A loopback UDP socket that wake_loop() sends a byte to, so that it can interrupt select().
+static int wake_fd = -1;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Set while the loop waits in select(), so that wake_loop() knows it has to send to wake_fd. Unlike the wake
+// sockets, which only the loop touches, this is read from other tasks and from interrupts.
+static std::atomic<bool> loop_selecting{false};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -59,6 +81,30 @@ void Application::setup() {
     } while (!component->can_proceed());
   }
 
+#if defined(USE_TICKLESS_IDLE) && defined(USE_ESP32)
+  loop_task_handle = xTaskGetCurrentTaskHandle();
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+  wake_fd = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+  if (wake_fd >= 0) {
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrlen = sizeof(addr);
+    // Bind to an ephemeral loopback port and connect to ourselves, so that a plain send() wakes up select()
+    if (lwip_bind(wake_fd, reinterpret_cast<struct sockaddr *>(&addr), addrlen) != 0 ||
+        lwip_getsockname(wake_fd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen) != 0 ||
+        lwip_connect(wake_fd, reinterpret_cast<struct sockaddr *>(&addr), addrlen) != 0) {
+      ESP_LOGW(TAG, "Could not set up loop wake socket, sockets will only be polled every max_sleep_time");
+      lwip_close(wake_fd);
+      wake_fd = -1;
+    } else {
+      int flags = lwip_fcntl(wake_fd, F_GETFL, 0);
+      lwip_fcntl(wake_fd, F_SETFL, flags | O_NONBLOCK);
+    }
+  }
+#endif
+#endif
+
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
@@ -84,6 +130,15 @@ void Application::loop() {
   if (HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
   } else {
+#if defined(USE_TICKLESS_IDLE) && defined(USE_ESP32)
+    uint32_t sleep_time = this->scheduler.next_schedule_in().value_or(this->max_sleep_time_);
+    sleep_time = std::min(sleep_time, this->max_sleep_time_);
+    if (sleep_time == 0) {
+      yield();
+    } else {
+      this->idle_wait_(sleep_time);
+    }
+#else
     uint32_t delay_time = this->loop_interval_;
     if (now - this->last_loop_ < this->loop_interval_)
       delay_time = this->loop_interval_ - (now - this->last_loop_);
@@ -94,6 +149,7 @@ void Application::loop() {
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -123,6 +179,107 @@ void IRAM_ATTR HOT Application::feed_wdt() {
 #endif
   }
 }
+#if defined(USE_TICKLESS_IDLE) && defined(USE_ESP32)
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+static void wake_loop_deferred(void *arg1, uint32_t arg2) { App.wake_loop(); }
+#endif
+
+void Application::idle_wait_(uint32_t ms) {
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+  if (wake_fd >= 0 && (!this->wake_sockets_.empty() || !this->write_wake_sockets_.empty())) {
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(wake_fd, &read_fds);
+    int max_fd = wake_fd;
+    for (int fd : this->wake_sockets_) {
+      FD_SET(fd, &read_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    for (int fd : this->write_wake_sockets_) {
+      FD_SET(fd, &write_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+    fd_set *write_fds_ptr = this->write_wake_sockets_.empty() ? nullptr : &write_fds;
+    this->write_wake_sockets_.clear();
+    struct timeval tv;
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    // A wake before this point is still pending as a task notification
+    loop_selecting.store(true);
+    if (ulTaskNotifyTake(pdTRUE, 0) != 0) {
+      loop_selecting.store(false);
+      return;
+    }
+    int ret = lwip_select(max_fd + 1, &read_fds, write_fds_ptr, nullptr, &tv);
+    loop_selecting.store(false);
+    if (ret > 0 && FD_ISSET(wake_fd, &read_fds)) {
+      uint8_t buf[16];
+      while (lwip_recv(wake_fd, buf, sizeof(buf), 0) > 0) {
+      }
+    }
+    // Clear any notification that was given while we weren't waiting on it
+    ulTaskNotifyTake(pdTRUE, 0);
+    return;
+  }
+#endif
+  // Without select() queued data can only be retried by polling, at the rate the loop would run without tickless idle
+  if (!this->write_wake_sockets_.empty()) {
+    ms = std::min(ms, this->loop_interval_);
+    this->write_wake_sockets_.clear();
+  }
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+void Application::wake_loop() {
+  if (loop_task_handle == nullptr)
+    return;
+  xTaskNotifyGive(loop_task_handle);
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+  if (loop_selecting.load()) {
+    const uint8_t dummy = 0;
+    lwip_send(wake_fd, &dummy, 1, 0);
+  }
+#endif
+}
+void IRAM_ATTR Application::wake_loop_isr() {
+  if (loop_task_handle == nullptr)
+    return;
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  vTaskNotifyGiveFromISR(loop_task_handle, &higher_priority_task_woken);
+#ifdef USE_SOCKET_IMPL_BSD_SOCKETS
+  if (loop_selecting.load()) {
+    // Sockets can't be used from an ISR, let the timer task do the wakeup for us
+    xTimerPendFunctionCallFromISR(wake_loop_deferred, nullptr, 0, &higher_priority_task_woken);
+  }
+#endif
+  if (higher_priority_task_woken == pdTRUE)
+    portYIELD_FROM_ISR();
+}
+void Application::register_wake_socket(int fd) {
+  if (fd < 0)
+    return;
+  this->wake_sockets_.push_back(fd);
+}
+void Application::unregister_wake_socket(int fd) {
+  // Only remove one entry: a closed fd may already have been re-used and registered by a new socket
+  auto it = std::find(this->wake_sockets_.begin(), this->wake_sockets_.end(), fd);
+  if (it != this->wake_sockets_.end())
+    this->wake_sockets_.erase(it);
+}
+void Application::wake_when_writable(int fd) {
+  if (fd < 0)
+    return;
+  this->write_wake_sockets_.push_back(fd);
+}
+#else
+void Application::wake_loop() {}
+void IRAM_ATTR Application::wake_loop_isr() {}
+void Application::register_wake_socket(int fd) {}
+void Application::unregister_wake_socket(int fd) {}
+void Application::wake_when_writable(int fd) {}
+#endif
+
 void Application::reboot() {
   ESP_LOGI(TAG, "Forcing a reboot...");
   for (auto *comp : this->components_)
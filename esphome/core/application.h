@@ -139,6 +139,34 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Set the maximum time the loop may sleep for when tickless idle is enabled.
+   *
+   * With tickless idle, the loop doesn't wake up every loop_interval, but sleeps until the next scheduler deadline
+   * or until a wake source fires (see wake_loop() and register_wake_socket()). Components that poll in loop()
+   * without registering a wake source are still called at least once every max_sleep_time milliseconds, but no more
+   * often than that, so they react up to max_sleep_time late. The native API, OTA, the logger, rotary encoders, GPIO
+   * binary sensors on internal pins and UART buses receiving data (ESP-IDF only) wake the loop.
+   *
+   * Tickless idle is only implemented on ESP32, other platforms keep using the loop_interval based polling.
+   */
+#ifdef USE_TICKLESS_IDLE
+  void set_max_sleep_time(uint32_t max_sleep_time) { this->max_sleep_time_ = max_sleep_time; }
+#endif
+
+  /// Wake up the loop if it's currently sleeping. Safe to call from other tasks, but not from an interrupt.
+  void wake_loop();
+  /// Wake up the loop if it's currently sleeping, from within an interrupt handler.
+  static void wake_loop_isr();
+  /// Wake up the loop whenever the given socket file descriptor becomes readable. Must be called from the loop.
+  void register_wake_socket(int fd);
+  void unregister_wake_socket(int fd);
+  /** Wake up the loop when the given socket becomes writable, only for the next time the loop sleeps.
+   *
+   * For sockets with data queued that the socket couldn't take yet, so that it is sent as soon as there's room
+   * instead of after max_sleep_time. Must be called from the loop.
+   */
+  void wake_when_writable(int fd);
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -269,6 +297,10 @@ class Application {
 
   void feed_wdt_arch_();
 
+#ifdef USE_TICKLESS_IDLE
+  void idle_wait_(uint32_t ms);
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -311,6 +343,11 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+#ifdef USE_TICKLESS_IDLE
+  uint32_t max_sleep_time_{1000};
+  std::vector<int> wake_sockets_{};
+  std::vector<int> write_wake_sockets_{};
+#endif
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
 };
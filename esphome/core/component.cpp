@@ -6,6 +6,10 @@
 #include "esphome/core/log.h"
 #include <utility>
 
+#ifdef USE_DEBUG_PROFILER
+#include "esphome/components/debug/component_profiler.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "component";
@@ -55,6 +59,14 @@ bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+void Component::set_interval(const char *name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, name, interval, std::move(f));
+}
+
+bool Component::cancel_interval(const char *name) {  // NOLINT
+  return App.scheduler.cancel_interval(this, name);
+}
+
 void Component::set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                           std::function<RetryResult()> &&f, float backoff_increase_factor) {  // NOLINT
   App.scheduler.set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
@@ -72,6 +84,14 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+void Component::set_timeout(const char *name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_timeout(this, name, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() { this->dump_config(); }
@@ -84,6 +104,14 @@ void Component::call() {
       // State Construction: Call setup and set state to setup
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_SETUP;
+#ifdef USE_DEBUG_PROFILER
+      if (debug::global_component_profiler != nullptr) {
+        const uint32_t start = micros();
+        this->call_setup();
+        debug::global_component_profiler->record_setup(this, micros() - start);
+        break;
+      }
+#endif
       this->call_setup();
       break;
     case COMPONENT_STATE_SETUP:
@@ -123,6 +151,12 @@ bool Component::cancel_defer(const std::string &name) {  // NOLINT
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
+bool Component::cancel_defer(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
+void Component::defer(const char *name, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, name, 0, std::move(f));
+}
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
@@ -191,8 +225,16 @@ uint32_t PollingComponent::get_update_interval() const { return this->update_int
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
 WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
-    : started_(millis()), component_(component) {}
+    : started_(millis()), component_(component) {
+#ifdef USE_DEBUG_PROFILER
+  this->started_us_ = micros();
+#endif
+}
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_DEBUG_PROFILER
+  if (debug::global_component_profiler != nullptr)
+    debug::global_component_profiler->record_loop(this->component_, micros() - this->started_us_);
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
@@ -31,7 +31,7 @@ from esphome.const import (
     TARGET_PLATFORMS,
     PLATFORM_ESP8266,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, TimePeriod, coroutine_with_priority
 from esphome.helpers import copy_file_if_changed, walk_files
 
 _LOGGER = logging.getLogger(__name__)
@@ -50,6 +50,8 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_TICKLESS_IDLE = "tickless_idle"
+CONF_MAX_SLEEP_TIME = "max_sleep_time"
 
 
 VALID_INCLUDE_EXTS = {".h", ".hpp", ".tcc", ".ino", ".cpp", ".c"}
@@ -127,6 +129,20 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            # Components that only poll in loop() without waking it are then only called
+            # every max_sleep_time. GPIO binary sensors and UART RX wake the loop.
+            cv.Optional(CONF_TICKLESS_IDLE): cv.All(
+                cv.Schema(
+                    {
+                        # Must stay well below the task watchdog timeout
+                        cv.Optional(CONF_MAX_SLEEP_TIME, default="1s"): cv.All(
+                            cv.positive_time_period_milliseconds,
+                            cv.Range(max=TimePeriod(seconds=2)),
+                        ),
+                    }
+                ),
+                cv.only_on_esp32,
+            ),
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -347,6 +363,12 @@ async def to_code(config):
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
 
+    if CONF_TICKLESS_IDLE in config:
+        cg.add_define("USE_TICKLESS_IDLE")
+        cg.add(
+            cg.App.set_max_sleep_time(config[CONF_TICKLESS_IDLE][CONF_MAX_SLEEP_TIME])
+        )
+
     if CONF_PROJECT in config:
         cg.add_define("ESPHOME_PROJECT_NAME", config[CONF_PROJECT][CONF_NAME])
         cg.add_define("ESPHOME_PROJECT_VERSION", config[CONF_PROJECT][CONF_VERSION])
@@ -19,6 +19,7 @@
 #define USE_BUTTON
 #define USE_CLIMATE
 #define USE_COVER
+#define USE_DEBUG_PROFILER
 #define USE_DEEP_SLEEP
 #define USE_FAN
 #define USE_GRAPH
@@ -57,7 +58,10 @@
 #define USE_ESP32_CAMERA
 #define USE_ESP32_IGNORE_EFUSE_MAC_CRC
 #define USE_IMPROV
+#define USE_LOGGER_ASYNC
+#define USE_LOGGER_BINARY
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_TICKLESS_IDLE
 
 #ifdef USE_ARDUINO
 #define USE_ETHERNET
@@ -9,42 +9,55 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+/// The number of interned keys below which keys that are no longer referenced are kept around.
+static const uint32_t MIN_KEY_SWEEP_THRESHOLD = 32;
+
+static uint32_t key_hash(Component *component, const char *name) {
+  uint32_t hash = 2166136261UL;
+  for (const char *c = name; *c != '\0'; c++) {
+    hash *= 16777619UL;
+    hash ^= *c;
+  }
+  return hash ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component));
+}
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
-void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+void HOT Scheduler::set_timeout(Component *component, const char *name, uint32_t timeout,
                                 std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  uint32_t key = NO_KEY;
+  if (name[0] != '\0') {
+    key = this->intern_key_(component, name);
+    this->cancel_key_(key, SchedulerItem::TIMEOUT);
+  }
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name, timeout);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
+  auto item = this->acquire_item_(component, key, SchedulerItem::TIMEOUT);
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
   item->void_callback = std::move(func);
-  item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+bool HOT Scheduler::cancel_timeout(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
 }
-void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+void HOT Scheduler::set_interval(Component *component, const char *name, uint32_t interval,
                                  std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  uint32_t key = NO_KEY;
+  if (name[0] != '\0') {
+    key = this->intern_key_(component, name);
+    this->cancel_key_(key, SchedulerItem::INTERVAL);
+  }
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -54,43 +67,39 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name, interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
+  auto item = this->acquire_item_(component, key, SchedulerItem::INTERVAL);
   item->interval = interval;
   item->last_execution = now - offset - interval;
   item->last_execution_major = this->millis_major_;
   if (item->last_execution > now)
     item->last_execution_major--;
   item->void_callback = std::move(func);
-  item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+bool HOT Scheduler::cancel_interval(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
 }
 
-void HOT Scheduler::set_retry(Component *component, const std::string &name, uint32_t initial_wait_time,
+void HOT Scheduler::set_retry(Component *component, const char *name, uint32_t initial_wait_time,
                               uint8_t max_attempts, std::function<RetryResult()> &&func,
                               float backoff_increase_factor) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_retry(component, name);
+  uint32_t key = NO_KEY;
+  if (name[0] != '\0') {
+    key = this->intern_key_(component, name);
+    this->cancel_key_(key, SchedulerItem::RETRY);
+  }
 
   if (initial_wait_time == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)", name.c_str(),
+  ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)", name,
             initial_wait_time, max_attempts, backoff_increase_factor);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::RETRY;
+  auto item = this->acquire_item_(component, key, SchedulerItem::RETRY);
   item->interval = initial_wait_time;
   item->retry_countdown = max_attempts;
   item->backoff_multiplier = backoff_increase_factor;
@@ -99,14 +108,15 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   if (item->last_execution > now)
     item->last_execution_major--;
   item->retry_callback = std::move(func);
-  item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
+bool HOT Scheduler::cancel_retry(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::RETRY);
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  // Items added by the loop() of components since call() would otherwise only be seen after sleeping
+  this->process_to_add();
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
@@ -130,7 +140,7 @@ void IRAM_ATTR HOT Scheduler::call() {
     while (!this->empty_()) {
       auto item = std::move(this->items_[0]);
       ESP_LOGVV(TAG, "  %s '%s' interval=%u last_execution=%u (%u) next=%u (%u)", item->get_type_str(),
-                item->name.c_str(), item->interval, item->last_execution, item->last_execution_major,
+                this->get_item_name_(item.get()), item->interval, item->last_execution, item->last_execution_major,
                 item->next_execution(), item->next_execution_major());
 
       this->pop_raw_();
@@ -182,7 +192,7 @@ void IRAM_ATTR HOT Scheduler::call() {
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
       ESP_LOGVV(TAG, "Running %s '%s' with interval=%u last_execution=%u (now=%u)", item->get_type_str(),
-                item->name.c_str(), item->interval, item->last_execution, now);
+                this->get_item_name_(item.get()), item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
@@ -208,6 +218,7 @@ void IRAM_ATTR HOT Scheduler::call() {
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->recycle_item_(std::move(item));
         continue;
       }
 
@@ -223,6 +234,8 @@ void IRAM_ATTR HOT Scheduler::call() {
             item->interval *= item->backoff_multiplier;
         }
         this->push_(std::move(item));
+      } else {
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -232,6 +245,8 @@ void IRAM_ATTR HOT Scheduler::call() {
 void HOT Scheduler::process_to_add() {
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      to_remove_--;
+      this->recycle_item_(std::move(it));
       continue;
     }
 
@@ -252,25 +267,165 @@ void HOT Scheduler::cleanup_() {
 }
 void HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  this->recycle_item_(std::move(this->items_.back()));
   this->items_.pop_back();
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
+  if (item->key != NO_KEY)
+    this->keys_[item->key].active[item->type] = item.get();
+  this->to_add_.push_back(std::move(item));
+}
+bool HOT Scheduler::cancel_item_(Component *component, const char *name, Scheduler::SchedulerItem::Type type) {
+  if (name[0] == '\0')
+    return this->cancel_anonymous_item_(component, type);
+
+  uint32_t key = this->find_key_(component, name, key_hash(component, name));
+  if (key == NO_KEY)
+    return false;
+  return this->cancel_key_(key, type);
+}
+bool HOT Scheduler::cancel_key_(uint32_t key, Scheduler::SchedulerItem::Type type) {
+  SchedulerItem *&active = this->keys_[key].active[type];
+  if (active == nullptr)
+    return false;
+  active->remove = true;
+  active = nullptr;
+  to_remove_++;
+  return true;
+}
+bool Scheduler::cancel_anonymous_item_(Component *component, Scheduler::SchedulerItem::Type type) {
   bool ret = false;
   for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->component == component && it->key == NO_KEY && it->type == type && !it->remove) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->key == NO_KEY && it->type == type && !it->remove) {
+      to_remove_++;
       it->remove = true;
       ret = true;
     }
 
   return ret;
 }
+uint32_t HOT Scheduler::find_key_(Component *component, const char *name, uint32_t hash) {
+  auto it = this->key_index_.find(hash);
+  if (it == this->key_index_.end())
+    return NO_KEY;
+  for (uint32_t index = it->second; index != NO_KEY; index = this->keys_[index].next) {
+    const SchedulerKey &key = this->keys_[index];
+    if (key.component == component && key.name == name)
+      return index;
+  }
+  return NO_KEY;
+}
+uint32_t HOT Scheduler::intern_key_(Component *component, const char *name) {
+  const uint32_t hash = key_hash(component, name);
+  uint32_t index = this->find_key_(component, name, hash);
+  if (index != NO_KEY)
+    return index;
+
+  if (this->used_keys_ >= std::max(this->key_sweep_threshold_, MIN_KEY_SWEEP_THRESHOLD)) {
+    this->sweep_keys_();
+    // Sweep again once the number of keys in use has doubled, so that sweeping stays amortized O(1)
+    this->key_sweep_threshold_ = this->used_keys_ * 2;
+  }
+
+  if (this->free_key_ != NO_KEY) {
+    index = this->free_key_;
+    this->free_key_ = this->keys_[index].next;
+  } else {
+    index = static_cast<uint32_t>(this->keys_.size());
+    this->keys_.emplace_back();
+  }
+  SchedulerKey &key = this->keys_[index];
+  key.component = component;
+  key.name = name;
+  key.active[0] = key.active[1] = key.active[2] = nullptr;
+  key.items = 0;
+  key.hash = hash;
+  key.used = true;
+  // Insert at the front of the chain of keys with the same hash
+  auto it = this->key_index_.find(hash);
+  if (it == this->key_index_.end()) {
+    key.next = NO_KEY;
+    this->key_index_[hash] = index;
+  } else {
+    key.next = it->second;
+    it->second = index;
+  }
+  this->used_keys_++;
+  return index;
+}
+void Scheduler::sweep_keys_() {
+  for (uint32_t index = 0; index < this->keys_.size(); index++) {
+    SchedulerKey &key = this->keys_[index];
+    if (!key.used || key.items != 0)
+      continue;
+
+    // Unlink from the chain of keys with the same hash
+    auto it = this->key_index_.find(key.hash);
+    if (it->second == index) {
+      if (key.next == NO_KEY) {
+        this->key_index_.erase(it);
+      } else {
+        it->second = key.next;
+      }
+    } else {
+      uint32_t prev = it->second;
+      while (this->keys_[prev].next != index)
+        prev = this->keys_[prev].next;
+      this->keys_[prev].next = key.next;
+    }
+
+    key.used = false;
+    key.name.clear();
+    key.name.shrink_to_fit();
+    key.next = this->free_key_;
+    this->free_key_ = index;
+    this->used_keys_--;
+  }
+}
+const char *Scheduler::get_item_name_(SchedulerItem *item) {
+  if (item->key == NO_KEY)
+    return "";
+  return this->keys_[item->key].name.c_str();
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_(Component *component, uint32_t key,
+                                                                      Scheduler::SchedulerItem::Type type) {
+  std::unique_ptr<SchedulerItem> item;
+  if (this->free_items_.empty()) {
+    item = make_unique<SchedulerItem>();
+  } else {
+    item = std::move(this->free_items_.back());
+    this->free_items_.pop_back();
+  }
+  item->component = component;
+  item->key = key;
+  item->type = type;
+  item->retry_countdown = 3;
+  item->backoff_multiplier = 1.0f;
+  item->remove = false;
+  if (key != NO_KEY)
+    this->keys_[key].items++;
+  return item;
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  if (!item)
+    return;
+  if (item->key != NO_KEY) {
+    SchedulerKey &key = this->keys_[item->key];
+    if (key.active[item->type] == item.get())
+      key.active[item->type] = nullptr;
+    key.items--;
+  }
+  // Release anything captured by the callbacks now, not when the item is re-used
+  item->void_callback = nullptr;
+  item->retry_callback = nullptr;
+  this->free_items_.push_back(std::move(item));
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 namespace esphome {
 
@@ -10,15 +11,36 @@ class Component;
 
 class Scheduler {
  public:
-  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
-  bool cancel_timeout(Component *component, const std::string &name);
-  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
-  bool cancel_interval(Component *component, const std::string &name);
+  void set_timeout(Component *component, const char *name, uint32_t timeout, std::function<void()> &&func);
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func) {
+    this->set_timeout(component, name.c_str(), timeout, std::move(func));
+  }
+  bool cancel_timeout(Component *component, const char *name);
+  bool cancel_timeout(Component *component, const std::string &name) {
+    return this->cancel_timeout(component, name.c_str());
+  }
+  void set_interval(Component *component, const char *name, uint32_t interval, std::function<void()> &&func);
+  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func) {
+    this->set_interval(component, name.c_str(), interval, std::move(func));
+  }
+  bool cancel_interval(Component *component, const char *name);
+  bool cancel_interval(Component *component, const std::string &name) {
+    return this->cancel_interval(component, name.c_str());
+  }
 
-  void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
+  void set_retry(Component *component, const char *name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult()> &&func, float backoff_increase_factor = 1.0f);
-  bool cancel_retry(Component *component, const std::string &name);
+  void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
+                 std::function<RetryResult()> &&func, float backoff_increase_factor = 1.0f) {
+    this->set_retry(component, name.c_str(), initial_wait_time, max_attempts, std::move(func),
+                    backoff_increase_factor);
+  }
+  bool cancel_retry(Component *component, const char *name);
+  bool cancel_retry(Component *component, const std::string &name) {
+    return this->cancel_retry(component, name.c_str());
+  }
 
+  /// Time until the next item is due, including items added since the last call(). Not for use from a callback.
   optional<uint32_t> next_schedule_in();
 
   void call();
@@ -28,7 +50,8 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    /// Interned (component, name) key, see SchedulerKey. NO_KEY for anonymous items.
+    uint32_t key;
     enum Type { TIMEOUT, INTERVAL, RETRY } type;
     union {
       uint32_t interval;
@@ -70,11 +93,39 @@ class Scheduler {
     }
   };
 
+  /** A (component, name) pair that has been used with the scheduler.
+   *
+   * Names are interned the first time they're seen so that re-arming the same timeout doesn't copy the name again,
+   * and so that the live item of each type can be found (and cancelled) without scanning the whole heap. Keys that
+   * no item refers to any more are released by sweep_keys_(), so names built at runtime don't pile up.
+   */
+  struct SchedulerKey {
+    Component *component;
+    std::string name;
+    /// The live (not cancelled) item for each SchedulerItem::Type, or nullptr.
+    SchedulerItem *active[3];
+    /// The number of items (including cancelled ones that are still queued) that refer to this key.
+    uint32_t items;
+    uint32_t hash;
+    /// The next key with the same hash, or the next free slot of keys_ for a released key. NO_KEY at the end.
+    uint32_t next;
+    bool used;
+  };
+  static const uint32_t NO_KEY = 0xFFFFFFFFUL;
+
   uint32_t millis_();
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  bool cancel_item_(Component *component, const char *name, SchedulerItem::Type type);
+  bool cancel_key_(uint32_t key, SchedulerItem::Type type);
+  bool cancel_anonymous_item_(Component *component, SchedulerItem::Type type);
+  uint32_t find_key_(Component *component, const char *name, uint32_t hash);
+  uint32_t intern_key_(Component *component, const char *name);
+  void sweep_keys_();
+  const char *get_item_name_(SchedulerItem *item);
+  std::unique_ptr<SchedulerItem> acquire_item_(Component *component, uint32_t key, SchedulerItem::Type type);
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -82,6 +133,17 @@ class Scheduler {
 
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Finished items kept around for re-use. The pool grows to the largest number of items ever scheduled at once, so
+  /// re-arming doesn't have to allocate once the device has run through its usual set of timers.
+  std::vector<std::unique_ptr<SchedulerItem>> free_items_;
+  std::vector<SchedulerKey> keys_;
+  /// Maps hash(component, name) to the first key with that hash, the others are chained through SchedulerKey::next.
+  std::unordered_map<uint32_t, uint32_t> key_index_;
+  /// The first released slot of keys_, or NO_KEY.
+  uint32_t free_key_{NO_KEY};
+  uint32_t used_keys_{0};
+  /// Interning a new key when used_keys_ has reached this first releases the keys that are no longer referenced.
+  uint32_t key_sweep_threshold_{0};
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
@@ -30,6 +30,9 @@ RESPONSE_ERROR_WRONG_CURRENT_FLASH_CONFIG = 134
 RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135
 RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137
+RESPONSE_ERROR_NO_UPDATE_PARTITION = 138
+RESPONSE_ERROR_WRONG_DELTA_BASE = 139
+RESPONSE_ERROR_INVALID_IMAGE = 140
 RESPONSE_ERROR_UNKNOWN = 255
 
 OTA_VERSION_1_0 = 1
@@ -151,6 +154,21 @@ def check_error(data, expect):
             "Error: The OTA partition on the ESP is too small. ESPHome needs to resize "
             "this partition, please flash over USB."
         )
+    if dat == RESPONSE_ERROR_NO_UPDATE_PARTITION:
+        raise OTAError(
+            "Error: The ESP has no partition to store the update in. Please flash "
+            "over USB."
+        )
+    if dat == RESPONSE_ERROR_WRONG_DELTA_BASE:
+        raise OTAError(
+            "Error: The delta patch was not created from the firmware running on the "
+            "ESP. Please upload the full firmware."
+        )
+    if dat == RESPONSE_ERROR_INVALID_IMAGE:
+        raise OTAError(
+            "Error: The uploaded file is corrupt or incomplete. See the MQTT/USB logs "
+            "for more information."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -0,0 +1,245 @@
+"""Delta patches for OTA updates.
+
+A patch turns the firmware image a device is running into a new one, so that
+only the differences have to be uploaded. Devices that support it detect a
+patch by its magic and apply it against their running partition while it is
+being received (see esphome/components/ota/ota_decoder.h).
+
+The patch starts with a header:
+
+    "ESPD" | version (u8) | base size (u32 LE) | base MD5 (16 bytes)
+           | new size (u32 LE) | new MD5 (16 bytes)
+
+followed by operations, each an opcode followed by LEB128 varints:
+
+    DATA (0)  length            followed by length bytes of the new image
+    COPY (1)  offset length     bytes of the base image from offset
+    ADD  (2)  offset length     followed by length bytes that are added (mod 256)
+                                to the bytes of the base image from offset
+
+ADD covers regions that mostly match the base image, like code that moved and
+whose addresses changed. Its added bytes are mostly zero, so the patch
+compresses well, and uploads are gzip compressed when the device supports it.
+"""
+import hashlib
+import re
+import struct
+
+MAGIC = b"ESPD"
+VERSION = 1
+HEADER = struct.Struct("<4sBI16sI16s")
+
+OP_DATA = 0
+OP_COPY = 1
+OP_ADD = 2
+
+# Length of the blocks of the base image that are looked up in the new one
+BLOCK_SIZE = 16
+# Matches shorter than this are cheaper as data
+MIN_MATCH = 24
+# How far the score of an approximate match may fall below its best before giving up
+MAX_MISMATCH = 32
+
+_ZERO_RUN = re.compile(b"\\x00{%d,}" % MIN_MATCH)
+
+
+class DeltaError(Exception):
+    pass
+
+
+def _varint(value):
+    result = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            result.append(byte | 0x80)
+        else:
+            result.append(byte)
+            return bytes(result)
+
+
+def _read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise DeltaError("Patch is truncated")
+        byte = data[pos]
+        pos += 1
+        # Like the device, only accept what fits into 32 bits
+        if shift == 28 and byte > 0x0F:
+            raise DeltaError("Invalid varint in patch")
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def _extend_approximately(old, new, old_pos, new_pos):
+    """Length of the region after an exact match that still mostly matches."""
+    score = 0
+    best_score = 0
+    best_length = 0
+    length = 0
+    limit = min(len(old) - old_pos, len(new) - new_pos)
+    while length < limit:
+        score += 1 if old[old_pos + length] == new[new_pos + length] else -1
+        length += 1
+        if score > best_score:
+            best_score = score
+            best_length = length
+        elif score < best_score - MAX_MISMATCH:
+            break
+    return best_length
+
+
+class _PatchWriter:
+    def __init__(self, new):
+        self.new = new
+        self.ops = bytearray()
+        self.pending = 0
+
+    def data(self, end):
+        if end > self.pending:
+            self.ops += bytes([OP_DATA]) + _varint(end - self.pending)
+            self.ops += self.new[self.pending : end]
+        self.pending = end
+
+    def copy(self, old_pos, new_pos, length):
+        self.data(new_pos)
+        self.ops += bytes([OP_COPY]) + _varint(old_pos) + _varint(length)
+        self.pending = new_pos + length
+
+    def add(self, old, old_pos, new_pos, length):
+        self.data(new_pos)
+        diff = bytes(
+            (self.new[new_pos + i] - old[old_pos + i]) & 0xFF for i in range(length)
+        )
+        # Runs that match exactly are copied instead
+        start = 0
+        for run in _ZERO_RUN.finditer(diff):
+            if run.start() > start:
+                self.ops += bytes([OP_ADD]) + _varint(old_pos + start)
+                self.ops += _varint(run.start() - start) + diff[start : run.start()]
+            self.ops += bytes([OP_COPY]) + _varint(old_pos + run.start())
+            self.ops += _varint(run.end() - run.start())
+            start = run.end()
+        if start < length:
+            self.ops += bytes([OP_ADD]) + _varint(old_pos + start)
+            self.ops += _varint(length - start) + diff[start:]
+        self.pending = new_pos + length
+
+
+def create_patch(old: bytes, new: bytes) -> bytes:
+    """Create a patch that turns the image old into new."""
+    index = {}
+    for pos in range(0, len(old) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        index.setdefault(old[pos : pos + BLOCK_SIZE], pos)
+
+    writer = _PatchWriter(new)
+    # Where the base image is expected to continue, from the last match
+    offset = 0
+    new_pos = 0
+    while new_pos + BLOCK_SIZE <= len(new):
+        block = new[new_pos : new_pos + BLOCK_SIZE]
+        old_pos = new_pos + offset
+        if (
+            not 0 <= old_pos <= len(old) - BLOCK_SIZE
+            or old[old_pos : old_pos + BLOCK_SIZE] != block
+        ):
+            old_pos = index.get(block)
+            if old_pos is None:
+                new_pos += 1
+                continue
+
+        # Extend the match backwards into the pending data, then forwards
+        start = new_pos
+        while (
+            start > writer.pending
+            and old_pos > 0
+            and new[start - 1] == old[old_pos - 1]
+        ):
+            start -= 1
+            old_pos -= 1
+        length = new_pos - start + BLOCK_SIZE
+        limit = min(len(old) - old_pos, len(new) - start)
+        while length < limit and new[start + length] == old[old_pos + length]:
+            length += 1
+        if length < MIN_MATCH:
+            new_pos += 1
+            continue
+
+        writer.copy(old_pos, start, length)
+        new_pos = start + length
+        offset = old_pos - start
+        approximate = _extend_approximately(old, new, old_pos + length, new_pos)
+        if approximate:
+            writer.add(old, old_pos + length, new_pos, approximate)
+            new_pos += approximate
+    writer.data(len(new))
+
+    header = HEADER.pack(
+        MAGIC,
+        VERSION,
+        len(old),
+        hashlib.md5(old).digest(),
+        len(new),
+        hashlib.md5(new).digest(),
+    )
+    return header + bytes(writer.ops)
+
+
+def is_patch(data: bytes) -> bool:
+    return data[: len(MAGIC)] == MAGIC
+
+
+def apply_patch(old: bytes, patch: bytes) -> bytes:
+    """Apply a patch to the image old, like the device does."""
+    if len(patch) < HEADER.size:
+        raise DeltaError("Patch is truncated")
+    magic, version, old_size, old_md5, new_size, new_md5 = HEADER.unpack_from(patch)
+    if magic != MAGIC:
+        raise DeltaError("Not a delta patch")
+    if version != VERSION:
+        raise DeltaError(f"Unsupported patch version {version}")
+    if len(old) < old_size or hashlib.md5(old[:old_size]).digest() != old_md5:
+        raise DeltaError("Patch was not created from this image")
+    old = old[:old_size]
+
+    new = bytearray()
+    pos = HEADER.size
+    while len(new) < new_size:
+        if pos >= len(patch):
+            raise DeltaError("Patch is truncated")
+        op = patch[pos]
+        pos += 1
+        if op == OP_DATA:
+            length, pos = _read_varint(patch, pos)
+            if pos + length > len(patch):
+                raise DeltaError("Patch is truncated")
+            new += patch[pos : pos + length]
+            pos += length
+        elif op in (OP_COPY, OP_ADD):
+            old_pos, pos = _read_varint(patch, pos)
+            length, pos = _read_varint(patch, pos)
+            if old_pos + length > len(old):
+                raise DeltaError("Patch reads past the end of the image")
+            if op == OP_COPY:
+                new += old[old_pos : old_pos + length]
+            else:
+                if pos + length > len(patch):
+                    raise DeltaError("Patch is truncated")
+                new += bytes(
+                    (old[old_pos + i] + patch[pos + i]) & 0xFF for i in range(length)
+                )
+                pos += length
+        else:
+            raise DeltaError(f"Invalid operation {op}")
+        if len(new) > new_size:
+            raise DeltaError("Patch creates a larger image than declared")
+    if pos != len(patch):
+        raise DeltaError("Unexpected data after the patch")
+    if hashlib.md5(new).digest() != new_md5:
+        raise DeltaError("MD5 of the patched image doesn't match")
+    return bytes(new)
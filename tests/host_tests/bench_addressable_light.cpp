@@ -0,0 +1,95 @@
+// Benchmark of the bulk range operations of AddressableLight on a 1500 LED RGB strip, compared with doing the same
+// pixel by pixel through the views.
+//
+// host_test sources: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// host_test sources: esphome/components/light/esp_range_view.cpp esphome/components/light/light_output.cpp
+// host_test sources: esphome/core/color.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/light/addressable_light.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace esphome {
+namespace light {
+
+class BenchLight : public AddressableLight {
+ public:
+  explicit BenchLight(int32_t size) : data_(size * 3), effect_data_(size) {
+    this->correction_.set_max_brightness(Color(255, 220, 200, 255));
+    this->correction_.calculate_gamma_table(2.8f);
+    this->correction_.set_local_brightness(200);
+  }
+  int32_t size() const override { return this->effect_data_.size(); }
+  void clear_effect_data() override {}
+  LightTraits get_traits() override { return {}; }
+  void write_state(LightState *state) override {}
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->data_.data()) + 3 * index;
+    return ESPColorView(base + 1, base + 0, base + 2, nullptr, const_cast<uint8_t *>(&this->effect_data_[index]),
+                        &this->correction_);
+  }
+  AddressableLightBuffer get_buffer_internal() const override {
+    AddressableLightBuffer buffer;
+    buffer.data = const_cast<uint8_t *>(this->data_.data());
+    buffer.offsets[0] = 1;
+    buffer.offsets[1] = 0;
+    return buffer;
+  }
+
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> effect_data_;
+};
+
+static const int32_t LEDS = 1500;
+static const int ROUNDS = 1000;
+
+template<typename F> static void run(const char *name, F &&f) {
+  double best_s = 1e9;
+  for (int run = 0; run < 5; run++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+      f(i);
+    best_s = std::min(best_s, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  printf("%-18s %8.1f Mpixel/s\n", name, double(LEDS) * ROUNDS / best_s / 1e6);
+}
+
+HOST_BENCHMARK(addressable_light_bulk) {
+  BenchLight light(LEDS);
+  std::vector<Color> colors(LEDS);
+  for (int32_t i = 0; i < LEDS; i++)
+    colors[i] = Color(i, i * 3, i * 5);
+
+  // The views first: until a bulk operation builds the fused tables, they correct with the math
+  run("fill, views", [&](int i) {
+    for (int32_t led = 0; led < LEDS; led++)
+      light[led].set(Color(i, 50, 200));
+  });
+  run("blend, views", [&](int i) {
+    const uint8_t amnt = 10 + (i & 63);
+    for (int32_t led = 0; led < LEDS; led++) {
+      ESPColorView view = light[led];
+      view.set(Color(i, 50, 200) * amnt + view.get() * static_cast<uint8_t>(255 - amnt));
+    }
+  });
+  run("set, views", [&](int i) {
+    colors[i % LEDS].r++;
+    for (int32_t led = 0; led < LEDS; led++)
+      light[led].set(colors[led]);
+  });
+  run("fill, bulk", [&](int i) { light.fill_range(0, LEDS, Color(i, 50, 200)); });
+  run("blend, bulk", [&](int i) { light.blend_range(0, LEDS, Color(i, 50, 200), 10 + (i & 63)); });
+  run("set, bulk", [&](int i) {
+    colors[i % LEDS].r++;
+    light.set_range(0, colors.data(), LEDS);
+  });
+}
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,141 @@
+// Benchmark of batched state updates in the native API (api: batch_delay).
+//
+// Sends sensor state updates through the frame helpers the way APIConnection does. Without batching, every update
+// is encoded into its own buffer and written with write_protobuf_packet(). With batch_delay, frames are built back to
+// back with finish_frame() until 1400 bytes are reached and then written with write_frames(), like
+// flush_state_updates_(). The socket counts the writes and passes them to /dev/null, so that the time includes a
+// system call per write. The Noise helper encrypts with ChaCha20-Poly1305 from OpenSSL and skips the handshake.
+//
+// host_test sources: esphome/components/api/api_frame_helper.cpp esphome/components/api/proto.cpp
+// host_test sources: esphome/components/api/api_pb2.cpp tests/host_tests/noise_cipher.cpp
+// host_test libs: -lcrypto
+
+#include "host_test.h"
+#include "noise/protocol.h"
+
+#include "esphome/components/api/api_frame_helper.h"
+#include "esphome/components/api/api_pb2.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace api {
+
+static const size_t MAX_BATCH_SIZE = 1400;
+static const uint32_t SENSORS = 80;
+static const uint32_t ROUNDS = 20000;
+
+class CountingSocket : public socket::Socket {
+ public:
+  CountingSocket() : fd_(::open("/dev/null", O_WRONLY)) {}
+  ~CountingSocket() override { ::close(this->fd_); }
+  std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) override { return nullptr; }
+  int bind(const struct sockaddr *addr, socklen_t addrlen) override { return 0; }
+  int close() override { return 0; }
+  int shutdown(int how) override { return 0; }
+  int getpeername(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getpeername() override { return "bench"; }
+  int getsockname(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getsockname() override { return "bench"; }
+  int getsockopt(int level, int optname, void *optval, socklen_t *optlen) override { return 0; }
+  int setsockopt(int level, int optname, const void *optval, socklen_t optlen) override { return 0; }
+  int listen(int backlog) override { return 0; }
+  ssize_t read(void *buf, size_t len) override { return 0; }
+  ssize_t readv(const struct iovec *iov, int iovcnt) override { return 0; }
+  ssize_t write(const void *buf, size_t len) override {
+    this->writes++;
+    this->bytes += len;
+    return ::write(this->fd_, buf, len);
+  }
+  ssize_t writev(const struct iovec *iov, int iovcnt) override {
+    this->writes++;
+    ssize_t len = ::writev(this->fd_, iov, iovcnt);
+    this->bytes += len;
+    return len;
+  }
+  int setblocking(bool blocking) override { return 0; }
+
+  uint64_t writes{0};
+  uint64_t bytes{0};
+
+ protected:
+  int fd_;
+};
+
+/// A Noise helper in the state after the handshake.
+class EstablishedNoiseFrameHelper : public APINoiseFrameHelper {
+ public:
+  EstablishedNoiseFrameHelper(std::unique_ptr<socket::Socket> socket)
+      : APINoiseFrameHelper(std::move(socket), std::make_shared<APINoiseContext>()) {
+    this->send_cipher_ = host_test::noise_cipherstate_new();
+    this->recv_cipher_ = host_test::noise_cipherstate_new();
+    this->state_ = State::DATA;
+  }
+};
+
+static SensorStateResponse sensor_state(uint32_t round, uint32_t sensor) {
+  SensorStateResponse resp{};
+  resp.key = 0x9E3779B9u * (sensor + 1);
+  resp.state = 20.0f + static_cast<float>((round * 7 + sensor) % 100) / 10.0f;
+  return resp;
+}
+
+static void send_unbatched(APIFrameHelper *helper, std::vector<uint8_t> &buffer, uint32_t round) {
+  for (uint32_t sensor = 0; sensor < SENSORS; sensor++) {
+    buffer.clear();
+    buffer.resize(helper->frame_header_padding());
+    sensor_state(round, sensor).encode(ProtoWriteBuffer{&buffer});
+    helper->write_protobuf_packet(25, ProtoWriteBuffer{&buffer});
+  }
+}
+
+static void send_batched(APIFrameHelper *helper, std::vector<uint8_t> &buffer, uint32_t round) {
+  uint32_t sensor = 0;
+  while (sensor < SENSORS) {
+    buffer.clear();
+    while (sensor < SENSORS && buffer.size() < MAX_BATCH_SIZE) {
+      const size_t frame_start = buffer.size();
+      buffer.resize(frame_start + helper->frame_header_padding());
+      sensor_state(round, sensor).encode(ProtoWriteBuffer{&buffer});
+      helper->finish_frame(25, ProtoWriteBuffer{&buffer}, frame_start);
+      sensor++;
+    }
+    helper->write_frames(ProtoWriteBuffer{&buffer});
+  }
+}
+
+template<typename Helper>
+static void run(const char *name, void (*send)(APIFrameHelper *, std::vector<uint8_t> &, uint32_t)) {
+  auto socket = make_unique<CountingSocket>();
+  CountingSocket *counter = socket.get();
+  Helper helper(std::move(socket));
+  helper.init();
+  std::vector<uint8_t> buffer;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < ROUNDS; round++)
+    send(&helper, buffer, round);
+  const auto end = std::chrono::steady_clock::now();
+
+  const double updates = double(SENSORS) * ROUNDS;
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  printf("%-28s %7.1f ns/update  %.3f writes/update  %5.1f bytes/update\n", name, ns / updates,
+         counter->writes / updates, counter->bytes / updates);
+}
+
+HOST_BENCHMARK(api_state_updates) {
+  printf("%u sensors, %u rounds of updates\n", SENSORS, ROUNDS);
+  run<APIPlaintextFrameHelper>("plaintext, one per write", send_unbatched);
+  run<APIPlaintextFrameHelper>("plaintext, batched", send_batched);
+  run<EstablishedNoiseFrameHelper>("noise, one per write", send_unbatched);
+  run<EstablishedNoiseFrameHelper>("noise, batched", send_batched);
+}
+
+}  // namespace api
+}  // namespace esphome
@@ -0,0 +1,116 @@
+// Benchmark of DisplayBuffer primitives on a 320x240 display that only keeps a framebuffer in memory, once with the
+// default span hooks (which draw pixel by pixel) and once with span overrides like the ones of the ILI9341 driver.
+//
+// host_test sources: esphome/components/display/display_buffer.cpp esphome/core/color.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/display/display_buffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace esphome {
+
+size_t time::ESPTime::strftime(char *buffer, size_t buffer_len, const char *format) { return 0; }
+void graph::Graph::draw(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+void graph::Graph::draw_legend(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+
+namespace display {
+
+class MemoryDisplay : public DisplayBuffer {
+ public:
+  static const int WIDTH = 320;
+  static const int HEIGHT = 240;
+
+  std::vector<uint8_t> buffer = std::vector<uint8_t>(WIDTH * HEIGHT, 0);
+
+ protected:
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+      return;
+    this->buffer[y * WIDTH + x] = color.r;
+  }
+};
+
+class SpanDisplay : public MemoryDisplay {
+ protected:
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override {
+    if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+      return;
+    for (int j = y; j < y + height; j++)
+      memset(this->buffer.data() + j * WIDTH + x, color.r, width);
+  }
+  void draw_absolute_row_internal(int x, int y, const Color *colors, int length) override {
+    const int start = x;
+    int height = 1;
+    if (!this->clip_absolute_rect_(&x, &y, &length, &height))
+      return;
+    colors += x - start;
+    for (int i = 0; i < length; i++)
+      this->buffer[y * WIDTH + x + i] = colors[i].r;
+  }
+};
+
+static const uint8_t GLYPH[] = {0x3C, 0x66, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0x66, 0x3C, 0x00};
+static const GlyphData GLYPHS[] = {{"A", GLYPH, 0, 0, 8, 12}, {"B", GLYPH, 0, 0, 8, 12}, {"C", GLYPH, 0, 0, 8, 12}};
+static const uint8_t RGB_IMAGE[64 * 64 * 3] = {0};
+// Mostly background, like an icon
+static const uint8_t BINARY_IMAGE[8 * 64] = {0xF0};
+
+static void run(const char *name, MemoryDisplay &display) {
+  Font font(GLYPHS, 3, 10, 12);
+  Image rgb(RGB_IMAGE, 64, 64, IMAGE_TYPE_RGB24);
+  Image binary(BINARY_IMAGE, 64, 64, IMAGE_TYPE_BINARY);
+
+  const auto bench = [&](const char *primitive, const std::function<void()> &draw) {
+    // Best of a few runs
+    double best_us = 1e9;
+    for (int run = 0; run < 5; run++) {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < 50; i++)
+        draw();
+      const auto end = std::chrono::steady_clock::now();
+      best_us = std::min(best_us, std::chrono::duration<double, std::micro>(end - start).count() / 50);
+    }
+    printf("%-16s %-16s %8.1f us/frame\n", name, primitive, best_us);
+  };
+
+  for (auto rotation : {DISPLAY_ROTATION_0_DEGREES, DISPLAY_ROTATION_90_DEGREES}) {
+    display.set_rotation(rotation);
+    printf("rotation %d\n", rotation);
+    bench("fill", [&]() { display.fill(Color(10, 10, 10)); });
+    bench("20 rects", [&]() {
+      for (int i = 0; i < 20; i++)
+        display.filled_rectangle(i * 5, i * 5, 100, 60, Color(i, 0, 0));
+    });
+    bench("640 glyphs", [&]() {
+      for (int line = 0; line < 16; line++)
+        display.print(0, line * 14, &font, Color(255, 0, 0), "ABCABCABCABCABCABCABCABCABCABCABCABCABCA");
+    });
+    bench("8 RGB images", [&]() {
+      for (int i = 0; i < 8; i++)
+        display.image(i * 30, 40, &rgb);
+    });
+    bench("8 binary images", [&]() {
+      for (int i = 0; i < 8; i++)
+        display.image(i * 30, 40, &binary);
+    });
+  }
+}
+
+HOST_BENCHMARK(display_primitives) {
+  MemoryDisplay pixel_display;
+  run("default hooks", pixel_display);
+  SpanDisplay span_display;
+  run("span overrides", span_display);
+  EXPECT_TRUE(pixel_display.buffer == span_display.buffer);
+}
+
+}  // namespace display
+}  // namespace esphome
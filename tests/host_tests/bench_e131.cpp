@@ -0,0 +1,422 @@
+// Replay benchmark of the realtime light protocols: E1.31, WLED and Adalight frames played into a 1700 LED strip.
+//
+// The E1.31 and WLED traffic is generated as a pcap capture (Ethernet, IPv4 and UDP), which is parsed again and
+// replayed by UDP port through the stub WiFiUDP of tests/host_tests/include/WiFi.h, like the packets of a capture
+// taken with tcpdump or Wireshark would be. Set BENCH_E131_PCAP to the path of such a capture to replay it instead of
+// the generated E1.31 and WLED traffic. Adalight has no packets, its frames are fed to a fake UART in chunks of a
+// receive FIFO.
+//
+// host_test sources: esphome/components/e131/e131.cpp esphome/components/e131/e131_packet.cpp
+// host_test sources: esphome/components/e131/e131_addressable_light_effect.cpp
+// host_test sources: esphome/components/wled/wled_light_effect.cpp
+// host_test sources: esphome/components/adalight/adalight_light_effect.cpp
+// host_test sources: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// host_test sources: esphome/components/light/esp_range_view.cpp esphome/components/light/esp_hsv_color.cpp
+// host_test sources: esphome/components/light/light_output.cpp esphome/components/light/light_state.cpp
+// host_test sources: esphome/components/light/light_call.cpp esphome/core/entity_base.cpp
+// host_test sources: esphome/core/color.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test flags: -DUSE_ARDUINO -DUSE_ESP32
+
+#include "host_test.h"
+
+#include "esphome/components/adalight/adalight_light_effect.h"
+#include "esphome/components/e131/e131.h"
+#include "esphome/components/e131/e131_addressable_light_effect.h"
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/wled/wled_light_effect.h"
+#include "esphome/core/preferences.h"
+
+#include <WiFi.h>
+#include <lwip/igmp.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+std::deque<std::vector<uint8_t>> UDP::received;  // NOLINT
+
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) { return 0; }
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) { return 0; }
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace e131 {
+
+static const int32_t LEDS = 1700;
+static const int FRAMES = 400;
+static const uint16_t E131_PORT = 5568;
+static const uint16_t WLED_PORT = 21324;
+// The replay runs on the fake clock, following the time stamps of the capture
+static const uint32_t START_US = 1000000;
+
+class BenchLight : public light::AddressableLight {
+ public:
+  explicit BenchLight(int32_t size) : data_(size * 3), effect_data_(size) {
+    this->correction_.set_max_brightness(Color(255, 220, 200, 255));
+    this->correction_.calculate_gamma_table(2.8f);
+  }
+  int32_t size() const override { return this->effect_data_.size(); }
+  void clear_effect_data() override {}
+  light::LightTraits get_traits() override { return {}; }
+  void write_state(light::LightState *state) override {}
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->data_.data()) + 3 * index;
+    return light::ESPColorView(base + 1, base + 0, base + 2, nullptr,
+                               const_cast<uint8_t *>(&this->effect_data_[index]), &this->correction_);
+  }
+  light::AddressableLightBuffer get_buffer_internal() const override {
+    light::AddressableLightBuffer buffer;
+    buffer.data = const_cast<uint8_t *>(this->data_.data());
+    buffer.offsets[0] = 1;
+    buffer.offsets[1] = 0;
+    return buffer;
+  }
+
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> effect_data_;
+};
+
+/// The UART an Adalight effect reads from, with a frame stream that is handed out a FIFO's worth per apply().
+class BenchUART : public uart::UARTComponent {
+ public:
+  std::vector<uint8_t> stream;
+  size_t position{0};
+  size_t fifo{0};
+
+  void write_array(const uint8_t *data, size_t len) override {}
+  bool peek_byte(uint8_t *data) override { return false; }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (len > static_cast<size_t>(this->available()))
+      return false;
+    memcpy(data, &this->stream[this->position], len);
+    this->position += len;
+    this->fifo -= len;
+    return true;
+  }
+  int available() override { return this->fifo; }
+  void flush() override {}
+  /// Receive up to len more bytes of the stream, returns false at its end.
+  bool receive(size_t len) {
+    this->fifo = std::min(len, this->stream.size() - this->position);
+    return this->fifo != 0;
+  }
+
+ protected:
+  void check_logger_conflict() override {}
+};
+
+static void put16(std::vector<uint8_t> &data, size_t offset, uint16_t value) {
+  data[offset] = value >> 8;
+  data[offset + 1] = value;
+}
+
+static void put_le16(std::vector<uint8_t> &data, uint16_t value) {
+  data.push_back(value);
+  data.push_back(value >> 8);
+}
+
+static void put_le32(std::vector<uint8_t> &data, uint32_t value) {
+  put_le16(data, value);
+  put_le16(data, value >> 16);
+}
+
+static uint8_t pixel(int frame, int32_t led, int channel) { return (frame * 3 + led * 7 + channel * 85) & 0xFF; }
+
+static std::vector<uint8_t> root_layer(size_t size, uint32_t vector) {
+  static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> packet(size, 0);
+  put16(packet, 0, 0x0010);
+  memcpy(&packet[4], ACN_ID, sizeof(ACN_ID));
+  put16(packet, 16, 0x7000 | (size - 16));
+  put16(packet, 20, vector);
+  put16(packet, 38, 0x7000 | (size - 38));
+  return packet;
+}
+
+/// E1.31 data for the 170 RGB LEDs of a universe, shown with the synchronization packets of universe 1000.
+static std::vector<uint8_t> e131_data(int frame, uint16_t universe) {
+  const int32_t first = (universe - 1) * 170;
+  const int count = std::min<int32_t>(170, LEDS - first);
+  std::vector<uint8_t> packet = root_layer(126 + count * 3, 4);
+  put16(packet, 42, 2);
+  packet[108] = 100;
+  put16(packet, 109, 1000);
+  packet[111] = frame;
+  put16(packet, 113, universe);
+  put16(packet, 115, 0x7000 | (packet.size() - 115));
+  packet[117] = 2;
+  packet[118] = 0xa1;
+  put16(packet, 121, 1);
+  put16(packet, 123, 1 + count * 3);
+  for (int led = 0; led < count; led++) {
+    for (int channel = 0; channel < 3; channel++)
+      packet[126 + led * 3 + channel] = pixel(frame, first + led, channel);
+  }
+  return packet;
+}
+
+static std::vector<uint8_t> e131_sync(int frame) {
+  std::vector<uint8_t> packet = root_layer(49, 8);
+  put16(packet, 42, 1);
+  packet[44] = frame;
+  put16(packet, 45, 1000);
+  return packet;
+}
+
+/// A WLED DNRGB packet with up to 489 LEDs from first, the most that fits into one.
+static std::vector<uint8_t> wled_dnrgb(int frame, int32_t first) {
+  const int32_t count = std::min<int32_t>(489, LEDS - first);
+  std::vector<uint8_t> packet{4, 2, static_cast<uint8_t>(first >> 8), static_cast<uint8_t>(first)};
+  for (int32_t led = first; led < first + count; led++) {
+    for (int channel = 0; channel < 3; channel++)
+      packet.push_back(pixel(frame, led, channel));
+  }
+  return packet;
+}
+
+/// An Adalight frame for all LEDs.
+static std::vector<uint8_t> adalight_frame(int frame) {
+  const uint16_t count = LEDS - 1;
+  std::vector<uint8_t> data{'A', 'd', 'a', static_cast<uint8_t>(count >> 8), static_cast<uint8_t>(count)};
+  data.push_back(data[3] ^ data[4] ^ 0x55);
+  for (int32_t led = 0; led < LEDS; led++) {
+    for (int channel = 0; channel < 3; channel++)
+      data.push_back(pixel(frame, led, channel));
+  }
+  return data;
+}
+
+/// Packets in the classic pcap format, Ethernet frames with IPv4 and UDP.
+class PcapWriter {
+ public:
+  PcapWriter() {
+    put_le32(this->data, 0xa1b2c3d4);
+    put_le16(this->data, 2);
+    put_le16(this->data, 4);
+    put_le32(this->data, 0);
+    put_le32(this->data, 0);
+    put_le32(this->data, 65535);
+    put_le32(this->data, 1);
+  }
+
+  void add(uint32_t time_us, uint16_t port, const std::vector<uint8_t> &payload) {
+    std::vector<uint8_t> frame(14 + 20 + 8, 0);
+    put16(frame, 12, 0x0800);
+    frame[14] = 0x45;
+    put16(frame, 16, 20 + 8 + payload.size());
+    frame[22] = 64;
+    frame[23] = 17;
+    put16(frame, 34, 49152);
+    put16(frame, 36, port);
+    put16(frame, 38, 8 + payload.size());
+    frame.insert(frame.end(), payload.begin(), payload.end());
+
+    put_le32(this->data, time_us / 1000000);
+    put_le32(this->data, time_us % 1000000);
+    put_le32(this->data, frame.size());
+    put_le32(this->data, frame.size());
+    this->data.insert(this->data.end(), frame.begin(), frame.end());
+  }
+
+  std::vector<uint8_t> data;
+};
+
+struct Packet {
+  uint32_t time_us;
+  uint16_t port;
+  std::vector<uint8_t> payload;
+};
+
+static uint32_t read_le32(const uint8_t *data) {
+  return data[0] | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+}
+
+/// The UDP packets of a pcap capture with Ethernet frames, in little endian byte order.
+static std::vector<Packet> read_pcap(const std::vector<uint8_t> &capture) {
+  std::vector<Packet> packets;
+  if (capture.size() < 24 || read_le32(capture.data()) != 0xa1b2c3d4 || read_le32(&capture[20]) != 1)
+    return packets;
+  for (size_t pos = 24; pos + 16 <= capture.size();) {
+    const uint32_t time_us = read_le32(&capture[pos]) * 1000000 + read_le32(&capture[pos + 4]);
+    const size_t len = read_le32(&capture[pos + 8]);
+    const uint8_t *frame = &capture[pos + 16];
+    pos += 16 + len;
+    if (pos > capture.size())
+      break;
+    if (len < 14 + 20 + 8 || frame[12] != 0x08 || frame[13] != 0x00 || frame[23] != 17)
+      continue;
+    const uint8_t *udp = frame + 14 + (frame[14] & 0x0F) * 4;
+    const size_t udp_len = udp[4] << 8 | udp[5];
+    if (udp + udp_len > frame + len || udp_len < 8)
+      continue;
+    packets.push_back(Packet{time_us, static_cast<uint16_t>(udp[2] << 8 | udp[3]),
+                             std::vector<uint8_t>(udp + 8, udp + udp_len)});
+  }
+  return packets;
+}
+
+/// E1.31 with a synchronization packet per frame and WLED, one after the other, at 40 frames per second.
+static std::vector<uint8_t> generate_capture() {
+  PcapWriter pcap;
+  uint32_t time_us = 0;
+  for (int frame = 0; frame < FRAMES; frame++, time_us += 25000) {
+    for (uint16_t universe = 1; universe <= (LEDS + 169) / 170; universe++)
+      pcap.add(time_us, E131_PORT, e131_data(frame, universe));
+    pcap.add(time_us, E131_PORT, e131_sync(frame));
+  }
+  for (int frame = 0; frame < FRAMES; frame++, time_us += 25000) {
+    for (int32_t first = 0; first < LEDS; first += 489)
+      pcap.add(time_us, WLED_PORT, wled_dnrgb(frame, first));
+  }
+  return pcap.data;
+}
+
+struct Result {
+  size_t packets{0};
+  size_t bytes{0};
+  size_t frames{0};
+};
+
+static void report(const char *name, const Result &result, double seconds) {
+  printf("%-10s %6zu frames %7.1f us/frame %7.0f kpackets/s %7.1f MB/s %7.1f Mpixel/s\n", name, result.frames,
+         seconds * 1e6 / result.frames, result.packets / seconds / 1e3, result.bytes / seconds / 1e6,
+         double(result.frames) * LEDS / seconds / 1e6);
+}
+
+static Result replay_e131(const std::vector<Packet> &packets) {
+  BenchLight light(LEDS);
+  light::LightState state("strip", &light);
+  light.setup_state(&state);
+  E131Component e131;
+  E131AddressableLightEffect effect("e131");
+  effect.set_first_universe(1);
+  effect.set_channels(E131_RGB);
+  effect.set_e131(&e131);
+  effect.init_internal(&state);
+  e131.setup();
+  effect.start();
+
+  Result result;
+  for (const auto &packet : packets) {
+    if (packet.port != E131_PORT)
+      continue;
+    host_test::set_micros(START_US + packet.time_us);
+    UDP::received.push_back(packet.payload);
+    e131.loop();
+    result.packets++;
+    result.bytes += packet.payload.size();
+    if (state.show())
+      result.frames++;
+  }
+  effect.stop();
+  return result;
+}
+
+static Result replay_wled(const std::vector<Packet> &packets) {
+  BenchLight light(LEDS);
+  light::LightState state("strip", &light);
+  light.setup_state(&state);
+  wled::WLEDLightEffect effect("wled");
+  effect.set_port(WLED_PORT);
+  effect.init_internal(&state);
+  effect.start();
+  host_test::set_micros(START_US);
+  effect.apply(light, Color());
+  state.show();
+
+  // WLED reads the packets that arrived since the last apply(), which runs once all packets with the same time stamp
+  // are received
+  Result result;
+  for (size_t i = 0; i < packets.size(); i++) {
+    if (packets[i].port != WLED_PORT)
+      continue;
+    host_test::set_micros(START_US + packets[i].time_us);
+    UDP::received.push_back(packets[i].payload);
+    result.packets++;
+    result.bytes += packets[i].payload.size();
+    if (i + 1 < packets.size() && packets[i + 1].time_us == packets[i].time_us)
+      continue;
+    effect.apply(light, Color());
+    if (state.show())
+      result.frames++;
+  }
+  effect.stop();
+  return result;
+}
+
+static Result replay_adalight() {
+  BenchLight light(LEDS);
+  light::LightState state("strip", &light);
+  light.setup_state(&state);
+  BenchUART uart;
+  for (int frame = 0; frame < FRAMES; frame++) {
+    const auto data = adalight_frame(frame);
+    uart.stream.insert(uart.stream.end(), data.begin(), data.end());
+  }
+  adalight::AdalightLightEffect effect("adalight");
+  effect.set_uart_parent(&uart);
+  effect.init_internal(&state);
+  effect.start();
+  host_test::set_micros(START_US);
+  effect.apply(light, Color());
+  state.show();
+
+  // The 128 byte FIFO of an ESP32 UART, which fills in 1280 us at 1 Mbaud
+  Result result;
+  host_test::set_micros(START_US);
+  while (uart.receive(128)) {
+    host_test::advance_micros(1280);
+    result.packets++;
+    result.bytes += uart.available();
+    effect.apply(light, Color());
+    if (state.show())
+      result.frames++;
+  }
+  effect.stop();
+  return result;
+}
+
+template<typename F> static void run(const char *name, F &&replay) {
+  double best_s = 1e9;
+  Result result;
+  for (int run = 0; run < 5; run++) {
+    const auto start = std::chrono::steady_clock::now();
+    result = replay();
+    best_s = std::min(best_s, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  if (result.frames == 0) {
+    printf("%-10s no frames\n", name);
+    return;
+  }
+  report(name, result, best_s);
+}
+
+HOST_BENCHMARK(e131_replay) {
+  std::vector<uint8_t> capture;
+  const char *path = getenv("BENCH_E131_PCAP");
+  if (path != nullptr) {
+    std::ifstream file(path, std::ios::binary);
+    capture.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    printf("Replaying %s\n", path);
+  } else {
+    capture = generate_capture();
+  }
+  const auto packets = read_pcap(capture);
+  printf("%zu packets, %d LEDs\n", packets.size(), LEDS);
+
+  run("E1.31", [&packets]() { return replay_e131(packets); });
+  run("WLED", [&packets]() { return replay_wled(packets); });
+  run("Adalight", []() { return replay_adalight(); });
+}
+
+}  // namespace e131
+}  // namespace esphome
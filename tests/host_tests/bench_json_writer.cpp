@@ -0,0 +1,68 @@
+// Benchmark of json::JsonWriter with the documents web_server and MQTT send for state updates.
+//
+// host_test sources: esphome/components/json/json_writer.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/json/json_writer.h"
+
+#include <chrono>
+
+namespace esphome {
+namespace json {
+
+static const uint32_t ROUNDS = 1000000;
+
+template<typename F> static void run(const char *name, F &&f) {
+  size_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < ROUNDS; round++)
+    bytes += f(round);
+  const auto end = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  printf("%-36s %6.1f ns/document  %zu bytes/document\n", name, ns / ROUNDS, bytes / ROUNDS);
+}
+
+HOST_BENCHMARK(json_writer_documents) {
+  // The web_server sensor state: id, formatted state and value
+  run("sensor, new string", [](uint32_t round) {
+    return write_json([round](JsonWriter &root) {
+             root.add("id", "sensor-living_room_temperature");
+             root.add("state", "21.5 °C");
+             root.add("value", 20.0f + static_cast<float>(round % 100) / 10.0f);
+           })
+        .size();
+  });
+  run("sensor, reused buffer", [](uint32_t round) {
+    size_t length;
+    write_json(
+        [round](JsonWriter &root) {
+          root.add("id", "sensor-living_room_temperature");
+          root.add("state", "21.5 °C");
+          root.add("value", 20.0f + static_cast<float>(round % 100) / 10.0f);
+        },
+        &length);
+    return length;
+  });
+  // The MQTT JSON light state
+  run("light, reused buffer", [](uint32_t round) {
+    size_t length;
+    write_json(
+        [round](JsonWriter &root) {
+          root.add("state", "ON");
+          root.add("color_mode", "rgb");
+          root.add("brightness", round % 256);
+          root.begin_object("color");
+          root.add("r", 255u);
+          root.add("g", round % 256);
+          root.add("b", 0u);
+          root.end_object();
+          root.add("effect", "None");
+        },
+        &length);
+    return length;
+  });
+}
+
+}  // namespace json
+}  // namespace esphome
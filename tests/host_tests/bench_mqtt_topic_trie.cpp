@@ -0,0 +1,90 @@
+// Benchmark of dispatching MQTT messages through the topic trie, compared to matching every subscription with the
+// recursive topic_match() that MQTTClientComponent::on_message used before.
+//
+// host_test sources: esphome/components/mqtt/mqtt_topic_trie.cpp
+// host_test flags: -DUSE_MQTT
+
+#include "host_test.h"
+
+#include "esphome/components/mqtt/mqtt_topic_trie.h"
+
+#include <chrono>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
+  if (*message == '\0' && *subscription == '\0')
+    return true;
+  if (*message == '\0' || *subscription == '\0')
+    return false;
+  bool do_wildcards = is_normal || past_separator;
+  if (*subscription == '+' && do_wildcards) {
+    subscription++;
+    while (*message != '\0' && *message != '/')
+      message++;
+    return topic_match(message, subscription, is_normal, true);
+  }
+  if (*subscription == '#' && do_wildcards)
+    return true;
+  if (*message != *subscription)
+    return false;
+  past_separator = past_separator || *subscription == '/';
+  subscription++;
+  message++;
+  return topic_match(message, subscription, is_normal, past_separator);
+}
+
+static bool topic_match(const char *message, const char *subscription) {
+  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+}
+
+static const uint32_t MESSAGES = 200000;
+
+static void run(uint32_t subscriptions) {
+  // The command topics of switches, plus a wildcard subscription like the one of a custom component
+  std::vector<std::string> filters;
+  for (uint32_t i = 0; i + 1 < subscriptions; i++)
+    filters.push_back("livingroom/switch/relay_" + std::to_string(i) + "/command");
+  filters.emplace_back("livingroom/+/status");
+  std::vector<std::string> topics;
+  for (uint32_t i = 0; i < 64; i++)
+    topics.push_back(filters[(i * 7919) % filters.size()]);
+  topics[0] = "livingroom/sensor/status";
+
+  MQTTTopicTrie trie;
+  for (uint32_t i = 0; i < filters.size(); i++)
+    trie.add(filters[i], i);
+  std::vector<uint16_t> matched;
+  uint64_t trie_matches = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < MESSAGES; i++) {
+    matched.clear();
+    trie.match(topics[i % topics.size()], matched);
+    trie_matches += matched.size();
+  }
+  const double trie_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  uint64_t linear_matches = 0;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < MESSAGES; i++) {
+    const std::string &topic = topics[i % topics.size()];
+    for (auto &filter : filters)
+      linear_matches += topic_match(topic.c_str(), filter.c_str());
+  }
+  const double linear_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(trie_matches, linear_matches);
+  printf("%5u subscriptions  trie %6.2f M msg/s  topic_match %6.2f M msg/s\n", subscriptions,
+         MESSAGES / trie_s / 1e6, MESSAGES / linear_s / 1e6);
+}
+
+HOST_BENCHMARK(mqtt_dispatch) {
+  run(10);
+  run(100);
+  run(1000);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
@@ -0,0 +1,66 @@
+// Benchmark of OTA updates with the ESP-IDF backend on a simulated flash, see ota_host.h: the pipelined writer task
+// compared with writing each chunk synchronously, for a 1.5 MB image over links and flashes of different speeds.
+//
+// host_test sources: tests/host_tests/ota_host.cpp esphome/components/ota/ota_component.cpp
+// host_test sources: esphome/components/ota/ota_backend_esp_idf.cpp esphome/components/ota/ota_decoder.cpp
+// host_test sources: esphome/components/ota/ota_writer.cpp esphome/components/md5/md5.cpp
+// host_test sources: esphome/components/socket/bsd_sockets_impl.cpp
+// host_test sources: esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test flags: -DUSE_ESP32 -DUSE_ESP_IDF -DOPENSSL_SUPPRESS_DEPRECATED
+// host_test libs: -lcrypto -lz
+
+#include "host_test.h"
+#include "ota_host.h"
+
+#include <chrono>
+#include <random>
+
+namespace esphome {
+namespace ota {
+
+static const size_t IMAGE_SIZE = 1536 * 1024;
+/// Programming a byte, about 1 MB/s.
+static const uint32_t PROGRAM_NS_PER_BYTE = 1000;
+
+/// Seconds to upload the image, or a negative number when the upload failed.
+static double upload_time(const std::vector<uint8_t> &image, uint32_t sector_erase_us, uint32_t link_kbps,
+                          bool synchronous) {
+  ota_host::reset();
+  ota_host::set_flash_timing(sector_erase_us, PROGRAM_NS_PER_BYTE);
+  ota_host::set_task_create_fails(synchronous);
+  ota_host::HostOTAComponent ota;
+  ota.setup();
+
+  ota_host::UploadOptions options;
+  options.link_kbps = link_kbps;
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = ota_host::upload(&ota, image, options);
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (result.response != OTA_RESPONSE_UPDATE_END_OK || ota_host::get_written_image() != image)
+    return -1;
+  return seconds;
+}
+
+HOST_BENCHMARK(ota_writer) {
+  host_test::use_real_time();
+  std::mt19937 random(1);
+  std::vector<uint8_t> image(IMAGE_SIZE);
+  for (auto &byte : image)
+    byte = random();
+  image[0] = 0xE9;
+
+  struct Setup {
+    uint32_t sector_erase_us;
+    uint32_t link_kbps;
+  };
+  printf("erase  link       synchronous  pipelined\n");
+  for (const Setup &setup : {Setup{25000, 200}, Setup{25000, 1000}, Setup{8000, 600}, Setup{3000, 1500}}) {
+    const double synchronous = upload_time(image, setup.sector_erase_us, setup.link_kbps, true);
+    const double pipelined = upload_time(image, setup.sector_erase_us, setup.link_kbps, false);
+    printf("%2u ms  %4u kB/s  %9.2f s  %7.2f s\n", setup.sector_erase_us / 1000, setup.link_kbps, synchronous,
+           pipelined);
+  }
+}
+
+}  // namespace ota
+}  // namespace esphome
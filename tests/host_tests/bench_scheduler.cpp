@@ -0,0 +1,218 @@
+// Benchmark of Scheduler against the scheduler it replaced, with 1k and 10k named items.
+//
+// host_test sources: esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+/// The previous scheduler: items own a copy of their name, cancelling scans all items and every item is allocated.
+/// Only what the benchmark uses is kept. It leaves out the handling of millis() overflows, which makes its heap
+/// comparisons cheaper, so the loop numbers slightly favour it.
+class LegacyScheduler {
+ public:
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func) {
+    if (!name.empty())
+      this->cancel_item_(component, name, false);
+    this->push_(component, name, false, timeout, millis(), std::move(func));
+  }
+  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func) {
+    if (!name.empty())
+      this->cancel_item_(component, name, true);
+    this->push_(component, name, true, interval, millis() - interval, std::move(func));
+  }
+  bool cancel_timeout(Component *component, const std::string &name) {
+    return this->cancel_item_(component, name, false);
+  }
+
+  void call() {
+    const uint32_t now = millis();
+    this->process_to_add_();
+    if (this->to_remove_ > 10) {
+      std::vector<std::unique_ptr<Item>> valid_items;
+      while (!this->empty_()) {
+        valid_items.push_back(std::move(this->items_[0]));
+        this->pop_raw_();
+      }
+      this->items_ = std::move(valid_items);
+    }
+    while (!this->empty_()) {
+      auto &item = this->items_[0];
+      if (now - item->last_execution < item->interval)
+        break;
+      item->callback();
+      auto done = std::move(this->items_[0]);
+      this->pop_raw_();
+      if (done->remove) {
+        this->to_remove_--;
+        continue;
+      }
+      if (done->repeat) {
+        done->last_execution += (now - done->last_execution) / done->interval * done->interval;
+        this->to_add_.push_back(std::move(done));
+      }
+    }
+    this->process_to_add_();
+  }
+
+ protected:
+  struct Item {
+    Component *component;
+    std::string name;
+    bool repeat;
+    uint32_t interval;
+    uint32_t last_execution;
+    std::function<void()> callback;
+    bool remove;
+  };
+
+  static bool cmp_(const std::unique_ptr<Item> &a, const std::unique_ptr<Item> &b) {
+    return a->last_execution + a->interval > b->last_execution + b->interval;
+  }
+  void push_(Component *component, const std::string &name, bool repeat, uint32_t interval, uint32_t last_execution,
+             std::function<void()> &&func) {
+    auto item = make_unique<Item>();
+    item->component = component;
+    item->name = name;
+    item->repeat = repeat;
+    item->interval = interval;
+    item->last_execution = last_execution;
+    item->callback = std::move(func);
+    item->remove = false;
+    this->to_add_.push_back(std::move(item));
+  }
+  bool cancel_item_(Component *component, const std::string &name, bool repeat) {
+    bool ret = false;
+    for (auto &it : this->items_)
+      if (it->component == component && it->name == name && it->repeat == repeat && !it->remove) {
+        this->to_remove_++;
+        it->remove = true;
+        ret = true;
+      }
+    for (auto &it : this->to_add_)
+      if (it->component == component && it->name == name && it->repeat == repeat) {
+        it->remove = true;
+        ret = true;
+      }
+    return ret;
+  }
+  void process_to_add_() {
+    for (auto &it : this->to_add_) {
+      if (it->remove)
+        continue;
+      this->items_.push_back(std::move(it));
+      std::push_heap(this->items_.begin(), this->items_.end(), cmp_);
+    }
+    this->to_add_.clear();
+  }
+  bool empty_() {
+    while (!this->items_.empty() && this->items_[0]->remove) {
+      this->to_remove_--;
+      this->pop_raw_();
+    }
+    return this->items_.empty();
+  }
+  void pop_raw_() {
+    std::pop_heap(this->items_.begin(), this->items_.end(), cmp_);
+    this->items_.pop_back();
+  }
+
+  std::vector<std::unique_ptr<Item>> items_;
+  std::vector<std::unique_ptr<Item>> to_add_;
+  uint32_t to_remove_{0};
+};
+
+template<typename F> static void run(const char *name, const char *unit, uint32_t operations, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto end = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  printf("%-32s %10.1f ns/%s\n", name, ns / operations, unit);
+}
+
+static std::vector<std::string> item_names(uint32_t count) {
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < count; i++)
+    names.push_back("component_timeout_" + std::to_string(i));
+  return names;
+}
+
+// Arm `count` named timeouts, then re-arm every one of them `rounds` times, like debounce timers do.
+template<typename S> static void bench_rearm(const char *name, uint32_t count, uint32_t rounds) {
+  S scheduler;
+  Component component;
+  const auto names = item_names(count);
+  for (auto &item_name : names)
+    scheduler.set_timeout(&component, item_name, 1000000, []() {});
+  scheduler.call();
+  run(name, "re-arm", count * rounds, [&]() {
+    for (uint32_t round = 0; round < rounds; round++) {
+      for (auto &item_name : names)
+        scheduler.set_timeout(&component, item_name, 1000000, []() {});
+      scheduler.call();
+    }
+  });
+}
+
+// `count` intervals with different periods, run the loop every millisecond for 10 s.
+template<typename S> static void bench_intervals(const char *name, uint32_t count) {
+  S scheduler;
+  Component component;
+  const auto names = item_names(count);
+  for (uint32_t i = 0; i < count; i++)
+    scheduler.set_interval(&component, names[i], 100 + i % 900, []() {});
+  run(name, "loop", 10000, [&]() {
+    for (uint32_t ms = 0; ms < 10000; ms++) {
+      host_test::advance_millis(1);
+      scheduler.call();
+    }
+  });
+}
+
+// Arm `count` named timeouts and cancel all of them.
+template<typename S> static void bench_cancel(const char *name, uint32_t count) {
+  S scheduler;
+  Component component;
+  const auto names = item_names(count);
+  for (auto &item_name : names)
+    scheduler.set_timeout(&component, item_name, 1000000, []() {});
+  scheduler.call();
+  run(name, "cancel", count, [&]() {
+    for (auto &item_name : names)
+      scheduler.cancel_timeout(&component, item_name);
+    scheduler.call();
+  });
+}
+
+HOST_BENCHMARK(scheduler_rearm) {
+  bench_rearm<LegacyScheduler>("re-arm, 1k items, old", 1000, 10);
+  bench_rearm<Scheduler>("re-arm, 1k items, new", 1000, 10);
+  bench_rearm<LegacyScheduler>("re-arm, 10k items, old", 10000, 1);
+  bench_rearm<Scheduler>("re-arm, 10k items, new", 10000, 10);
+}
+
+HOST_BENCHMARK(scheduler_cancel) {
+  bench_cancel<LegacyScheduler>("cancel, 1k items, old", 1000);
+  bench_cancel<Scheduler>("cancel, 1k items, new", 1000);
+  bench_cancel<LegacyScheduler>("cancel, 10k items, old", 10000);
+  bench_cancel<Scheduler>("cancel, 10k items, new", 10000);
+}
+
+HOST_BENCHMARK(scheduler_intervals) {
+  bench_intervals<LegacyScheduler>("loop with 1k intervals, old", 1000);
+  bench_intervals<Scheduler>("loop with 1k intervals, new", 1000);
+  bench_intervals<LegacyScheduler>("loop with 10k intervals, old", 10000);
+  bench_intervals<Scheduler>("loop with 10k intervals, new", 10000);
+}
+
+}  // namespace esphome
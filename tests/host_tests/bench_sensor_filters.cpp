@@ -0,0 +1,86 @@
+// Benchmark of the sliding window sensor filters (median, quantile, min and max) against the sort-based filters they
+// replaced, with windows of 5 to 500 values and an output for every value.
+//
+// host_test sources: esphome/components/sensor/sensor.cpp esphome/components/sensor/filter.cpp
+// host_test sources: esphome/core/entity_base.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+#include "legacy_sensor_filters.h"
+
+#include "esphome/components/sensor/filter.h"
+#include "esphome/core/preferences.h"
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace sensor {
+
+static const size_t WINDOW_SIZES[] = {5, 15, 100, 500};
+static const uint32_t VALUES = 20000;
+
+/// A noisy signal, like the readings of an ADC.
+static std::vector<float> signal_values() {
+  std::mt19937 rng(42);
+  std::normal_distribution<float> noise(0.0f, 0.5f);
+  std::vector<float> values;
+  for (uint32_t i = 0; i < VALUES; i++)
+    values.push_back(20.0f + static_cast<float>(i % 1000) / 100.0f + noise(rng));
+  return values;
+}
+
+template<typename F> static void run(const std::string &name, F &filter, const std::vector<float> &values) {
+  float sum = 0.0f;
+  const auto start = std::chrono::steady_clock::now();
+  for (float value : values)
+    sum += filter.new_value(value).value_or(0.0f);
+  const auto end = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  // The sum keeps the compiler from dropping the outputs
+  printf("%-32s %10.1f ns/value (%.0f)\n", name.c_str(), ns / values.size(), sum);
+}
+
+HOST_BENCHMARK(sensor_filters_median) {
+  const auto values = signal_values();
+  for (size_t window_size : WINDOW_SIZES) {
+    legacy::LegacyMedianFilter legacy(window_size, 1, 1);
+    MedianFilter filter(window_size, 1, 1);
+    run("median, window " + std::to_string(window_size) + ", old", legacy, values);
+    run("median, window " + std::to_string(window_size) + ", new", filter, values);
+  }
+}
+
+HOST_BENCHMARK(sensor_filters_quantile) {
+  const auto values = signal_values();
+  for (size_t window_size : WINDOW_SIZES) {
+    legacy::LegacyQuantileFilter legacy(window_size, 1, 1, 0.9f);
+    QuantileFilter filter(window_size, 1, 1, 0.9f);
+    run("quantile, window " + std::to_string(window_size) + ", old", legacy, values);
+    run("quantile, window " + std::to_string(window_size) + ", new", filter, values);
+  }
+}
+
+HOST_BENCHMARK(sensor_filters_min_max) {
+  const auto values = signal_values();
+  for (size_t window_size : WINDOW_SIZES) {
+    legacy::LegacyMinFilter legacy_min(window_size, 1, 1);
+    MinFilter min_filter(window_size, 1, 1);
+    legacy::LegacyMaxFilter legacy_max(window_size, 1, 1);
+    MaxFilter max_filter(window_size, 1, 1);
+    run("min, window " + std::to_string(window_size) + ", old", legacy_min, values);
+    run("min, window " + std::to_string(window_size) + ", new", min_filter, values);
+    run("max, window " + std::to_string(window_size) + ", old", legacy_max, values);
+    run("max, window " + std::to_string(window_size) + ", new", max_filter, values);
+  }
+}
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,48 @@
+"""Generate the delta patch fixtures of tests/host_tests/test_ota.cpp with esphome/ota_delta.py.
+
+Run from the repository root: python3 tests/host_tests/fixtures/ota_delta/generate.py
+"""
+import os
+import random
+import struct
+import sys
+
+sys.path.insert(0, os.getcwd())
+
+from esphome import ota_delta  # noqa: E402
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def image(size, seed):
+    """Code-like data: random instructions with absolute addresses among them."""
+    rnd = random.Random(seed)
+    words = []
+    for _ in range(size // 4):
+        if rnd.random() < 0.25:
+            words.append(0x400D0000 + rnd.randrange(0, size) & ~3)
+        else:
+            words.append(rnd.getrandbits(32) & 0x00FFFFFF)
+    return b"".join(struct.pack("<I", w) for w in words)
+
+
+def relocate(data, shift):
+    """Move all addresses in data by shift, like code that moved does."""
+    words = list(struct.unpack(f"<{len(data) // 4}I", data))
+    words = [w + shift if w >= 0x400D0000 else w for w in words]
+    return struct.pack(f"<{len(words)}I", *words)
+
+
+def main():
+    base = image(16384, 1)
+    # Unchanged code, code that moved and new code, which take COPY, ADD and DATA operations
+    new = base[:4096] + relocate(base[4096:12288], 0x40) + image(512, 2) + base[12288:]
+    patch = ota_delta.create_patch(base, new)
+    assert ota_delta.apply_patch(base, patch) == new
+    for name, data in (("base.bin", base), ("image.bin", new), ("patch.bin", patch)):
+        with open(os.path.join(HERE, name), "wb") as f:
+            f.write(data)
+
+
+if __name__ == "__main__":
+    main()
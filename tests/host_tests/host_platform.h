@@ -0,0 +1,15 @@
+#pragma once
+
+// Included ahead of every source of a host test: system headers that the device toolchains make available without
+// an explicit include.
+
+#include <algorithm>
+#include <array>
+#include <arpa/inet.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <tuple>
@@ -0,0 +1,201 @@
+#include "host_test.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/components/debug/component_profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// The parts of the core that depend on the platform, replaced by versions for the build machine. Tests can't also
+// link esphome/core/application.cpp, hal or helpers.cpp.
+
+namespace esphome {
+namespace host_test {
+
+struct Test {
+  const char *name;
+  TestFunction function;
+  bool benchmark;
+};
+
+static std::vector<Test> &tests() {
+  static std::vector<Test> tests;
+  return tests;
+}
+
+// Atomic, as threads of a test may read it while the test advances it
+static std::atomic<uint32_t> now_us{0};
+static bool real_time = false;
+static std::chrono::steady_clock::time_point real_time_start;
+static int failures = 0;
+static bool verbose = false;
+
+Registration::Registration(const char *name, TestFunction function, bool benchmark) {
+  tests().push_back(Test{name, function, benchmark});
+}
+
+void set_micros(uint32_t now) { now_us = now; }
+void advance_micros(uint32_t us) { now_us += us; }
+void advance_millis(uint32_t ms) { now_us += ms * 1000; }
+void use_real_time() {
+  real_time = true;
+  real_time_start = std::chrono::steady_clock::now() - std::chrono::microseconds(now_us);
+}
+
+void fail(const char *file, int line, const std::string &message) {
+  printf("%s:%d: %s\n", file, line, message.c_str());
+  failures++;
+}
+
+}  // namespace host_test
+
+uint32_t micros() {
+  if (!host_test::real_time)
+    return host_test::now_us;
+  const auto elapsed = std::chrono::steady_clock::now() - host_test::real_time_start;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+uint32_t millis() { return micros() / 1000; }
+void delay(uint32_t ms) {
+  if (host_test::real_time)
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  else
+    host_test::advance_millis(ms);
+}
+void delayMicroseconds(uint32_t us) {  // NOLINT(readability-identifier-naming)
+  if (host_test::real_time)
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  else
+    host_test::advance_micros(us);
+}
+void yield() {}
+void arch_feed_wdt() {}
+uint32_t arch_get_cpu_cycle_count() { return micros() * 240; }
+uint32_t arch_get_cpu_freq_hz() { return 240000000; }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list arg;
+  va_start(arg, format);
+  esp_log_vprintf_(level, tag, line, format, arg);
+  va_end(arg);
+}
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  if (!host_test::verbose)
+    return;
+  printf("[%s:%d] ", tag, line);
+  vprintf(format, args);
+  printf("\n");
+}
+
+Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+void Application::feed_wdt() {}
+
+void HighFrequencyLoopRequester::start() { this->started_ = true; }
+void HighFrequencyLoopRequester::stop() { this->started_ = false; }
+
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= c;
+  }
+  return hash;
+}
+uint32_t random_uint32() { return static_cast<uint32_t>(rand()); }  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+void fill_random(uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    data[i] = random_uint32();
+}
+std::string to_string(int value) { return std::to_string(value); }
+size_t parse_hex(const char *str, size_t length, uint8_t *data, size_t count) {
+  uint8_t val;
+  size_t chars = std::min(length, 2 * count);
+  for (size_t i = 2 * count - chars; i < 2 * count; i++, str++) {
+    if (*str >= '0' && *str <= '9')
+      val = *str - '0';
+    else if (*str >= 'A' && *str <= 'F')
+      val = 10 + (*str - 'A');
+    else if (*str >= 'a' && *str <= 'f')
+      val = 10 + (*str - 'a');
+    else
+      return 0;
+    data[i >> 1] = !(i & 1) ? val << 4 : data[i >> 1] | val;
+  }
+  return chars;
+}
+template<typename T> T clamp(const T val, const T min, const T max) {
+  if (val < min)
+    return min;
+  if (val > max)
+    return max;
+  return val;
+}
+template uint8_t clamp(uint8_t, uint8_t, uint8_t);
+template float clamp(float, float, float);
+template int clamp(int, int, int);
+float lerp(float completion, float start, float end) { return start + (end - start) * completion; }
+
+float gamma_correct(float value, float gamma) {
+  if (value <= 0.0f)
+    return 0.0f;
+  if (gamma <= 0.0f)
+    return value;
+  return powf(value, gamma);
+}
+float gamma_uncorrect(float value, float gamma) {
+  if (value <= 0.0f)
+    return 0.0f;
+  if (gamma <= 0.0f)
+    return value;
+  return powf(value, 1 / gamma);
+}
+
+namespace debug {
+// Tests don't profile components. Weak, so that the tests of the profiler itself can link component_profiler.cpp.
+__attribute__((weak)) ComponentProfiler *global_component_profiler =  // NOLINT
+    nullptr;
+__attribute__((weak)) void ComponentProfiler::record_loop(Component *component, uint32_t duration_us) {}
+__attribute__((weak)) void ComponentProfiler::record_setup(Component *component, uint32_t duration_us) {}
+}  // namespace debug
+
+}  // namespace esphome
+
+int main(int argc, char **argv) {
+  using namespace esphome::host_test;
+  bool benchmarks = false;
+  const char *filter = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      benchmarks = true;
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      verbose = true;
+    } else {
+      filter = argv[i];
+    }
+  }
+
+  int run = 0;
+  for (auto &test : tests()) {
+    if (test.benchmark != benchmarks || (filter != nullptr && strstr(test.name, filter) == nullptr))
+      continue;
+    const int failures_before = failures;
+    now_us = 0;
+    real_time = false;
+    test.function();
+    printf("%s %s\n", failures == failures_before ? "PASS" : "FAIL", test.name);
+    run++;
+  }
+  if (run == 0)
+    printf("No %s matched\n", benchmarks ? "benchmarks" : "tests");
+  return failures == 0 ? 0 : 1;
+}
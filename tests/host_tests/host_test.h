@@ -0,0 +1,65 @@
+#pragma once
+
+// Support for C++ tests that run on the build machine instead of a device, see script/host_test.
+//
+// Every test_*.cpp or bench_*.cpp file in this directory is built into its own program together with host_test.cpp
+// and the sources listed in its "// host_test sources:" comment (paths relative to the repository root). Extra
+// compiler flags and libraries can be given with "// host_test flags:" and "// host_test libs:".
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace esphome {
+namespace host_test {
+
+using TestFunction = void (*)();
+
+struct Registration {
+  Registration(const char *name, TestFunction function, bool benchmark);
+};
+
+/// Set the time returned by micros() and millis(). The clock only moves when a test (or delay()) advances it.
+void set_micros(uint32_t now);
+void advance_micros(uint32_t us);
+void advance_millis(uint32_t ms);
+/// Make micros(), millis() and delay() follow the real time instead, for tests that talk to other threads. Every test
+/// starts with the fake clock.
+void use_real_time();
+
+/// Record a failed check, called by the EXPECT_ macros.
+void fail(const char *file, int line, const std::string &message);
+
+template<typename T> std::string to_string(const T &value) { return std::to_string(value); }
+inline std::string to_string(const std::string &value) { return '"' + value + '"'; }
+inline std::string to_string(const char *value) { return '"' + std::string(value) + '"'; }
+inline std::string to_string(bool value) { return value ? "true" : "false"; }
+
+}  // namespace host_test
+}  // namespace esphome
+
+#define HOST_TEST_REGISTER_(name, benchmark) \
+  static void name(); \
+  static const esphome::host_test::Registration name##_registration{#name, name, benchmark}; \
+  static void name()
+
+/// Define a test, which is run by script/host_test.
+#define HOST_TEST(name) HOST_TEST_REGISTER_(name, false)
+/// Define a benchmark, which is only run by script/host_test --bench.
+#define HOST_BENCHMARK(name) HOST_TEST_REGISTER_(name, true)
+
+#define EXPECT_TRUE(condition) \
+  do { \
+    if (!(condition)) \
+      esphome::host_test::fail(__FILE__, __LINE__, "expected " #condition); \
+  } while (0)
+
+#define EXPECT_EQ(actual, expected) \
+  do { \
+    const auto &actual_ = (actual); \
+    const auto &expected_ = (expected); \
+    if (!(actual_ == expected_)) \
+      esphome::host_test::fail(__FILE__, __LINE__, \
+                               #actual " is " + esphome::host_test::to_string(actual_) + ", expected " + \
+                                   esphome::host_test::to_string(expected_)); \
+  } while (0)
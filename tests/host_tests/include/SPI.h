@@ -0,0 +1,40 @@
+#pragma once
+
+// Test stub of the Arduino SPI class: every byte written to the bus goes to write(), which a test overrides to emulate
+// the device on the other end.
+
+#include <cstddef>
+#include <cstdint>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+class SPISettings {
+ public:
+  SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode) {}
+};
+
+class SPIClass {
+ public:
+  virtual ~SPIClass() {}
+
+  void beginTransaction(SPISettings settings) {}  // NOLINT(readability-identifier-naming)
+  void endTransaction() {}                        // NOLINT(readability-identifier-naming)
+
+  virtual void write(uint8_t data) {}
+  void write16(uint16_t data) {
+    this->write(data >> 8);
+    this->write(data);
+  }
+  void writeBytes(const uint8_t *data, uint32_t size) {  // NOLINT(readability-identifier-naming)
+    for (uint32_t i = 0; i < size; i++)
+      this->write(data[i]);
+  }
+  uint8_t transfer(uint8_t data) {
+    this->write(data);
+    return 0;
+  }
+  void transfer(void *data, uint32_t size) { this->writeBytes(static_cast<const uint8_t *>(data), size); }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+// Test stub of the Arduino UDP classes: received packets are taken from a queue that the test fills.
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+class UDP {
+ public:
+  virtual ~UDP() {}
+
+  /// The packets that parsePacket() returns next, defined by the test.
+  static std::deque<std::vector<uint8_t>> received;  // NOLINT
+
+  uint8_t begin(uint16_t port) { return 1; }
+  void stop() {}
+  int parsePacket() {  // NOLINT(readability-identifier-naming)
+    if (this->has_packet_)
+      received.pop_front();
+    this->has_packet_ = !received.empty();
+    this->position_ = 0;
+    return this->has_packet_ ? received.front().size() : 0;
+  }
+  int read(unsigned char *buffer, size_t len) {
+    if (!this->has_packet_)
+      return 0;
+    const auto &packet = received.front();
+    size_t n = std::min(len, packet.size() - this->position_);
+    memcpy(buffer, packet.data() + this->position_, n);
+    this->position_ += n;
+    return n;
+  }
+  int read(char *buffer, size_t len) { return this->read(reinterpret_cast<unsigned char *>(buffer), len); }
+
+ protected:
+  bool has_packet_{false};
+  size_t position_{0};
+};
+
+class WiFiUDP : public UDP {};
@@ -0,0 +1,8 @@
+#pragma once
+
+// The attribute macros of the ESP8266 SDK, which have no meaning on the host.
+
+#include <cstdint>
+
+#define IRAM_ATTR
+#define ICACHE_RODATA_ATTR
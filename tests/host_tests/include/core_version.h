@@ -0,0 +1,7 @@
+#pragma once
+
+// The version of the ESP8266 Arduino core, for host tests that build ESP8266 code.
+
+#define ARDUINO_ESP8266_MAJOR 3
+#define ARDUINO_ESP8266_MINOR 0
+#define ARDUINO_ESP8266_REVISION 2
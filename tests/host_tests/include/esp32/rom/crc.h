@@ -0,0 +1,8 @@
+#pragma once
+
+// The CRC functions of the ESP32 ROM, on top of zlib (link with -lz).
+
+#include <cstdint>
+#include <zlib.h>
+
+inline uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) { return crc32(crc, buf, len); }
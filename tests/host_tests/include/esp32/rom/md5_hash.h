@@ -0,0 +1,11 @@
+#pragma once
+
+// The MD5 functions of the ESP32 ROM, on top of OpenSSL (link with -lcrypto).
+
+#include <openssl/md5.h>
+
+typedef MD5_CTX MD5Context;
+
+inline void MD5Init(MD5Context *context) { MD5_Init(context); }
+inline void MD5Update(MD5Context *context, const unsigned char *buf, unsigned len) { MD5_Update(context, buf, len); }
+inline void MD5Final(unsigned char digest[16], MD5Context *context) { MD5_Final(digest, context); }
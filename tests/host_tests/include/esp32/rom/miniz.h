@@ -0,0 +1,76 @@
+#pragma once
+
+// miniz's tinfl as in the ESP32 ROM, on top of zlib (link with -lz).
+//
+// Like the ROM version, it reads ahead past the end of a deflate stream: the bytes that follow it in the same call
+// are counted as consumed, and end up in m_bit_buf after the unused bits of the last byte of the stream.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_FLAG_HAS_MORE_INPUT 2
+
+typedef enum {
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+typedef uint32_t tinfl_bit_buf_t;
+
+typedef struct {
+  uint32_t m_state;
+  uint32_t m_num_bits;
+  tinfl_bit_buf_t m_bit_buf;
+  z_stream z;
+} tinfl_decompressor;
+
+#define tinfl_init(r) ((r)->m_state = 0)
+
+/// Unused bits of the last byte of the stream that are left in the bit buffer.
+static const uint32_t TINFL_HOST_PARTIAL_BITS = 3;
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *in, size_t *in_size, uint8_t *out_start,
+                                     uint8_t *out, size_t *out_size, const uint32_t flags) {
+  if (r->m_state == 0) {
+    memset(&r->z, 0, sizeof(r->z));
+    inflateInit2(&r->z, -15);
+    r->m_state = 1;
+  }
+  if (r->m_state == 2) {
+    *in_size = 0;
+    *out_size = 0;
+    return TINFL_STATUS_DONE;
+  }
+  r->z.next_in = const_cast<Bytef *>(in);
+  r->z.avail_in = *in_size;
+  r->z.next_out = out;
+  r->z.avail_out = *out_size;
+  const int ret = inflate(&r->z, Z_NO_FLUSH);
+  *out_size -= r->z.avail_out;
+  if (ret == Z_STREAM_END) {
+    inflateEnd(&r->z);
+    r->m_state = 2;
+    r->m_num_bits = TINFL_HOST_PARTIAL_BITS;
+    r->m_bit_buf = 0x5;
+    while (r->z.avail_in > 0 && r->m_num_bits + 8 <= 8 * sizeof(tinfl_bit_buf_t)) {
+      r->m_bit_buf |= tinfl_bit_buf_t(*r->z.next_in++) << r->m_num_bits;
+      r->m_num_bits += 8;
+      r->z.avail_in--;
+    }
+    *in_size -= r->z.avail_in;
+    return TINFL_STATUS_DONE;
+  }
+  *in_size -= r->z.avail_in;
+  if (ret != Z_OK && ret != Z_BUF_ERROR) {
+    inflateEnd(&r->z);
+    return TINFL_STATUS_FAILED;
+  }
+  return r->z.avail_out == 0 ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_NEEDS_MORE_INPUT;
+}
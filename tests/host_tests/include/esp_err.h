@@ -0,0 +1,9 @@
+#pragma once
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_FLASH_OP_FAIL 0x6001
+#define ESP_ERR_FLASH_OP_TIMEOUT 0x6002
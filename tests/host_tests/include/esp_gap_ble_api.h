@@ -0,0 +1,21 @@
+#pragma once
+
+// The advertising data types of ESP-IDF's GAP API, for the parts of esp32_ble_tracker that only look at the raw
+// advertisement.
+
+typedef enum {
+  ESP_BLE_AD_TYPE_FLAG = 0x01,
+  ESP_BLE_AD_TYPE_16SRV_PART = 0x02,
+  ESP_BLE_AD_TYPE_16SRV_CMPL = 0x03,
+  ESP_BLE_AD_TYPE_32SRV_PART = 0x04,
+  ESP_BLE_AD_TYPE_32SRV_CMPL = 0x05,
+  ESP_BLE_AD_TYPE_128SRV_PART = 0x06,
+  ESP_BLE_AD_TYPE_128SRV_CMPL = 0x07,
+  ESP_BLE_AD_TYPE_NAME_SHORT = 0x08,
+  ESP_BLE_AD_TYPE_NAME_CMPL = 0x09,
+  ESP_BLE_AD_TYPE_TX_PWR = 0x0A,
+  ESP_BLE_AD_TYPE_SERVICE_DATA = 0x16,
+  ESP_BLE_AD_TYPE_32SERVICE_DATA = 0x20,
+  ESP_BLE_AD_TYPE_128SERVICE_DATA = 0x21,
+  ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE = 0xFF,
+} esp_ble_adv_data_type;
@@ -0,0 +1,3 @@
+#pragma once
+
+// ESP-IDF logging for host tests: esphome/core/log.h includes it, and its macros aren't used.
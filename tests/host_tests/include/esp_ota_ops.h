@@ -0,0 +1,24 @@
+#pragma once
+
+// The OTA and partition functions of ESP-IDF, implemented on a simulated flash in tests/host_tests/ota_host.cpp.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+#define ESP_ERR_OTA_VALIDATE_FAILED 0x1503
+
+typedef uint32_t esp_ota_handle_t;
+typedef struct {
+  int index;
+} esp_partition_t;
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start_from);
+const esp_partition_t *esp_ota_get_running_partition();
+esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle);
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size);
+esp_err_t esp_ota_end(esp_ota_handle_t handle);
+esp_err_t esp_ota_abort(esp_ota_handle_t handle);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition);
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size);
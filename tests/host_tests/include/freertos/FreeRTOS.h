@@ -0,0 +1,18 @@
+#pragma once
+
+// The parts of FreeRTOS used by the OTA writer, implemented on top of threads in tests/host_tests/ota_host.cpp.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef void *TaskHandle_t;
+typedef void *QueueHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
@@ -0,0 +1,10 @@
+#pragma once
+
+// Test stub of the lwIP IGMP functions, defined by the test.
+
+#include "lwip/ip4_addr.h"
+
+typedef int8_t err_t;  // NOLINT
+
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
@@ -0,0 +1,11 @@
+#pragma once
+
+// Test stub of the lwIP IPv4 address type.
+
+#include <cstdint>
+
+typedef struct ip4_addr {  // NOLINT
+  uint32_t addr;
+} ip4_addr_t;
+
+#define IP4_ADDR_ANY4 nullptr
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "lwip/ip4_addr.h"
@@ -0,0 +1,13 @@
+#pragma once
+
+// lwIP's BSD socket API is the one of the build machine.
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#define lwip_close close
+#define lwip_readv readv
+#define lwip_writev writev
@@ -0,0 +1,88 @@
+#pragma once
+
+// The parts of the noise-c API used by the native API, for host tests. Only the cipher states used once a connection
+// is established are implemented (see noise_cipher.cpp), there's no handshake.
+
+#include <cstddef>
+#include <cstdint>
+
+struct NoiseBuffer {
+  uint8_t *data;
+  size_t size;
+  size_t max_size;
+};
+struct NoiseCipherState;
+struct NoiseHandshakeState;
+struct NoiseProtocolId {
+  int prefix_id;
+  int pattern_id;
+  int dh_id;
+  int cipher_id;
+  int hash_id;
+  int hybrid_id;
+  int modifier_ids[4];
+  int reserved[4];
+};
+
+#define noise_buffer_init(b) ((b).data = nullptr, (b).size = 0, (b).max_size = 0)
+#define noise_buffer_set_inout(b, d, s, m) ((b).data = (d), (b).size = (s), (b).max_size = (m))
+#define noise_buffer_set_input(b, d, s) ((b).data = (d), (b).size = (s), (b).max_size = (s))
+#define noise_buffer_set_output(b, d, s) ((b).data = (d), (b).size = 0, (b).max_size = (s))
+
+enum {
+  NOISE_ERROR_NONE = 0,
+  NOISE_ERROR_NO_MEMORY,
+  NOISE_ERROR_UNKNOWN_ID,
+  NOISE_ERROR_UNKNOWN_NAME,
+  NOISE_ERROR_MAC_FAILURE,
+  NOISE_ERROR_NOT_APPLICABLE,
+  NOISE_ERROR_SYSTEM,
+  NOISE_ERROR_REMOTE_KEY_REQUIRED,
+  NOISE_ERROR_LOCAL_KEY_REQUIRED,
+  NOISE_ERROR_PSK_REQUIRED,
+  NOISE_ERROR_INVALID_LENGTH,
+  NOISE_ERROR_INVALID_PARAM,
+  NOISE_ERROR_INVALID_STATE,
+  NOISE_ERROR_INVALID_NONCE,
+  NOISE_ERROR_INVALID_PRIVATE_KEY,
+  NOISE_ERROR_INVALID_PUBLIC_KEY,
+  NOISE_ERROR_INVALID_FORMAT,
+  NOISE_ERROR_INVALID_SIGNATURE,
+};
+enum {
+  NOISE_ACTION_READ_MESSAGE = 1,
+  NOISE_ACTION_SPLIT,
+  NOISE_ACTION_WRITE_MESSAGE,
+  NOISE_ROLE_RESPONDER,
+  NOISE_PREFIX_STANDARD,
+  NOISE_PATTERN_NN,
+  NOISE_CIPHER_CHACHAPOLY,
+  NOISE_DH_CURVE25519,
+  NOISE_DH_NONE,
+  NOISE_HASH_SHA256,
+  NOISE_MODIFIER_PSK0,
+};
+
+extern "C" {
+int noise_cipherstate_decrypt(NoiseCipherState *state, NoiseBuffer *buffer);
+int noise_cipherstate_encrypt(NoiseCipherState *state, NoiseBuffer *buffer);
+int noise_cipherstate_free(NoiseCipherState *state);
+size_t noise_cipherstate_get_mac_length(const NoiseCipherState *state);
+int noise_handshakestate_free(NoiseHandshakeState *state);
+int noise_handshakestate_get_action(const NoiseHandshakeState *state);
+int noise_handshakestate_new_by_id(NoiseHandshakeState **state, const NoiseProtocolId *protocol_id, int role);
+int noise_handshakestate_read_message(NoiseHandshakeState *state, NoiseBuffer *message, NoiseBuffer *payload);
+int noise_handshakestate_set_pre_shared_key(NoiseHandshakeState *state, const uint8_t *key, size_t key_len);
+int noise_handshakestate_set_prologue(NoiseHandshakeState *state, const void *prologue, size_t prologue_len);
+int noise_handshakestate_split(NoiseHandshakeState *state, NoiseCipherState **send, NoiseCipherState **receive);
+int noise_handshakestate_start(NoiseHandshakeState *state);
+int noise_handshakestate_write_message(NoiseHandshakeState *state, NoiseBuffer *message, const NoiseBuffer *payload);
+int noise_protocol_name_to_id(NoiseProtocolId *id, const char *name, size_t name_len);
+}
+
+namespace esphome {
+namespace host_test {
+/// A ChaCha20-Poly1305 cipher state with a fixed key, as noise-c uses after the handshake.
+NoiseCipherState *noise_cipherstate_new();
+}  // namespace host_test
+}  // namespace esphome
@@ -0,0 +1,106 @@
+#pragma once
+
+// The sliding window filters of the sensor component before they kept their window in ring buffers and heaps: every
+// output sorts or scans a copy of a std::deque. Used as the reference of test_sensor_filters.cpp and the baseline of
+// bench_sensor_filters.cpp, only the parts those use are kept.
+
+#include "esphome/core/optional.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+namespace esphome {
+namespace legacy {
+
+/// The window handling that all the old filters shared, new_value() is the same apart from computing the output.
+class LegacyWindowFilter {
+ public:
+  LegacyWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
+      : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+  virtual ~LegacyWindowFilter() = default;
+
+  void set_window_size(size_t window_size) { this->window_size_ = window_size; }
+
+  optional<float> new_value(float value) {
+    if (!std::isnan(value)) {
+      while (this->queue_.size() >= this->window_size_) {
+        this->queue_.pop_front();
+      }
+      this->queue_.push_back(value);
+    }
+
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      float result = 0.0f;
+      if (!this->queue_.empty())
+        result = this->compute_();
+      return result;
+    }
+    return {};
+  }
+
+ protected:
+  virtual float compute_() = 0;
+
+  std::deque<float> queue_;
+  size_t send_every_;
+  size_t send_at_;
+  size_t window_size_;
+};
+
+class LegacyMedianFilter : public LegacyWindowFilter {
+ public:
+  using LegacyWindowFilter::LegacyWindowFilter;
+
+ protected:
+  float compute_() override {
+    std::deque<float> median_queue = this->queue_;
+    sort(median_queue.begin(), median_queue.end());
+
+    size_t queue_size = median_queue.size();
+    if (queue_size % 2) {
+      return median_queue[queue_size / 2];
+    } else {
+      return (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
+    }
+  }
+};
+
+class LegacyQuantileFilter : public LegacyWindowFilter {
+ public:
+  LegacyQuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+      : LegacyWindowFilter(window_size, send_every, send_first_at), quantile_(quantile) {}
+
+ protected:
+  float compute_() override {
+    std::deque<float> quantile_queue = this->queue_;
+    sort(quantile_queue.begin(), quantile_queue.end());
+
+    size_t queue_size = quantile_queue.size();
+    size_t position = ceilf(queue_size * this->quantile_) - 1;
+    return quantile_queue[position];
+  }
+
+  float quantile_;
+};
+
+class LegacyMinFilter : public LegacyWindowFilter {
+ public:
+  using LegacyWindowFilter::LegacyWindowFilter;
+
+ protected:
+  float compute_() override { return *std::min_element(this->queue_.begin(), this->queue_.end()); }
+};
+
+class LegacyMaxFilter : public LegacyWindowFilter {
+ public:
+  using LegacyWindowFilter::LegacyWindowFilter;
+
+ protected:
+  float compute_() override { return *std::max_element(this->queue_.begin(), this->queue_.end()); }
+};
+
+}  // namespace legacy
+}  // namespace esphome
@@ -0,0 +1,98 @@
+#include "noise/protocol.h"
+#include "host_test.h"
+
+#include <openssl/evp.h>
+
+// ChaCha20-Poly1305 like noise-c encrypts transport messages with, built on OpenSSL. The handshake isn't implemented.
+
+static const size_t MAC_LENGTH = 16;
+
+struct NoiseCipherState {
+  EVP_CIPHER_CTX *ctx;
+  uint64_t nonce;
+};
+
+static bool crypt(NoiseCipherState *state, uint8_t *data, size_t len, uint8_t *tag, bool encrypt) {
+  static const uint8_t KEY[32] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                                  17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+  // Noise uses 32 zero bits followed by the little endian 64-bit counter as the nonce
+  uint8_t iv[12] = {0};
+  for (int i = 0; i < 8; i++)
+    iv[4 + i] = state->nonce >> (8 * i);
+  int out_len;
+  if (EVP_CipherInit_ex(state->ctx, nullptr, nullptr, KEY, iv, encrypt) != 1)
+    return false;
+  if (!encrypt && EVP_CIPHER_CTX_ctrl(state->ctx, EVP_CTRL_AEAD_SET_TAG, MAC_LENGTH, tag) != 1)
+    return false;
+  if (EVP_CipherUpdate(state->ctx, data, &out_len, data, len) != 1)
+    return false;
+  if (EVP_CipherFinal_ex(state->ctx, data + out_len, &out_len) != 1)
+    return false;
+  if (encrypt && EVP_CIPHER_CTX_ctrl(state->ctx, EVP_CTRL_AEAD_GET_TAG, MAC_LENGTH, tag) != 1)
+    return false;
+  state->nonce++;
+  return true;
+}
+
+extern "C" {
+
+int noise_cipherstate_encrypt(NoiseCipherState *state, NoiseBuffer *buffer) {
+  if (buffer->size + MAC_LENGTH > buffer->max_size)
+    return NOISE_ERROR_INVALID_LENGTH;
+  if (!crypt(state, buffer->data, buffer->size, buffer->data + buffer->size, true))
+    return NOISE_ERROR_SYSTEM;
+  buffer->size += MAC_LENGTH;
+  return NOISE_ERROR_NONE;
+}
+int noise_cipherstate_decrypt(NoiseCipherState *state, NoiseBuffer *buffer) {
+  if (buffer->size < MAC_LENGTH)
+    return NOISE_ERROR_INVALID_LENGTH;
+  buffer->size -= MAC_LENGTH;
+  if (!crypt(state, buffer->data, buffer->size, buffer->data + buffer->size, false))
+    return NOISE_ERROR_MAC_FAILURE;
+  return NOISE_ERROR_NONE;
+}
+int noise_cipherstate_free(NoiseCipherState *state) {
+  EVP_CIPHER_CTX_free(state->ctx);
+  delete state;  // NOLINT(cppcoreguidelines-owning-memory)
+  return NOISE_ERROR_NONE;
+}
+size_t noise_cipherstate_get_mac_length(const NoiseCipherState *state) { return MAC_LENGTH; }
+
+int noise_handshakestate_free(NoiseHandshakeState *state) { return NOISE_ERROR_NONE; }
+int noise_handshakestate_get_action(const NoiseHandshakeState *state) { return 0; }
+int noise_handshakestate_new_by_id(NoiseHandshakeState **state, const NoiseProtocolId *protocol_id, int role) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_handshakestate_read_message(NoiseHandshakeState *state, NoiseBuffer *message, NoiseBuffer *payload) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_handshakestate_set_pre_shared_key(NoiseHandshakeState *state, const uint8_t *key, size_t key_len) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_handshakestate_set_prologue(NoiseHandshakeState *state, const void *prologue, size_t prologue_len) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_handshakestate_split(NoiseHandshakeState *state, NoiseCipherState **send, NoiseCipherState **receive) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_handshakestate_start(NoiseHandshakeState *state) { return NOISE_ERROR_NOT_APPLICABLE; }
+int noise_handshakestate_write_message(NoiseHandshakeState *state, NoiseBuffer *message, const NoiseBuffer *payload) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+int noise_protocol_name_to_id(NoiseProtocolId *id, const char *name, size_t name_len) {
+  return NOISE_ERROR_NOT_APPLICABLE;
+}
+}
+
+namespace esphome {
+namespace host_test {
+
+NoiseCipherState *noise_cipherstate_new() {
+  auto *state = new NoiseCipherState{EVP_CIPHER_CTX_new(), 0};  // NOLINT(cppcoreguidelines-owning-memory)
+  EVP_CipherInit_ex(state->ctx, EVP_chacha20_poly1305(), nullptr, nullptr, nullptr, 1);
+  return state;
+}
+
+}  // namespace host_test
+}  // namespace esphome
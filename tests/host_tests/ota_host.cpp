@@ -0,0 +1,363 @@
+#include "ota_host.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/network/util.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <esp_ota_ops.h>
+#include <openssl/md5.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+// FreeRTOS
+
+namespace {
+
+/// Thrown in a task that is blocked on a queue when it's deleted, to end its thread.
+struct TaskDeleted {};
+
+struct Task {
+  std::thread thread;
+  std::atomic<bool> deleted{false};
+};
+
+thread_local Task *current_task = nullptr;  // NOLINT
+
+struct Queue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length;
+  size_t item_size;
+};
+
+/// Wait until ready() or the ticks (ms) passed, false on timeout.
+template<typename F> bool wait_queue(Queue *queue, std::unique_lock<std::mutex> &lock, TickType_t wait, F ready) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait);
+  while (!ready()) {
+    if (current_task != nullptr && current_task->deleted)
+      throw TaskDeleted();
+    if (wait != portMAX_DELAY && std::chrono::steady_clock::now() >= deadline)
+      return false;
+    queue->changed.wait_for(lock, std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  auto *queue = new Queue;  // NOLINT(cppcoreguidelines-owning-memory)
+  queue->length = length;
+  queue->item_size = item_size;
+  return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void *item, TickType_t wait) {
+  auto *queue = static_cast<Queue *>(handle);
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!wait_queue(queue, lock, wait, [queue]() { return queue->items.size() < queue->length; }))
+    return pdFALSE;
+  const auto *data = static_cast<const uint8_t *>(item);
+  queue->items.emplace_back(data, data + queue->item_size);
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void *item, TickType_t wait) {
+  auto *queue = static_cast<Queue *>(handle);
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!wait_queue(queue, lock, wait, [queue]() { return !queue->items.empty(); }))
+    return pdFALSE;
+  memcpy(item, queue->items.front().data(), queue->item_size);
+  queue->items.pop_front();
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) {
+  auto *queue = static_cast<Queue *>(handle);
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->items.size();
+}
+
+void vQueueDelete(QueueHandle_t handle) { delete static_cast<Queue *>(handle); }  // NOLINT
+
+static bool task_create_fails = false;  // NOLINT
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack_depth, void *params,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+  if (task_create_fails)
+    return pdFALSE;
+  auto *task = new Task;  // NOLINT(cppcoreguidelines-owning-memory)
+  task->thread = std::thread([task, function, params]() {
+    current_task = task;
+    try {
+      function(params);
+    } catch (const TaskDeleted &) {
+    }
+  });
+  *handle = task;
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+  auto *task = static_cast<Task *>(handle);
+  task->deleted = true;
+  task->thread.join();
+  delete task;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+// Simulated flash
+
+static const size_t SECTOR_SIZE = 4096;
+
+static std::vector<uint8_t> update_image;   // NOLINT
+static std::vector<uint8_t> written_image;  // NOLINT
+static std::vector<uint8_t> running_image;  // NOLINT
+static uint32_t sector_erase_us = 0;        // NOLINT
+static uint32_t program_ns_per_byte = 0;    // NOLINT
+static uint64_t program_ns_left = 0;        // NOLINT
+static size_t flash_fails_at = SIZE_MAX;    // NOLINT
+static const esp_partition_t RUNNING_PARTITION{0};
+static const esp_partition_t UPDATE_PARTITION{1};
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start_from) {
+  return &UPDATE_PARTITION;
+}
+const esp_partition_t *esp_ota_get_running_partition() { return &RUNNING_PARTITION; }
+
+esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle) {
+  update_image.clear();
+  program_ns_left = 0;
+  *out_handle = 1;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size) {
+  // Sectors are erased when the writes reach them, like sequential writes of ESP-IDF do
+  const size_t sectors = (update_image.size() + size + SECTOR_SIZE - 1) / SECTOR_SIZE -
+                         (update_image.size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+  program_ns_left += uint64_t(size) * program_ns_per_byte;
+  esphome::delayMicroseconds(sectors * sector_erase_us + program_ns_left / 1000);
+  program_ns_left %= 1000;
+  // A failing write takes as long as one that succeeds
+  if (update_image.size() + size > flash_fails_at)
+    return ESP_ERR_FLASH_OP_FAIL;
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  update_image.insert(update_image.end(), bytes, bytes + size);
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle) {
+  written_image = update_image;
+  return ESP_OK;
+}
+esp_err_t esp_ota_abort(esp_ota_handle_t handle) {
+  update_image.clear();
+  return ESP_OK;
+}
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition) { return ESP_OK; }
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size) {
+  if (partition != &RUNNING_PARTITION || src_offset + size > running_image.size())
+    return ESP_FAIL;
+  memcpy(dst, running_image.data() + src_offset, size);
+  return ESP_OK;
+}
+
+namespace esphome {
+
+void Application::register_wake_socket(int fd) {}
+void Application::safe_reboot() { throw ota_host::Rebooted(); }
+void Application::reboot() { throw ota_host::Rebooted(); }
+// Only called by the safe mode, which the tests don't enter
+void Application::setup() {}
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+namespace network {
+std::string get_use_address() { return "localhost"; }
+}  // namespace network
+
+namespace ota_host {
+
+void reset() {
+  set_flash_timing(0, 0);
+  set_task_create_fails(false);
+  set_flash_fails_at(SIZE_MAX);
+  written_image.clear();
+}
+void set_flash_timing(uint32_t erase_us, uint32_t ns_per_byte) {
+  sector_erase_us = erase_us;
+  program_ns_per_byte = ns_per_byte;
+}
+const std::vector<uint8_t> &get_written_image() { return written_image; }
+void set_running_image(const std::vector<uint8_t> &image) {
+  running_image = image;
+  // The rest of the partition is erased flash
+  running_image.resize(image.size() + 65536, 0xFF);
+}
+void set_task_create_fails(bool fails) { task_create_fails = fails; }
+void set_flash_fails_at(size_t offset) { flash_fails_at = offset; }
+
+// Responses of the OTA protocol, see esphome/espota2.py
+static const uint8_t RESPONSE_OK = 0;
+static const uint8_t RESPONSE_HEADER_OK = 64;
+static const uint8_t RESPONSE_AUTH_OK = 65;
+static const uint8_t RESPONSE_UPDATE_PREPARE_OK = 66;
+static const uint8_t RESPONSE_BIN_MD5_OK = 67;
+static const uint8_t RESPONSE_RECEIVE_OK = 68;
+static const uint8_t RESPONSE_UPDATE_END_OK = 69;
+static const uint8_t RESPONSE_SUPPORTS_COMPRESSION = 70;
+static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+
+static bool send_all(int fd, const uint8_t *data, size_t len) {
+  while (len > 0) {
+    const ssize_t sent = ::send(fd, data, len, MSG_NOSIGNAL);
+    if (sent <= 0)
+      return false;
+    data += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+/// Receive one response byte, 0 if the connection was closed.
+static uint8_t receive(int fd) {
+  uint8_t response = 0;
+  if (::recv(fd, &response, 1, MSG_WAITALL) != 1)
+    return 0;
+  return response;
+}
+
+static UploadResult upload_(int fd, const std::vector<uint8_t> &data, const UploadOptions &options) {
+  UploadResult result;
+  const uint8_t magic[] = {0x6C, 0x26, 0xF7, 0x5C, 0x45};
+  send_all(fd, magic, sizeof(magic));
+  if ((result.response = receive(fd)) != RESPONSE_OK)
+    return result;
+  receive(fd);  // version
+
+  const uint8_t features = options.supports_compression ? FEATURE_SUPPORTS_COMPRESSION : 0;
+  send_all(fd, &features, 1);
+  result.response = receive(fd);
+  if (result.response != RESPONSE_HEADER_OK && result.response != RESPONSE_SUPPORTS_COMPRESSION)
+    return result;
+  result.compression = result.response == RESPONSE_SUPPORTS_COMPRESSION;
+  if ((result.response = receive(fd)) != RESPONSE_AUTH_OK)
+    return result;
+
+  const uint32_t size = data.size();
+  const uint8_t size_bytes[] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
+  send_all(fd, size_bytes, sizeof(size_bytes));
+  if ((result.response = receive(fd)) != RESPONSE_UPDATE_PREPARE_OK)
+    return result;
+
+  uint8_t digest[MD5_DIGEST_LENGTH];
+  MD5(data.data(), data.size(), digest);
+  char md5[33];
+  for (int i = 0; i < MD5_DIGEST_LENGTH; i++)
+    sprintf(md5 + 2 * i, "%02x", digest[i]);
+  send_all(fd, reinterpret_cast<uint8_t *>(md5), 32);
+  if ((result.response = receive(fd)) != RESPONSE_BIN_MD5_OK)
+    return result;
+
+  // Sent in 1 kB chunks like espota2.py. Link time that isn't used while the receiver stalls is lost, like on the air.
+  auto next = std::chrono::steady_clock::now();
+  const size_t send_size = std::min(data.size(), options.close_after);
+  for (size_t offset = 0; offset < send_size; offset += 1024) {
+    const size_t len = std::min<size_t>(1024, send_size - offset);
+    // The device sends an error and closes the connection if it fails while receiving
+    if (!send_all(fd, data.data() + offset, len))
+      break;
+    if (options.link_kbps != 0) {
+      next = std::max(next, std::chrono::steady_clock::now()) +
+             std::chrono::microseconds(uint64_t(len) * 1000000 / (options.link_kbps * 1024));
+      std::this_thread::sleep_until(next);
+    }
+  }
+
+  if (send_size < data.size()) {
+    result.response = 0;
+    return result;
+  }
+  if ((result.response = receive(fd)) != RESPONSE_RECEIVE_OK)
+    return result;
+  if ((result.response = receive(fd)) != RESPONSE_UPDATE_END_OK)
+    return result;
+  send_all(fd, &RESPONSE_OK, 1);
+  return result;
+}
+
+static UploadResult upload_to_port(uint16_t port, const std::vector<uint8_t> &data, const UploadOptions &options) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  UploadResult result;
+  if (::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0) {
+    struct timeval timeout {};
+    timeout.tv_sec = 20;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    // Small like the one espota2.py sets, so the sender can't run far ahead of the device
+    int send_buffer = 8192;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer));
+    result = upload_(fd, data, options);
+  }
+  ::close(fd);
+  return result;
+}
+
+void HostOTAComponent::setup() {
+  // A port that is free now, the test is done before anything else takes it
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in address {};
+  address.sin_family = AF_INET;
+  socklen_t len = sizeof(address);
+  ::bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address));
+  ::getsockname(fd, reinterpret_cast<struct sockaddr *>(&address), &len);
+  ::close(fd);
+  this->set_port(ntohs(address.sin_port));
+  ota::OTAComponent::setup();
+  // About the receive window of lwIP on the ESP32, accepted connections inherit it
+  int receive_buffer = 2880;
+  this->server_->setsockopt(SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+}
+
+UploadResult upload(ota::OTAComponent *ota, const std::vector<uint8_t> &data, const UploadOptions &options) {
+  UploadResult result;
+  std::atomic<bool> done{false};
+  std::thread client([&]() {
+    result = upload_to_port(ota->get_port(), data, options);
+    done = true;
+  });
+  bool rebooted = false;
+  try {
+    // The component handles the whole upload in one loop()
+    while (!done) {
+      ota->loop();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  } catch (const Rebooted &) {
+    rebooted = true;
+  }
+  client.join();
+  result.rebooted = rebooted;
+  return result;
+}
+
+}  // namespace ota_host
+}  // namespace esphome
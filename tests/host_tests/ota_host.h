@@ -0,0 +1,63 @@
+#pragma once
+
+// Support for running the OTA component on the build machine: FreeRTOS tasks and queues on threads, a simulated
+// flash behind the esp_ota_* functions of ESP-IDF, and a client that uploads images like esphome/espota2.py does.
+//
+// Tests using it are built with "-DUSE_ESP32 -DUSE_ESP_IDF" and link tests/host_tests/ota_host.cpp, the OTA, md5 and
+// socket sources, and "-lcrypto -lz".
+
+#include "esphome/components/ota/ota_component.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace ota_host {
+
+/// Thrown by App.safe_reboot(), which the OTA component calls after a successful update.
+struct Rebooted {};
+
+/// Undo the settings below, called at the start of each test.
+void reset();
+/// Timing of the simulated flash: erasing a 4 kB sector when the writes reach it, and programming a byte.
+void set_flash_timing(uint32_t sector_erase_us, uint32_t program_ns_per_byte);
+/// The image written by the last update.
+const std::vector<uint8_t> &get_written_image();
+/// Set the image of the running firmware, which delta patches are applied against.
+void set_running_image(const std::vector<uint8_t> &image);
+/// Make xTaskCreate() fail, so that the OTA writer falls back to synchronous writes.
+void set_task_create_fails(bool fails);
+/// Make writes to the flash fail once this many bytes of the image were written, SIZE_MAX to never fail.
+void set_flash_fails_at(size_t offset);
+
+struct UploadOptions {
+  /// Tell the device that the client can send gzip compressed images.
+  bool supports_compression{false};
+  /// Limit the sending rate like a slow link, 0 for no limit.
+  uint32_t link_kbps{0};
+  /// Close the connection after sending this many bytes of the data.
+  size_t close_after{SIZE_MAX};
+};
+
+struct UploadResult {
+  /// The response code that ended the upload: OTA_RESPONSE_UPDATE_END_OK, or the error the device sent.
+  uint8_t response{0};
+  /// Whether the device answered that it supports compression.
+  bool compression{false};
+  /// Whether the device rebooted into the new image.
+  bool rebooted{false};
+};
+
+/// The OTA component, listening on a free port of the build machine.
+class HostOTAComponent : public ota::OTAComponent {
+ public:
+  void setup() override;
+};
+
+/// Upload data to the OTA component from a client thread, while the component handles the upload on this one.
+UploadResult upload(ota::OTAComponent *ota, const std::vector<uint8_t> &data, const UploadOptions &options);
+
+}  // namespace ota_host
+}  // namespace esphome
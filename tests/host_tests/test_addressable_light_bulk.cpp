@@ -0,0 +1,201 @@
+// Tests of the bulk range operations of AddressableLight and the fused color correction tables.
+//
+// Every operation is done on a light with a pixel buffer, which takes the bulk paths, and repeated pixel by pixel
+// through the views of a second light, which never builds the fused tables and so corrects with the math of
+// ESPColorCorrection. Both have to end up with the same buffer.
+//
+// host_test sources: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// host_test sources: esphome/components/light/esp_range_view.cpp esphome/components/light/light_output.cpp
+// host_test sources: esphome/core/color.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/light/addressable_light.h"
+
+#include <vector>
+
+namespace esphome {
+namespace light {
+
+class TestLight : public AddressableLight {
+ public:
+  TestLight(int32_t size, bool white, bool bulk)
+      : size_(size), white_(white), bulk_(bulk), data_(size * (white ? 4 : 3)), effect_data_(size) {}
+  int32_t size() const override { return this->size_; }
+  void clear_effect_data() override {}
+  LightTraits get_traits() override { return {}; }
+  void write_state(LightState *state) override {}
+  void set_correction(float gamma, Color max_brightness, uint8_t local_brightness) {
+    this->correction_.set_max_brightness(max_brightness);
+    this->correction_.calculate_gamma_table(gamma);
+    this->correction_.set_local_brightness(local_brightness);
+  }
+  const std::vector<uint8_t> &data() const { return this->data_; }
+
+ protected:
+  // GRB(W) like most LED strips, to check the channel offsets
+  ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->data_.data()) + (this->white_ ? 4 : 3) * index;
+    return ESPColorView(base + 1, base + 0, base + 2, this->white_ ? base + 3 : nullptr,
+                        const_cast<uint8_t *>(&this->effect_data_[index]), &this->correction_);
+  }
+  AddressableLightBuffer get_buffer_internal() const override {
+    AddressableLightBuffer buffer;
+    if (!this->bulk_)
+      return buffer;
+    buffer.data = const_cast<uint8_t *>(this->data_.data());
+    buffer.offsets[0] = 1;
+    buffer.offsets[1] = 0;
+    buffer.white = this->white_;
+    return buffer;
+  }
+
+  int32_t size_;
+  bool white_;
+  bool bulk_;
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> effect_data_;
+};
+
+static const int32_t SIZE = 50;
+
+/// Run each operation on a light with and one without bulk paths, with all kinds of color correction settings.
+static void for_each_correction(const char *name, void (*bulk)(TestLight &), void (*reference)(TestLight &)) {
+  for (bool white : {false, true}) {
+    for (float gamma : {0.0f, 1.0f, 2.8f}) {
+      for (auto max_brightness : {Color(255, 255, 255, 255), Color(200, 128, 64, 0)}) {
+        for (uint8_t local_brightness : {255, 180, 1, 0}) {
+          TestLight light(SIZE, white, true);
+          TestLight expected(SIZE, white, false);
+          light.set_correction(gamma, max_brightness, local_brightness);
+          expected.set_correction(gamma, max_brightness, local_brightness);
+          bulk(light);
+          reference(expected);
+          if (light.data() != expected.data()) {
+            host_test::fail(__FILE__, __LINE__,
+                            std::string(name) + " differs with white " + std::to_string(white) + ", gamma " +
+                                std::to_string(gamma) + ", max brightness " + std::to_string(max_brightness.red) +
+                                ", local brightness " + std::to_string(local_brightness));
+          }
+        }
+      }
+    }
+  }
+}
+
+static Color color_at(int32_t i) { return Color(i * 7, i * 13, i * 29, i * 3); }
+
+HOST_TEST(addressable_light_fill_range) {
+  for_each_correction(
+      "fill_range",
+      [](TestLight &light) {
+        light.fill_range(0, SIZE, Color(255, 100, 3, 77));
+        light.fill_range(10, 11, Color(1, 2, 3, 4));
+        light.fill_range(20, 35, Color(9, 8, 7, 6));
+        light.range(-5, SIZE) = Color(40, 50, 60, 70);
+      },
+      [](TestLight &light) {
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(Color(255, 100, 3, 77));
+        light[10].set(Color(1, 2, 3, 4));
+        for (int32_t i = 20; i < 35; i++)
+          light[i].set(Color(9, 8, 7, 6));
+        for (int32_t i = SIZE - 5; i < SIZE; i++)
+          light[i].set(Color(40, 50, 60, 70));
+      });
+}
+
+HOST_TEST(addressable_light_set_range) {
+  for_each_correction(
+      "set_range",
+      [](TestLight &light) {
+        std::vector<Color> colors;
+        for (int32_t i = 0; i < SIZE + 10; i++)
+          colors.push_back(color_at(i));
+        light.set_range(0, colors.data(), SIZE);
+        // Clipped at the end
+        light.set_range(SIZE - 3, colors.data() + 40, 10);
+      },
+      [](TestLight &light) {
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(color_at(i));
+        for (int32_t i = 0; i < 3; i++)
+          light[SIZE - 3 + i].set(color_at(40 + i));
+      });
+}
+
+HOST_TEST(addressable_light_blend_range) {
+  for_each_correction(
+      "blend_range",
+      [](TestLight &light) {
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(color_at(i));
+        for (uint8_t amnt : {1, 17, 128, 254, 255})
+          light.blend_range(0, SIZE, Color(10, 200, 90, 40), amnt);
+        light.blend_range(5, 15, Color(255, 0, 0, 0), 100);
+      },
+      [](TestLight &light) {
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(color_at(i));
+        const auto blend = [&light](int32_t from, int32_t to, Color color, uint8_t amnt) {
+          for (int32_t i = from; i < to; i++) {
+            ESPColorView view = light[i];
+            view.set(color * amnt + view.get() * static_cast<uint8_t>(255 - amnt));
+          }
+        };
+        for (uint8_t amnt : {1, 17, 128, 254, 255})
+          blend(0, SIZE, Color(10, 200, 90, 40), amnt);
+        blend(5, 15, Color(255, 0, 0, 0), 100);
+      });
+}
+
+HOST_TEST(addressable_light_tables_follow_settings) {
+  // Once the tables exist, the views read and write through them and they follow changes of the settings
+  for_each_correction(
+      "views after changing the correction",
+      [](TestLight &light) {
+        // Builds the tables
+        const Color first(1, 1, 1, 1);
+        light.set_range(0, &first, 1);
+        light.set_correction(2.2f, Color(100, 150, 200, 250), 99);
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(color_at(i));
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(light[i].get());
+      },
+      [](TestLight &light) {
+        light[0].set(Color(1, 1, 1, 1));
+        light.set_correction(2.2f, Color(100, 150, 200, 250), 99);
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(color_at(i));
+        for (int32_t i = 0; i < SIZE; i++)
+          light[i].set(light[i].get());
+      });
+}
+
+HOST_TEST(addressable_light_without_buffer) {
+  // Lights without a pixel buffer fall back to the views
+  TestLight light(SIZE, true, false);
+  TestLight expected(SIZE, true, false);
+  light.set_correction(2.8f, Color(255, 255, 255, 255), 200);
+  expected.set_correction(2.8f, Color(255, 255, 255, 255), 200);
+
+  std::vector<Color> colors;
+  for (int32_t i = 0; i < SIZE; i++)
+    colors.push_back(color_at(i));
+  light.set_range(0, colors.data(), SIZE);
+  light.blend_range(0, SIZE, Color(10, 200, 90, 40), 77);
+  light.fill_range(3, 9, Color(5, 6, 7, 8));
+
+  for (int32_t i = 0; i < SIZE; i++) {
+    ESPColorView view = expected[i];
+    view.set(colors[i]);
+    view.set(Color(10, 200, 90, 40) * 77 + view.get() * static_cast<uint8_t>(255 - 77));
+  }
+  for (int32_t i = 3; i < 9; i++)
+    expected[i].set(Color(5, 6, 7, 8));
+  EXPECT_TRUE(light.data() == expected.data());
+}
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,221 @@
+// Tests of the plaintext API frame helper: frames built in place by write_protobuf_packet() against the frames of
+// encoding the payload first and copying it behind a separate header, writes that the socket only takes part of, and
+// the compaction of the TX backlog.
+//
+// host_test sources: esphome/components/api/api_frame_helper.cpp esphome/components/api/proto.cpp
+// host_test sources: esphome/components/api/api_pb2.cpp tests/host_tests/noise_cipher.cpp
+// host_test libs: -lcrypto
+
+#include "host_test.h"
+
+#include "esphome/components/api/api_frame_helper.h"
+#include "esphome/components/api/api_pb2.h"
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace esphome {
+namespace api {
+
+/// Records what is written, taking at most `room` bytes until it is raised again, like a full TCP send buffer.
+class TestSocket : public socket::Socket {
+ public:
+  std::vector<uint8_t> sent;
+  size_t room{SIZE_MAX};
+  int writes{0};
+
+  std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) override { return nullptr; }
+  int bind(const struct sockaddr *addr, socklen_t addrlen) override { return 0; }
+  int close() override { return 0; }
+  int shutdown(int how) override { return 0; }
+  int getpeername(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getpeername() override { return "test"; }
+  int getsockname(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getsockname() override { return "test"; }
+  int getsockopt(int level, int optname, void *optval, socklen_t *optlen) override { return 0; }
+  int setsockopt(int level, int optname, const void *optval, socklen_t optlen) override { return 0; }
+  int listen(int backlog) override { return 0; }
+  ssize_t read(void *buf, size_t len) override { return 0; }
+  ssize_t readv(const struct iovec *iov, int iovcnt) override { return 0; }
+  ssize_t write(const void *buf, size_t len) override {
+    struct iovec iov;
+    iov.iov_base = const_cast<void *>(buf);
+    iov.iov_len = len;
+    return this->writev(&iov, 1);
+  }
+  ssize_t writev(const struct iovec *iov, int iovcnt) override {
+    this->writes++;
+    if (this->room == 0) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    size_t total = 0;
+    for (int i = 0; i < iovcnt && this->room != 0; i++) {
+      const size_t len = std::min(iov[i].iov_len, this->room);
+      const auto *data = static_cast<const uint8_t *>(iov[i].iov_base);
+      this->sent.insert(this->sent.end(), data, data + len);
+      this->room -= len;
+      total += len;
+    }
+    return total;
+  }
+  int setblocking(bool blocking) override { return 0; }
+};
+
+class TestFrameHelper : public APIPlaintextFrameHelper {
+ public:
+  explicit TestFrameHelper(std::unique_ptr<socket::Socket> socket) : APIPlaintextFrameHelper(std::move(socket)) {
+    this->init();
+  }
+  size_t tx_buf_size() const { return this->tx_buf_.size(); }
+  size_t tx_buf_offset() const { return this->tx_buf_offset_; }
+};
+
+struct Setup {
+  TestSocket *socket;
+  TestFrameHelper helper;
+
+  Setup() : Setup(new TestSocket()) {}  // NOLINT(cppcoreguidelines-owning-memory)
+
+ protected:
+  explicit Setup(TestSocket *socket) : socket(socket), helper(std::unique_ptr<socket::Socket>(socket)) {}
+};
+
+static TextSensorStateResponse text_state(uint32_t key, size_t length) {
+  TextSensorStateResponse msg{};
+  msg.key = key;
+  msg.state = std::string(length, 'a' + key % 26);
+  msg.missing_state = false;
+  return msg;
+}
+
+/// Send a message like APIConnection: encoded after the reserved header bytes and framed in place.
+static APIError send(TestFrameHelper &helper, uint16_t type, const ProtoMessage &msg) {
+  std::vector<uint8_t> buffer(helper.frame_header_padding());
+  msg.encode(ProtoWriteBuffer{&buffer});
+  return helper.write_protobuf_packet(type, ProtoWriteBuffer{&buffer});
+}
+
+/// The frame as it was built before, by encoding the payload on its own and copying it behind the header.
+static std::vector<uint8_t> copied_frame(uint16_t type, const ProtoMessage &msg) {
+  std::vector<uint8_t> payload;
+  msg.encode(ProtoWriteBuffer{&payload});
+  std::vector<uint8_t> frame{0x00};
+  ProtoVarInt(payload.size()).encode(frame);
+  ProtoVarInt(type).encode(frame);
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  return frame;
+}
+
+HOST_TEST(api_frame_helper_plaintext_frames) {
+  // Header lengths from 3 bytes up to the whole padding: one to three size bytes, one or two type bytes
+  const size_t lengths[] = {0, 10, 130, 20000};
+  const uint16_t types[] = {27, 200};
+  for (size_t length : lengths) {
+    for (uint16_t type : types) {
+      Setup setup;
+      const auto msg = text_state(length, length);
+      EXPECT_TRUE(send(setup.helper, type, msg) == APIError::OK);
+      EXPECT_TRUE(setup.socket->sent == copied_frame(type, msg));
+      EXPECT_EQ(setup.socket->writes, 1);
+      EXPECT_TRUE(!setup.helper.has_pending_tx_data());
+    }
+  }
+
+  SensorStateResponse sensor{};
+  sensor.key = 0x12345678;
+  sensor.state = 21.5f;
+  Setup setup;
+  EXPECT_TRUE(send(setup.helper, 25, sensor) == APIError::OK);
+  EXPECT_TRUE(setup.socket->sent == copied_frame(25, sensor));
+}
+
+HOST_TEST(api_frame_helper_partial_writes) {
+  Setup setup;
+  std::vector<uint8_t> expected;
+  // The socket takes a few bytes of the first frame, later frames queue behind the rest of it
+  setup.socket->room = 5;
+  for (uint32_t key = 0; key < 6; key++) {
+    const auto msg = text_state(key, 40 + key * 30);
+    EXPECT_TRUE(send(setup.helper, 27, msg) == APIError::OK);
+    const auto frame = copied_frame(27, msg);
+    expected.insert(expected.end(), frame.begin(), frame.end());
+  }
+  EXPECT_EQ(setup.socket->sent.size(), 5u);
+  EXPECT_TRUE(setup.helper.has_pending_tx_data());
+  EXPECT_TRUE(!setup.helper.can_write_without_blocking());
+
+  // Each loop() sends what fits, in order
+  int loops = 0;
+  while (setup.helper.has_pending_tx_data() && loops < 1000) {
+    setup.socket->room = 17;
+    EXPECT_TRUE(setup.helper.loop() == APIError::OK);
+    loops++;
+  }
+  EXPECT_TRUE(setup.socket->sent == expected);
+  EXPECT_TRUE(setup.helper.can_write_without_blocking());
+  EXPECT_EQ(setup.helper.tx_buf_size(), 0u);
+  EXPECT_EQ(setup.helper.tx_buf_offset(), 0u);
+
+  // A frame the socket takes part of directly keeps the rest
+  setup.socket->room = 3;
+  const auto msg = text_state(7, 50);
+  EXPECT_TRUE(send(setup.helper, 27, msg) == APIError::OK);
+  const auto frame = copied_frame(27, msg);
+  expected.insert(expected.end(), frame.begin(), frame.end());
+  EXPECT_EQ(setup.helper.tx_buf_size(), frame.size() - 3);
+  setup.socket->room = SIZE_MAX;
+  setup.helper.loop();
+  EXPECT_TRUE(setup.socket->sent == expected);
+}
+
+HOST_TEST(api_frame_helper_compaction) {
+  Setup setup;
+  std::vector<uint8_t> expected;
+  auto queue = [&setup, &expected](uint32_t key) {
+    const auto msg = text_state(key, 96);
+    EXPECT_TRUE(send(setup.helper, 27, msg) == APIError::OK);
+    const auto frame = copied_frame(27, msg);
+    expected.insert(expected.end(), frame.begin(), frame.end());
+    return frame.size();
+  };
+  setup.socket->room = 0;
+  const size_t frame = queue(1);
+  queue(2);
+  queue(3);
+  EXPECT_EQ(setup.helper.tx_buf_size(), 3 * frame);
+
+  // Sent bytes stay in the buffer, only the offset moves
+  setup.socket->room = frame + 10;
+  setup.helper.loop();
+  EXPECT_EQ(setup.helper.tx_buf_offset(), frame + 10);
+  EXPECT_EQ(setup.helper.tx_buf_size(), 3 * frame);
+
+  // Less than half of the buffer was sent, appending keeps it
+  setup.socket->room = 0;
+  queue(4);
+  EXPECT_EQ(setup.helper.tx_buf_offset(), frame + 10);
+  EXPECT_EQ(setup.helper.tx_buf_size(), 4 * frame);
+
+  // Once half of it was sent, it is dropped before appending
+  setup.socket->room = frame;
+  setup.helper.loop();
+  EXPECT_EQ(setup.helper.tx_buf_offset(), 2 * frame + 10);
+  setup.socket->room = 0;
+  queue(5);
+  EXPECT_EQ(setup.helper.tx_buf_offset(), 0u);
+  EXPECT_EQ(setup.helper.tx_buf_size(), 3 * frame - 10);
+
+  // The stream is the same as without any of it
+  setup.socket->room = SIZE_MAX;
+  setup.helper.loop();
+  EXPECT_TRUE(!setup.helper.has_pending_tx_data());
+  EXPECT_TRUE(setup.socket->sent == expected);
+}
+
+}  // namespace api
+}  // namespace esphome
@@ -0,0 +1,122 @@
+// Tests of api::StateUpdateQueue, the state updates that wait for the next batch of a native API connection:
+// coalescing, binary sensor pulses, the batch size and updates whose message can't be built.
+//
+// host_test sources: esphome/components/api/state_update_queue.cpp esphome/core/entity_base.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/api/state_update_queue.h"
+#include "esphome/core/hal.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace api {
+
+class TestEntity : public EntityBase {
+ public:
+  using EntityBase::EntityBase;
+
+ protected:
+  uint32_t hash_base() override { return 0; }
+};
+
+/// Builds a batch like APIConnection::flush_state_updates_(), with the names of the entities as frames.
+struct TestBatch {
+  size_t max_frames{100};
+  /// The entity whose message can't be encoded.
+  EntityBase *broken{nullptr};
+  std::vector<std::string> frames;
+
+  size_t build(StateUpdateQueue &queue) {
+    this->frames.clear();
+    return queue.build_batch([this]() { return this->frames.size() < this->max_frames; },
+                             [this](const PendingStateUpdate &update) {
+                               if (update.entity == this->broken)
+                                 return false;
+                               std::string frame = update.entity->get_name();
+                               if (update.type == StateUpdateType::BINARY_SENSOR)
+                                 frame += update.binary_state ? "=ON" : "=OFF";
+                               this->frames.push_back(frame);
+                               return true;
+                             });
+  }
+};
+
+HOST_TEST(api_state_update_queue_coalesce) {
+  TestEntity temperature("temperature"), relay("relay"), motion("motion");
+  StateUpdateQueue queue;
+  host_test::advance_millis(10);
+  const uint32_t first_queued = millis();
+  queue.push(&temperature, StateUpdateType::SENSOR);
+  host_test::advance_millis(10);
+  queue.push(&relay, StateUpdateType::SWITCH);
+  queue.push(&temperature, StateUpdateType::SENSOR);
+  // Every binary sensor change is sent, only a repeat of the last queued state is dropped
+  queue.push(&motion, StateUpdateType::BINARY_SENSOR, true);
+  queue.push(&motion, StateUpdateType::BINARY_SENSOR, false);
+  queue.push(&motion, StateUpdateType::BINARY_SENSOR, false);
+  EXPECT_EQ(queue.size(), 4u);
+  EXPECT_EQ(queue.get_pending_since(), first_queued);
+
+  TestBatch batch;
+  EXPECT_EQ(batch.build(queue), 4u);
+  const std::vector<std::string> expected{"temperature", "relay", "motion=ON", "motion=OFF"};
+  EXPECT_TRUE(batch.frames == expected);
+  queue.pop(4);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.take_dropped(), 0u);
+}
+
+HOST_TEST(api_state_update_queue_batch_size) {
+  TestEntity first("first"), second("second"), third("third");
+  StateUpdateQueue queue;
+  queue.push(&first, StateUpdateType::SENSOR);
+  queue.push(&second, StateUpdateType::SENSOR);
+  queue.push(&third, StateUpdateType::SENSOR);
+
+  TestBatch batch;
+  batch.max_frames = 2;
+  EXPECT_EQ(batch.build(queue), 2u);
+  // The updates stay queued until the batch was written
+  EXPECT_EQ(queue.size(), 3u);
+  queue.pop(2);
+  EXPECT_EQ(batch.build(queue), 1u);
+  EXPECT_EQ(batch.frames[0], std::string("third"));
+}
+
+HOST_TEST(api_state_update_queue_drops_failed_update) {
+  TestEntity broken("broken"), first("first"), second("second");
+  StateUpdateQueue queue;
+  queue.push(&broken, StateUpdateType::SENSOR);
+  queue.push(&first, StateUpdateType::SENSOR);
+  queue.push(&second, StateUpdateType::SENSOR);
+
+  // An update at the head that can't be built doesn't hold up the ones behind it
+  TestBatch batch;
+  batch.broken = &broken;
+  EXPECT_EQ(batch.build(queue), 3u);
+  const std::vector<std::string> expected{"first", "second"};
+  EXPECT_TRUE(batch.frames == expected);
+  queue.pop(3);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.take_dropped(), 1u);
+  EXPECT_EQ(queue.take_dropped(), 0u);
+
+  // Neither does it hold up later batches
+  queue.push(&broken, StateUpdateType::SENSOR);
+  EXPECT_EQ(batch.build(queue), 1u);
+  queue.pop(1);
+  queue.push(&first, StateUpdateType::SENSOR);
+  EXPECT_EQ(batch.build(queue), 1u);
+  EXPECT_TRUE(batch.frames == std::vector<std::string>{"first"});
+}
+
+}  // namespace api
+}  // namespace esphome
@@ -0,0 +1,177 @@
+// Tests of api::ComponentIterator: what advance() returns and when it moves on to the next entity.
+//
+// host_test sources: esphome/components/api/util.cpp esphome/components/sensor/sensor.cpp
+// host_test sources: esphome/components/sensor/filter.cpp esphome/core/entity_base.cpp esphome/core/component.cpp
+// host_test sources: esphome/core/scheduler.cpp esphome/components/api/api_pb2.cpp esphome/components/api/proto.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/api/api_connection.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/api/util.h"
+#include "esphome/core/application.h"
+#include "esphome/core/preferences.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace api {
+
+// The iterator only reads the user services of the server, the rest of api_server.cpp isn't built.
+APIServer *global_api_server = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+APIServer::APIServer() {}
+void APIServer::setup() {}
+void APIServer::loop() {}
+void APIServer::dump_config() {}
+void APIServer::on_shutdown() {}
+float APIServer::get_setup_priority() const { return 0.0f; }
+void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {}
+void APIServer::on_cover_update(cover::Cover *obj) {}
+void APIServer::on_fan_update(fan::FanState *obj) {}
+void APIServer::on_light_update(light::LightState *obj) {}
+void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {}
+void APIServer::on_switch_update(switch_::Switch *obj, bool state) {}
+void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {}
+void APIServer::on_climate_update(climate::Climate *obj) {}
+void APIServer::on_number_update(number::Number *obj, float state) {}
+void APIServer::on_select_update(select::Select *obj, const std::string &state) {}
+
+class TestService : public UserServiceDescriptor {
+ public:
+  ListEntitiesServicesResponse encode_list_service_response() override { return {}; }
+  bool execute_service(const ExecuteServiceRequest &req) override { return true; }
+};
+
+/// Records every entity it is offered and refuses the next `refuse` of them, like a connection with a full buffer.
+class TestIterator : public ComponentIterator {
+ public:
+  using ComponentIterator::ComponentIterator;
+
+  bool on_begin() override { return this->offer_("begin"); }
+  bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override { return true; }
+  bool on_cover(cover::Cover *cover) override { return true; }
+  bool on_fan(fan::FanState *fan) override { return true; }
+  bool on_light(light::LightState *light) override { return true; }
+  bool on_sensor(sensor::Sensor *sensor) override { return this->offer_(sensor->get_name()); }
+  bool on_switch(switch_::Switch *a_switch) override { return true; }
+  bool on_button(button::Button *button) override { return true; }
+  bool on_text_sensor(text_sensor::TextSensor *text_sensor) override { return true; }
+  bool on_service(UserServiceDescriptor *service) override { return this->offer_("service"); }
+  bool on_climate(climate::Climate *climate) override { return true; }
+  bool on_number(number::Number *number) override { return true; }
+  bool on_select(select::Select *select) override { return true; }
+  bool on_end() override { return this->offer_("end"); }
+
+  std::vector<std::string> offered;
+  std::vector<std::string> sent;
+  int refuse{0};
+
+ protected:
+  bool offer_(const std::string &name) {
+    this->offered.push_back(name);
+    if (this->refuse > 0) {
+      this->refuse--;
+      return false;
+    }
+    this->sent.push_back(name);
+    return true;
+  }
+};
+
+/// Two sensors with an internal one in between, and a user service.
+static APIServer *test_server() {
+  static APIServer *server = nullptr;
+  if (server != nullptr)
+    return server;
+  server = new APIServer();  // NOLINT(cppcoreguidelines-owning-memory)
+  server->register_user_service(new TestService());
+  auto *first = new sensor::Sensor("first");
+  auto *internal = new sensor::Sensor("internal");
+  internal->set_internal(true);
+  auto *second = new sensor::Sensor("second");
+  App.register_sensor(first);
+  App.register_sensor(internal);
+  App.register_sensor(second);
+  return server;
+}
+
+HOST_TEST(component_iterator_not_started) {
+  TestIterator iterator(test_server());
+  EXPECT_TRUE(iterator.completed());
+  EXPECT_TRUE(!iterator.advance());
+  EXPECT_TRUE(iterator.offered.empty());
+}
+
+HOST_TEST(component_iterator_visits_all) {
+  TestIterator iterator(test_server());
+  iterator.begin();
+  EXPECT_TRUE(!iterator.completed());
+  int calls = 0;
+  while (!iterator.completed()) {
+    // Every call does something: it sends an entity, skips an internal one or moves on to the next platform
+    EXPECT_TRUE(iterator.advance());
+    EXPECT_TRUE(++calls < 100);
+    if (calls >= 100)
+      return;
+  }
+  const std::vector<std::string> expected{"begin", "first", "second", "service", "end"};
+  EXPECT_TRUE(iterator.sent == expected);
+  EXPECT_TRUE(iterator.offered == expected);
+
+  // Once completed, it stays completed until begin() is called again
+  EXPECT_TRUE(!iterator.advance());
+  iterator.begin();
+  EXPECT_TRUE(!iterator.completed());
+}
+
+/// Call advance() until the iterator offers the next entity, returns what that call returned.
+static bool advance_to_next_offer(TestIterator &iterator) {
+  const size_t offered = iterator.offered.size();
+  for (int i = 0; i < 100; i++) {
+    const bool result = iterator.advance();
+    if (iterator.offered.size() != offered)
+      return result;
+    // Skipping an internal entity or moving on to the next platform also counts as progress
+    EXPECT_TRUE(result);
+  }
+  return false;
+}
+
+HOST_TEST(component_iterator_retries_refused) {
+  TestIterator iterator(test_server());
+  iterator.begin();
+
+  // A refused entity makes advance() return false and is offered again by the next call
+  iterator.refuse = 1;
+  EXPECT_TRUE(!advance_to_next_offer(iterator));
+  EXPECT_TRUE(advance_to_next_offer(iterator));
+  EXPECT_TRUE(advance_to_next_offer(iterator));
+  iterator.refuse = 2;
+  EXPECT_TRUE(!advance_to_next_offer(iterator));
+  EXPECT_TRUE(!advance_to_next_offer(iterator));
+  EXPECT_TRUE(advance_to_next_offer(iterator));
+  EXPECT_TRUE(advance_to_next_offer(iterator));
+
+  // The iterator only completes once the end was sent
+  iterator.refuse = 1;
+  EXPECT_TRUE(!advance_to_next_offer(iterator));
+  EXPECT_TRUE(!iterator.completed());
+  EXPECT_TRUE(advance_to_next_offer(iterator));
+  EXPECT_TRUE(iterator.completed());
+
+  const std::vector<std::string> offered{"begin",  "begin",   "first", "second", "second",
+                                         "second", "service", "end",   "end"};
+  const std::vector<std::string> sent{"begin", "first", "second", "service", "end"};
+  EXPECT_TRUE(iterator.offered == offered);
+  EXPECT_TRUE(iterator.sent == sent);
+}
+
+}  // namespace api
+}  // namespace esphome
@@ -0,0 +1,80 @@
+// Tests of debug::ComponentProfiler, the per-component timing statistics of the debug component.
+//
+// host_test sources: esphome/components/debug/component_profiler.cpp esphome/core/component.cpp
+// host_test sources: esphome/core/scheduler.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/debug/component_profiler.h"
+
+namespace esphome {
+namespace debug {
+
+class TestProfiler : public ComponentProfiler {
+ public:
+  using ComponentProfiler::ComponentProfiler;
+  const ComponentProfile *profile(Component *component) { return this->find_(component); }
+};
+
+HOST_TEST(profiler_quantiles) {
+  TestProfiler profiler(4);
+  Component component;
+  // 90 fast calls and 10 slow ones
+  for (int i = 0; i < 90; i++)
+    profiler.record_loop(&component, 10);
+  for (int i = 0; i < 10; i++)
+    profiler.record_loop(&component, 3000);
+
+  const ComponentProfile *profile = profiler.profile(&component);
+  EXPECT_EQ(profile->count, 100u);
+  EXPECT_EQ(profile->max_us, 3000u);
+  // 10 µs is in the bucket [8, 15], 3000 µs in [2048, 4095] capped to the maximum
+  EXPECT_EQ(profile->quantile_us(0.5f), 15u);
+  EXPECT_EQ(profile->quantile_us(0.9f), 15u);
+  EXPECT_EQ(profile->quantile_us(0.99f), 3000u);
+}
+
+HOST_TEST(profiler_quantiles_of_busy_component) {
+  TestProfiler profiler(4);
+  Component component;
+  // A loop() that runs every 100 µs fills a single bucket with 600000 samples within a 60 s window
+  for (int i = 0; i < 600000; i++)
+    profiler.record_loop(&component, 5);
+  profiler.record_loop(&component, 100000);
+
+  const ComponentProfile *profile = profiler.profile(&component);
+  EXPECT_EQ(profile->count, 600001u);
+  EXPECT_EQ(profile->quantile_us(0.5f), 7u);
+  EXPECT_EQ(profile->quantile_us(0.99f), 7u);
+  EXPECT_EQ(profile->max_us, 100000u);
+}
+
+HOST_TEST(profiler_reset_window) {
+  TestProfiler profiler(4);
+  Component component;
+  profiler.record_setup(&component, 1234);
+  for (int i = 0; i < 100; i++)
+    profiler.record_loop(&component, 1000);
+  profiler.reset_window();
+  profiler.record_loop(&component, 3);
+
+  const ComponentProfile *profile = profiler.profile(&component);
+  EXPECT_EQ(profile->count, 1u);
+  EXPECT_EQ(profile->setup_us, 1234u);
+  EXPECT_EQ(profile->quantile_us(0.5f), 3u);
+  EXPECT_EQ(profile->quantile_us(0.99f), 3u);
+}
+
+HOST_TEST(profiler_full_table) {
+  TestProfiler profiler(2);
+  Component first, second, third;
+  profiler.record_loop(&first, 1);
+  profiler.record_loop(&second, 1);
+  profiler.record_loop(&third, 1);
+  EXPECT_TRUE(profiler.profile(&first) != nullptr);
+  EXPECT_TRUE(profiler.profile(&second) != nullptr);
+  EXPECT_TRUE(profiler.profile(&third) == nullptr);
+}
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,166 @@
+// Tests of the dirty region of DisplayBuffer: the window flush_dirty_() hands to the driver after drawing, the rows
+// that row_changed_() lets the driver skip and the flush counters.
+//
+// The display flushes like the ILI9341 and ST7735 drivers, in bands of consecutive changed rows of the dirty window,
+// and takes one microsecond of the fake clock per row it sends.
+//
+// host_test sources: esphome/components/display/display_buffer.cpp esphome/core/color.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/display/display_buffer.h"
+
+#include <functional>
+#include <vector>
+
+namespace esphome {
+
+// Only referenced by the text and graph functions of DisplayBuffer, which these tests don't use
+size_t time::ESPTime::strftime(char *buffer, size_t buffer_len, const char *format) { return 0; }
+void graph::Graph::draw(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+void graph::Graph::draw_legend(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+
+namespace display {
+
+static const Color RED(255, 0, 0);
+static const Color BLUE(0, 0, 255);
+
+struct Rect {
+  int x1, y1, x2, y2;
+  bool operator==(const Rect &other) const {
+    return x1 == other.x1 && y1 == other.y1 && x2 == other.x2 && y2 == other.y2;
+  }
+};
+
+/// A display with one byte per pixel that records what it flushes.
+class DirtyDisplay : public DisplayBuffer {
+ public:
+  static const int WIDTH = 48;
+  static const int HEIGHT = 32;
+
+  /// The windows handed to flush_rect_().
+  std::vector<Rect> flushed;
+  /// The bands of rows that were sent, with the columns of their window.
+  std::vector<Rect> sent;
+
+  explicit DirtyDisplay(std::function<void(DisplayBuffer &)> &&draw) {
+    this->init_internal_(WIDTH * HEIGHT);
+    this->set_writer(std::move(draw));
+    this->flush_dirty_();
+  }
+  void update() {
+    this->do_update_();
+    this->flush();
+  }
+  void flush() {
+    this->flushed.clear();
+    this->sent.clear();
+    this->flush_dirty_();
+  }
+  /// Like a driver after resetting the display, which lost what was sent.
+  void reset() {
+    this->invalidate_rows_();
+    this->mark_dirty_all_();
+  }
+  uint8_t pixel(int x, int y) const { return this->buffer_[y * WIDTH + x]; }
+
+ protected:
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+      return;
+    this->buffer_[y * WIDTH + x] = color.r | color.b >> 4;
+    this->mark_dirty_(x, y);
+  }
+  size_t flush_rect_(int x1, int y1, int x2, int y2) override {
+    this->flushed.push_back(Rect{x1, y1, x2, y2});
+    size_t bytes = 0;
+    int band_start = -1;
+    for (int y = y1; y <= y2 + 1; y++) {
+      bool changed = y <= y2 && this->row_changed_(y, this->buffer_ + y * WIDTH, WIDTH);
+      if (changed && band_start < 0)
+        band_start = y;
+      if (changed || band_start < 0)
+        continue;
+      this->sent.push_back(Rect{x1, band_start, x2, y - 1});
+      bytes += (x2 - x1 + 1) * (y - band_start);
+      host_test::advance_micros(y - band_start);
+      band_start = -1;
+    }
+    return bytes;
+  }
+};
+
+HOST_TEST(display_dirty_window) {
+  int frame = 0;
+  DirtyDisplay display([&frame](DisplayBuffer &it) {
+    it.filled_rectangle(4 + frame, 2, 10, 6, RED);
+    if (frame >= 2)
+      it.filled_rectangle(30, 20, 5, 3, BLUE);
+  });
+  display.set_auto_clear(false);
+
+  // Without auto clear, only what's drawn is dirty: the window covers the rectangle
+  display.update();
+  EXPECT_TRUE(display.flushed == (std::vector<Rect>{{4, 2, 13, 7}}));
+  EXPECT_TRUE(display.sent == display.flushed);
+  EXPECT_EQ(display.get_flush_bytes(), 10u * 6u);
+  EXPECT_EQ(display.get_flush_time_us(), 6u);
+
+  // The window spans everything drawn in the frame
+  frame = 2;
+  display.update();
+  EXPECT_TRUE(display.flushed == (std::vector<Rect>{{6, 2, 34, 22}}));
+  // The rows between the rectangles didn't change and aren't sent
+  EXPECT_TRUE(display.sent == (std::vector<Rect>{{6, 2, 34, 7}, {6, 20, 34, 22}}));
+  EXPECT_EQ(display.get_flush_bytes(), 29u * (6u + 3u));
+  EXPECT_EQ(display.get_flush_time_us(), 9u);
+  // What the last frame drew outside of the window is still in the buffer
+  EXPECT_EQ(display.pixel(4, 3), display.pixel(6, 3));
+  EXPECT_TRUE(display.pixel(4, 3) != 0);
+
+  // Without drawing nothing is flushed, and the counters say so
+  DirtyDisplay idle([](DisplayBuffer &it) {});
+  idle.set_auto_clear(false);
+  idle.update();
+  EXPECT_TRUE(idle.flushed.empty());
+  EXPECT_EQ(idle.get_flush_bytes(), 0u);
+  EXPECT_EQ(idle.get_flush_time_us(), 0u);
+}
+
+HOST_TEST(display_dirty_unchanged_rows) {
+  int frame = 0;
+  DirtyDisplay display([&frame](DisplayBuffer &it) {
+    it.filled_rectangle(0, 4, 20, 4, RED);
+    it.filled_rectangle(frame, 16, 8, 2, BLUE);
+  });
+
+  // The first frame sends every row that differs from the cleared buffer sent by setup
+  display.update();
+  EXPECT_TRUE(display.flushed == (std::vector<Rect>{{0, 0, DirtyDisplay::WIDTH - 1, DirtyDisplay::HEIGHT - 1}}));
+  EXPECT_TRUE(display.sent == (std::vector<Rect>{{0, 4, 47, 7}, {0, 16, 47, 17}}));
+
+  // Auto clear marks the whole display, but only the rows of the moving rectangle changed
+  frame = 3;
+  display.update();
+  EXPECT_EQ(display.flushed.size(), 1u);
+  EXPECT_TRUE(display.sent == (std::vector<Rect>{{0, 16, 47, 17}}));
+  EXPECT_EQ(display.get_flush_bytes(), 48u * 2u);
+  EXPECT_EQ(display.get_flush_time_us(), 2u);
+
+  // Drawing exactly the same sends nothing
+  display.update();
+  EXPECT_TRUE(display.sent.empty());
+  EXPECT_EQ(display.get_flush_bytes(), 0u);
+  EXPECT_EQ(display.get_flush_time_us(), 0u);
+
+  // After the driver invalidated the rows, all of them are sent again
+  display.reset();
+  display.flush();
+  EXPECT_TRUE(display.sent == (std::vector<Rect>{{0, 0, 47, 31}}));
+  EXPECT_EQ(display.get_flush_bytes(), 48u * 32u);
+}
+
+}  // namespace display
+}  // namespace esphome
@@ -0,0 +1,229 @@
+// Tests of drawing DisplayBuffer primitives as spans.
+//
+// Everything is drawn on three displays in all rotations: a reference that draws pixel by pixel with draw_pixel_at(),
+// a display that only implements draw_absolute_pixel_internal() and so uses the default span hooks, and one that
+// overrides the span hooks like the ILI9341, ST7735 and SSD1306 drivers do. All three have to end up with the same
+// pixels.
+//
+// host_test sources: esphome/components/display/display_buffer.cpp esphome/core/color.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/display/display_buffer.h"
+
+#include <functional>
+#include <vector>
+
+namespace esphome {
+
+// Only referenced by the text and graph functions of DisplayBuffer, which these tests don't use
+size_t time::ESPTime::strftime(char *buffer, size_t buffer_len, const char *format) { return 0; }
+void graph::Graph::draw(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+void graph::Graph::draw_legend(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+
+namespace display {
+
+static const Color RED(255, 0, 0);
+static const Color GREEN(0, 255, 0);
+static const Color BLUE(0, 0, 255);
+
+class MemoryDisplay : public DisplayBuffer {
+ public:
+  static const int WIDTH = 40;
+  static const int HEIGHT = 24;
+
+  std::vector<uint32_t> pixels = std::vector<uint32_t>(WIDTH * HEIGHT, 0);
+  /// Number of calls of the drawing hooks.
+  int calls{0};
+
+ protected:
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    this->calls++;
+    this->set_pixel_(x, y, color);
+  }
+  void set_pixel_(int x, int y, Color color) {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+      return;
+    this->pixels[y * WIDTH + x] = color.r | color.g << 8 | color.b << 16 | color.w << 24;
+  }
+};
+
+class SpanDisplay : public MemoryDisplay {
+ protected:
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override {
+    this->calls++;
+    if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+      return;
+    for (int j = y; j < y + height; j++) {
+      for (int i = x; i < x + width; i++)
+        this->set_pixel_(i, j, color);
+    }
+  }
+  void draw_absolute_row_internal(int x, int y, const Color *colors, int length) override {
+    this->calls++;
+    const int start = x;
+    int height = 1;
+    if (!this->clip_absolute_rect_(&x, &y, &length, &height))
+      return;
+    colors += x - start;
+    for (int i = 0; i < length; i++)
+      this->set_pixel_(x + i, y, colors[i]);
+  }
+};
+
+static const DisplayRotation ROTATIONS[] = {DISPLAY_ROTATION_0_DEGREES, DISPLAY_ROTATION_90_DEGREES,
+                                            DISPLAY_ROTATION_180_DEGREES, DISPLAY_ROTATION_270_DEGREES};
+
+static void fill_pixels(DisplayBuffer &display, int x, int y, int width, int height, Color color) {
+  for (int j = y; j < y + height; j++) {
+    for (int i = x; i < x + width; i++)
+      display.draw_pixel_at(i, j, color);
+  }
+}
+
+/// Draw with the span functions and compare with the reference that draws pixel by pixel.
+static void expect_same_pixels(const char *name, const std::function<void(DisplayBuffer &)> &draw,
+                               const std::function<void(DisplayBuffer &)> &reference) {
+  for (auto rotation : ROTATIONS) {
+    MemoryDisplay expected;
+    MemoryDisplay pixel_display;
+    SpanDisplay span_display;
+    expected.set_rotation(rotation);
+    pixel_display.set_rotation(rotation);
+    span_display.set_rotation(rotation);
+
+    reference(expected);
+    draw(pixel_display);
+    draw(span_display);
+
+    const std::string context = std::string(name) + " at " + std::to_string(rotation) + " degrees";
+    if (pixel_display.pixels != expected.pixels)
+      host_test::fail(__FILE__, __LINE__, context + ": default hooks differ from drawing pixel by pixel");
+    if (span_display.pixels != expected.pixels)
+      host_test::fail(__FILE__, __LINE__, context + ": span hooks differ from drawing pixel by pixel");
+  }
+}
+
+HOST_TEST(display_spans_rectangles) {
+  expect_same_pixels(
+      "rectangles",
+      [](DisplayBuffer &display) {
+        display.filled_rectangle(-3, -2, 10, 8, RED);
+        display.filled_rectangle(30, 15, 20, 20, GREEN);
+        display.horizontal_line(5, 10, 50, BLUE);
+        display.vertical_line(12, -5, 40, Color::WHITE);
+        display.rectangle(2, 3, 9, 7, GREEN);
+        display.filled_rectangle(5, 5, 0, 3, RED);
+        display.filled_rectangle(5, 5, -2, 3, RED);
+      },
+      [](DisplayBuffer &display) {
+        fill_pixels(display, -3, -2, 10, 8, RED);
+        fill_pixels(display, 30, 15, 20, 20, GREEN);
+        fill_pixels(display, 5, 10, 50, 1, BLUE);
+        fill_pixels(display, 12, -5, 1, 40, Color::WHITE);
+        fill_pixels(display, 2, 3, 9, 1, GREEN);
+        fill_pixels(display, 2, 9, 9, 1, GREEN);
+        fill_pixels(display, 2, 3, 1, 7, GREEN);
+        fill_pixels(display, 10, 3, 1, 7, GREEN);
+      });
+}
+
+HOST_TEST(display_spans_fill) {
+  expect_same_pixels(
+      "fill", [](DisplayBuffer &display) { display.fill(RED); },
+      [](DisplayBuffer &display) { fill_pixels(display, 0, 0, display.get_width(), display.get_height(), RED); });
+
+  // One span for the whole display in every rotation
+  for (auto rotation : ROTATIONS) {
+    SpanDisplay display;
+    display.set_rotation(rotation);
+    display.fill(BLUE);
+    EXPECT_EQ(display.calls, 1);
+  }
+}
+
+// A 10x5 glyph, two bytes per row, with runs that cross the byte boundary
+static const uint8_t GLYPH_A[] = {0xFF, 0xC0, 0x81, 0x40, 0x99, 0x00, 0x00, 0x00, 0xAA, 0x80};
+static const uint8_t GLYPH_B[] = {0xF0, 0x0F, 0x3C, 0xFF, 0x81, 0x42};
+static const GlyphData GLYPHS[] = {
+    {"A", GLYPH_A, 1, 2, 10, 5},
+    {"B", GLYPH_B, 0, 0, 8, 6},
+};
+
+HOST_TEST(display_spans_text) {
+  Font font(GLYPHS, 2, 6, 8);
+  for (auto position : {std::make_pair(3, 2), std::make_pair(-4, -3), std::make_pair(30, 20)}) {
+    const int x = position.first;
+    const int y = position.second;
+    expect_same_pixels(
+        "text", [&](DisplayBuffer &display) { display.print(x, y, &font, RED, TextAlign::TOP_LEFT, "AB?A"); },
+        [&](DisplayBuffer &display) {
+          int x_at, y_start, width, height;
+          display.get_text_bounds(x, y, "AB?A", &font, TextAlign::TOP_LEFT, &x_at, &y_start, &width, &height);
+          for (const char *c = "AB?A"; *c != '\0'; c++) {
+            if (*c == '?') {
+              // Characters without a glyph are drawn as a box as wide as the first glyph
+              fill_pixels(display, x_at, y_start, GLYPHS[0].width, height, RED);
+              x_at += GLYPHS[0].width;
+              continue;
+            }
+            const Glyph &glyph = font.get_glyphs()[*c - 'A'];
+            const GlyphData &data = GLYPHS[*c - 'A'];
+            for (int glyph_y = data.offset_y; glyph_y < data.offset_y + data.height; glyph_y++) {
+              for (int glyph_x = data.offset_x; glyph_x < data.offset_x + data.width; glyph_x++) {
+                if (glyph.get_pixel(glyph_x, glyph_y))
+                  display.draw_pixel_at(x_at + glyph_x, y_start + glyph_y, RED);
+              }
+            }
+            x_at += data.width + data.offset_x;
+          }
+        });
+  }
+}
+
+// 11x9 binary image, two bytes per row
+static const uint8_t BINARY_IMAGE[] = {0xFF, 0xE0, 0x80, 0x20, 0xAA, 0xA0, 0x55, 0x40, 0x00, 0x00,
+                                       0xFF, 0xE0, 0xF0, 0x00, 0x0F, 0xE0, 0x31, 0x80};
+
+HOST_TEST(display_spans_images) {
+  uint8_t rgb_data[7 * 5 * 3];
+  for (size_t i = 0; i < sizeof(rgb_data); i++)
+    rgb_data[i] = i * 37;
+  uint8_t grayscale_data[6 * 4];
+  for (size_t i = 0; i < sizeof(grayscale_data); i++)
+    grayscale_data[i] = i * 11;
+  Image binary(BINARY_IMAGE, 11, 9, IMAGE_TYPE_BINARY);
+  Image rgb(rgb_data, 7, 5, IMAGE_TYPE_RGB24);
+  Image grayscale(grayscale_data, 6, 4, IMAGE_TYPE_GRAYSCALE);
+
+  for (auto position : {std::make_pair(2, 3), std::make_pair(-5, -2), std::make_pair(35, 20)}) {
+    const int x = position.first;
+    const int y = position.second;
+    expect_same_pixels(
+        "images",
+        [&](DisplayBuffer &display) {
+          display.image(x, y, &binary, RED, BLUE);
+          display.image(x + 12, y + 1, &rgb);
+          display.image(x + 3, y + 10, &grayscale);
+        },
+        [&](DisplayBuffer &display) {
+          for (int img_y = 0; img_y < 9; img_y++) {
+            for (int img_x = 0; img_x < 11; img_x++)
+              display.draw_pixel_at(x + img_x, y + img_y, binary.get_pixel(img_x, img_y) ? RED : BLUE);
+          }
+          for (int img_y = 0; img_y < 5; img_y++) {
+            for (int img_x = 0; img_x < 7; img_x++)
+              display.draw_pixel_at(x + 12 + img_x, y + 1 + img_y, rgb.get_color_pixel(img_x, img_y));
+          }
+          for (int img_y = 0; img_y < 4; img_y++) {
+            for (int img_x = 0; img_x < 6; img_x++)
+              display.draw_pixel_at(x + 3 + img_x, y + 10 + img_y, grayscale.get_grayscale_pixel(img_x, img_y));
+          }
+        });
+  }
+}
+
+}  // namespace display
+}  // namespace esphome
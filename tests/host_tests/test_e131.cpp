@@ -0,0 +1,281 @@
+// Tests of receiving E1.31 packets into an addressable light: parsing, sequence numbers, synchronization and the
+// multicast groups that are joined.
+//
+// host_test sources: esphome/components/e131/e131.cpp esphome/components/e131/e131_packet.cpp
+// host_test sources: esphome/components/e131/e131_addressable_light_effect.cpp
+// host_test sources: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// host_test sources: esphome/components/light/esp_range_view.cpp esphome/components/light/esp_hsv_color.cpp
+// host_test sources: esphome/components/light/light_output.cpp esphome/components/light/light_state.cpp
+// host_test sources: esphome/components/light/light_call.cpp esphome/core/entity_base.cpp
+// host_test sources: esphome/core/color.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test flags: -DUSE_ARDUINO -DUSE_ESP32
+
+#include "host_test.h"
+
+#include "esphome/components/e131/e131.h"
+#include "esphome/components/e131/e131_addressable_light_effect.h"
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/core/preferences.h"
+
+#include <WiFi.h>
+#include <lwip/igmp.h>
+
+#include <map>
+#include <vector>
+
+std::deque<std::vector<uint8_t>> UDP::received;  // NOLINT
+
+/// Joins minus leaves of each multicast group, by the last two bytes of the group address (the universe).
+static std::map<int, int> igmp_groups;  // NOLINT
+
+static int universe_of(const ip4_addr_t *group) {
+  const uint32_t addr = group->addr;
+  return ((addr >> 16) & 0xff) << 8 | ((addr >> 24) & 0xff);
+}
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  igmp_groups[universe_of(groupaddr)]++;
+  return 0;
+}
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  if (--igmp_groups[universe_of(groupaddr)] == 0)
+    igmp_groups.erase(universe_of(groupaddr));
+  return 0;
+}
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace e131 {
+
+class TestLight : public light::AddressableLight {
+ public:
+  explicit TestLight(int32_t size) : data_(size * 3), effect_data_(size) {}
+  int32_t size() const override { return this->effect_data_.size(); }
+  void clear_effect_data() override {}
+  light::LightTraits get_traits() override { return {}; }
+  void write_state(light::LightState *state) override {}
+  /// The raw RGB value of a channel, without color correction.
+  uint8_t channel(int32_t index, int channel) const { return this->data_[index * 3 + channel]; }
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->data_.data()) + 3 * index;
+    return light::ESPColorView(base, base + 1, base + 2, nullptr, const_cast<uint8_t *>(&this->effect_data_[index]),
+                               &this->correction_);
+  }
+  light::AddressableLightBuffer get_buffer_internal() const override {
+    light::AddressableLightBuffer buffer;
+    buffer.data = const_cast<uint8_t *>(this->data_.data());
+    return buffer;
+  }
+
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> effect_data_;
+};
+
+static void put16(std::vector<uint8_t> &packet, size_t offset, uint16_t value) {
+  packet[offset] = value >> 8;
+  packet[offset + 1] = value;
+}
+
+static std::vector<uint8_t> root_layer(size_t size, uint32_t vector) {
+  static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> packet(size, 0);
+  put16(packet, 0, 0x0010);
+  memcpy(&packet[4], ACN_ID, sizeof(ACN_ID));
+  put16(packet, 16, 0x7000 | (size - 16));
+  put16(packet, 20, vector);
+  put16(packet, 38, 0x7000 | (size - 38));
+  return packet;
+}
+
+/// A data packet with the values of count RGB LEDs, all set to value.
+static std::vector<uint8_t> data_packet(uint16_t universe, uint8_t sequence, uint16_t sync_universe, int count,
+                                        uint8_t value) {
+  std::vector<uint8_t> packet = root_layer(126 + count * 3, 4);
+  put16(packet, 42, 2);
+  packet[108] = 100;
+  put16(packet, 109, sync_universe);
+  packet[111] = sequence;
+  put16(packet, 113, universe);
+  put16(packet, 115, 0x7000 | (packet.size() - 115));
+  packet[117] = 2;
+  packet[118] = 0xa1;
+  put16(packet, 121, 1);
+  put16(packet, 123, 1 + count * 3);
+  memset(&packet[126], value, count * 3);
+  return packet;
+}
+
+static std::vector<uint8_t> sync_packet(uint16_t sync_universe) {
+  std::vector<uint8_t> packet = root_layer(49, 8);
+  put16(packet, 42, 1);
+  put16(packet, 45, sync_universe);
+  return packet;
+}
+
+class E131Test {
+ public:
+  explicit E131Test(int32_t leds, int first_universe = 1)
+      : light(leds), state("strip", &this->light), effect("e131") {
+    igmp_groups.clear();
+    UDP::received.clear();
+    this->light.setup_state(&this->state);
+    this->effect.set_first_universe(first_universe);
+    this->effect.set_channels(E131_RGB);
+    this->effect.set_e131(&this->e131);
+    this->effect.init_internal(&this->state);
+    this->e131.setup();
+    this->effect.start();
+  }
+
+  void receive(const std::vector<uint8_t> &packet) {
+    UDP::received.push_back(packet);
+    this->e131.loop();
+  }
+  void apply() { this->effect.apply(this->light, Color()); }
+  /// Whether a show was scheduled since the last call.
+  bool shown() { return this->state.show(); }
+
+  TestLight light;
+  light::LightState state;
+  E131Component e131;
+  E131AddressableLightEffect effect;
+};
+
+HOST_TEST(e131_data) {
+  // 170 RGB LEDs per universe
+  E131Test test(200);
+  EXPECT_EQ(test.effect.get_universe_count(), 2);
+
+  test.receive(data_packet(1, 1, 0, 170, 0x40));
+  EXPECT_EQ(test.light.channel(0, 0), 0x40);
+  EXPECT_EQ(test.light.channel(169, 2), 0x40);
+  EXPECT_EQ(test.light.channel(170, 0), 0);
+  EXPECT_TRUE(test.shown());
+
+  // Only the LEDs the light has
+  test.receive(data_packet(2, 1, 0, 170, 0x50));
+  EXPECT_EQ(test.light.channel(170, 0), 0x50);
+  EXPECT_EQ(test.light.channel(199, 2), 0x50);
+  EXPECT_EQ(test.light.channel(169, 0), 0x40);
+
+  // Other universes, truncated packets and packets with another start code are ignored
+  test.receive(data_packet(3, 1, 0, 170, 0x60));
+  auto truncated = data_packet(1, 2, 0, 10, 0x70);
+  truncated.resize(truncated.size() - 1);
+  test.receive(truncated);
+  auto start_code = data_packet(1, 3, 0, 10, 0x70);
+  start_code[125] = 0xdd;
+  test.receive(start_code);
+  EXPECT_EQ(test.light.channel(0, 0), 0x40);
+  EXPECT_TRUE(test.shown());
+  EXPECT_TRUE(!test.shown());
+}
+
+HOST_TEST(e131_sequence) {
+  E131Test test(10);
+  test.receive(data_packet(1, 100, 0, 10, 10));
+  EXPECT_EQ(test.light.channel(0, 0), 10);
+  // Out of order, the newer data wins
+  test.receive(data_packet(1, 95, 0, 10, 20));
+  EXPECT_EQ(test.light.channel(0, 0), 10);
+  test.receive(data_packet(1, 100, 0, 10, 20));
+  EXPECT_EQ(test.light.channel(0, 0), 10);
+  test.receive(data_packet(1, 101, 0, 10, 30));
+  EXPECT_EQ(test.light.channel(0, 0), 30);
+  // Far behind, the sender restarted
+  test.receive(data_packet(1, 50, 0, 10, 40));
+  EXPECT_EQ(test.light.channel(0, 0), 40);
+  // Wraps around
+  test.receive(data_packet(1, 250, 0, 10, 50));
+  test.receive(data_packet(1, 2, 0, 10, 60));
+  EXPECT_EQ(test.light.channel(0, 0), 60);
+}
+
+HOST_TEST(e131_sync) {
+  E131Test test(10);
+  host_test::set_micros(1000000);
+
+  // Without a synchronization packet so far, data is shown right away
+  test.receive(data_packet(1, 1, 7, 10, 10));
+  EXPECT_TRUE(test.shown());
+
+  // Once they arrive, data waits for the next one
+  test.receive(sync_packet(7));
+  test.receive(data_packet(1, 2, 7, 10, 20));
+  EXPECT_EQ(test.light.channel(0, 0), 20);
+  EXPECT_TRUE(!test.shown());
+  test.receive(sync_packet(8));
+  EXPECT_TRUE(!test.shown());
+  test.receive(sync_packet(7));
+  EXPECT_TRUE(test.shown());
+
+  // Data that waits is shown by apply() once the synchronization packets stop
+  host_test::advance_millis(100);
+  test.receive(data_packet(1, 3, 7, 10, 30));
+  test.apply();
+  EXPECT_TRUE(!test.shown());
+  host_test::advance_millis(2400);
+  test.apply();
+  EXPECT_TRUE(test.shown());
+  test.apply();
+  EXPECT_TRUE(!test.shown());
+
+  // And later data is shown right away
+  test.receive(data_packet(1, 4, 7, 10, 40));
+  EXPECT_TRUE(test.shown());
+
+  // Data without a synchronization universe is always shown right away
+  test.receive(sync_packet(7));
+  test.receive(data_packet(1, 5, 0, 10, 50));
+  EXPECT_TRUE(test.shown());
+}
+
+HOST_TEST(e131_multicast_groups) {
+  E131Test test(400, 10);
+  EXPECT_EQ(igmp_groups.size(), size_t(3));
+  EXPECT_EQ(igmp_groups[10], 1);
+  EXPECT_EQ(igmp_groups[12], 1);
+
+  // The synchronization universe is joined once a packet names it
+  EXPECT_TRUE(igmp_groups.count(1000) == 0);
+  test.receive(data_packet(10, 1, 1000, 170, 1));
+  test.receive(data_packet(11, 1, 1000, 170, 1));
+  EXPECT_EQ(igmp_groups[1000], 1);
+
+  // A second effect with the same synchronization universe shares the group
+  E131AddressableLightEffect other("other");
+  other.set_first_universe(20);
+  other.set_channels(E131_RGB);
+  other.set_e131(&test.e131);
+  other.init_internal(&test.state);
+  other.start();
+  test.receive(data_packet(20, 1, 1000, 170, 1));
+  EXPECT_EQ(igmp_groups[1000], 1);
+  EXPECT_EQ(igmp_groups[20], 1);
+
+  // Switching to another synchronization universe leaves the old group once nobody uses it
+  test.receive(data_packet(10, 2, 1001, 170, 1));
+  EXPECT_EQ(igmp_groups[1000], 1);
+  EXPECT_EQ(igmp_groups[1001], 1);
+  other.stop();
+  EXPECT_TRUE(igmp_groups.count(1000) == 0);
+  EXPECT_TRUE(igmp_groups.count(20) == 0);
+
+  // Data without a synchronization universe leaves it as well
+  test.receive(data_packet(10, 3, 0, 170, 1));
+  EXPECT_TRUE(igmp_groups.count(1001) == 0);
+  test.receive(data_packet(10, 4, 1001, 170, 1));
+  EXPECT_EQ(igmp_groups[1001], 1);
+
+  test.effect.stop();
+  EXPECT_TRUE(igmp_groups.empty());
+}
+
+}  // namespace e131
+}  // namespace esphome
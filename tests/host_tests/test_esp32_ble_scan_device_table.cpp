@@ -0,0 +1,128 @@
+// Tests of esp32_ble_tracker::ScanDeviceTable: devices that collide in the hash table, forgetting them for a new scan,
+// the max_tracked_devices limit and the min_advertisement_interval rate limit.
+//
+// host_test sources: esphome/components/esp32_ble_tracker/scan_device_table.cpp
+// host_test flags: -DUSE_ESP32
+
+#include "host_test.h"
+
+#include "esphome/components/esp32_ble_tracker/scan_device_table.h"
+
+#include <vector>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/// The first slot of an address in a table with mask + 1 slots, like ScanDeviceTable::find_().
+static size_t first_slot(uint64_t address, size_t mask) {
+  return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+/// Addresses of one vendor that all start probing at the same slot.
+static std::vector<uint64_t> colliding_addresses(size_t count, size_t mask) {
+  std::vector<uint64_t> addresses;
+  const uint64_t vendor = 0xA4C138000000ULL;
+  for (uint64_t address = vendor; addresses.size() < count; address++) {
+    if (first_slot(address, mask) == first_slot(vendor, mask))
+      addresses.push_back(address);
+  }
+  return addresses;
+}
+
+HOST_TEST(ble_scan_device_table_probing) {
+  ScanDeviceTable table;
+  // 24 devices get 32 slots
+  table.init(24);
+  const auto addresses = colliding_addresses(6, 31);
+  for (size_t i = 0; i < addresses.size(); i += 2)
+    EXPECT_TRUE(table.mark_discovered(addresses[i]));
+  EXPECT_EQ(table.size(), 3u);
+
+  // Every device of the probe sequence is found, the others aren't
+  for (size_t i = 0; i < addresses.size(); i++)
+    EXPECT_EQ(table.is_discovered(addresses[i]), i % 2 == 0);
+  EXPECT_TRUE(!table.mark_discovered(addresses[2]));
+  EXPECT_TRUE(table.mark_discovered(addresses[3]));
+
+  // Address 0 is a device like any other
+  EXPECT_TRUE(!table.is_discovered(0));
+  EXPECT_TRUE(table.mark_discovered(0));
+  EXPECT_TRUE(table.is_discovered(0));
+}
+
+HOST_TEST(ble_scan_device_table_clear) {
+  ScanDeviceTable table;
+  table.init(24);
+  const auto addresses = colliding_addresses(4, 31);
+  const uint8_t payload[] = {0x02, 0x01, 0x06};
+  for (uint64_t address : addresses) {
+    table.mark_discovered(address);
+    table.should_forward(address, false, payload, sizeof(payload), 1000, 10000);
+  }
+
+  // A new scan forgets the devices, they are printed and forwarded again
+  table.clear();
+  EXPECT_EQ(table.size(), 0u);
+  for (uint64_t address : addresses) {
+    EXPECT_TRUE(!table.is_discovered(address));
+    EXPECT_TRUE(table.should_forward(address, false, payload, sizeof(payload), 1001, 10000));
+  }
+  EXPECT_TRUE(table.mark_discovered(addresses[3]));
+  EXPECT_TRUE(!table.is_discovered(addresses[0]));
+  EXPECT_TRUE(table.is_discovered(addresses[3]));
+}
+
+HOST_TEST(ble_scan_device_table_max_tracked_devices) {
+  ScanDeviceTable table;
+  table.init(4);
+  const uint8_t payload[] = {0x02, 0x01, 0x06};
+  for (uint64_t address = 1; address <= 4; address++)
+    EXPECT_TRUE(table.mark_discovered(address));
+  EXPECT_EQ(table.size(), 4u);
+
+  // Devices beyond the limit aren't tracked: never printed and never rate limited
+  EXPECT_TRUE(!table.mark_discovered(5));
+  EXPECT_TRUE(table.is_discovered(5));
+  EXPECT_TRUE(table.should_forward(5, false, payload, sizeof(payload), 1000, 10000));
+  EXPECT_TRUE(table.should_forward(5, false, payload, sizeof(payload), 1001, 10000));
+  EXPECT_EQ(table.size(), 4u);
+
+  // The tracked ones still are
+  EXPECT_TRUE(table.is_discovered(4));
+  EXPECT_TRUE(!table.mark_discovered(4));
+}
+
+HOST_TEST(ble_scan_device_table_rate_limit) {
+  ScanDeviceTable table;
+  table.init(8);
+  const uint64_t address = 0xA4C138000001ULL;
+  const uint8_t payload[] = {0x05, 0x16, 0x95, 0xFE, 0x01, 0x02};
+  const uint8_t changed[] = {0x05, 0x16, 0x95, 0xFE, 0x01, 0x03};
+  const uint32_t interval = 1000;
+
+  EXPECT_TRUE(table.should_forward(address, false, payload, sizeof(payload), 10000, interval));
+  EXPECT_TRUE(!table.should_forward(address, false, payload, sizeof(payload), 10500, interval));
+  // A changed payload is forwarded right away, and starts the interval again
+  EXPECT_TRUE(table.should_forward(address, false, changed, sizeof(changed), 10600, interval));
+  EXPECT_TRUE(!table.should_forward(address, false, changed, sizeof(changed), 11599, interval));
+  EXPECT_TRUE(table.should_forward(address, false, changed, sizeof(changed), 11600, interval));
+
+  // Scan responses are limited separately from the advertisements of the device
+  EXPECT_TRUE(table.should_forward(address, true, payload, sizeof(payload), 11700, interval));
+  EXPECT_TRUE(!table.should_forward(address, true, payload, sizeof(payload), 11800, interval));
+  EXPECT_TRUE(!table.should_forward(address, false, changed, sizeof(changed), 11800, interval));
+  EXPECT_EQ(table.size(), 2u);
+
+  // Other devices aren't affected, and printing a device doesn't reset its limit
+  EXPECT_TRUE(table.should_forward(address + 1, false, payload, sizeof(payload), 11800, interval));
+  EXPECT_TRUE(table.mark_discovered(address));
+  EXPECT_TRUE(!table.should_forward(address, false, changed, sizeof(changed), 11900, interval));
+
+  // millis() wrapping around
+  EXPECT_TRUE(table.should_forward(address + 2, false, payload, sizeof(payload), UINT32_MAX - 100, interval));
+  EXPECT_TRUE(!table.should_forward(address + 2, false, payload, sizeof(payload), 500, interval));
+  EXPECT_TRUE(table.should_forward(address + 2, false, payload, sizeof(payload), 900, interval));
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
@@ -0,0 +1,144 @@
+// Tests of the parts of esp32_ble_tracker that don't need the Bluetooth stack: the lock-free scan result queue, the
+// 16 bit UUIDs of raw advertisements and the dispatch of advertisements to the listeners by their match filters.
+//
+// host_test sources: esphome/components/esp32_ble_tracker/listener_index.cpp
+// host_test flags: -DUSE_ESP32
+
+#include "host_test.h"
+
+#include "esphome/components/esp32_ble_tracker/listener_index.h"
+#include "esphome/components/esp32_ble_tracker/lock_free_queue.h"
+#include "esphome/core/optional.h"
+
+#include <vector>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+HOST_TEST(ble_lock_free_queue_wrap_around) {
+  LockFreeQueue<int> queue;
+  queue.init(3);
+  EXPECT_EQ(queue.get_capacity(), 3u);
+  EXPECT_TRUE(queue.front() == nullptr);
+
+  // Head and tail go around the 4 slots several times
+  int pushed = 0;
+  int popped = 0;
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 1 + round % 3; i++)
+      EXPECT_TRUE(queue.push(pushed++));
+    while (queue.front() != nullptr) {
+      EXPECT_EQ(*queue.front(), popped);
+      queue.pop();
+      popped++;
+    }
+  }
+  EXPECT_EQ(popped, pushed);
+  EXPECT_EQ(queue.take_dropped(), 0u);
+}
+
+HOST_TEST(ble_lock_free_queue_full) {
+  LockFreeQueue<int> queue;
+  queue.init(3);
+  queue.push(1);
+  queue.pop();
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_TRUE(queue.push(4));
+  // Elements that don't fit are dropped and counted, the queued ones stay
+  EXPECT_TRUE(!queue.push(5));
+  EXPECT_TRUE(!queue.push(6));
+  EXPECT_EQ(queue.take_dropped(), 2u);
+  EXPECT_EQ(queue.take_dropped(), 0u);
+
+  EXPECT_EQ(*queue.front(), 2);
+  queue.pop();
+  EXPECT_TRUE(queue.push(7));
+  std::vector<int> values;
+  while (queue.front() != nullptr) {
+    values.push_back(*queue.front());
+    queue.pop();
+  }
+  const std::vector<int> expected{3, 4, 7};
+  EXPECT_TRUE(values == expected);
+}
+
+static std::vector<uint16_t> uuid16s(const std::vector<uint8_t> &payload, size_t max_uuids = 16) {
+  std::vector<uint16_t> uuids(max_uuids);
+  uuids.resize(collect_uuid16s(payload.data(), payload.size(), uuids.data(), max_uuids));
+  return uuids;
+}
+
+HOST_TEST(ble_collect_uuid16s) {
+  // Flags, then the complete and incomplete lists of 16 bit service UUIDs
+  const std::vector<uint8_t> lists{0x02, 0x01, 0x06, 0x05, 0x03, 0x0F, 0x18, 0x0A, 0x18, 0x03, 0x02, 0x1A, 0x18};
+  EXPECT_TRUE(uuid16s(lists) == (std::vector<uint16_t>{0x180F, 0x180A, 0x181A}));
+  // A list with an odd length only has its whole UUIDs
+  EXPECT_TRUE(uuid16s({0x04, 0x03, 0x0F, 0x18, 0x0A}) == (std::vector<uint16_t>{0x180F}));
+
+  // Service data, manufacturer data and 32 and 128 bit UUIDs that are 16 bit UUIDs in disguise
+  const std::vector<uint8_t> others{
+      0x05, 0x16, 0x95, 0xFE, 0x01, 0x02,                          // Service data of 0xFE95
+      0x04, 0xFF, 0x4C, 0x00, 0x02,                                // Manufacturer 0x004C
+      0x09, 0x05, 0x0D, 0x18, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78,  // 32 bit: 0x180D and one that isn't
+      0x11, 0x07, 0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80,  // 128 bit 0x181C on the base UUID
+      0x00, 0x10, 0x00, 0x00, 0x1C, 0x18, 0x00, 0x00,
+  };
+  EXPECT_TRUE(uuid16s(others) == (std::vector<uint16_t>{0xFE95, 0x004C, 0x180D, 0x181C}));
+  // A 128 bit UUID off the base UUID isn't one
+  std::vector<uint8_t> custom(others.begin() + 21, others.end());
+  custom[2] = 0x00;
+  EXPECT_TRUE(uuid16s(custom).empty());
+
+  // A truncated record ends the search, the UUIDs before it are kept
+  EXPECT_TRUE(uuid16s({0x03, 0x03, 0x0F, 0x18, 0x05, 0x03, 0x0A, 0x18}) == (std::vector<uint16_t>{0x180F}));
+  EXPECT_TRUE(uuid16s({0x03, 0x03, 0x0F, 0x18, 0x00, 0x03, 0x03, 0x0A, 0x18}) == (std::vector<uint16_t>{0x180F}));
+  // No more than fit into the array
+  EXPECT_EQ(uuid16s(lists, 2).size(), 2u);
+}
+
+struct TestListener {
+  uint64_t address{0};
+  optional<uint16_t> uuid{};
+
+  uint64_t get_match_address() const { return this->address; }
+  const optional<uint16_t> &get_match_uuid16() const { return this->uuid; }
+};
+
+HOST_TEST(ble_listener_index) {
+  TestListener all;
+  TestListener battery_1;
+  battery_1.uuid = 0x180F;
+  TestListener device;
+  device.address = 0xA4C138000001ULL;
+  TestListener xiaomi;
+  xiaomi.uuid = 0xFE95;
+  TestListener battery_2;
+  battery_2.uuid = 0x180F;
+  TestListener other_device;
+  other_device.address = 0xA4C138000002ULL;
+
+  ListenerIndex<TestListener> index;
+  index.build({&all, &battery_1, &device, &xiaomi, &battery_2, &other_device});
+  using Matched = std::vector<TestListener *>;
+
+  // Battery service UUID and service data: both battery listeners once each, in the order they were registered
+  const std::vector<uint8_t> battery{0x03, 0x03, 0x0F, 0x18, 0x04, 0x16, 0x0F, 0x18, 0x64};
+  EXPECT_TRUE(index.match(0x112233445566ULL, battery.data(), battery.size()) ==
+              (Matched{&battery_1, &battery_2, &all}));
+  // The address filter wins over the UUID filter
+  EXPECT_TRUE(index.match(0xA4C138000001ULL, battery.data(), battery.size()) ==
+              (Matched{&device, &battery_1, &battery_2, &all}));
+
+  const std::vector<uint8_t> mi{0x05, 0x16, 0x95, 0xFE, 0x50, 0x20};
+  EXPECT_TRUE(index.match(0xA4C138000002ULL, mi.data(), mi.size()) == (Matched{&other_device, &xiaomi, &all}));
+  EXPECT_TRUE(index.match(0x112233445566ULL, nullptr, 0) == (Matched{&all}));
+
+  // Rebuilding replaces the index
+  index.build({&xiaomi});
+  EXPECT_TRUE(index.match(0xA4C138000001ULL, battery.data(), battery.size()).empty());
+  EXPECT_TRUE(index.match(0xA4C138000001ULL, mi.data(), mi.size()) == (Matched{&xiaomi}));
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
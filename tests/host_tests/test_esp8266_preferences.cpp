@@ -0,0 +1,252 @@
+// Tests of the ESP8266 flash preferences: the journal of word updates, replaying it after a power loss in the middle
+// of a record and compacting it into a new snapshot once the sector is full.
+//
+// The preferences are included instead of built as a source, so that a reboot can reset their state. The flash
+// sector is simulated like NOR flash: erasing sets all bits, programming only clears them.
+//
+// host_test flags: -DUSE_ESP8266
+
+#include "host_test.h"
+
+#include "esphome/components/esp8266/preferences.cpp"
+
+#include <cstring>
+
+static uint8_t s_sector[SPI_FLASH_SEC_SIZE];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_erases = 0;                 // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Bytes that can still be programmed before the power is lost, negative for no limit
+static int32_t s_write_budget = -1;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static bool s_power_lost = false;    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+extern "C" {
+uint32_t _SPIFFS_end = 0;  // NOLINT
+
+static bool in_sector(uint32_t address, uint32_t size) {
+  const uint32_t start = esphome::esp8266::get_esp8266_flash_address();
+  return address - start <= SPI_FLASH_SEC_SIZE && size <= SPI_FLASH_SEC_SIZE - (address - start);
+}
+
+SpiFlashOpResult spi_flash_erase_sector(uint16_t sec) {
+  // The sector number derived from the address of _SPIFFS_end doesn't fit in 16 bits on the host
+  if (s_power_lost || sec != static_cast<uint16_t>(esphome::esp8266::get_esp8266_flash_sector()))
+    return SPI_FLASH_RESULT_ERR;
+  memset(s_sector, 0xFF, sizeof(s_sector));
+  s_erases++;
+  return SPI_FLASH_RESULT_OK;
+}
+
+SpiFlashOpResult spi_flash_write(uint32_t des_addr, uint32_t *src_addr, uint32_t size) {
+  if (s_power_lost || !in_sector(des_addr, size))
+    return SPI_FLASH_RESULT_ERR;
+  uint8_t *dest = &s_sector[des_addr - esphome::esp8266::get_esp8266_flash_address()];
+  const auto *src = reinterpret_cast<const uint8_t *>(src_addr);
+  for (uint32_t i = 0; i < size; i++) {
+    if (s_write_budget == 0) {
+      s_power_lost = true;
+      return SPI_FLASH_RESULT_ERR;
+    }
+    if (s_write_budget > 0)
+      s_write_budget--;
+    dest[i] &= src[i];
+  }
+  return SPI_FLASH_RESULT_OK;
+}
+
+SpiFlashOpResult spi_flash_read(uint32_t src_addr, uint32_t *des_addr, uint32_t size) {
+  if (!in_sector(src_addr, size))
+    return SPI_FLASH_RESULT_ERR;
+  memcpy(des_addr, &s_sector[src_addr - esphome::esp8266::get_esp8266_flash_address()], size);
+  return SPI_FLASH_RESULT_OK;
+}
+}
+
+namespace esphome {
+
+InterruptLock::InterruptLock() {}
+InterruptLock::~InterruptLock() {}
+
+namespace esp8266 {
+
+struct Pair {
+  uint32_t first;
+  uint32_t second;
+};
+
+/// The preferences of a device: a single word at word 0 (crc at 1) and two words at 2 and 3 (crc at 4).
+struct Device {
+  ESP8266Preferences *prefs;
+  ESPPreferenceObject word;
+  ESPPreferenceObject pair;
+};
+
+/// Start the device with the contents of the simulated sector, like after a reset or a power loss.
+static Device boot() {
+  delete[] s_flash_storage;  // NOLINT(cppcoreguidelines-owning-memory)
+  s_flash_dirty = false;
+  memset(s_flash_dirty_words, 0, sizeof(s_flash_dirty_words));
+  s_write_budget = -1;
+  s_power_lost = false;
+
+  Device device{};
+  device.prefs = new ESP8266Preferences();  // NOLINT(cppcoreguidelines-owning-memory)
+  device.prefs->setup();
+  device.word = device.prefs->make_preference(sizeof(uint32_t), 1, true);
+  device.pair = device.prefs->make_preference(sizeof(Pair), 2, true);
+  return device;
+}
+
+/// Start with an erased sector.
+static Device boot_erased() {
+  memset(s_sector, 0xFF, sizeof(s_sector));
+  s_erases = 0;
+  return boot();
+}
+
+static uint32_t load_word(Device &device) {
+  uint32_t value = 0;
+  EXPECT_TRUE(device.word.load(&value));
+  return value;
+}
+
+HOST_TEST(esp8266_preferences_journal) {
+  Device device = boot_erased();
+  uint32_t value;
+  EXPECT_TRUE(!device.word.load(&value));
+
+  // Only the changed words are appended to the journal, the sector isn't erased
+  uint32_t word = 1;
+  EXPECT_TRUE(device.word.save(&word));
+  EXPECT_TRUE(device.prefs->sync());
+  EXPECT_EQ(s_journal_pos, 2u);
+  word = 2;
+  EXPECT_TRUE(device.word.save(&word));
+  EXPECT_TRUE(device.prefs->sync());
+  EXPECT_EQ(s_journal_pos, 4u);
+  // Saving the same value again writes nothing
+  EXPECT_TRUE(device.word.save(&word));
+  EXPECT_TRUE(device.prefs->sync());
+  EXPECT_EQ(s_journal_pos, 4u);
+  EXPECT_EQ(s_erases, 0u);
+
+  device = boot();
+  EXPECT_EQ(load_word(device), 2u);
+  EXPECT_TRUE(!device.pair.load(&value));
+  EXPECT_EQ(s_journal_pos, 4u);
+}
+
+HOST_TEST(esp8266_preferences_torn_value) {
+  Device device = boot_erased();
+  uint32_t word = 1;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+
+  // The power is lost while the value of the first record is programmed
+  word = 2;
+  device.word.save(&word);
+  s_write_budget = 2;
+  EXPECT_TRUE(!device.prefs->sync());
+
+  device = boot();
+  EXPECT_EQ(load_word(device), 1u);
+  // The torn record is skipped and never reused
+  EXPECT_EQ(s_journal_pos, 3u);
+  word = 3;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+  device = boot();
+  EXPECT_EQ(load_word(device), 3u);
+  EXPECT_EQ(s_journal_pos, 5u);
+}
+
+HOST_TEST(esp8266_preferences_torn_header) {
+  Device device = boot_erased();
+  uint32_t word = 1;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+
+  // The value of the first record is written, the power is lost while its header is programmed
+  word = 2;
+  device.word.save(&word);
+  s_write_budget = 4 + 1;
+  EXPECT_TRUE(!device.prefs->sync());
+
+  device = boot();
+  EXPECT_EQ(load_word(device), 1u);
+  EXPECT_EQ(s_journal_pos, 3u);
+  word = 3;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+  device = boot();
+  EXPECT_EQ(load_word(device), 3u);
+}
+
+HOST_TEST(esp8266_preferences_torn_between_records) {
+  Device device = boot_erased();
+  Pair pair{1, 2};
+  device.pair.save(&pair);
+  EXPECT_TRUE(device.prefs->sync());
+
+  // Only the first of the three records (first, second and crc) is written: the crc rejects the mixed value
+  pair = Pair{3, 4};
+  device.pair.save(&pair);
+  s_write_budget = 8;
+  EXPECT_TRUE(!device.prefs->sync());
+
+  device = boot();
+  EXPECT_TRUE(!device.pair.load(&pair));
+  pair = Pair{5, 6};
+  device.pair.save(&pair);
+  EXPECT_TRUE(device.prefs->sync());
+  device = boot();
+  EXPECT_TRUE(device.pair.load(&pair));
+  EXPECT_EQ(pair.first, 5u);
+  EXPECT_EQ(pair.second, 6u);
+}
+
+HOST_TEST(esp8266_preferences_compaction) {
+  Device device = boot_erased();
+  Pair pair{100, 200};
+  device.pair.save(&pair);
+  EXPECT_TRUE(device.prefs->sync());
+
+  // Every sync appends two records (the word and its crc) until the journal is full
+  uint32_t word = 0;
+  while (s_erases == 0 && word < 1000) {
+    word++;
+    device.word.save(&word);
+    EXPECT_TRUE(device.prefs->sync());
+  }
+  EXPECT_EQ(s_erases, 1u);
+  EXPECT_EQ(word, (ESP8266_JOURNAL_SLOTS - 3) / 2 + 1);
+  EXPECT_EQ(s_journal_pos, 0u);
+
+  // The new snapshot holds all preferences and the journal starts over
+  device = boot();
+  EXPECT_EQ(load_word(device), word);
+  EXPECT_TRUE(device.pair.load(&pair));
+  EXPECT_EQ(pair.first, 100u);
+  EXPECT_EQ(pair.second, 200u);
+  word++;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+  EXPECT_EQ(s_erases, 1u);
+  device = boot();
+  EXPECT_EQ(load_word(device), word);
+  EXPECT_EQ(s_journal_pos, 2u);
+}
+
+HOST_TEST(esp8266_preferences_foreign_data) {
+  // A sector that other firmware left without an erased journal is compacted by the first sync
+  memset(s_sector, 0x5A, sizeof(s_sector));
+  s_erases = 0;
+  Device device = boot();
+  uint32_t word = 7;
+  device.word.save(&word);
+  EXPECT_TRUE(device.prefs->sync());
+  EXPECT_EQ(s_erases, 1u);
+  device = boot();
+  EXPECT_EQ(load_word(device), 7u);
+}
+
+}  // namespace esp8266
+}  // namespace esphome
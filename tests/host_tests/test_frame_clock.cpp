@@ -0,0 +1,209 @@
+// Tests of the frame clock: when frames are rendered and shown, and how missed frames and transfer times are counted.
+//
+// host_test sources: esphome/components/frame_clock/frame_clock.cpp
+// host_test sources: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// host_test sources: esphome/components/light/esp_range_view.cpp esphome/components/light/esp_hsv_color.cpp
+// host_test sources: esphome/components/light/light_output.cpp esphome/components/light/light_state.cpp
+// host_test sources: esphome/components/light/light_call.cpp esphome/core/entity_base.cpp
+// host_test sources: esphome/core/color.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test sources: esphome/components/sensor/sensor.cpp esphome/components/sensor/filter.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/frame_clock/frame_clock.h"
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace frame_clock {
+
+class TestLight : public light::AddressableLight {
+ public:
+  int32_t size() const override { return 1; }
+  void clear_effect_data() override {}
+  light::LightTraits get_traits() override { return {}; }
+  void write_state(light::LightState *state) override {
+    this->writes++;
+    this->shown_at = micros();
+    host_test::advance_micros(this->show_time_us);
+  }
+  bool is_show_done() override { return this->done; }
+
+  int writes{0};
+  uint32_t shown_at{0};
+  /// How long write_state() takes, like outputs that send while showing.
+  uint32_t show_time_us{0};
+  /// Whether the output finished sending, outputs that send in the background are busy for a while.
+  bool done{true};
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    return light::ESPColorView(&this->pixel_[0], &this->pixel_[1], &this->pixel_[2], nullptr, nullptr,
+                               &this->correction_);
+  }
+
+  mutable uint8_t pixel_[3]{};
+};
+
+class TestFrameClock : public FrameClock {
+ public:
+  uint32_t next_frame_us() const { return this->next_frame_us_; }
+  bool transfer_active() const { return this->transfer_active_; }
+};
+
+/// Two lights on a 50 FPS frame clock, which rendered the first frame at 1 s.
+class FrameClockTest {
+ public:
+  FrameClockTest() : state_a("a", &this->a), state_b("b", &this->b) {
+    this->a.setup_state(&this->state_a);
+    this->b.setup_state(&this->state_b);
+    this->clock.set_fps(50);
+    this->clock.add_light(&this->state_a);
+    this->clock.add_light(&this->state_b);
+    host_test::set_micros(1000000);
+    this->clock.loop();
+  }
+
+  TestLight a;
+  TestLight b;
+  light::AddressableLightState state_a;
+  light::AddressableLightState state_b;
+  TestFrameClock clock;
+};
+
+static const uint32_t FRAME_US = 20000;
+
+HOST_TEST(frame_clock_shows_together) {
+  FrameClockTest test;
+  // The first frame shows both lights at once
+  EXPECT_EQ(test.a.writes, 1);
+  EXPECT_EQ(test.b.writes, 1);
+  EXPECT_EQ(test.a.shown_at, test.b.shown_at);
+
+  // Clocked lights don't write from their own loop
+  test.a.schedule_show();
+  test.state_a.loop();
+  EXPECT_EQ(test.a.writes, 1);
+
+  // Only lights that changed are shown
+  host_test::advance_micros(FRAME_US);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 2);
+  EXPECT_EQ(test.b.writes, 1);
+  EXPECT_EQ(test.clock.get_missed_frames(), 0u);
+}
+
+HOST_TEST(frame_clock_frame_rate) {
+  FrameClockTest test;
+
+  // While idle, no frames are rendered and none are missed
+  host_test::advance_micros(5000000);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 1);
+  EXPECT_EQ(test.clock.get_missed_frames(), 0u);
+
+  // A light changes: rendered right away, then once per frame
+  const uint32_t start = micros();
+  test.a.schedule_show();
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 2);
+  EXPECT_EQ(test.clock.next_frame_us(), start + FRAME_US);
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US / 2);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 2);
+  host_test::advance_micros(FRAME_US / 2);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 3);
+  EXPECT_EQ(test.clock.get_missed_frames(), 0u);
+
+  // A frame that is rendered a bit late doesn't shift the ones after it
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US + 5000);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 4);
+  EXPECT_EQ(test.clock.next_frame_us(), start + 3 * FRAME_US);
+  EXPECT_EQ(test.clock.get_missed_frames(), 0u);
+}
+
+HOST_TEST(frame_clock_skipped_frames) {
+  FrameClockTest test;
+  const uint32_t start = micros();
+
+  // The loop stalled for 3.5 frames: the two frames in between are missed and skipped, and the clock keeps its phase
+  test.a.schedule_show();
+  test.b.schedule_show();
+  host_test::advance_micros(3 * FRAME_US + FRAME_US / 2);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 2);
+  EXPECT_EQ(test.b.writes, 2);
+  EXPECT_EQ(test.clock.get_missed_frames(), 2u);
+  EXPECT_EQ(test.clock.next_frame_us(), start + 4 * FRAME_US);
+
+  // Exactly one frame late: that frame is skipped, the current one is rendered
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US / 2 + FRAME_US);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 3);
+  EXPECT_EQ(test.clock.get_missed_frames(), 3u);
+  EXPECT_EQ(test.clock.next_frame_us(), start + 6 * FRAME_US);
+}
+
+HOST_TEST(frame_clock_busy_outputs) {
+  FrameClockTest test;
+
+  // An output that sends in the background is still busy when the next frame is due
+  test.a.done = false;
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US);
+  const uint32_t shown = micros();
+  test.clock.loop();
+  EXPECT_TRUE(test.clock.transfer_active());
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US);
+  test.clock.loop();
+  EXPECT_EQ(test.a.writes, 3);
+  EXPECT_EQ(test.clock.get_missed_frames(), 1u);
+
+  // Frames without changes don't count while the output is busy
+  host_test::advance_micros(FRAME_US);
+  test.clock.loop();
+  EXPECT_TRUE(test.clock.transfer_active());
+  EXPECT_EQ(test.clock.get_missed_frames(), 1u);
+
+  // The transfer time runs from showing the last frame until the output is done
+  test.a.done = true;
+  host_test::advance_micros(3000);
+  test.clock.loop();
+  EXPECT_TRUE(!test.clock.transfer_active());
+  EXPECT_EQ(test.clock.get_transfer_time_us(), micros() - (shown + FRAME_US));
+  EXPECT_EQ(test.clock.get_missed_frames(), 1u);
+}
+
+HOST_TEST(frame_clock_slow_show) {
+  FrameClockTest test;
+
+  // Outputs that send while showing are done once show() returns, so the transfer time is the time to show
+  test.a.show_time_us = 4000;
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US);
+  test.clock.loop();
+  EXPECT_TRUE(!test.clock.transfer_active());
+  EXPECT_EQ(test.clock.get_transfer_time_us(), 4000u);
+  EXPECT_EQ(test.clock.get_missed_frames(), 0u);
+
+  // Showing that takes longer than a frame misses it
+  test.a.show_time_us = FRAME_US + 1000;
+  test.a.schedule_show();
+  host_test::advance_micros(FRAME_US - 4000);
+  test.clock.loop();
+  EXPECT_EQ(test.clock.get_missed_frames(), 1u);
+}
+
+}  // namespace frame_clock
+}  // namespace esphome
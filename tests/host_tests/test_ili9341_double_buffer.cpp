@@ -0,0 +1,260 @@
+// Tests of the ILI9341 double buffer and asynchronous SPI writes, on an emulated panel that decodes the bytes on the
+// bus: swapping the buffers, copying the dirty window back, drawing a frame while the last one is still being sent and
+// other devices claiming the bus in the middle of a transfer.
+//
+// The bus uses the hardware SPI backend with the stub SPIClass of tests/host_tests/include/SPI.h, bit-banging waits
+// for the cycle counter, which doesn't move on the fake clock.
+//
+// host_test sources: esphome/components/spi/spi.cpp esphome/components/ili9341/ili9341_display.cpp
+// host_test sources: esphome/components/display/display_buffer.cpp esphome/core/color.cpp
+// host_test sources: esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test flags: -DUSE_SPI_ARDUINO_BACKEND
+
+#include "host_test.h"
+
+#include "esphome/components/ili9341/ili9341_display.h"
+
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace esphome {
+
+// Only referenced by the text and graph functions of DisplayBuffer, which these tests don't use
+size_t time::ESPTime::strftime(char *buffer, size_t buffer_len, const char *format) { return 0; }
+void graph::Graph::draw(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+void graph::Graph::draw_legend(display::DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {}
+
+namespace ili9341 {
+
+static const int WIDTH = 320;
+static const int HEIGHT = 240;
+
+/// The panel RAM behind the bus: takes the column and row address set commands and writes the RAM write data.
+class Panel : public SPIClass {
+ public:
+  std::vector<uint16_t> ram = std::vector<uint16_t>(WIDTH * HEIGHT, 0);
+  bool dc{false};
+  bool cs{true};
+  /// Bytes sent while the chip select was high or pixels outside of the address window.
+  int errors{0};
+
+  void write(uint8_t data) override {
+    if (this->cs) {
+      this->errors++;
+      return;
+    }
+    if (!this->dc) {
+      this->command_ = data;
+      this->arg_ = 0;
+      this->column_ = this->x1_;
+      this->row_ = this->y1_;
+      return;
+    }
+    switch (this->command_) {
+      case ILI9341_CASET:
+        set_arg_(this->arg_++, &this->x1_, &this->x2_, data);
+        break;
+      case ILI9341_PASET:
+        set_arg_(this->arg_++, &this->y1_, &this->y2_, data);
+        break;
+      case ILI9341_RAMWR:
+        if (this->arg_++ % 2 == 0) {
+          this->high_ = data;
+          break;
+        }
+        if (this->row_ > this->y2_ || this->column_ >= WIDTH || this->row_ >= HEIGHT) {
+          this->errors++;
+          break;
+        }
+        this->ram[this->row_ * WIDTH + this->column_] = this->high_ << 8 | data;
+        if (++this->column_ > this->x2_) {
+          this->column_ = this->x1_;
+          this->row_++;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+ protected:
+  static void set_arg_(int arg, uint16_t *first, uint16_t *last, uint8_t data) {
+    uint16_t *value = arg < 2 ? first : last;
+    *value = arg % 2 == 0 ? data << 8 : (*value & 0xFF00) | data;
+  }
+
+  uint8_t command_{0};
+  int arg_{0};
+  uint16_t x1_{0}, x2_{0}, y1_{0}, y2_{0};
+  uint16_t column_{0}, row_{0};
+  uint8_t high_{0};
+};
+
+/// Drives a level of the panel, the chip select and data/command pins.
+class PanelPin : public GPIOPin {
+ public:
+  explicit PanelPin(bool *level) : level_(level) {}
+  void setup() override {}
+  void pin_mode(gpio::Flags flags) override {}
+  bool digital_read() override { return *this->level_; }
+  void digital_write(bool value) override { *this->level_ = value; }
+  std::string dump_summary() const override { return "panel"; }
+
+ protected:
+  bool *level_;
+};
+
+class TestBus : public spi::SPIComponent {
+ public:
+  explicit TestBus(SPIClass *spi) { this->hw_spi_ = spi; }
+
+  /// Run loop() until the asynchronous writes are done, returns the number of calls.
+  int run() {
+    int calls = 0;
+    while (this->is_async_write_active() && calls < 1000) {
+      this->loop();
+      calls++;
+    }
+    return calls;
+  }
+};
+
+class TestDisplay : public ILI9341M5Stack {
+ public:
+  uint8_t *back() { return this->buffer_; }
+  uint8_t *front() { return this->front_buffer_; }
+  /// The buffer whose content was sent to the panel.
+  uint8_t *sent() { return this->front_buffer_ != nullptr ? this->front_buffer_ : this->buffer_; }
+  uint16_t color(uint8_t color332) { return this->convert_to_16bit_color_(color332); }
+};
+
+/// A display on an emulated panel, drawing `frame` with the writer.
+struct Setup {
+  Panel panel;
+  PanelPin cs{&panel.cs};
+  PanelPin dc{&panel.dc};
+  TestBus bus{&panel};
+  TestDisplay display;
+  int frame{0};
+
+  Setup(bool double_buffer, bool auto_clear, std::function<void(display::DisplayBuffer &, int)> &&draw) {
+    this->display.set_spi_parent(&this->bus);
+    this->display.set_cs_pin(&this->cs);
+    this->display.set_dc_pin(&this->dc);
+    this->display.set_double_buffer(double_buffer);
+    this->display.set_auto_clear(auto_clear);
+    this->display.set_writer([this, draw](display::DisplayBuffer &it) { draw(it, this->frame); });
+    this->display.setup();
+  }
+
+  void update(int frame) {
+    this->frame = frame;
+    this->display.update();
+  }
+
+  /// Pixels of the panel that differ from the buffer that was sent.
+  int mismatches() {
+    int count = 0;
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      if (this->panel.ram[i] != this->display.color(this->display.sent()[i]))
+        count++;
+    }
+    return count;
+  }
+};
+
+static const Color RED(255, 0, 0);
+static const Color BLUE(0, 0, 255);
+
+/// A rectangle that moves with every frame, and a bar that grows.
+static void draw_moving(display::DisplayBuffer &it, int frame) {
+  it.filled_rectangle(10 + frame * 7, 20 + frame * 3, 40, 30, RED);
+  it.filled_rectangle(0, HEIGHT - 10, 20 + frame * 11, 10, BLUE);
+}
+
+HOST_TEST(ili9341_double_buffer_swap) {
+  // Inside the red rectangle of frame 1
+  const int red_pixel = 30 * WIDTH + 20;
+  Setup setup(true, true, draw_moving);
+  EXPECT_TRUE(setup.display.front() != nullptr);
+  uint8_t *drawn = setup.display.back();
+  setup.update(1);
+
+  // The frame that was drawn is sent, drawing continues on a copy of it
+  EXPECT_TRUE(setup.display.front() == drawn);
+  EXPECT_TRUE(setup.display.back() != drawn);
+  EXPECT_EQ(memcmp(setup.display.back(), setup.display.front(), WIDTH * HEIGHT), 0);
+  EXPECT_TRUE(setup.bus.is_async_write_active());
+  // Only the address window was set, the pixels are sent from loop()
+  EXPECT_EQ(setup.panel.ram[red_pixel], 0);
+
+  EXPECT_TRUE(setup.bus.run() > 1);
+  EXPECT_TRUE(!setup.bus.is_async_write_active());
+  EXPECT_EQ(setup.mismatches(), 0);
+  EXPECT_EQ(setup.panel.ram[red_pixel], setup.display.color(setup.display.front()[red_pixel]));
+  EXPECT_TRUE(setup.panel.ram[red_pixel] != 0);
+  EXPECT_EQ(setup.panel.errors, 0);
+}
+
+HOST_TEST(ili9341_double_buffer_copy_back) {
+  // Without auto clear every frame draws on top of the last ones, the copied back window has to keep them all
+  Setup single(false, false, draw_moving);
+  Setup double_buffered(true, false, draw_moving);
+  for (int frame = 0; frame < 20; frame++) {
+    single.update(frame);
+    double_buffered.update(frame);
+    // Run only part of the transfer in some frames, the next frame then waits for it
+    if (frame % 3 != 0)
+      double_buffered.bus.run();
+    else
+      double_buffered.bus.loop();
+  }
+  double_buffered.bus.run();
+
+  EXPECT_EQ(single.mismatches(), 0);
+  EXPECT_EQ(double_buffered.mismatches(), 0);
+  EXPECT_TRUE(single.panel.ram == double_buffered.panel.ram);
+  EXPECT_EQ(memcmp(double_buffered.display.back(), double_buffered.display.front(), WIDTH * HEIGHT), 0);
+  EXPECT_EQ(double_buffered.panel.errors, 0);
+}
+
+HOST_TEST(ili9341_double_buffer_frame_while_pending) {
+  Setup setup(true, true, [](display::DisplayBuffer &it, int frame) {
+    it.filled_rectangle(0, 0, WIDTH, HEIGHT, frame == 1 ? RED : BLUE);
+  });
+  setup.update(1);
+  setup.bus.loop();
+  EXPECT_TRUE(setup.bus.is_async_write_active());
+  std::vector<uint8_t> first(setup.display.front(), setup.display.front() + WIDTH * HEIGHT);
+
+  // The next frame is drawn into the back buffer, the one that's being sent stays untouched
+  setup.update(2);
+  EXPECT_TRUE(setup.bus.is_async_write_active());
+  EXPECT_EQ(memcmp(setup.display.front(), first.data(), WIDTH * HEIGHT), 0);
+  EXPECT_TRUE(setup.display.back()[0] != first[0]);
+
+  // It is swapped in and sent as soon as the first transfer is done
+  setup.bus.run();
+  EXPECT_TRUE(setup.display.front()[0] != first[0]);
+  EXPECT_EQ(setup.mismatches(), 0);
+  EXPECT_EQ(setup.panel.errors, 0);
+}
+
+HOST_TEST(ili9341_double_buffer_other_device) {
+  Setup setup(true, true, draw_moving);
+  setup.update(1);
+  EXPECT_TRUE(setup.bus.is_async_write_active());
+
+  // Another device on the bus first waits for the transfer to finish
+  spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_1MHZ>
+      other(&setup.bus, nullptr);
+  other.enable();
+  EXPECT_TRUE(!setup.bus.is_async_write_active());
+  other.disable();
+  EXPECT_EQ(setup.mismatches(), 0);
+  EXPECT_EQ(setup.panel.errors, 0);
+}
+
+}  // namespace ili9341
+}  // namespace esphome
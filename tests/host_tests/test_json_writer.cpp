@@ -0,0 +1,185 @@
+// Tests of json::JsonWriter, the streaming writer for state documents, and of the light state document that
+// LightJSONSchema::dump_json() writes with it for MQTT and the web server.
+//
+// host_test sources: esphome/components/json/json_writer.cpp esphome/components/light/light_json_schema.cpp
+// host_test sources: esphome/components/light/light_state.cpp esphome/components/light/light_call.cpp
+// host_test sources: esphome/components/light/light_output.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test sources: esphome/core/entity_base.cpp
+// host_test flags: -DUSE_JSON
+
+#include "host_test.h"
+
+#include "esphome/components/json/json_writer.h"
+#include "esphome/components/light/light_json_schema.h"
+#include "esphome/components/light/light_output.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace json {
+
+HOST_TEST(json_writer_values) {
+  std::string json = write_json([](JsonWriter &root) {
+    root.add("id", "sensor-temperature");
+    root.add("state", "21.5 °C");
+    root.add("value", 21.5f);
+    root.add("on", true);
+    root.add("off", false);
+    root.add("int", -5);
+    root.add("unsigned", 4000000000UL);
+    root.add("long", -2147483647L - 1);
+  });
+
+  EXPECT_EQ(json, std::string(R"({"id":"sensor-temperature","state":"21.5 °C","value":21.5,"on":true,"off":false,)"
+                              R"("int":-5,"unsigned":4000000000,"long":-2147483648})"));
+}
+
+HOST_TEST(json_writer_floats) {
+  std::string json = write_json([](JsonWriter &root) {
+    root.add("nan", NAN);
+    root.add("inf", INFINITY);
+    root.add("-inf", -INFINITY);
+    root.add("zero", 0.0f);
+    root.add("small", 0.001f);
+    root.add("precision", 1.2345678f);
+    root.add("double", 0.25);
+  });
+
+  EXPECT_EQ(json, std::string(R"({"nan":NaN,"inf":Infinity,"-inf":-Infinity,"zero":0,"small":0.001,)"
+                              R"("precision":1.234568,"double":0.25})"));
+}
+
+HOST_TEST(json_writer_escapes_strings) {
+  std::string json = write_json([](JsonWriter &root) {
+    root.add("quote\"key", "a\"b\\c");
+    root.add("controls", "\b\f\n\r\t\x01\x1f");
+    root.add("embedded", std::string("a\0b", 3));
+  });
+
+  EXPECT_EQ(json, std::string(R"({"quote\"key":"a\"b\\c","controls":"\b\f\n\r\t\u0001\u001f",)"
+                              R"("embedded":"a\u0000b"})"));
+}
+
+HOST_TEST(json_writer_nesting) {
+  std::string json = write_json([](JsonWriter &root) {
+    root.begin_object("color");
+    root.add("r", 255u);
+    root.add("g", 0u);
+    root.end_object();
+    root.begin_array("effects");
+    root.add_value("None");
+    root.add_value(std::string("Rainbow"));
+    root.end_array();
+    root.begin_object("empty");
+    root.end_object();
+    root.begin_array("none");
+    root.end_array();
+    root.begin_object("outer");
+    root.begin_object("inner");
+    root.add("x", 1);
+    root.end_object();
+    root.add("y", 2);
+    root.end_object();
+    root.add("last", "z");
+  });
+
+  EXPECT_EQ(json, std::string(R"({"color":{"r":255,"g":0},"effects":["None","Rainbow"],"empty":{},"none":[],)"
+                              R"("outer":{"inner":{"x":1},"y":2},"last":"z"})"));
+}
+
+HOST_TEST(json_writer_reused_buffer) {
+  size_t length;
+  const char *first = write_json([](JsonWriter &root) { root.add("a", 1); }, &length);
+  EXPECT_EQ(std::string(first, length), std::string(R"({"a":1})"));
+  EXPECT_EQ(strlen(first), length);
+
+  const char *second = write_json([](JsonWriter &root) { root.add("b", "c"); }, &length);
+  EXPECT_EQ(std::string(second, length), std::string(R"({"b":"c"})"));
+}
+
+HOST_TEST(json_writer_fixed_buffer) {
+  const auto f = [](JsonWriter &root) { root.add("abcdef", "ghijkl"); };
+  const std::string expected = R"({"abcdef":"ghijkl"})";
+
+  char large[64];
+  EXPECT_EQ(write_json(large, sizeof(large), f), expected.size());
+  EXPECT_EQ(std::string(large), expected);
+
+  // Truncated and null terminated like snprintf(), the length is still the one of the whole document
+  char small[10];
+  memset(small, 'x', sizeof(small));
+  EXPECT_EQ(write_json(small, sizeof(small), f), expected.size());
+  EXPECT_EQ(std::string(small), expected.substr(0, sizeof(small) - 1));
+
+  char exact[20];
+  EXPECT_EQ(write_json(exact, sizeof(exact), f), expected.size());
+  EXPECT_EQ(std::string(exact), expected.substr(0, sizeof(exact) - 1));
+
+  char one = 'x';
+  EXPECT_EQ(write_json(&one, 1, f), expected.size());
+  EXPECT_EQ(one, '\0');
+
+  EXPECT_EQ(write_json(nullptr, 0, f), expected.size());
+}
+
+
+/// A count of how often a key occurs in a document, JsonWriter writes every key it is given.
+static int key_count(const std::string &json, const char *key) {
+  const std::string quoted = std::string("\"") + key + "\":";
+  int count = 0;
+  for (size_t pos = json.find(quoted); pos != std::string::npos; pos = json.find(quoted, pos + 1))
+    count++;
+  return count;
+}
+
+class TestLightOutput : public light::LightOutput {
+ public:
+  light::LightTraits get_traits() override {
+    light::LightTraits traits;
+    traits.set_supported_color_modes({light::ColorMode::RGB});
+    return traits;
+  }
+  void write_state(light::LightState *state) override {}
+};
+
+/// The document of light_json() in the web server.
+static std::string web_server_light_json(light::LightState &light) {
+  return write_json([&light](JsonWriter &root) {
+    root.add("id", "light-" + light.get_object_id());
+    light::LightJSONSchema::dump_json(light, root);
+  });
+}
+
+HOST_TEST(json_writer_light_state) {
+  TestLightOutput output;
+  light::LightState light("kitchen", &output);
+  light.remote_values.set_color_mode(light::ColorMode::RGB);
+  light.remote_values.set_state(true);
+  light.remote_values.set_brightness(1.0f);
+  light.remote_values.set_color_brightness(1.0f);
+  light.remote_values.set_red(1.0f);
+  light.remote_values.set_green(0.0f);
+  light.remote_values.set_blue(0.0f);
+
+  const std::string json = web_server_light_json(light);
+  EXPECT_EQ(json, std::string(R"({"id":"light-kitchen","color_mode":"rgb","state":"ON","brightness":255,)"
+                              R"("color":{"r":255,"g":0,"b":0}})"));
+  EXPECT_EQ(key_count(json, "state"), 1);
+
+  // Lights whose color mode isn't known yet still report their state, exactly once
+  light.remote_values.set_color_mode(light::ColorMode::UNKNOWN);
+  light.remote_values.set_state(false);
+  const std::string unknown = web_server_light_json(light);
+  EXPECT_EQ(unknown, std::string(R"({"id":"light-kitchen","state":"OFF","color":{}})"));
+  EXPECT_EQ(key_count(unknown, "state"), 1);
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,214 @@
+// Tests of logger::LogRingBuffer, the ring of log records behind logger: async_buffer_size: order, wrapping around
+// the end of the ring, padding, dropped records and producers on several threads.
+//
+// host_test sources: esphome/components/logger/log_ring_buffer.cpp
+// host_test flags: -DUSE_LOGGER_ASYNC
+
+#include "host_test.h"
+
+#include "esphome/components/logger/log_ring_buffer.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace esphome {
+namespace logger {
+
+class TestRing : public LogRingBuffer {
+ public:
+  /// Offset of a record from the start of the ring.
+  size_t offset(Record *record) const { return reinterpret_cast<uint8_t *>(record) - this->data_; }
+};
+
+/// Text length that makes a record occupy exactly `size` bytes of the ring.
+static size_t text_for_size(size_t size) { return size - sizeof(LogRingBuffer::Record) - 1; }
+
+static LogRingBuffer::Record *push(LogRingBuffer &ring, const std::string &text) {
+  auto *record = ring.reserve(text.size());
+  if (record == nullptr)
+    return nullptr;
+  memcpy(record->text(), text.c_str(), text.size() + 1);
+  ring.publish(record);
+  return record;
+}
+
+static std::string pop(LogRingBuffer &ring) {
+  auto *record = ring.peek();
+  if (record == nullptr)
+    return "<none>";
+  std::string text(record->text(), record->text_len);
+  ring.release(record);
+  return text;
+}
+
+HOST_TEST(log_ring_buffer_init) {
+  TestRing ring;
+  EXPECT_TRUE(!ring.init(sizeof(LogRingBuffer::Record)));
+  EXPECT_TRUE(!ring.is_initialized());
+  EXPECT_TRUE(ring.init(300));
+  EXPECT_EQ(ring.get_size(), 256u);
+  // A record may take at most half of the ring
+  EXPECT_TRUE(ring.reserve(text_for_size(128)) != nullptr);
+  EXPECT_TRUE(ring.reserve(text_for_size(128) + 1) == nullptr);
+}
+
+HOST_TEST(log_ring_buffer_wraps_around) {
+  TestRing ring;
+  ring.init(256);
+  // Records of all sizes, with the consumer a few records behind, wrap around the end of the ring many times
+  int pushed = 0, popped = 0;
+  for (int round = 0; round < 1000; round++) {
+    std::string text = std::to_string(pushed) + std::string(round % 50, 'x');
+    if (push(ring, text) != nullptr) {
+      pushed++;
+    } else {
+      EXPECT_TRUE(ring.peek() != nullptr);
+    }
+    if (round % 3 != 0 && popped < pushed) {
+      std::string expected = std::to_string(popped);
+      EXPECT_EQ(pop(ring).substr(0, expected.size()), expected);
+      popped++;
+    }
+  }
+  while (popped < pushed) {
+    EXPECT_EQ(pop(ring).substr(0, std::to_string(popped).size()), std::to_string(popped));
+    popped++;
+  }
+  EXPECT_TRUE(pushed > 500);
+  EXPECT_TRUE(ring.peek() == nullptr);
+}
+
+HOST_TEST(log_ring_buffer_padding) {
+  TestRing ring;
+  ring.init(256);
+  for (int i = 0; i < 3; i++)
+    push(ring, std::string(text_for_size(64), 'a'));
+  for (int i = 0; i < 3; i++)
+    pop(ring);
+
+  // 64 bytes are left before the end, a padding record fills them and the record starts at the beginning
+  auto *record = push(ring, std::string(text_for_size(96), 'b'));
+  EXPECT_EQ(ring.offset(record), 0u);
+  EXPECT_EQ(pop(ring), std::string(text_for_size(96), 'b'));
+  EXPECT_TRUE(ring.peek() == nullptr);
+
+  // The rest of the ring is free again: 160 bytes up to the end and the 96 bytes of the record
+  EXPECT_TRUE(push(ring, std::string(text_for_size(128), 'c')) != nullptr);
+  EXPECT_TRUE(push(ring, std::string(text_for_size(32), 'd')) != nullptr);
+  EXPECT_TRUE(push(ring, std::string(text_for_size(96), 'e')) != nullptr);
+  EXPECT_TRUE(ring.reserve(0) == nullptr);
+  EXPECT_EQ(pop(ring), std::string(text_for_size(128), 'c'));
+  EXPECT_EQ(pop(ring), std::string(text_for_size(32), 'd'));
+  EXPECT_EQ(pop(ring), std::string(text_for_size(96), 'e'));
+}
+
+HOST_TEST(log_ring_buffer_padding_without_header) {
+  TestRing ring;
+  ring.init(256);
+  // Leave a gap before the end that is too small for a record header
+  const size_t gap = 16;
+  EXPECT_TRUE(gap < sizeof(LogRingBuffer::Record));
+  push(ring, std::string(text_for_size(128), 'a'));
+  push(ring, std::string(text_for_size(128 - gap), 'b'));
+  pop(ring);
+  pop(ring);
+
+  auto *record = push(ring, std::string(text_for_size(64), 'c'));
+  EXPECT_EQ(ring.offset(record), 0u);
+  EXPECT_EQ(pop(ring), std::string(text_for_size(64), 'c'));
+  EXPECT_TRUE(ring.peek() == nullptr);
+}
+
+HOST_TEST(log_ring_buffer_unpublished) {
+  TestRing ring;
+  ring.init(256);
+  push(ring, "first");
+  auto *pending = ring.reserve(6);
+  push(ring, "third");
+
+  // The consumer stops at a record that is still being written, even if later ones are ready
+  EXPECT_EQ(pop(ring), std::string("first"));
+  EXPECT_TRUE(ring.peek() == nullptr);
+  memcpy(pending->text(), "second", 7);
+  ring.publish(pending);
+  EXPECT_EQ(pop(ring), std::string("second"));
+  EXPECT_EQ(pop(ring), std::string("third"));
+}
+
+HOST_TEST(log_ring_buffer_dropped) {
+  TestRing ring;
+  ring.init(256);
+  int pushed = 0;
+  while (push(ring, std::string(text_for_size(32), 'a')) != nullptr)
+    pushed++;
+  EXPECT_EQ(pushed, 8);
+  ring.add_dropped();
+  ring.add_dropped();
+  EXPECT_EQ(ring.take_dropped(), 2u);
+  EXPECT_EQ(ring.take_dropped(), 0u);
+
+  // Releasing a record makes room for exactly one more
+  pop(ring);
+  EXPECT_TRUE(push(ring, std::string(text_for_size(32), 'b')) != nullptr);
+  EXPECT_TRUE(push(ring, std::string(text_for_size(32), 'b')) == nullptr);
+}
+
+HOST_TEST(log_ring_buffer_concurrent_producers) {
+  TestRing ring;
+  ring.init(1024);
+  const int producers = 4;
+  const int messages = 20000;
+  std::atomic<int> finished{0};
+
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < producers; producer++) {
+    threads.emplace_back([&ring, &finished, producer, messages]() {
+      for (int i = 0; i < messages; i++) {
+        std::string text = std::to_string(producer) + ":" + std::to_string(i) + std::string(i % 40, '.');
+        if (push(ring, text) == nullptr)
+          ring.add_dropped();
+      }
+      finished++;
+    });
+  }
+
+  // Every producer's messages arrive complete and in order, the ones that didn't fit are counted as dropped
+  std::vector<int> next(producers, 0);
+  int received = 0;
+  uint32_t dropped = 0;
+  bool ok = true;
+  while (true) {
+    const bool done = finished == producers;
+    auto *record = ring.peek();
+    if (record == nullptr) {
+      if (done)
+        break;
+      std::this_thread::yield();
+      continue;
+    }
+    int producer, seq, length;
+    if (sscanf(record->text(), "%d:%d%n", &producer, &seq, &length) != 2 || producer < 0 || producer >= producers ||
+        seq < next[producer] || record->text_len != strlen(record->text()) ||
+        record->text_len != static_cast<size_t>(length + seq % 40)) {
+      ok = false;
+    } else {
+      next[producer] = seq + 1;
+    }
+    received++;
+    ring.release(record);
+    dropped += ring.take_dropped();
+  }
+  for (auto &thread : threads)
+    thread.join();
+  dropped += ring.take_dropped();
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(received + dropped, static_cast<uint32_t>(producers * messages));
+  EXPECT_TRUE(received > 0);
+}
+
+}  // namespace logger
+}  // namespace esphome
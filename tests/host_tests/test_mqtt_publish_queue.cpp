@@ -0,0 +1,146 @@
+// Tests of mqtt::MQTTPublishQueue with a fake client whose TCP window only takes a limited number of publishes: order,
+// coalescing, the memory cap and what is kept across a reconnect.
+//
+// host_test sources: esphome/components/mqtt/mqtt_publish_queue.cpp
+// host_test flags: -DUSE_MQTT
+
+#include "host_test.h"
+
+#include "esphome/components/mqtt/mqtt_publish_queue.h"
+#include "esphome/core/hal.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/// Accepts `room` more publishes, like AsyncMqttClient until its TCP window is full.
+struct FakeClient {
+  int room{0};
+  std::vector<std::string> sent;
+
+  bool publish(const std::string &topic, const std::string &payload) {
+    if (this->room == 0)
+      return false;
+    this->room--;
+    this->sent.push_back(topic + "=" + payload);
+    return true;
+  }
+};
+
+/// Publish like MQTTClientComponent::publish(): directly while nothing is queued, otherwise behind the queue.
+static bool publish(FakeClient &client, MQTTPublishQueue &queue, const std::string &topic, const std::string &payload,
+                    uint8_t qos = 0, bool coalesce = true) {
+  if (queue.empty() && client.publish(topic, payload))
+    return true;
+  return queue.push(topic, payload.data(), payload.size(), qos, false, coalesce);
+}
+
+static void flush(FakeClient &client, MQTTPublishQueue &queue) {
+  queue.flush(millis(),
+              [&client](const MQTTQueuedPublish &queued) { return client.publish(queued.topic, queued.payload); });
+}
+
+HOST_TEST(mqtt_publish_queue_order) {
+  FakeClient client;
+  MQTTPublishQueue queue;
+  queue.set_capacity(4096);
+  client.room = 1;
+  EXPECT_TRUE(publish(client, queue, "a", "1"));
+  EXPECT_TRUE(publish(client, queue, "b", "1"));
+  EXPECT_TRUE(publish(client, queue, "c", "1"));
+  // Room in the window doesn't let a new publish pass the queued ones
+  client.room = 1;
+  EXPECT_TRUE(publish(client, queue, "d", "1"));
+  EXPECT_EQ(queue.size(), 3u);
+
+  flush(client, queue);
+  EXPECT_EQ(queue.size(), 2u);
+  client.room = 10;
+  flush(client, queue);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.get_memory(), 0u);
+  const std::vector<std::string> expected{"a=1", "b=1", "c=1", "d=1"};
+  EXPECT_TRUE(client.sent == expected);
+}
+
+HOST_TEST(mqtt_publish_queue_coalesce) {
+  FakeClient client;
+  MQTTPublishQueue queue;
+  queue.set_capacity(4096);
+  publish(client, queue, "state", "1");
+  publish(client, queue, "other", "1");
+  publish(client, queue, "state", "2");
+  publish(client, queue, "state", "3");
+  // Messages that all have to be sent and QoS > 0 publishes are never replaced
+  publish(client, queue, "log", "one", 0, false);
+  publish(client, queue, "log", "two", 0, false);
+  publish(client, queue, "command", "on", 1);
+  publish(client, queue, "command", "off", 1);
+  EXPECT_EQ(queue.size(), 6u);
+
+  client.room = 10;
+  host_test::advance_millis(250);
+  flush(client, queue);
+  const std::vector<std::string> expected{"state=3", "other=1", "log=one", "log=two", "command=on", "command=off"};
+  EXPECT_TRUE(client.sent == expected);
+
+  const auto stats = queue.take_stats();
+  EXPECT_EQ(stats.coalesced, 2u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.max_latency, 250u);
+  EXPECT_EQ(queue.take_stats().coalesced, 0u);
+}
+
+HOST_TEST(mqtt_publish_queue_memory_cap) {
+  FakeClient client;
+  MQTTPublishQueue queue;
+  const size_t one = sizeof(MQTTQueuedPublish) + 2 + 10;
+  queue.set_capacity(3 * one);
+  EXPECT_TRUE(publish(client, queue, "t1", "0123456789"));
+  EXPECT_TRUE(publish(client, queue, "t2", "0123456789"));
+  EXPECT_TRUE(publish(client, queue, "t3", "0123456789"));
+  EXPECT_EQ(queue.get_memory(), 3 * one);
+  EXPECT_TRUE(!publish(client, queue, "t4", "0123456789"));
+  // Replacing a payload may not grow the queue past its capacity either
+  EXPECT_TRUE(!publish(client, queue, "t1", "0123456789-"));
+  EXPECT_TRUE(publish(client, queue, "t1", "012345678"));
+  EXPECT_EQ(queue.get_memory(), 3 * one - 1);
+  EXPECT_EQ(queue.take_stats().dropped, 2u);
+
+  client.room = 1;
+  flush(client, queue);
+  EXPECT_EQ(queue.get_memory(), 2 * one);
+  EXPECT_TRUE(publish(client, queue, "t4", "0123456789"));
+
+  // Without capacity nothing is queued
+  MQTTPublishQueue disabled;
+  EXPECT_TRUE(!publish(client, disabled, "t1", "0"));
+  EXPECT_EQ(disabled.take_stats().dropped, 0u);
+}
+
+HOST_TEST(mqtt_publish_queue_reconnect) {
+  FakeClient client;
+  MQTTPublishQueue queue;
+  queue.set_capacity(4096);
+  publish(client, queue, "state", "1");
+  publish(client, queue, "command", "on", 1);
+  publish(client, queue, "log", "message", 0, false);
+  publish(client, queue, "confirm", "yes", 2);
+
+  // The QoS 0 publishes are dropped when the connection is lost, the others are sent after reconnecting
+  EXPECT_EQ(queue.drop_qos0(), 2u);
+  EXPECT_EQ(queue.size(), 2u);
+  EXPECT_EQ(queue.get_memory(), 2 * sizeof(MQTTQueuedPublish) + 7 + 2 + 7 + 3);
+  EXPECT_EQ(queue.take_stats().dropped, 2u);
+
+  client.room = 10;
+  EXPECT_TRUE(publish(client, queue, "state", "2"));
+  flush(client, queue);
+  const std::vector<std::string> expected{"command=on", "confirm=yes", "state=2"};
+  EXPECT_TRUE(client.sent == expected);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
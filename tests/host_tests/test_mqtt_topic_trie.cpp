@@ -0,0 +1,187 @@
+// Tests of the MQTT subscription topic trie.
+//
+// host_test sources: esphome/components/mqtt/mqtt_topic_trie.cpp
+// host_test flags: -DUSE_MQTT
+
+#include "host_test.h"
+
+#include "esphome/components/mqtt/mqtt_topic_trie.h"
+
+#include <random>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+static std::vector<uint16_t> match(MQTTTopicTrie &trie, const std::string &topic) {
+  std::vector<uint16_t> matches;
+  trie.match(topic, matches);
+  return matches;
+}
+
+static bool matches(const std::string &filter, const std::string &topic) {
+  MQTTTopicTrie trie;
+  trie.add(filter, 0);
+  return !match(trie, topic).empty();
+}
+
+static std::string to_string(const std::vector<uint16_t> &ids) {
+  std::string result = "[";
+  for (auto id : ids)
+    result += (result.size() > 1 ? "," : "") + std::to_string(id);
+  return result + "]";
+}
+
+static std::vector<std::string> split_levels(const std::string &topic) {
+  std::vector<std::string> levels;
+  size_t start = 0;
+  while (true) {
+    size_t end = topic.find('/', start);
+    levels.push_back(topic.substr(start, end == std::string::npos ? std::string::npos : end - start));
+    if (end == std::string::npos)
+      return levels;
+    start = end + 1;
+  }
+}
+
+/// Matching as written in the MQTT spec, level by level.
+static bool spec_matches(const std::string &filter, const std::string &topic) {
+  const auto filter_levels = split_levels(filter);
+  const auto topic_levels = split_levels(topic);
+  const bool system_topic = !topic.empty() && topic[0] == '$';
+  for (size_t i = 0; i < filter_levels.size(); i++) {
+    if (filter_levels[i] == "#")
+      return i != 0 || !system_topic;
+    if (i >= topic_levels.size())
+      return false;
+    if (filter_levels[i] == "+") {
+      if (i == 0 && system_topic)
+        return false;
+      continue;
+    }
+    if (filter_levels[i] != topic_levels[i])
+      return false;
+  }
+  return filter_levels.size() == topic_levels.size();
+}
+
+HOST_TEST(mqtt_topic_trie_exact) {
+  EXPECT_TRUE(matches("a/b", "a/b"));
+  EXPECT_TRUE(!matches("a/b", "a"));
+  EXPECT_TRUE(!matches("a/b", "a/b/c"));
+  EXPECT_TRUE(!matches("a/b", "a/bc"));
+  EXPECT_TRUE(!matches("a/b", "A/b"));
+  EXPECT_TRUE(matches("a//b", "a//b"));
+  EXPECT_TRUE(!matches("a//b", "a/b"));
+  EXPECT_TRUE(matches("/a", "/a"));
+  EXPECT_TRUE(!matches("/a", "a"));
+  EXPECT_TRUE(matches("a/", "a/"));
+  EXPECT_TRUE(!matches("a/", "a"));
+}
+
+HOST_TEST(mqtt_topic_trie_plus) {
+  EXPECT_TRUE(matches("a/+", "a/b"));
+  EXPECT_TRUE(matches("a/+", "a/"));
+  EXPECT_TRUE(!matches("a/+", "a"));
+  EXPECT_TRUE(!matches("a/+", "a/b/c"));
+  EXPECT_TRUE(matches("a/+/c", "a/b/c"));
+  EXPECT_TRUE(!matches("a/+/c", "a/b/d"));
+  EXPECT_TRUE(matches("+/+", "/b"));
+  EXPECT_TRUE(matches("+", "a"));
+  EXPECT_TRUE(matches("+", ""));
+  EXPECT_TRUE(!matches("+", "a/b"));
+  EXPECT_TRUE(!matches("+/b", "$SYS/b"));
+  EXPECT_TRUE(matches("$SYS/+", "$SYS/b"));
+}
+
+HOST_TEST(mqtt_topic_trie_hash) {
+  EXPECT_TRUE(matches("#", "a"));
+  EXPECT_TRUE(matches("#", "a/b/c"));
+  EXPECT_TRUE(matches("#", "/"));
+  EXPECT_TRUE(matches("a/#", "a/b/c"));
+  EXPECT_TRUE(matches("a/#", "a/b"));
+  EXPECT_TRUE(matches("a/#", "a/"));
+  // '#' also matches the parent level
+  EXPECT_TRUE(matches("a/#", "a"));
+  EXPECT_TRUE(!matches("a/#", "b/a"));
+  EXPECT_TRUE(!matches("a/#", "ab"));
+  EXPECT_TRUE(matches("a/+/#", "a/b"));
+  EXPECT_TRUE(!matches("a/+/#", "a"));
+  EXPECT_TRUE(!matches("#", "$SYS/b"));
+  EXPECT_TRUE(matches("$SYS/#", "$SYS/b"));
+  EXPECT_TRUE(matches("$SYS/#", "$SYS"));
+}
+
+HOST_TEST(mqtt_topic_trie_ids) {
+  MQTTTopicTrie trie;
+  trie.add("home/+/state", 0);
+  trie.add("home/#", 1);
+  trie.add("home/light/state", 2);
+  trie.add("home/light/state", 3);
+  trie.add("other", 4);
+
+  EXPECT_EQ(to_string(match(trie, "home/light/state")), std::string("[0,1,2,3]"));
+  EXPECT_EQ(to_string(match(trie, "home/switch/state")), std::string("[0,1]"));
+  EXPECT_EQ(to_string(match(trie, "home")), std::string("[1]"));
+  EXPECT_EQ(to_string(match(trie, "other")), std::string("[4]"));
+  EXPECT_EQ(to_string(match(trie, "none")), std::string("[]"));
+
+  // Matches are appended
+  std::vector<uint16_t> ids{9};
+  trie.match("other", ids);
+  EXPECT_EQ(to_string(ids), std::string("[9,4]"));
+
+  trie.clear();
+  EXPECT_EQ(to_string(match(trie, "home/light/state")), std::string("[]"));
+  trie.add("home/light/state", 7);
+  EXPECT_EQ(to_string(match(trie, "home/light/state")), std::string("[7]"));
+}
+
+HOST_TEST(mqtt_topic_trie_random) {
+  // Compare random filters and topics made of a few short levels against the spec
+  static const char *const FILTER_LEVELS[] = {"a", "b", "", "$x", "ab", "+", "#"};
+  static const char *const TOPIC_LEVELS[] = {"a", "b", "", "$x", "ab"};
+  std::mt19937 rng(1);
+  const auto random_topic = [&rng](const char *const *levels, size_t count) {
+    std::string topic;
+    const uint32_t depth = rng() % 4 + 1;
+    for (uint32_t i = 0; i < depth; i++) {
+      std::string level = levels[rng() % count];
+      if (level == "#" && i != depth - 1)
+        level = "a";
+      topic += (i != 0 ? "/" : "") + level;
+    }
+    return topic;
+  };
+
+  int mismatches = 0;
+  for (int round = 0; round < 5000; round++) {
+    MQTTTopicTrie trie;
+    std::vector<std::string> filters;
+    const uint32_t count = rng() % 6 + 1;
+    for (uint32_t id = 0; id < count; id++) {
+      filters.push_back(random_topic(FILTER_LEVELS, 7));
+      trie.add(filters.back(), id);
+    }
+    for (int i = 0; i < 10; i++) {
+      const std::string topic = random_topic(TOPIC_LEVELS, 5);
+      std::vector<uint16_t> expected;
+      for (uint16_t id = 0; id < count; id++) {
+        if (spec_matches(filters[id], topic))
+          expected.push_back(id);
+      }
+      const auto actual = match(trie, topic);
+      if (actual != expected && mismatches++ < 5) {
+        std::string message = "topic \"" + topic + "\" matched " + to_string(actual) + ", expected " +
+                              to_string(expected) + " with filters";
+        for (auto &filter : filters)
+          message += " \"" + filter + "\"";
+        host_test::fail(__FILE__, __LINE__, message);
+      }
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
@@ -0,0 +1,505 @@
+// Tests of receiving OTA updates with the ESP-IDF backend on a simulated flash, see ota_host.h.
+//
+// host_test sources: tests/host_tests/ota_host.cpp esphome/components/ota/ota_component.cpp
+// host_test sources: esphome/components/ota/ota_backend_esp_idf.cpp esphome/components/ota/ota_decoder.cpp
+// host_test sources: esphome/components/ota/ota_writer.cpp esphome/components/md5/md5.cpp
+// host_test sources: esphome/components/socket/bsd_sockets_impl.cpp
+// host_test sources: esphome/core/component.cpp esphome/core/scheduler.cpp
+// host_test flags: -DUSE_ESP32 -DUSE_ESP_IDF -DOPENSSL_SUPPRESS_DEPRECATED
+// host_test libs: -lcrypto -lz
+
+#include "host_test.h"
+#include "ota_host.h"
+
+#include "esphome/components/ota/ota_backend_esp_idf.h"
+#include "esphome/components/ota/ota_decoder.h"
+#include "esphome/components/ota/ota_writer.h"
+#include "esphome/core/hal.h"
+
+#include <openssl/md5.h>
+#include <zlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <thread>
+
+/// Make allocations of at least this many bytes with new (std::nothrow) fail.
+static std::atomic<size_t> allocations_fail_from{SIZE_MAX};  // NOLINT
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+  if (size >= allocations_fail_from)
+    return nullptr;
+  return std::malloc(std::max<size_t>(size, 1));  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+namespace esphome {
+namespace ota {
+
+static std::vector<uint8_t> random_image(size_t size) {
+  std::mt19937 random(size);
+  std::vector<uint8_t> image(size);
+  for (auto &byte : image)
+    byte = random();
+  // Not the magic of a delta patch
+  image[0] = 0xE9;
+  return image;
+}
+
+static void put_le32(std::vector<uint8_t> &data, uint32_t value) {
+  for (int i = 0; i < 4; i++)
+    data.push_back(value >> (8 * i));
+}
+
+static void put_md5(std::vector<uint8_t> &data, const std::vector<uint8_t> &of) {
+  uint8_t digest[16];
+  MD5(of.data(), of.size(), digest);
+  data.insert(data.end(), digest, digest + 16);
+}
+
+static void put_varint(std::vector<uint8_t> &data, uint32_t value) {
+  while (value >= 0x80) {
+    data.push_back((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  data.push_back(value);
+}
+
+static std::vector<uint8_t> gzip(const std::vector<uint8_t> &data) {
+  z_stream z{};
+  // With a gzip header and trailer
+  deflateInit2(&z, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::vector<uint8_t> compressed(deflateBound(&z, data.size()));
+  z.next_in = const_cast<uint8_t *>(data.data());
+  z.avail_in = data.size();
+  z.next_out = compressed.data();
+  z.avail_out = compressed.size();
+  deflate(&z, Z_FINISH);
+  compressed.resize(z.total_out);
+  deflateEnd(&z);
+  return compressed;
+}
+
+/// The header of a delta patch from base to image, see DecodingOTABackend.
+static std::vector<uint8_t> delta_header(const std::vector<uint8_t> &base, const std::vector<uint8_t> &image) {
+  std::vector<uint8_t> patch{'E', 'S', 'P', 'D', 1};
+  put_le32(patch, base.size());
+  put_md5(patch, base);
+  put_le32(patch, image.size());
+  put_md5(patch, image);
+  return patch;
+}
+
+HOST_TEST(ota_upload) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::set_flash_timing(2000, 100);
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+
+  const auto image = random_image(300000);
+  const auto result = ota_host::upload(&ota, image, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(result.rebooted);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_upload_synchronous) {
+  // Without the writer task, every chunk is written as soon as it's complete
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::set_flash_timing(2000, 100);
+  ota_host::set_task_create_fails(true);
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+
+  const auto image = random_image(100003);
+  const auto result = ota_host::upload(&ota, image, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_upload_small_image) {
+  // Smaller than a chunk
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+
+  const auto image = random_image(1000);
+  EXPECT_EQ(ota_host::upload(&ota, image, {}).response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_upload_interrupted) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::set_flash_timing(2000, 100);
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+
+  // The connection is lost halfway, the next upload starts over
+  const auto image = random_image(200000);
+  ota_host::UploadOptions options;
+  options.close_after = 100000;
+  const auto interrupted = ota_host::upload(&ota, image, options);
+  EXPECT_TRUE(!interrupted.rebooted);
+  EXPECT_TRUE(ota_host::get_written_image().empty());
+
+  const auto result = ota_host::upload(&ota, image, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_flash_error) {
+  host_test::use_real_time();
+  // The error of a write in the background is reported when the next chunk is queued, or by waiting for the writes
+  // at the end when the last chunk fails
+  for (size_t fails_at : {50000, 199900}) {
+    for (bool synchronous : {false, true}) {
+      ota_host::reset();
+      ota_host::set_flash_timing(2000, 100);
+      ota_host::set_task_create_fails(synchronous);
+      ota_host::set_flash_fails_at(fails_at);
+      ota_host::HostOTAComponent ota;
+      ota.set_buffer_size(4096);
+      ota.setup();
+
+      const auto result = ota_host::upload(&ota, random_image(200000), {});
+      EXPECT_EQ(result.response, OTA_RESPONSE_ERROR_WRITING_FLASH);
+      EXPECT_TRUE(!result.rebooted);
+      EXPECT_TRUE(ota_host::get_written_image().empty());
+    }
+  }
+}
+
+HOST_TEST(ota_gzip) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+
+  // Where the trailer ends up relative to the chunks varies with the size
+  for (size_t size : {1000, 50000, 100001, 123457}) {
+    auto image = random_image(size);
+    // Compressible, but not too well
+    for (size_t i = 0; i < size; i += 2)
+      image[i] = 0;
+    const auto compressed = gzip(image);
+    ota_host::UploadOptions options;
+    options.supports_compression = true;
+    const auto result = ota_host::upload(&ota, compressed, options);
+    EXPECT_TRUE(result.compression);
+    EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+    EXPECT_TRUE(ota_host::get_written_image() == image);
+  }
+}
+
+HOST_TEST(ota_gzip_trailer) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+  ota_host::UploadOptions options;
+  options.supports_compression = true;
+
+  // The CRC and size of the decompressed image are checked, even when tinfl read the trailer ahead
+  auto image = random_image(60000);
+  for (size_t i = 0; i < image.size(); i += 2)
+    image[i] = 0;
+  const auto compressed = gzip(image);
+  for (size_t offset : {compressed.size() - 8, compressed.size() - 5, compressed.size() - 1}) {
+    auto corrupted = compressed;
+    corrupted[offset] ^= 0x01;
+    EXPECT_EQ(ota_host::upload(&ota, corrupted, options).response, OTA_RESPONSE_ERROR_INVALID_IMAGE);
+  }
+
+  // So is that the trailer is complete
+  for (size_t missing : {1, 7, 8}) {
+    std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - missing);
+    EXPECT_EQ(ota_host::upload(&ota, truncated, options).response, OTA_RESPONSE_ERROR_INVALID_IMAGE);
+  }
+  EXPECT_TRUE(ota_host::get_written_image().empty());
+}
+
+HOST_TEST(ota_gzip_no_memory) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::HostOTAComponent ota;
+  ota.set_buffer_size(4096);
+  ota.setup();
+  ota_host::UploadOptions options;
+  options.supports_compression = true;
+
+  // Compression is only offered when the memory to decompress could be allocated, otherwise the client sends the
+  // image as is
+  const auto image = random_image(20000);
+  allocations_fail_from = TINFL_LZ_DICT_SIZE;
+  auto result = ota_host::upload(&ota, image, options);
+  allocations_fail_from = SIZE_MAX;
+  EXPECT_TRUE(!result.compression);
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+
+  result = ota_host::upload(&ota, gzip(image), options);
+  EXPECT_TRUE(result.compression);
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+/// A fixture of tests/host_tests/fixtures/ota_delta, created with esphome/ota_delta.py by generate.py there.
+static std::vector<uint8_t> read_fixture(const char *name) {
+  std::ifstream file(std::string("tests/host_tests/fixtures/ota_delta/") + name, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void put_data(std::vector<uint8_t> &patch, const std::vector<uint8_t> &data) {
+  patch.push_back(0);
+  put_varint(patch, data.size());
+  patch.insert(patch.end(), data.begin(), data.end());
+}
+
+static void put_copy(std::vector<uint8_t> &patch, uint32_t offset, uint32_t len) {
+  patch.push_back(1);
+  put_varint(patch, offset);
+  put_varint(patch, len);
+}
+
+static void put_add(std::vector<uint8_t> &patch, uint32_t offset, const std::vector<uint8_t> &add) {
+  patch.push_back(2);
+  put_varint(patch, offset);
+  put_varint(patch, add.size());
+  patch.insert(patch.end(), add.begin(), add.end());
+}
+
+/// A patch with all operations and varints of one to three bytes, and the image it creates from base.
+static std::vector<uint8_t> operations_patch(const std::vector<uint8_t> &base, std::vector<uint8_t> *image) {
+  const auto data = random_image(300);
+  std::vector<uint8_t> add(2000);
+  for (size_t i = 0; i < add.size(); i++)
+    add[i] = i % 7 == 0 ? i / 7 : 0;
+
+  image->assign(data.begin(), data.end());
+  image->insert(image->end(), base.begin() + 20000, base.begin() + 40000);
+  for (size_t i = 0; i < add.size(); i++)
+    image->push_back(base[100 + i] + add[i]);
+  image->insert(image->end(), base.begin(), base.begin() + 5);
+
+  auto patch = delta_header(base, *image);
+  put_data(patch, data);
+  put_copy(patch, 20000, 20000);
+  put_add(patch, 100, add);
+  put_copy(patch, 0, 5);
+  return patch;
+}
+
+static void start_delta_test(ota_host::HostOTAComponent *ota, const std::vector<uint8_t> &base) {
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::set_running_image(base);
+  ota->set_buffer_size(4096);
+  ota->setup();
+}
+
+HOST_TEST(ota_delta_fixture) {
+  const auto base = read_fixture("base.bin");
+  const auto image = read_fixture("image.bin");
+  const auto patch = read_fixture("patch.bin");
+  EXPECT_TRUE(!base.empty() && !image.empty() && !patch.empty());
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+
+  auto result = ota_host::upload(&ota, patch, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(result.rebooted);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+
+  // Compressed like espota2.py uploads it
+  ota_host::UploadOptions options;
+  options.supports_compression = true;
+  result = ota_host::upload(&ota, gzip(patch), options);
+  EXPECT_TRUE(result.compression);
+  EXPECT_EQ(result.response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_delta_operations) {
+  const auto base = random_image(50000);
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+
+  std::vector<uint8_t> image;
+  const auto patch = operations_patch(base, &image);
+  EXPECT_EQ(ota_host::upload(&ota, patch, {}).response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+HOST_TEST(ota_delta_varint) {
+  const auto base = random_image(1000);
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+
+  // Bits above bit 31 or a 6th byte are rejected instead of dropped, which would turn this into an offset of 0
+  for (uint8_t last : {0x10, 0x80}) {
+    auto invalid = delta_header(base, base);
+    const uint8_t too_large[] = {0x80, 0x80, 0x80, 0x80, last, 0x00};
+    invalid.push_back(1);
+    invalid.insert(invalid.end(), too_large, too_large + (last & 0x80 ? 6 : 5));
+    put_varint(invalid, base.size());
+    EXPECT_EQ(ota_host::upload(&ota, invalid, {}).response, OTA_RESPONSE_ERROR_INVALID_IMAGE);
+    EXPECT_TRUE(ota_host::get_written_image().empty());
+  }
+
+  // Varints may use all 5 bytes, as long as the value fits into 32 bits
+  auto patch = delta_header(base, base);
+  const uint8_t offset[] = {0x80, 0x80, 0x80, 0x80, 0x00};
+  patch.push_back(1);
+  patch.insert(patch.end(), offset, offset + sizeof(offset));
+  put_varint(patch, base.size());
+  EXPECT_EQ(ota_host::upload(&ota, patch, {}).response, OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == base);
+}
+
+HOST_TEST(ota_delta_wrong_base) {
+  const auto base = random_image(50000);
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+  std::vector<uint8_t> image;
+  const auto patch = operations_patch(base, &image);
+
+  auto running = base;
+  running[base.size() - 1] ^= 0x01;
+  ota_host::set_running_image(running);
+  const auto result = ota_host::upload(&ota, patch, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_ERROR_WRONG_DELTA_BASE);
+  EXPECT_EQ(result.response, 139);
+  EXPECT_TRUE(!result.rebooted);
+  EXPECT_TRUE(ota_host::get_written_image().empty());
+}
+
+HOST_TEST(ota_delta_image_md5) {
+  const auto base = random_image(50000);
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+  std::vector<uint8_t> image;
+  auto patch = operations_patch(base, &image);
+
+  // The patch creates an image of the right size, but not the one its header describes
+  patch[patch.size() - 1] ^= 0x01;
+  const auto result = ota_host::upload(&ota, patch, {});
+  EXPECT_EQ(result.response, OTA_RESPONSE_ERROR_INVALID_IMAGE);
+  EXPECT_EQ(result.response, 140);
+  EXPECT_TRUE(!result.rebooted);
+  EXPECT_TRUE(ota_host::get_written_image().empty());
+}
+
+HOST_TEST(ota_delta_truncated) {
+  const auto base = random_image(50000);
+  ota_host::HostOTAComponent ota;
+  start_delta_test(&ota, base);
+  std::vector<uint8_t> image;
+  const auto patch = operations_patch(base, &image);
+
+  // Ends in the header, in the data of DATA, in the varints of COPY, in the added bytes of ADD and in the last COPY
+  const size_t header = 45;
+  for (size_t len : {size_t(20), header + 100, header + 304, header + 2200, patch.size() - 1}) {
+    std::vector<uint8_t> truncated(patch.begin(), patch.begin() + len);
+    const auto result = ota_host::upload(&ota, truncated, {});
+    EXPECT_EQ(result.response, OTA_RESPONSE_ERROR_INVALID_IMAGE);
+    EXPECT_TRUE(!result.rebooted);
+    EXPECT_TRUE(ota_host::get_written_image().empty());
+  }
+}
+
+HOST_TEST(ota_writer_long_write) {
+  // A delta patch that copies the whole running image is one write, which takes about 1 s on this flash, longer than
+  // the timeout. The writer only times out when the writes stop making progress.
+  host_test::use_real_time();
+  ota_host::reset();
+  ota_host::set_flash_timing(15000, 100);
+  const auto base = random_image(256 * 1024);
+  ota_host::set_running_image(base);
+  auto image = base;
+  const std::vector<uint8_t> data(200, 0x5A);
+  image.insert(image.end(), data.begin(), data.end());
+
+  auto patch = delta_header(base, image);
+  patch.push_back(1);
+  put_varint(patch, 0);
+  put_varint(patch, base.size());
+  patch.push_back(0);
+  put_varint(patch, data.size());
+  patch.insert(patch.end(), data.begin(), data.end());
+
+  static const uint32_t TIMEOUT = 300;
+  DecodingOTABackend backend(make_unique<IDFOTABackend>());
+  EXPECT_EQ(backend.begin(patch.size()), OTA_RESPONSE_OK);
+  OTAWriter writer;
+  EXPECT_TRUE(writer.begin(&backend, 64));
+  EXPECT_TRUE(writer.is_pipelined());
+  // The third chunk waits for the first one, which has the copy
+  const uint32_t start = millis();
+  for (size_t offset = 0; offset < patch.size(); offset += 64) {
+    uint8_t *chunk = writer.get_buffer(TIMEOUT);
+    EXPECT_TRUE(chunk != nullptr);
+    if (chunk == nullptr)
+      return;
+    const size_t len = std::min<size_t>(64, patch.size() - offset);
+    memcpy(chunk, patch.data() + offset, len);
+    EXPECT_EQ(writer.write(len), OTA_RESPONSE_OK);
+  }
+  EXPECT_EQ(writer.finish(TIMEOUT), OTA_RESPONSE_OK);
+  EXPECT_TRUE(millis() - start > 2 * TIMEOUT);
+  EXPECT_EQ(backend.end(), OTA_RESPONSE_OK);
+  EXPECT_TRUE(ota_host::get_written_image() == image);
+}
+
+/// A backend whose writes hang until released, and time passes whenever the writer checks for progress.
+class HangingBackend : public OTABackend {
+ public:
+  OTAResponseTypes begin(size_t image_size) override { return OTA_RESPONSE_OK; }
+  void set_update_md5(const char *md5) override {}
+  OTAResponseTypes write(uint8_t *data, size_t len) override {
+    while (!this->released)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return OTA_RESPONSE_OK;
+  }
+  OTAResponseTypes end() override { return OTA_RESPONSE_OK; }
+  void abort() override {}
+  bool supports_compression() override { return false; }
+  size_t get_bytes_written() override {
+    host_test::advance_millis(1000);
+    return 0;
+  }
+
+  std::atomic<bool> released{false};
+};
+
+HOST_TEST(ota_writer_stalled) {
+  HangingBackend backend;
+  OTAWriter writer;
+  EXPECT_TRUE(writer.begin(&backend, 64));
+  for (int i = 0; i < 2; i++) {
+    memset(writer.get_buffer(10000), 0, 64);
+    EXPECT_EQ(writer.write(64), OTA_RESPONSE_OK);
+  }
+  const uint32_t start = millis();
+  EXPECT_TRUE(writer.get_buffer(10000) == nullptr);
+  EXPECT_TRUE(millis() - start > 10000);
+  EXPECT_EQ(writer.finish(10000), OTA_RESPONSE_ERROR_WRITING_FLASH);
+  backend.released = true;
+}
+
+}  // namespace ota
+}  // namespace esphome
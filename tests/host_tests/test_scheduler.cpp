@@ -0,0 +1,328 @@
+// Tests of Scheduler: cancelling and re-arming named items, recycling items and releasing interned names.
+//
+// host_test sources: esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/scheduler.h"
+
+#include <string>
+
+namespace esphome {
+
+class TestScheduler : public Scheduler {
+ public:
+  /// All items the scheduler owns: queued, about to be queued and recycled.
+  size_t allocated_items() const { return this->items_.size() + this->to_add_.size() + this->free_items_.size(); }
+  size_t queued_items() const { return this->items_.size() + this->to_add_.size(); }
+  uint32_t to_remove() const { return this->to_remove_; }
+  size_t key_slots() const { return this->keys_.size(); }
+  uint32_t used_keys() const { return this->used_keys_; }
+};
+
+static uint32_t next_in(Scheduler &scheduler) { return scheduler.next_schedule_in().value_or(UINT32_MAX); }
+
+HOST_TEST(scheduler_timeout) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  scheduler.set_timeout(&component, "timeout", 100, [&calls]() { calls++; });
+
+  host_test::advance_millis(99);
+  scheduler.call();
+  EXPECT_EQ(calls, 0);
+  host_test::advance_millis(1);
+  scheduler.call();
+  EXPECT_EQ(calls, 1);
+  host_test::advance_millis(1000);
+  scheduler.call();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_next_schedule_in_sees_new_items) {
+  // With tickless idle Application::loop() sleeps for next_schedule_in() after the loop() of all components, a
+  // timeout that one of them registered after scheduler.call() must cut that sleep short
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  scheduler.set_timeout(&component, "later", 1000, []() {});
+  scheduler.call();
+  EXPECT_EQ(next_in(scheduler), 1000u);
+
+  scheduler.set_timeout(&component, "timeout", 10, [&calls]() { calls++; });
+  EXPECT_EQ(next_in(scheduler), 10u);
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_EQ(calls, 1);
+
+  // So must a defer(), and a cancelled one doesn't
+  scheduler.set_timeout(&component, "timeout", 0, []() {});
+  scheduler.cancel_timeout(&component, "timeout");
+  EXPECT_EQ(next_in(scheduler), 990u);
+  scheduler.set_timeout(&component, "timeout", 0, []() {});
+  EXPECT_EQ(next_in(scheduler), 0u);
+}
+
+HOST_TEST(scheduler_rearm_replaces_timeout) {
+  TestScheduler scheduler;
+  Component component;
+  int first = 0, second = 0;
+  scheduler.set_timeout(&component, "timeout", 100, [&first]() { first++; });
+  host_test::advance_millis(50);
+  scheduler.call();
+  scheduler.set_timeout(&component, std::string("timeout"), 100, [&second]() { second++; });
+
+  host_test::advance_millis(60);
+  scheduler.call();
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(second, 0);
+  host_test::advance_millis(40);
+  scheduler.call();
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(second, 1);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_cancel) {
+  TestScheduler scheduler;
+  Component component, other;
+  int calls = 0;
+  scheduler.set_timeout(&component, "name", 100, [&calls]() { calls++; });
+  scheduler.set_interval(&component, "name", 100, [&calls]() { calls += 10; });
+  scheduler.set_timeout(&other, "name", 100, [&calls]() { calls += 100; });
+
+  EXPECT_TRUE(scheduler.cancel_timeout(&component, "name"));
+  EXPECT_TRUE(!scheduler.cancel_timeout(&component, "name"));
+  EXPECT_TRUE(!scheduler.cancel_retry(&component, "name"));
+  EXPECT_TRUE(!scheduler.cancel_timeout(&component, "unknown"));
+
+  host_test::advance_millis(100);
+  scheduler.call();
+  // Only the interval of the component and the timeout of the other component are left
+  EXPECT_EQ(calls, 110);
+  EXPECT_TRUE(scheduler.cancel_interval(&component, "name"));
+  host_test::advance_millis(1000);
+  scheduler.call();
+  EXPECT_EQ(calls, 110);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_cancel_anonymous) {
+  TestScheduler scheduler;
+  Component component, other;
+  int calls = 0;
+  scheduler.set_timeout(&component, "", 100, [&calls]() { calls++; });
+  scheduler.set_timeout(&component, "", 200, [&calls]() { calls++; });
+  scheduler.set_timeout(&other, "", 100, [&calls]() { calls += 10; });
+  scheduler.set_timeout(&component, "named", 100, [&calls]() { calls += 100; });
+
+  EXPECT_TRUE(scheduler.cancel_timeout(&component, ""));
+  EXPECT_TRUE(!scheduler.cancel_timeout(&component, ""));
+  host_test::advance_millis(1000);
+  scheduler.call();
+  EXPECT_EQ(calls, 110);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+}
+
+HOST_TEST(scheduler_interval_cancels_itself) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  scheduler.set_interval(&component, "interval", 10, [&]() {
+    if (++calls == 3)
+      scheduler.cancel_interval(&component, "interval");
+  });
+
+  for (int i = 0; i < 20; i++) {
+    host_test::advance_millis(10);
+    scheduler.call();
+  }
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_timeout_rearms_itself) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  std::function<void()> callback = [&]() {
+    if (++calls < 5)
+      scheduler.set_timeout(&component, "again", 10, std::function<void()>(callback));
+  };
+  scheduler.set_timeout(&component, "again", 10, std::function<void()>(callback));
+
+  for (int i = 0; i < 20; i++) {
+    host_test::advance_millis(10);
+    scheduler.call();
+  }
+  EXPECT_EQ(calls, 5);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_retry) {
+  TestScheduler scheduler;
+  Component component;
+  int attempts = 0;
+  scheduler.set_retry(
+      &component, "retry", 10, 5,
+      [&attempts]() {
+        attempts++;
+        return attempts == 3 ? RetryResult::DONE : RetryResult::RETRY;
+      },
+      2.0f);
+
+  // The first attempt runs right away, the wait time doubles after every attempt
+  scheduler.call();
+  EXPECT_EQ(attempts, 1);
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_EQ(attempts, 1);
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_EQ(attempts, 2);
+  host_test::advance_millis(30);
+  scheduler.call();
+  EXPECT_EQ(attempts, 2);
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_EQ(attempts, 3);
+  host_test::advance_millis(1000);
+  scheduler.call();
+  EXPECT_EQ(attempts, 3);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_dont_run_cancels) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  scheduler.set_timeout(&component, "timeout", 100, [&calls]() { calls++; });
+  scheduler.set_timeout(&component, "timeout", SCHEDULER_DONT_RUN, [&calls]() { calls++; });
+  host_test::advance_millis(1000);
+  scheduler.call();
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+}
+
+HOST_TEST(scheduler_recycles_items) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  for (int i = 0; i < 10; i++)
+    scheduler.set_interval(&component, "interval" + std::to_string(i), 10, [&calls]() { calls++; });
+  host_test::advance_millis(10);
+  scheduler.call();
+  const size_t allocated = scheduler.allocated_items();
+
+  // Re-arming, cancelling and expiring timeouts only re-uses items
+  for (int i = 0; i < 1000; i++) {
+    scheduler.set_timeout(&component, "timeout", 5, []() {});
+    scheduler.set_timeout(&component, "", 5, []() {});
+    if (i % 3 == 0)
+      scheduler.cancel_timeout(&component, "timeout");
+    host_test::advance_millis(3);
+    scheduler.call();
+  }
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_TRUE(scheduler.allocated_items() <= allocated + 4);
+  EXPECT_EQ(scheduler.queued_items(), 10u);
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+  EXPECT_TRUE(calls > 1000);
+}
+
+HOST_TEST(scheduler_compacts_cancelled_items) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0;
+  for (int i = 0; i < 100; i++)
+    scheduler.set_timeout(&component, "timeout" + std::to_string(i), 1000 + i, [&calls]() { calls++; });
+  scheduler.call();
+  EXPECT_EQ(scheduler.queued_items(), 100u);
+
+  // Cancelled items stay in the heap until there are too many of them
+  for (int i = 0; i < 50; i++)
+    EXPECT_TRUE(scheduler.cancel_timeout(&component, "timeout" + std::to_string(i * 2)));
+  EXPECT_EQ(scheduler.to_remove(), 50u);
+  scheduler.call();
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+  EXPECT_EQ(scheduler.queued_items(), 50u);
+
+  // Items cancelled before they were added to the heap are dropped when they would be added
+  scheduler.set_timeout(&component, "late", 10, [&calls]() { calls += 1000; });
+  EXPECT_TRUE(scheduler.cancel_timeout(&component, "late"));
+  EXPECT_EQ(scheduler.to_remove(), 1u);
+  scheduler.process_to_add();
+  EXPECT_EQ(scheduler.to_remove(), 0u);
+
+  host_test::advance_millis(2000);
+  scheduler.call();
+  EXPECT_EQ(calls, 50);
+  EXPECT_EQ(scheduler.queued_items(), 0u);
+}
+
+HOST_TEST(scheduler_releases_names) {
+  TestScheduler scheduler;
+  Component component;
+  int calls = 0, kept = 0;
+  scheduler.set_interval(&component, "kept", 1000000, [&kept]() { kept++; });
+
+  // Names built at runtime, e.g. from addresses, that are only used once
+  for (int i = 0; i < 10000; i++) {
+    scheduler.set_timeout(&component, "device-" + std::to_string(i), 10, [&calls]() { calls++; });
+    if (i % 2 == 0)
+      scheduler.cancel_timeout(&component, "device-" + std::to_string(i));
+    host_test::advance_millis(5);
+    scheduler.call();
+  }
+  host_test::advance_millis(10);
+  scheduler.call();
+  EXPECT_EQ(calls, 5000);
+  EXPECT_EQ(kept, 1);
+  EXPECT_TRUE(scheduler.key_slots() <= 64);
+  EXPECT_TRUE(scheduler.used_keys() <= 64);
+
+  // The key that is still in use survives the sweeps
+  EXPECT_TRUE(scheduler.cancel_interval(&component, "kept"));
+}
+
+static uint32_t name_hash(const char *name) {
+  uint32_t hash = 2166136261UL;
+  for (const char *c = name; *c != '\0'; c++) {
+    hash *= 16777619UL;
+    hash ^= *c;
+  }
+  return hash;
+}
+
+HOST_TEST(scheduler_releases_colliding_names) {
+  TestScheduler scheduler;
+  Component component;
+  // Components (never dereferenced here) whose keys for "a", "b" and "c" have the same hash as (component, "a")
+  auto *with_b = reinterpret_cast<Component *>(reinterpret_cast<uintptr_t>(&component) ^ name_hash("a") ^
+                                               name_hash("b"));
+  auto *with_c = reinterpret_cast<Component *>(reinterpret_cast<uintptr_t>(&component) ^ name_hash("a") ^
+                                               name_hash("c"));
+  scheduler.set_timeout(&component, "a", 100, []() {});
+  scheduler.set_timeout(with_b, "b", 100, []() {});
+  scheduler.set_timeout(with_c, "c", 100, []() {});
+
+  // Release the key in the middle of the chain
+  EXPECT_TRUE(scheduler.cancel_timeout(with_b, "b"));
+  scheduler.process_to_add();
+  for (int i = 0; i < 100; i++)
+    scheduler.set_timeout(&component, "other-" + std::to_string(i), SCHEDULER_DONT_RUN, []() {});
+
+  EXPECT_TRUE(!scheduler.cancel_timeout(with_b, "b"));
+  EXPECT_TRUE(scheduler.cancel_timeout(with_c, "c"));
+  EXPECT_TRUE(scheduler.cancel_timeout(&component, "a"));
+  scheduler.process_to_add();
+  EXPECT_TRUE(scheduler.used_keys() <= 64);
+}
+
+}  // namespace esphome
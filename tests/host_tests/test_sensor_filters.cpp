@@ -0,0 +1,158 @@
+// Tests of the sliding window sensor filters (median, quantile, min and max) against the sort-based filters they
+// replaced, with NaNs, duplicate values, windows that wrapped around many times and window sizes changed on the fly.
+//
+// host_test sources: esphome/components/sensor/sensor.cpp esphome/components/sensor/filter.cpp
+// host_test sources: esphome/core/entity_base.cpp esphome/core/component.cpp esphome/core/scheduler.cpp
+
+#include "host_test.h"
+#include "legacy_sensor_filters.h"
+
+#include "esphome/components/sensor/filter.h"
+#include "esphome/core/preferences.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace esphome {
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace sensor {
+
+static const size_t WINDOW_SIZES[] = {1, 2, 3, 4, 5, 8, 15, 32};
+
+/// Values from a few levels, so that the windows hold duplicates, with NaNs in between.
+static std::vector<float> random_values(uint32_t seed, size_t count) {
+  std::mt19937 rng(seed);
+  std::vector<float> values;
+  for (size_t i = 0; i < count; i++) {
+    if (rng() % 10 == 0) {
+      values.push_back(NAN);
+    } else {
+      values.push_back(static_cast<float>(rng() % 9) * 0.25f - 1.0f);
+    }
+  }
+  return values;
+}
+
+/// The output of a filter by value, -1000 if it didn't send one.
+static float output(optional<float> value) { return value.value_or(-1000.0f); }
+
+/// Feed the same values to both filters and change their window size halfway, the outputs must be identical.
+template<typename F, typename L>
+static void expect_same_outputs(F &filter, L &legacy, const std::vector<float> &values, size_t resize_to) {
+  const size_t resize_at = values.size() / 2;
+  for (size_t i = 0; i < values.size(); i++) {
+    float value = values[i];
+    if (i == resize_at) {
+      filter.set_window_size(resize_to);
+      legacy.set_window_size(resize_to);
+      // The old filters only shrank their window once the next value arrived, after a NaN they would still use the
+      // values that left the window
+      if (std::isnan(value))
+        value = 0.0f;
+    }
+    optional<float> actual = filter.new_value(value);
+    optional<float> expected = legacy.new_value(value);
+    if (actual.has_value() != expected.has_value() || (actual.has_value() && *actual != *expected)) {
+      EXPECT_EQ(output(actual), output(expected));
+      EXPECT_EQ(i, values.size());
+      return;
+    }
+  }
+}
+
+HOST_TEST(sensor_filters_median_matches_sort) {
+  uint32_t seed = 1;
+  for (size_t window_size : WINDOW_SIZES) {
+    for (size_t send_every : {1, 3}) {
+      for (size_t resize_to : {window_size / 2 + 1, window_size * 2}) {
+        MedianFilter filter(window_size, send_every, 1);
+        legacy::LegacyMedianFilter legacy(window_size, send_every, 1);
+        expect_same_outputs(filter, legacy, random_values(seed++, 1000), resize_to);
+      }
+    }
+  }
+}
+
+HOST_TEST(sensor_filters_quantile_matches_sort) {
+  uint32_t seed = 100;
+  for (size_t window_size : WINDOW_SIZES) {
+    for (float quantile : {0.1f, 0.25f, 0.5f, 0.9f, 1.0f}) {
+      for (size_t resize_to : {window_size / 2 + 1, window_size * 2}) {
+        QuantileFilter filter(window_size, 2, 1, quantile);
+        legacy::LegacyQuantileFilter legacy(window_size, 2, 1, quantile);
+        expect_same_outputs(filter, legacy, random_values(seed++, 1000), resize_to);
+      }
+    }
+  }
+}
+
+HOST_TEST(sensor_filters_min_max_match_scan) {
+  uint32_t seed = 200;
+  for (size_t window_size : WINDOW_SIZES) {
+    for (size_t send_every : {1, 4}) {
+      for (size_t resize_to : {window_size / 2 + 1, window_size * 2}) {
+        MinFilter min_filter(window_size, send_every, send_every);
+        legacy::LegacyMinFilter legacy_min(window_size, send_every, send_every);
+        expect_same_outputs(min_filter, legacy_min, random_values(seed++, 1000), resize_to);
+        MaxFilter max_filter(window_size, send_every, 1);
+        legacy::LegacyMaxFilter legacy_max(window_size, send_every, 1);
+        expect_same_outputs(max_filter, legacy_max, random_values(seed++, 1000), resize_to);
+      }
+    }
+  }
+}
+
+HOST_TEST(sensor_filters_wrap_around) {
+  // Far more values than the window holds, descending values make every new one the minimum
+  MedianFilter median(4, 1, 1);
+  MinFilter min(4, 1, 1);
+  MaxFilter max(4, 1, 1);
+  for (int i = 1000; i > 10; i--) {
+    median.new_value(i);
+    min.new_value(i);
+    max.new_value(i);
+  }
+  EXPECT_EQ(output(median.new_value(10)), 11.5f);
+  EXPECT_EQ(output(min.new_value(10)), 10.0f);
+  EXPECT_EQ(output(max.new_value(10)), 13.0f);
+}
+
+HOST_TEST(sensor_filters_nan) {
+  // NaNs are left out of the window, a window without values outputs 0
+  MedianFilter median(3, 1, 1);
+  EXPECT_EQ(output(median.new_value(NAN)), 0.0f);
+  EXPECT_EQ(output(median.new_value(2.0f)), 2.0f);
+  EXPECT_EQ(output(median.new_value(NAN)), 2.0f);
+  EXPECT_EQ(output(median.new_value(4.0f)), 3.0f);
+  MaxFilter max(3, 1, 1);
+  EXPECT_EQ(output(max.new_value(NAN)), 0.0f);
+}
+
+HOST_TEST(sensor_filters_set_window_size) {
+  MedianFilter median(5, 1, 1);
+  MinFilter min(5, 1, 1);
+  for (int i = 1; i <= 5; i++) {
+    median.new_value(i);
+    min.new_value(i);
+  }
+
+  // Shrinking keeps the newest values that still fit: 4, 5 and the new 6
+  median.set_window_size(3);
+  min.set_window_size(3);
+  EXPECT_EQ(output(median.new_value(6)), 5.0f);
+  EXPECT_EQ(output(min.new_value(6)), 4.0f);
+  // Growing keeps all values: 4, 5, 6 and the new 7
+  median.set_window_size(5);
+  min.set_window_size(5);
+  EXPECT_EQ(output(median.new_value(7)), 5.5f);
+  EXPECT_EQ(output(min.new_value(7)), 4.0f);
+}
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,37 @@
+// Tests of web_server::etag_matches(), which decides whether the index page and the included files are answered with
+// 304 Not Modified.
+//
+// host_test sources: esphome/components/web_server/etag.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/web_server/etag.h"
+
+namespace esphome {
+namespace web_server {
+
+static const char *const ETAG = "\"5d41402abc4b2a76\"";
+
+HOST_TEST(web_server_etag_matches) {
+  EXPECT_TRUE(etag_matches("\"5d41402abc4b2a76\"", ETAG));
+  // Browsers send the ETag of a response they decompressed as weak
+  EXPECT_TRUE(etag_matches("W/\"5d41402abc4b2a76\"", ETAG));
+  EXPECT_TRUE(etag_matches("*", ETAG));
+  // The cached versions of several firmwares
+  EXPECT_TRUE(etag_matches("\"0123456789abcdef\", \"5d41402abc4b2a76\"", ETAG));
+  EXPECT_TRUE(etag_matches("\"0123456789abcdef\",W/\"5d41402abc4b2a76\"", ETAG));
+}
+
+HOST_TEST(web_server_etag_doesnt_match) {
+  EXPECT_TRUE(!etag_matches("", ETAG));
+  EXPECT_TRUE(!etag_matches("\"0123456789abcdef\"", ETAG));
+  // The quotes are part of the ETag
+  EXPECT_TRUE(!etag_matches("5d41402abc4b2a76", ETAG));
+  EXPECT_TRUE(!etag_matches("\"5d41402abc4b2a7\"", ETAG));
+  EXPECT_TRUE(!etag_matches("\"5d41402abc4b2a76", ETAG));
+  EXPECT_TRUE(!etag_matches("\"5d41402abc4b2a76\"x", ETAG));
+  EXPECT_TRUE(!etag_matches(" , ", ETAG));
+}
+
+}  // namespace web_server
+}  // namespace esphome
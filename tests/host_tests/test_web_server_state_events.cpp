@@ -0,0 +1,111 @@
+// Tests of web_server::StateEventQueue, the state events that wait for the web server loop: coalescing, binary sensor
+// pulses, the flush interval and how long backed up clients can hold the events back.
+//
+// host_test sources: esphome/components/web_server/state_event_queue.cpp esphome/core/entity_base.cpp
+
+#include "host_test.h"
+
+#include "esphome/components/web_server/state_event_queue.h"
+#include "esphome/core/hal.h"
+
+#include <string>
+
+namespace esphome {
+
+// Only used for the object ids of entities
+std::string str_snake_case(const std::string &str) { return str; }
+std::string str_sanitize(const std::string &str) { return str; }
+
+namespace web_server {
+
+class TestEntity : public EntityBase {
+ public:
+  using EntityBase::EntityBase;
+
+ protected:
+  uint32_t hash_base() override { return 0; }
+};
+
+HOST_TEST(web_server_state_events_coalesce) {
+  TestEntity first("first"), second("second");
+  StateEventQueue queue;
+  queue.push(&first, StateEventType::SENSOR);
+  queue.push(&second, StateEventType::SWITCH);
+  queue.push(&first, StateEventType::SENSOR);
+  queue.push(&first, StateEventType::SENSOR);
+
+  // One event per entity, in the order of their first change, the state is read when they are sent
+  EXPECT_EQ(queue.events().size(), 2u);
+  EXPECT_TRUE(queue.events()[0].obj == &first);
+  EXPECT_TRUE(queue.events()[1].obj == &second);
+  EXPECT_EQ(queue.take_coalesced(), 2u);
+  EXPECT_EQ(queue.take_coalesced(), 0u);
+
+  queue.sent(millis());
+  EXPECT_TRUE(queue.empty());
+  queue.push(&first, StateEventType::SENSOR);
+  EXPECT_EQ(queue.events().size(), 1u);
+}
+
+HOST_TEST(web_server_state_events_binary_sensor_pulse) {
+  TestEntity motion("motion"), other("other");
+  StateEventQueue queue;
+  queue.push(&motion, StateEventType::BINARY_SENSOR, true);
+  queue.push(&other, StateEventType::SENSOR);
+  queue.push(&motion, StateEventType::BINARY_SENSOR, false);
+  // A repeat of the last queued state adds nothing
+  queue.push(&motion, StateEventType::BINARY_SENSOR, false);
+  queue.push(&motion, StateEventType::BINARY_SENSOR, true);
+
+  // Every change is sent with its own state
+  const auto &events = queue.events();
+  EXPECT_EQ(events.size(), 4u);
+  if (events.size() != 4)
+    return;
+  EXPECT_TRUE(events[0].obj == &motion && events[0].binary_state);
+  EXPECT_TRUE(events[1].obj == &other);
+  EXPECT_TRUE(events[2].obj == &motion && !events[2].binary_state);
+  EXPECT_TRUE(events[3].obj == &motion && events[3].binary_state);
+  EXPECT_EQ(queue.take_coalesced(), 1u);
+}
+
+HOST_TEST(web_server_state_events_flush_interval) {
+  TestEntity entity("entity");
+  StateEventQueue queue;
+  queue.set_flush_interval(100);
+  EXPECT_TRUE(!queue.is_due(millis(), false));
+  queue.sent(millis());
+
+  queue.push(&entity, StateEventType::SENSOR);
+  host_test::advance_millis(99);
+  EXPECT_TRUE(!queue.is_due(millis(), false));
+  host_test::advance_millis(1);
+  EXPECT_TRUE(queue.is_due(millis(), false));
+}
+
+HOST_TEST(web_server_state_events_hold_back) {
+  TestEntity first("first"), second("second");
+  StateEventQueue queue;
+  queue.set_max_hold_back(1000);
+
+  // Backed up clients hold the events back, counted from the oldest queued event
+  queue.push(&first, StateEventType::SENSOR);
+  EXPECT_TRUE(queue.is_due(millis(), false));
+  EXPECT_TRUE(!queue.is_due(millis(), true));
+  host_test::advance_millis(600);
+  queue.push(&second, StateEventType::SENSOR);
+  EXPECT_TRUE(!queue.is_due(millis(), true));
+  host_test::advance_millis(400);
+  EXPECT_TRUE(queue.is_due(millis(), true));
+
+  // The hold back starts over with the next event after they were sent
+  queue.sent(millis());
+  host_test::advance_millis(5000);
+  queue.push(&first, StateEventType::SENSOR);
+  EXPECT_TRUE(!queue.is_due(millis(), true));
+  host_test::advance_millis(1000);
+  EXPECT_TRUE(queue.is_due(millis(), true));
+}
+
+}  // namespace web_server
+}  // namespace esphome
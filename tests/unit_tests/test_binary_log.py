@@ -0,0 +1,138 @@
+import struct
+
+import pytest
+
+from esphome import binary_log
+
+FORMAT_ADDRESS = 0x3F400100
+TAG_ADDRESS = 0x3F400200
+
+
+def varint(value):
+    result = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            result.append(byte | 0x80)
+        else:
+            result.append(byte)
+            return bytes(result)
+
+
+def zigzag(value):
+    return varint((value << 1) ^ (value >> 63))
+
+
+def string(value):
+    data = value.encode()
+    return varint(len(data)) + data
+
+
+def message(fmt, *args):
+    strings = {FORMAT_ADDRESS: fmt, TAG_ADDRESS: "sensor"}
+    data = varint(FORMAT_ADDRESS) + varint(TAG_ADDRESS) + varint(123) + b"".join(args)
+    return binary_log.decode_message(data, strings.__getitem__)
+
+
+@pytest.mark.parametrize(
+    "fmt, args, expected",
+    (
+        ("No arguments", (), "No arguments"),
+        ("%d %i", (zigzag(-5), zigzag(7)), "-5 7"),
+        ("%u %lu %zu", (varint(4000000000), varint(1), varint(2)), "4000000000 1 2"),
+        ("%x %X %02X %#x %#o", (varint(255),) * 3 + (varint(31), varint(8)), "ff FF FF 0x1f 010"),
+        ("%5d|%-5d|%05d|%+d", (zigzag(3),) * 4, "    3|3    |00003|+3"),
+        ("%.1f%%", (struct.pack("<f", 21.5),), "21.5%"),
+        ("%.2f %e", (struct.pack("<f", 0.25), struct.pack("<f", 1000.0)), "0.25 1.000000e+03"),
+        # Doubles are sent as float32 and lose their precision beyond about 7 digits
+        ("%.9f", (struct.pack("<f", 0.123456789),), "0.123456791"),
+        ("'%s' %-4s|", (string("abc"), string("x")), "'abc' x   |"),
+        ("%.*s %*d", (zigzag(2), string("xy"), zigzag(-3), zigzag(1)), "xy 1  "),
+        ("%c %p", (zigzag(ord("A")), varint(0x3FFB0000)), "A 0x3ffb0000"),
+    ),
+)
+def test_decode_message(fmt, args, expected):
+    tag, line, text = message(fmt, *args)
+
+    assert tag == "sensor"
+    assert line == 123
+    assert text == expected
+
+
+def test_decode_message__text_fallback():
+    data = varint(0) + string("wifi") + varint(7) + string("Connected to 'home'")
+
+    actual = binary_log.decode_message(data, {}.__getitem__)
+
+    assert actual == ("wifi", 7, "Connected to 'home'")
+
+
+def test_format_log_line():
+    actual = binary_log.format_log_line(2, "wifi", 7, "Weak signal")
+
+    assert actual == "\033[0;33m[W][wifi:007]: Weak signal\033[0m"
+
+
+def test_decode_log_line():
+    strings = {FORMAT_ADDRESS: "Value %d", TAG_ADDRESS: "sensor"}
+    data = varint(FORMAT_ADDRESS) + varint(TAG_ADDRESS) + varint(42) + zigzag(-1)
+
+    actual = binary_log.decode_log_line(5, data, strings.__getitem__)
+
+    assert actual == "\033[0;36m[D][sensor:042]: Value -1\033[0m"
+
+
+def test_decode_log_line__wrong_elf():
+    data = varint(FORMAT_ADDRESS) + varint(TAG_ADDRESS) + varint(42)
+
+    actual = binary_log.decode_log_line(5, data, {}.__getitem__)
+
+    assert "[D][binary_log:000]: Can't decode message" in actual
+
+
+def test_encode_bool_field():
+    assert binary_log.encode_bool_field(3, True) == b"\x18\x01"
+    assert binary_log.encode_bool_field(3, False) == b"\x18\x00"
+
+
+def test_find_bytes_field():
+    # SubscribeLogsResponse: level = 5, message = "abc", send_failed = true, binary_message = 01 02
+    # and a fixed32 and fixed64 field the decoder doesn't know
+    data = (
+        b"\x08\x05"
+        + b"\x1a\x03abc"
+        + b"\x20\x01"
+        + b"\x2a\x02\x01\x02"
+        + b"\x35"
+        + b"\0" * 4
+        + b"\x39"
+        + b"\0" * 8
+    )
+
+    assert binary_log.find_bytes_field(data, 5) == b"\x01\x02"
+    assert binary_log.find_bytes_field(data, 3) == b"abc"
+    assert binary_log.find_bytes_field(data, 6) is None
+    assert binary_log.find_bytes_field(b"", 5) is None
+
+
+def test_elf_strings(tmp_path):
+    # Minimal ELF32 with a null section, one section holding strings and one NOBITS section at the same address
+    content = b"sensor\0%d\0"
+    section_offset = 0x34
+    header_offset = section_offset + len(content)
+    data = bytearray(b"\x7fELF\x01\x01\x01" + b"\0" * 9)
+    data += struct.pack("<HHIIIIIHHHHHH", 2, 94, 1, 0, 0, header_offset, 0, 0x34, 0, 0, 40, 3, 0)
+    data += content
+    data += b"\0" * 40
+    data += struct.pack("<IIIIIIIIII", 0, 1, 2, 0x3F400000, section_offset, len(content), 0, 0, 1, 0)
+    data += struct.pack("<IIIIIIIIII", 0, 8, 3, 0x3F400000, 0, 0x100, 0, 0, 1, 0)
+    path = tmp_path / "firmware.elf"
+    path.write_bytes(bytes(data))
+
+    strings = binary_log.ElfStrings(str(path))
+
+    assert strings(0x3F400000) == "sensor"
+    assert strings(0x3F400007) == "%d"
+    with pytest.raises(KeyError):
+        strings(0x3F400100)
@@ -0,0 +1,17 @@
+import argparse
+
+import pytest
+
+from esphome.__main__ import upload_program
+from esphome.const import KEY_CORE, KEY_TARGET_PLATFORM
+from esphome.core import CORE, EsphomeError
+
+
+@pytest.mark.parametrize("platform", ["esp8266", "rp2040"])
+def test_upload_delta_base_only_esp32(monkeypatch, platform):
+    monkeypatch.setitem(CORE.data, KEY_CORE, {KEY_TARGET_PLATFORM: platform})
+    args = argparse.Namespace(delta_base="firmware.bin")
+    # Over the air and over serial
+    for host in ("192.168.1.10", "/dev/ttyUSB0"):
+        with pytest.raises(EsphomeError, match="only supported on ESP32"):
+            upload_program({}, args, host)
@@ -0,0 +1,122 @@
+import gzip
+import random
+import struct
+
+import pytest
+
+from esphome import ota_delta
+
+
+def image(size, seed=1):
+    """Code-like data: random instructions with absolute addresses among them."""
+    rnd = random.Random(seed)
+    words = []
+    for _ in range(size // 4):
+        if rnd.random() < 0.25:
+            words.append(0x400D0000 + rnd.randrange(0, size) & ~3)
+        else:
+            words.append(rnd.getrandbits(32) & 0x00FFFFFF)
+    return b"".join(struct.pack("<I", w) for w in words)
+
+
+def relocate(data, shift):
+    """Move all addresses in data by shift, like code that moved does."""
+    words = list(struct.unpack(f"<{len(data) // 4}I", data))
+    words = [w + shift if w >= 0x400D0000 else w for w in words]
+    return struct.pack(f"<{len(words)}I", *words)
+
+
+OLD = image(20000)
+
+
+@pytest.mark.parametrize(
+    "new",
+    (
+        OLD,
+        b"",
+        OLD[:100],
+        OLD + b"appended",
+        OLD[:5000] + image(300, seed=2) + OLD[5000:],
+        OLD[:5000] + OLD[6000:],
+        OLD[10000:] + OLD[:10000],
+        OLD[:8000] + relocate(OLD[8000:], 0x40),
+        OLD[:4000] + bytes([OLD[4000] ^ 0xFF]) + OLD[4001:],
+        image(20000, seed=3),
+    ),
+)
+def test_roundtrip(new):
+    patch = ota_delta.create_patch(OLD, new)
+
+    assert ota_delta.is_patch(patch)
+    assert ota_delta.apply_patch(OLD, patch) == new
+
+
+def test_roundtrip__empty_base():
+    new = image(1000)
+
+    assert ota_delta.apply_patch(b"", ota_delta.create_patch(b"", new)) == new
+
+
+def test_patch_is_small():
+    old = image(100000)
+    new = old[:5000] + image(300, seed=2) + relocate(old[5000:], 0x12C)
+
+    patch = ota_delta.create_patch(old, new)
+
+    # Compared to uploading the whole compressed image
+    assert len(gzip.compress(patch)) < len(gzip.compress(new)) // 4
+
+
+def test_apply_patch__base_larger_than_declared():
+    new = OLD + b"new"
+    patch = ota_delta.create_patch(OLD, new)
+
+    assert ota_delta.apply_patch(OLD + b"\xFF" * 100, patch) == new
+
+
+def test_is_patch():
+    assert not ota_delta.is_patch(OLD)
+    assert not ota_delta.is_patch(gzip.compress(OLD))
+
+
+@pytest.mark.parametrize(
+    "base",
+    (
+        OLD[:-1],
+        OLD[:1000] + b"\x00" + OLD[1001:],
+        image(20000, seed=2),
+    ),
+)
+def test_apply_patch__wrong_base(base):
+    patch = ota_delta.create_patch(OLD, OLD + b"new")
+
+    with pytest.raises(ota_delta.DeltaError, match="not created from this image"):
+        ota_delta.apply_patch(base, patch)
+
+
+def header(new=b"x"):
+    return ota_delta.create_patch(OLD, new)[: ota_delta.HEADER.size]
+
+
+@pytest.mark.parametrize(
+    "patch, message",
+    (
+        (b"ESPD", "truncated"),
+        (b"ESPX" + header()[4:], "Not a delta patch"),
+        (header()[:4] + b"\x02" + header()[5:], "Unsupported patch version"),
+        (header(), "truncated"),
+        (header() + b"\x00\x05x", "truncated"),
+        (header() + b"\x00\x02xy", "larger image"),
+        (header() + b"\x00\x01xz", "Unexpected data"),
+        (header() + b"\x00\x01y", "MD5"),
+        (header() + b"\x03", "Invalid operation"),
+        (header() + b"\x01\x80", "truncated"),
+        (header() + b"\x01\xFF\xFF\xFF\xFF\xFF\x01", "Invalid varint"),
+        (header() + b"\x01\x80\x80\x80\x80\x10\x01", "Invalid varint"),
+        (header() + b"\x01" + bytes([0xA0, 0x9C, 0x01]) + b"\x01", "past the end"),
+        (header() + b"\x02\x00\x01", "truncated"),
+    ),
+)
+def test_apply_patch__invalid(patch, message):
+    with pytest.raises(ota_delta.DeltaError, match=message):
+        ota_delta.apply_patch(OLD, patch)
@@ -0,0 +1,34 @@
+import gzip
+import hashlib
+
+from esphome.components import web_server
+from esphome.core import CORE
+
+
+def test_compress_include(tmp_path, monkeypatch):
+    content = b"body { color: red; }\n" * 50
+    (tmp_path / "style.css").write_bytes(content)
+    monkeypatch.setattr(CORE, "config_path", str(tmp_path / "test.yaml"))
+
+    data, etag = web_server.compress_include("style.css")
+
+    compressed = bytes(data)
+    assert len(compressed) < len(content)
+    assert gzip.decompress(compressed) == content
+    # A strong ETag, quotes included, that only depends on the content
+    assert etag == f'"{hashlib.sha256(content).hexdigest()[:16]}"'
+
+
+def test_compress_include__reproducible(tmp_path, monkeypatch):
+    monkeypatch.setattr(CORE, "config_path", str(tmp_path / "test.yaml"))
+    (tmp_path / "script.js").write_bytes(b"console.log('a');")
+    first = web_server.compress_include("script.js")
+    # gzip stores the modification time, it mustn't make the output differ between builds
+    (tmp_path / "script.js").write_bytes(b"console.log('a');")
+    second = web_server.compress_include("script.js")
+    assert first == second
+
+    (tmp_path / "script.js").write_bytes(b"console.log('b');")
+    data, etag = web_server.compress_include("script.js")
+    assert etag != first[1]
+    assert gzip.decompress(bytes(data)) == b"console.log('b');"